@@ -6,9 +6,11 @@ set -e
 cd "$(dirname "$0")"
 
 # check protoc version
+# The generated C++ code has to match the protobuf runtime of gRPC v1.28.1
+# (see env/install-grpc.sh) which is protobuf v3.11.2.
 protocVersion=$(protoc --version)
-if [[ ! $protocVersion = "libprotoc 3."* ]]; then
-    echo "protoc v3.x.x is required! Your version is $protocVersion";
+if [[ ! $protocVersion = "libprotoc 3.11.2" ]]; then
+    echo "protoc v3.11.2 is required! Your version is $protocVersion";
     exit 1;
 fi
 
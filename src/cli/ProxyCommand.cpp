@@ -14,8 +14,11 @@
 #include "cli/util.hpp"
 
 #include "netspeak/Netspeak.hpp"
+#include "netspeak/service/AsyncProxyServer.hpp"
+#include "netspeak/service/Backend.hpp"
 #include "netspeak/service/LoadBalanceProxy.hpp"
 #include "netspeak/service/NetspeakService.grpc.pb.h"
+#include "netspeak/service/ShardedProxy.hpp"
 #include "netspeak/util/service.hpp"
 
 namespace cli {
@@ -25,6 +28,14 @@ using namespace netspeak;
 
 #define PORT_KEY "port"
 #define SOURCE_KEY "source"
+#define SHARDED_KEY "sharded"
+#define CHANNELS_KEY "channels"
+#define ASYNC_KEY "async"
+#define NETWORK_THREADS_KEY "network-threads"
+#define LOAD_FACTOR_KEY "load-factor"
+#define HEDGE_PERCENTILE_KEY "hedge-percentile"
+#define CACHE_SIZE_KEY "cache-size"
+#define CACHE_TTL_KEY "cache-ttl"
 
 std::string ProxyCommand::desc() {
   return "A proxy to both combine and balance multiple Netspeak gRPC services.";
@@ -40,27 +51,95 @@ void ProxyCommand::add_options(bpo::options_description_easy_init& easy_init) {
             "Example:\n"
             "    netspeak4 proxy -p 1234 -s localhost:1401 -s localhost:1402\n"
             "\n"
+            "An address can be followed by `=<weight>` to give a replica a "
+            "larger or smaller share of the searches of its corpus, e.g. "
+            "`localhost:1403=2` for a replica twice as fast as the others. "
+            "The default weight is 1.\n"
+            "\n"
             "All the services behind the addresses are expected to be "
             "unchaning (the available corpora don't change) and to out-live "
             "this proxy. This cannot be used as a dynamic load balancer.");
+  easy_init(SHARDED_KEY, bpo::bool_switch(),
+            "Treat all sources of a corpus as disjoint shards of it instead of "
+            "replicas.\n"
+            "\n"
+            "Each search is forwarded to all shards of its corpus and their "
+            "results are merged. The shards of a corpus have to use unique "
+            "phrase ids, e.g. by partitioning the phrases by length.");
+  easy_init(CHANNELS_KEY, bpo::value<size_t>()->default_value(4),
+            "The number of channels (connections) to each source.\n"
+            "\n"
+            "Calls are spread over all channels of a source, so that a single "
+            "HTTP/2 connection doesn't limit the throughput of the proxy.");
+  easy_init(ASYNC_KEY, bpo::bool_switch(),
+            "Forward searches asynchronously using completion queues.\n"
+            "\n"
+            "By default, every forwarded search blocks one of gRPC's "
+            "synchronous threads until its source responded. In asynchronous "
+            "mode, searches are received and forwarded by network threads "
+            "without blocking, so the proxy can handle many more concurrent "
+            "searches. This isn't supported for sharded sources.");
+  easy_init(NETWORK_THREADS_KEY, bpo::value<size_t>(),
+            "The number of network threads in asynchronous mode.\n"
+            "\n"
+            "Defaults to the number of cores.");
+  easy_init(LOAD_FACTOR_KEY, bpo::value<double>()->default_value(1.25),
+            "The maximum load of a source relative to the average load of "
+            "all sources of its corpus.\n"
+            "\n"
+            "Each query prefers the same source to make use of its caches, "
+            "but a source with more than this factor times the average "
+            "number of outstanding searches gets no new searches until its "
+            "load dropped. This has to be at least 1.");
+  easy_init(HEDGE_PERCENTILE_KEY, bpo::value<double>()->default_value(0),
+            "Hedge searches that take longer than the given percentile "
+            "(0-100) of recent latencies of their corpus.\n"
+            "\n"
+            "A hedged search is sent to a second source of its corpus and "
+            "the first successful response is used. E.g. 95 hedges the "
+            "slowest 5% of searches. 0 disables hedging.");
+  easy_init(CACHE_SIZE_KEY, bpo::value<size_t>()->default_value(0),
+            "The size of the response cache in MiB.\n"
+            "\n"
+            "Successful responses of single searches are cached, so repeated "
+            "searches don't reach the sources. 0 disables the cache. This "
+            "isn't supported for sharded sources.");
+  easy_init(CACHE_TTL_KEY, bpo::value<double>()->default_value(60),
+            "The time in seconds after which a cached response expires.");
 }
 
-typedef std::shared_ptr<service::NetspeakService::Stub> StubPtr;
-StubPtr newStub(const std::string& address) {
-  auto channel =
-      grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
-  return service::NetspeakService::NewStub(channel);
+typedef std::shared_ptr<service::Backend> BackendPtr;
+
+double parseWeight(const std::string& value) {
+  try {
+    size_t end;
+    const double weight = std::stod(value, &end);
+    if (end == value.size() && weight > 0) {
+      return weight;
+    }
+  } catch (const std::exception&) {
+  }
+  throw std::logic_error("Invalid source weight: " + value);
 }
 
-std::vector<std::pair<service::Corpus, StubPtr>> scanSources(
-    const std::vector<std::string>& sources) {
-  std::vector<std::pair<service::Corpus, StubPtr>> list;
+std::vector<std::pair<service::Corpus, BackendPtr>> scanSources(
+    const std::vector<std::string>& sources, size_t channels) {
+  std::vector<std::pair<service::Corpus, BackendPtr>> list;
   std::unordered_map<std::string, std::pair<service::Corpus, std::string>>
       corpora_map;
-  for (const auto& address : sources) {
-    std::cout << "New stub " << address << "\n";
-    const auto stub = newStub(address);
-    const auto corpora_res = getCorpora(*stub, address);
+  for (const auto& source : sources) {
+    std::string address = source;
+    double weight = 1;
+    const auto weight_pos = source.rfind('=');
+    if (weight_pos != std::string::npos) {
+      address = source.substr(0, weight_pos);
+      weight = parseWeight(source.substr(weight_pos + 1));
+    }
+
+    std::cout << "New backend " << address << " (weight " << weight << ")\n";
+    const auto backend =
+        std::make_shared<service::Backend>(address, channels, weight);
+    const auto corpora_res = getCorpora(backend->stub(), address);
     std::cout << "Returned " << corpora_res.corpora().size() << " corpora\n";
 
     for (const auto& corpus : corpora_res.corpora()) {
@@ -84,34 +163,71 @@ std::vector<std::pair<service::Corpus, StubPtr>> scanSources(
       }
 
       std::cout << "    " << corpus << "\n";
-      list.push_back(std::pair<service::Corpus, StubPtr>(corpus, stub));
+      list.push_back(std::pair<service::Corpus, BackendPtr>(corpus, backend));
     }
   }
 
   return list;
 }
 
-std::unique_ptr<service::NetspeakService::Service> build_proxy_service(
-    boost::program_options::variables_map& variables) {
-  const auto& sources = variables[SOURCE_KEY].as<std::vector<std::string>>();
-
-  const auto list = scanSources(sources);
-
-  return std::make_unique<service::LoadBalanceProxy>(list);
-}
-
 int ProxyCommand::run(bpo::variables_map variables) {
   auto port = variables[PORT_KEY].as<uint16_t>();
-  auto service = build_proxy_service(variables);
-  service = add_logging(variables, std::move(service));
+  const auto& sources = variables[SOURCE_KEY].as<std::vector<std::string>>();
+  const auto list = scanSources(sources, variables[CHANNELS_KEY].as<size_t>());
+  const bool sharded = variables[SHARDED_KEY].as<bool>();
+  const bool async = variables[ASYNC_KEY].as<bool>();
+  service::LoadBalanceProxy::Options proxy_options;
+  proxy_options.load_factor = variables[LOAD_FACTOR_KEY].as<double>();
+  proxy_options.hedge_percentile =
+      variables[HEDGE_PERCENTILE_KEY].as<double>();
+  proxy_options.cache.max_bytes =
+      variables[CACHE_SIZE_KEY].as<size_t>() * 1024 * 1024;
+  proxy_options.cache.ttl = std::chrono::milliseconds(
+      static_cast<int64_t>(variables[CACHE_TTL_KEY].as<double>() * 1000));
+  if (sharded && async) {
+    throw std::logic_error("Sharded sources can't be forwarded to "
+                           "asynchronously.");
+  }
+  if (sharded && proxy_options.cache.max_bytes > 0) {
+    throw std::logic_error("Responses of sharded sources can't be cached.");
+  }
 
   grpc::ServerBuilder builder;
   builder.AddListeningPort("[::]:" + std::to_string(port),
                            grpc::InsecureServerCredentials());
-  builder.RegisterService(&*service);
-  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
-  std::cout << "Server listening on port " << port << "\n";
-  server->Wait();
+
+  if (async) {
+    auto proxy =
+        std::make_unique<service::LoadBalanceProxy>(list, proxy_options);
+    const auto& proxy_ref = *proxy;
+    auto service = add_logging(variables, std::move(proxy));
+    auto logger = dynamic_cast<service::RequestLogger*>(service.get());
+
+    service::AsyncProxyServer::Options options;
+    options.completion_queues =
+        variables.count(NETWORK_THREADS_KEY) == 0
+            ? std::max(std::thread::hardware_concurrency(), 1u)
+            : variables[NETWORK_THREADS_KEY].as<size_t>();
+    service::AsyncProxyServer server(std::move(service), proxy_ref, logger,
+                                     builder, options);
+    std::cout << "Server listening on port " << port << " ("
+              << options.completion_queues << " network threads)\n";
+    server.wait();
+  } else {
+    std::unique_ptr<service::NetspeakService::Service> service;
+    if (sharded) {
+      service = std::make_unique<service::ShardedProxy>(list);
+    } else {
+      service =
+          std::make_unique<service::LoadBalanceProxy>(list, proxy_options);
+    }
+    service = add_logging(variables, std::move(service));
+
+    builder.RegisterService(&*service);
+    std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+    std::cout << "Server listening on port " << port << "\n";
+    server->Wait();
+  }
 
   return EXIT_SUCCESS;
 }
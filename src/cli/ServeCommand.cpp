@@ -6,7 +6,9 @@
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
 #include "boost/algorithm/string.hpp"
 #include "boost/filesystem.hpp"
@@ -17,7 +19,9 @@
 
 #include "netspeak/Netspeak.hpp"
 #include "netspeak/error.hpp"
+#include "netspeak/service/AsyncServer.hpp"
 #include "netspeak/service/UniqueMap.hpp"
+#include "netspeak/util/ProcessSupervisor.hpp"
 #include "netspeak/util/PropertiesFormat.hpp"
 #include "netspeak/util/glob.hpp"
 #include "netspeak/util/service.hpp"
@@ -32,6 +36,11 @@ using namespace netspeak;
 #define CONFIG_KEY "config"
 #define PORT_KEY "port"
 #define OVERRIDE_KEY "override"
+#define ASYNC_KEY "async"
+#define NETWORK_THREADS_KEY "network-threads"
+#define SEARCH_THREADS_KEY "search-threads"
+#define MAX_QUEUED_SEARCHES_KEY "max-queued-searches"
+#define WORKERS_KEY "workers"
 
 std::string ServeCommand::desc() {
   return "Create a new gRPC server for a Netspeak index.";
@@ -67,6 +76,41 @@ void ServeCommand::add_options(
       "virtual file that contains all overrides and extends the given file.\n"
       "\n"
       "The only key that cannot be overriden is `extends`.");
+  easy_init(ASYNC_KEY, bpo::bool_switch(),
+            "Serve requests asynchronously using completion queues.\n"
+            "\n"
+            "By default, the server uses gRPC's synchronous thread pool which "
+            "uses the same threads to handle connections and to search. In "
+            "asynchronous mode, calls are received by network threads (one "
+            "completion queue each) and searches are executed by a separate "
+            "pool of search threads. Searches that don't fit into the queue of "
+            "the search threads are rejected with RESOURCE_EXHAUSTED.");
+  easy_init(NETWORK_THREADS_KEY, bpo::value<size_t>(),
+            "The number of network threads in asynchronous mode.\n"
+            "\n"
+            "Defaults to the number of cores.");
+  easy_init(SEARCH_THREADS_KEY, bpo::value<size_t>(),
+            "The number of search threads in asynchronous mode.\n"
+            "\n"
+            "Defaults to the number of cores.");
+  easy_init(MAX_QUEUED_SEARCHES_KEY, bpo::value<size_t>(),
+            "The maximum number of searches waiting for a search thread in "
+            "asynchronous mode.\n"
+            "\n"
+            "Defaults to 16 times the number of search threads.");
+  easy_init(WORKERS_KEY, bpo::value<size_t>(),
+            "Serve with the given number of worker processes.\n"
+            "\n"
+            "The indexes are loaded once and the workers are forked from the "
+            "loading process, so they share the memory of all loaded index "
+            "structures. All workers listen on the same port (SO_REUSEPORT) "
+            "and the kernel spreads the connections over them. The loading "
+            "process supervises the workers and restarts every worker that "
+            "exits. Each worker has its own caches and log files.\n"
+            "\n"
+            "By default, the server runs in a single process. The default "
+            "thread counts of asynchronous mode are divided by the number of "
+            "workers.");
   add_logging_options(easy_init);
 }
 
@@ -131,6 +175,7 @@ service::UniqueMap::entry load_map_entry(const Configuration& config) {
   return service::UniqueMap::entry{
     .instance = std::move(netspeak),
     .corpus = corpus,
+    .admission = service::AdmissionControl::Limits::from_config(config),
   };
 }
 
@@ -155,25 +200,74 @@ std::unique_ptr<service::NetspeakService::Service> build_service(
   return std::make_unique<service::UniqueMap>(std::move(entries));
 }
 
-int ServeCommand::run(boost::program_options::variables_map variables) {
+service::AsyncServer::Options get_async_options(
+    boost::program_options::variables_map& variables, size_t workers) {
+  const size_t cores =
+      std::max<size_t>(std::thread::hardware_concurrency() / workers, 1);
+  auto get = [&](const char* key, size_t default_value) {
+    return variables.count(key) == 0 ? default_value
+                                     : variables[key].as<size_t>();
+  };
+
+  service::AsyncServer::Options options;
+  options.completion_queues = get(NETWORK_THREADS_KEY, cores);
+  options.search_threads = get(SEARCH_THREADS_KEY, cores);
+  options.max_queued_searches =
+      get(MAX_QUEUED_SEARCHES_KEY, 16 * options.search_threads);
+  return options;
+}
+
+int serve(boost::program_options::variables_map& variables,
+          std::unique_ptr<service::NetspeakService::Service> service,
+          size_t workers, bool supervised) {
   auto port = variables[PORT_KEY].as<uint16_t>();
-  auto service = build_service(variables);
-  service = add_logging(variables, std::move(service));
+  // each worker logs to its own files
+  service = add_logging(variables, std::move(service), supervised);
 
   grpc::ServerBuilder builder;
   builder.AddListeningPort("[::]:" + std::to_string(port),
                            grpc::InsecureServerCredentials());
-  builder.RegisterService(&*service);
-  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
-  std::cout << "Server listening on port " << port << std::endl;
+  // all workers listen on the same port
+  builder.AddChannelArgument(GRPC_ARG_ALLOW_REUSEPORT, 1);
 
-  // For some reason, this flush is essential for the whole thing to work in
-  // docker. I have no idea why but after about 30h of trial and error, it
-  // finally worked and this is what made it work.
-  std::cout.flush();
+  if (variables[ASYNC_KEY].as<bool>()) {
+    const auto options = get_async_options(variables, workers);
+    service::AsyncServer server(std::move(service), builder, options);
+    std::cout << "Server listening on port " << port << " ("
+              << options.completion_queues << " network threads, "
+              << options.search_threads << " search threads)" << std::endl;
+    std::cout.flush();
 
-  server->Wait();
+    server.wait();
+  } else {
+    builder.RegisterService(&*service);
+    std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+    std::cout << "Server listening on port " << port << std::endl;
+
+    // For some reason, this flush is essential for the whole thing to work in
+    // docker. I have no idea why but after about 30h of trial and error, it
+    // finally worked and this is what made it work.
+    std::cout.flush();
+
+    server->Wait();
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int ServeCommand::run(boost::program_options::variables_map variables) {
+  auto service = build_service(variables);
+  if (variables.count(WORKERS_KEY) == 0) {
+    return serve(variables, std::move(service), 1, false);
+  }
 
+  // gRPC must not be used before the workers are forked, so the workers build
+  // their own servers. Each of them moves its own copy of the service.
+  const auto workers = variables[WORKERS_KEY].as<size_t>();
+  util::ProcessSupervisor supervisor(workers, [&]() {
+    return serve(variables, std::move(service), workers, true);
+  });
+  supervisor.run();
   return EXIT_SUCCESS;
 }
 
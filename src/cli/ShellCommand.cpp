@@ -1,5 +1,6 @@
 #include "cli/ShellCommand.hpp"
 
+#include <google/protobuf/arena.h>
 #include <grpc/grpc.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/client_context.h>
@@ -9,8 +10,12 @@
 #include <chrono>
 #include <cstdio>
 #include <iomanip>
+#include <string>
+#include <vector>
 
+#include "boost/algorithm/string/trim.hpp"
 #include "boost/filesystem.hpp"
+#include "boost/optional.hpp"
 
 #include "cli/util.hpp"
 
@@ -47,7 +52,9 @@ std::string ShellCommand::desc() {
          "Connect to a Netspeak server:\n"
          "    netspeak4 shell --source web-en.api.netspeak.org:7883\n"
          "    netspeak4 shell --source localhost:1234\n"
-         "    netspeak4 shell --source localhost:1234 --corpus web-en\n";
+         "    netspeak4 shell --source localhost:1234 --corpus web-en\n"
+         "\n"
+         "Several queries separated by `;;` are searched as one batch.\n";
 };
 
 void ShellCommand::add_options(
@@ -68,115 +75,192 @@ void ShellCommand::add_options(
 typedef std::function<void(const service::SearchRequest&,
                            service::SearchResponse&)>
     Searcher;
+typedef std::function<void(const service::SearchBatchRequest&,
+                           service::SearchBatchResponse&)>
+    BatchSearcher;
+
+const uint32_t max_phrases_request = 200;
+const uint32_t max_phrases_display = 50;
+
+/**
+ * @brief Splits the given input line into its queries.
+ *
+ * Queries are separated by `;;`. Empty queries are ignored.
+ */
+std::vector<std::string> split_queries(const std::string& line) {
+  std::vector<std::string> queries;
+  size_t start = 0;
+  while (true) {
+    const auto end = line.find(";;", start);
+    auto query = line.substr(start, end == std::string::npos
+                                        ? std::string::npos
+                                        : end - start);
+    boost::algorithm::trim(query);
+    if (!query.empty()) {
+      queries.push_back(std::move(query));
+    }
+    if (end == std::string::npos) {
+      break;
+    }
+    start = end + 2;
+  }
+  return queries;
+}
+
+void print_response(const service::SearchResponse& response,
+                    boost::optional<std::chrono::milliseconds> duration) {
+  if (response.has_result()) {
+    const auto& result = response.result();
+
+    // print some meta data about the response
+    std::cout << FG_BRIGHT_BLACK;
+    std::cout << result.phrases().size()
+              << " phrase(s) (limit=" << max_phrases_request << ")";
+    if (duration) {
+      std::cout << " took " << duration->count() << "ms";
+    }
+    if (!result.unknown_words().empty()) {
+      std::cout << " (" << result.unknown_words().size()
+                << " unknown word(s):";
+      for (const auto& unknown_word : result.unknown_words()) {
+        std::cout << " \"" << unknown_word << "\"";
+      }
+      std::cout << ")";
+    }
+    std::cout << RESET << std::endl;
+    std::cout << std::endl;
+
+    // print all retrieved phrases
+    size_t i = 1;
+    std::cout << "Rank: Frequency    Text" << std::endl;
+
+    uint32_t phrase_counter = 0;
+    for (const auto& phrase : result.phrases()) {
+      if (phrase_counter >= max_phrases_display) {
+        break;
+      }
+      phrase_counter++;
+
+      std::cout << std::right << std::setw(4) << i++ << ": " << std::left
+                << std::setw(12) << phrase.frequency();
+      for (const auto& word : phrase.words()) {
+        std::cout << " ";
+
+        // add some color
+        const auto tag = word.tag();
+        switch (tag) {
+          case service::Phrase::Word::WORD_FOR_QMARK:
+          case service::Phrase::Word::WORD_FOR_STAR:
+          case service::Phrase::Word::WORD_FOR_PLUS:
+          case service::Phrase::Word::WORD_FOR_REGEX:
+            std::cout << FG_RED;
+            break;
+          case service::Phrase::Word::WORD_IN_DICTSET:
+          case service::Phrase::Word::WORD_IN_OPTIONSET:
+          case service::Phrase::Word::WORD_IN_ORDERSET:
+            std::cout << FG_BLUE;
+            break;
+          default:
+            break;
+        }
+
+        // print word
+        std::cout << word.text();
+
+        // reset colors
+        std::cout << RESET;
+      }
+      std::cout << std::endl;
+    }
 
-void RunShell(Searcher& searcher) {
-  std::cout << "Enter a query (type 'q' to exit).\n";
+    if ((int)phrase_counter != result.phrases().size()) {
+      std::cout << "and " << (result.phrases().size() - phrase_counter)
+                << " more phrase(s)\n";
+    }
+  } else {
+    const auto& error = response.error();
+
+    // print error
+    std::cout << "Error: "
+              << service::SearchResponse::Error::Kind_Name(error.kind())
+              << ": " << error.message() << std::endl;
+  }
+}
 
-  const uint32_t max_phrases_request = 200;
-  const uint32_t max_phrases_display = 50;
+void RunShell(Searcher& searcher, BatchSearcher& batch_searcher) {
+  std::cout << "Enter a query (type 'q' to exit). Separate queries with ';;' "
+               "to search them as one batch.\n";
 
   // Set up a Netspeak request.
   service::SearchRequest request;
   request.set_max_phrases(max_phrases_request);
 
   while (true) {
-    std::string query;
+    std::string line;
     std::cout << "\n" << FG_BRIGHT_BLACK << ">>>" << RESET << " ";
-    std::getline(std::cin, query);
-    if (query == "q") {
+    std::getline(std::cin, line);
+    if (line == "q") {
       std::cout << "Shutting down. This might take a while." << std::endl;
       break;
     }
 
-    request.set_query(query);
+    const auto queries = split_queries(line);
+
+    if (queries.size() <= 1) {
+      request.set_query(queries.empty() ? line : queries[0]);
+
+      // Search Netspeak. This will never throw an exception.
+      // The response is allocated on an arena, so that all of its phrases and
+      // words are freed at once.
+      google::protobuf::Arena arena;
+      auto& response =
+          *google::protobuf::Arena::CreateMessage<service::SearchResponse>(
+              &arena);
+      const auto time_start = std::chrono::steady_clock::now();
+      try {
+        searcher(request, response);
+      } catch (std::exception& e) {
+        std::cerr << "Error during search: " << e.what() << "\n";
+        continue;
+      }
+      const auto duration = std::chrono::steady_clock::now() - time_start;
 
-    // Search Netspeak. This will never throw an exception.
-    service::SearchResponse response;
-    const auto time_start = std::chrono::steady_clock::now();
-    try {
-      searcher(request, response);
-    } catch (std::exception& e) {
-      std::cerr << "Error during search: " << e.what() << "\n";
-      continue;
-    }
-    const auto duration = std::chrono::steady_clock::now() - time_start;
+      print_response(response,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                         duration));
+    } else {
+      google::protobuf::Arena arena;
+      auto& batch_request =
+          *google::protobuf::Arena::CreateMessage<service::SearchBatchRequest>(
+              &arena);
+      auto& batch_response =
+          *google::protobuf::Arena::CreateMessage<service::SearchBatchResponse>(
+              &arena);
+      for (const auto& query : queries) {
+        auto req = batch_request.add_requests();
+        req->CopyFrom(request);
+        req->set_query(query);
+      }
 
-    if (response.has_result()) {
-      const auto& result = response.result();
+      const auto time_start = std::chrono::steady_clock::now();
+      try {
+        batch_searcher(batch_request, batch_response);
+      } catch (std::exception& e) {
+        std::cerr << "Error during search: " << e.what() << "\n";
+        continue;
+      }
+      const auto duration = std::chrono::steady_clock::now() - time_start;
 
-      // print some meta data about the response
-      std::cout << FG_BRIGHT_BLACK;
-      std::cout << result.phrases().size()
-                << " phrase(s) (limit=" << max_phrases_request << ") took "
+      std::cout << FG_BRIGHT_BLACK << queries.size() << " queries took "
                 << std::chrono::duration_cast<std::chrono::milliseconds>(
                        duration)
                        .count()
-                << "ms";
-      if (!result.unknown_words().empty()) {
-        std::cout << " (" << result.unknown_words().size()
-                  << " unknown word(s):";
-        for (const auto& unknown_word : result.unknown_words()) {
-          std::cout << " \"" << unknown_word << "\"";
-        }
-        std::cout << ")";
-      }
-      std::cout << RESET << std::endl;
-      std::cout << std::endl;
-
-      // print all retrieved phrases
-      size_t i = 1;
-      std::cout << "Rank: Frequency    Text" << std::endl;
-
-      uint32_t phrase_counter = 0;
-      for (const auto& phrase : result.phrases()) {
-        if (phrase_counter >= max_phrases_display) {
-          break;
-        }
-        phrase_counter++;
-
-        std::cout << std::right << std::setw(4) << i++ << ": " << std::left
-                  << std::setw(12) << phrase.frequency();
-        for (const auto& word : phrase.words()) {
-          std::cout << " ";
-
-          // add some color
-          const auto tag = word.tag();
-          switch (tag) {
-            case service::Phrase::Word::WORD_FOR_QMARK:
-            case service::Phrase::Word::WORD_FOR_STAR:
-            case service::Phrase::Word::WORD_FOR_PLUS:
-            case service::Phrase::Word::WORD_FOR_REGEX:
-              std::cout << FG_RED;
-              break;
-            case service::Phrase::Word::WORD_IN_DICTSET:
-            case service::Phrase::Word::WORD_IN_OPTIONSET:
-            case service::Phrase::Word::WORD_IN_ORDERSET:
-              std::cout << FG_BLUE;
-              break;
-            default:
-              break;
-          }
-
-          // print word
-          std::cout << word.text();
-
-          // reset colors
-          std::cout << RESET;
-        }
-        std::cout << std::endl;
-      }
-
-      if ((int)phrase_counter != result.phrases().size()) {
-        std::cout << "and " << (result.phrases().size() - phrase_counter)
-                  << " more phrase(s)\n";
+                << "ms" << RESET << std::endl;
+      for (int i = 0; i < batch_response.responses_size(); i++) {
+        std::cout << "\n" << FG_BRIGHT_BLACK << ">>>" << RESET << " "
+                  << queries[i] << std::endl;
+        print_response(batch_response.responses(i), boost::none);
       }
-    } else {
-      const auto& error = response.error();
-
-      // print error
-      std::cout << "Error: "
-                << service::SearchResponse::Error::Kind_Name(error.kind())
-                << ": " << error.message() << std::endl;
     }
     std::cout.flush();
   }
@@ -198,7 +282,17 @@ void RunNetspeakShell(const Configuration& config) {
                           service::SearchResponse& response) {
     netspeak.search(request, response);
   };
-  RunShell(searcher);
+  BatchSearcher batch_searcher = [&](const service::SearchBatchRequest& request,
+                                     service::SearchBatchResponse& response) {
+    std::vector<const service::SearchRequest*> requests;
+    std::vector<service::SearchResponse*> responses;
+    for (const auto& req : request.requests()) {
+      requests.push_back(&req);
+      responses.push_back(response.add_responses());
+    }
+    netspeak.search_batch(requests, responses);
+  };
+  RunShell(searcher, batch_searcher);
 }
 
 void handle_corpus_key(std::string& corpus_key,
@@ -270,7 +364,22 @@ void RunLocalServerShell(const std::string& address, std::string corpus_key) {
       throw std::logic_error(what.str());
     }
   };
-  RunShell(searcher);
+  BatchSearcher batch_searcher = [&](const service::SearchBatchRequest& request,
+                                     service::SearchBatchResponse& response) {
+    service::SearchBatchRequest req(request);
+    for (auto& r : *req.mutable_requests()) {
+      r.set_corpus(corpus_key);
+    }
+
+    grpc::ClientContext context;
+    auto status = stub->SearchBatch(&context, req, &response);
+    if (!status.ok()) {
+      std::stringstream what;
+      what << status;
+      throw std::logic_error(what.str());
+    }
+  };
+  RunShell(searcher, batch_searcher);
 }
 
 int ShellCommand::run(boost::program_options::variables_map variables) {
@@ -1,11 +1,13 @@
 #include "cli/StressCommand.hpp"
 
+#include <google/protobuf/arena.h>
 #include <grpc/grpc.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <fstream>
@@ -15,6 +17,7 @@
 #include <random>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "boost/filesystem.hpp"
 
@@ -35,6 +38,7 @@ using namespace netspeak;
 #define CONCURRENCY_KEY "concurrency"
 #define MAX_QUERIES_KEY "max-queries"
 #define TRACKING_ID_KEY "tracking-id"
+#define BATCH_SIZE_KEY "batch-size"
 
 std::string StressCommand::desc() {
   return "Runs a stress test against a Netspeak gRPC server and displays "
@@ -84,6 +88,12 @@ void StressCommand::add_options(
             "sending queries.");
   easy_init(TRACKING_ID_KEY ",t", bpo::value<std::string>(),
             "A tracking id sent along every request.");
+  easy_init(BATCH_SIZE_KEY ",b", bpo::value<uint32_t>()->default_value(1),
+            "The number of queries sent per request.\n"
+            "\n"
+            "If this is greater than 1, queries will be sent using the "
+            "SearchBatch method. All queries of a batch search the same corpus "
+            "and the measured durations are the durations of whole batches.");
 }
 
 
@@ -119,6 +129,18 @@ private:
     }
   }
 
+  static grpc::Status safe_search_batch(
+      netspeak::service::NetspeakService::Stub& stub,
+      grpc::ClientContext* context,
+      const netspeak::service::SearchBatchRequest& request,
+      netspeak::service::SearchBatchResponse* response) {
+    try {
+      return stub.SearchBatch(context, request, response);
+    } catch (...) {
+      return grpc::Status(grpc::StatusCode::UNKNOWN, "unknown");
+    }
+  }
+
   struct corpus_measurements {
     std::atomic<uint64_t> req_counter_;
     std::atomic<uint64_t> grpc_error_counter_;
@@ -190,7 +212,8 @@ public:
          const std::string& tracking_id)
       : queries_(queries), address_(address), tracking_id_(tracking_id) {}
 
-  void start(const uint32_t concurrency, const uint64_t max_queries) {
+  void start(const uint32_t concurrency, const uint64_t max_queries,
+             const uint32_t batch_size) {
     const auto corpus_keys = get_corpus_keys();
     if (corpus_keys.empty()) {
       throw std::logic_error(
@@ -218,33 +241,91 @@ public:
         std::uniform_int_distribution<int> keys_d(0, corpus_keys.size() - 1);
         std::uniform_int_distribution<int> queries_d(0, queries_.size() - 1);
 
-        while (++req_counter <= max_queries) {
-          grpc::ClientContext context;
-          service::SearchRequest req;
-          service::SearchResponse resp;
+        // Requests and responses are allocated on an arena which is reset
+        // after every request. The initial block is reused, so most requests
+        // don't allocate any memory for messages.
+        std::vector<char> arena_block(64 * 1024);
+        google::protobuf::ArenaOptions arena_options;
+        arena_options.initial_block = arena_block.data();
+        arena_options.initial_block_size = arena_block.size();
+        google::protobuf::Arena arena(arena_options);
+
+        while (true) {
+          const uint64_t first = req_counter.fetch_add(batch_size);
+          if (first >= max_queries) {
+            break;
+          }
+          const auto count =
+              static_cast<int>(std::min<uint64_t>(batch_size,
+                                                  max_queries - first));
 
+          grpc::ClientContext context;
           service::set_tracking_id(context, tracking_id_);
 
-          const auto query_index = queries_d(rnd);
           const auto corpus_keys_index = keys_d(rnd);
           auto& measurements = *measurements_list[corpus_keys_index];
 
-          req.set_query(queries_[query_index]);
-          req.set_corpus(corpus_keys[corpus_keys_index]);
-
-          const auto start = std::chrono::steady_clock::now();
-          const auto status = safe_search(*stub, &context, req, &resp);
-
-          measurements.add_duration(std::chrono::steady_clock::now() - start);
-          measurements.req_counter_++;
-
-          if (!status.ok()) {
-            measurements.grpc_error_counter_++;
-          } else if (resp.has_error()) {
-            measurements.resp_error_counter_++;
+          if (batch_size == 1) {
+            auto& req =
+                *google::protobuf::Arena::CreateMessage<service::SearchRequest>(
+                    &arena);
+            auto& resp = *google::protobuf::Arena::CreateMessage<
+                service::SearchResponse>(&arena);
+
+            req.set_query(queries_[queries_d(rnd)]);
+            req.set_corpus(corpus_keys[corpus_keys_index]);
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto status = safe_search(*stub, &context, req, &resp);
+
+            measurements.add_duration(std::chrono::steady_clock::now() -
+                                      start);
+            measurements.req_counter_++;
+
+            if (!status.ok()) {
+              measurements.grpc_error_counter_++;
+            } else if (resp.has_error()) {
+              measurements.resp_error_counter_++;
+            } else {
+              measurements.success_counter_++;
+            }
           } else {
-            measurements.success_counter_++;
+            auto& req = *google::protobuf::Arena::CreateMessage<
+                service::SearchBatchRequest>(&arena);
+            auto& resp = *google::protobuf::Arena::CreateMessage<
+                service::SearchBatchResponse>(&arena);
+
+            req.mutable_requests()->Reserve(count);
+            for (int i = 0; i < count; i++) {
+              auto r = req.add_requests();
+              r->set_query(queries_[queries_d(rnd)]);
+              r->set_corpus(corpus_keys[corpus_keys_index]);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto status = safe_search_batch(*stub, &context, req, &resp);
+
+            measurements.add_duration(std::chrono::steady_clock::now() -
+                                      start);
+            measurements.req_counter_ += count;
+
+            if (!status.ok()) {
+              measurements.grpc_error_counter_ += count;
+            } else {
+              for (const auto& r : resp.responses()) {
+                if (r.has_error()) {
+                  measurements.resp_error_counter_++;
+                } else {
+                  measurements.success_counter_++;
+                }
+              }
+              // missing responses count as gRPC errors
+              measurements.grpc_error_counter_ +=
+                  count - std::min(count, resp.responses_size());
+            }
           }
+
+          arena.Reset();
         }
       }));
     }
@@ -340,8 +421,13 @@ int StressCommand::run(boost::program_options::variables_map variables) {
                                ? ""
                                : variables[TRACKING_ID_KEY].as<std::string>();
 
+  const auto batch_size = variables[BATCH_SIZE_KEY].as<uint32_t>();
+  if (batch_size == 0) {
+    throw std::logic_error("The batch size has to be at least 1.");
+  }
+
   Tester tester(queries, source, tracking_id);
-  tester.start(concurrency, max);
+  tester.start(concurrency, max, batch_size);
 
   return EXIT_SUCCESS;
 }
@@ -33,11 +33,12 @@ void add_logging_options(bpo::options_description_easy_init& easy_init) {
 
 std::unique_ptr<NetspeakService::Service> add_logging(
     bpo::variables_map& variables,
-    std::unique_ptr<NetspeakService::Service> service) {
+    std::unique_ptr<NetspeakService::Service> service, bool with_pid) {
   if (variables.count(LOG_DIR_KEY) > 0) {
     // add a logger
     bfs::path log_dir(variables[LOG_DIR_KEY].as<std::string>());
-    return std::make_unique<RequestLogger>(std::move(service), log_dir);
+    return std::make_unique<RequestLogger>(std::move(service), log_dir,
+                                           with_pid);
   } else {
     return service;
   }
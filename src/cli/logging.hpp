@@ -15,7 +15,8 @@ void add_logging_options(
 
 std::unique_ptr<netspeak::service::NetspeakService::Service> add_logging(
     boost::program_options::variables_map& variables,
-    std::unique_ptr<netspeak::service::NetspeakService::Service> service);
+    std::unique_ptr<netspeak::service::NetspeakService::Service> service,
+    bool with_pid = false);
 
 } // namespace cli
 
@@ -30,13 +30,29 @@ PREFIX::CORPUS_NAME("corpus.name");
 PREFIX::CORPUS_LANGUAGE("corpus.language");
 
 PREFIX::CACHE_CAPACITY("cache.capacity");
+PREFIX::CACHE_REGEX_CAPACITY("cache.regex.capacity");
+PREFIX::CACHE_QUERY_CAPACITY("cache.query.capacity");
 
 PREFIX::QUERY_LOWER_CASE("query.lower-case");
+PREFIX::QUERY_PARSER("query.parser");
 
 PREFIX::SEARCH_MAX_NORM_QUERIES("search.max-norm-queries");
+PREFIX::SEARCH_BATCH_THREADS("search.batch.threads");
+
+PREFIX::SEARCH_COUNT_MAX_ENTRIES("search.count.max-entries");
+PREFIX::SEARCH_COUNT_MAX_TIME("search.count.max-time");
 
 PREFIX::SEARCH_REGEX_MAX_MATCHES("search.regex.max-matches");
 PREFIX::SEARCH_REGEX_MAX_TIME("search.regex.max-time");
+PREFIX::SEARCH_REGEX_THREADS("search.regex.threads");
+PREFIX::SEARCH_REGEX_TRIGRAM_INDEX("search.regex.trigram-index");
+PREFIX::SEARCH_REGEX_AFFIX_INDEX("search.regex.affix-index");
+
+PREFIX::ADMISSION_MAX_CONCURRENT("admission.max-concurrent");
+PREFIX::ADMISSION_MAX_CONCURRENT_COST("admission.max-concurrent-cost");
+PREFIX::ADMISSION_MAX_CONCURRENT_PER_CLIENT(
+    "admission.max-concurrent-per-client");
+PREFIX::ADMISSION_MAX_QUEUE_TIME("admission.max-queue-time");
 
 PREFIX::DEFAULT_PHRASE_INDEX_DIR_NAME("phrase-index");
 PREFIX::DEFAULT_PHRASE_CORPUS_DIR_NAME("phrase-corpus");
@@ -66,13 +66,28 @@ public:
   static const std::string CORPUS_LANGUAGE;
 
   static const std::string CACHE_CAPACITY;
+  static const std::string CACHE_REGEX_CAPACITY;
+  static const std::string CACHE_QUERY_CAPACITY;
 
   static const std::string QUERY_LOWER_CASE;
+  static const std::string QUERY_PARSER;
 
   static const std::string SEARCH_MAX_NORM_QUERIES;
+  static const std::string SEARCH_BATCH_THREADS;
+
+  static const std::string SEARCH_COUNT_MAX_ENTRIES;
+  static const std::string SEARCH_COUNT_MAX_TIME;
 
   static const std::string SEARCH_REGEX_MAX_MATCHES;
   static const std::string SEARCH_REGEX_MAX_TIME;
+  static const std::string SEARCH_REGEX_THREADS;
+  static const std::string SEARCH_REGEX_TRIGRAM_INDEX;
+  static const std::string SEARCH_REGEX_AFFIX_INDEX;
+
+  static const std::string ADMISSION_MAX_CONCURRENT;
+  static const std::string ADMISSION_MAX_CONCURRENT_COST;
+  static const std::string ADMISSION_MAX_CONCURRENT_PER_CLIENT;
+  static const std::string ADMISSION_MAX_QUEUE_TIME;
 
   static const std::string DEFAULT_PHRASE_INDEX_DIR_NAME;
   static const std::string DEFAULT_PHRASE_CORPUS_DIR_NAME;
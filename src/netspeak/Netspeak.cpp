@@ -1,10 +1,21 @@
 #include "netspeak/Netspeak.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <future>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "boost/lexical_cast.hpp"
 
 #include "netspeak/error.hpp"
+#include "netspeak/model/ContinuationToken.hpp"
+#include "netspeak/service/continuation.hpp"
 #include "netspeak/util/Vec.hpp"
 
 
@@ -16,7 +27,31 @@ using namespace model;
 const std::string DEFAULT_REGEX_MAX_MATCHES = "100";
 const std::string DEFAULT_REGEX_MAX_TIME = "20" /* ms */;
 const std::string DEFAULT_CACHE_CAPCITY = "1000000";
+const std::string DEFAULT_REGEX_CACHE_CAPCITY = "10000";
+const std::string DEFAULT_QUERY_CACHE_CAPCITY = "10000";
 const std::string DEFAULT_MAX_NORM_QUERIES = "1000";
+const std::string DEFAULT_COUNT_MAX_ENTRIES = "10000000";
+const std::string DEFAULT_COUNT_MAX_TIME = "100" /* ms */;
+const std::string DEFAULT_QUERY_PARSER = "recursive-descent";
+
+typedef std::shared_ptr<Query> (*query_parser)(const std::string& query);
+
+query_parser get_query_parser(const Configuration& config) {
+  const auto name =
+      config.get(Configuration::QUERY_PARSER, DEFAULT_QUERY_PARSER);
+  if (name == "recursive-descent") {
+    return &parse_query;
+  }
+  if (name == "antlr4") {
+    return &antlr4::parse_query;
+  }
+
+  std::stringstream out;
+  out << "Invalid query parser '" << name << "' for '"
+      << Configuration::QUERY_PARSER
+      << "'. Expected 'recursive-descent' or 'antlr4'.";
+  throw util::tracable_runtime_error(out.str());
+}
 
 Netspeak::search_config Netspeak::get_search_config(
     const Configuration& config) const {
@@ -24,12 +59,21 @@ Netspeak::search_config Netspeak::get_search_config(
     .max_norm_queries = boost::lexical_cast<size_t>(config.get(
         Configuration::SEARCH_MAX_NORM_QUERIES, DEFAULT_MAX_NORM_QUERIES)),
 
+    // count
+    .count_max_entries = boost::lexical_cast<uint64_t>(config.get(
+        Configuration::SEARCH_COUNT_MAX_ENTRIES, DEFAULT_COUNT_MAX_ENTRIES)),
+    .count_max_time =
+        std::chrono::milliseconds(boost::lexical_cast<size_t>(config.get(
+            Configuration::SEARCH_COUNT_MAX_TIME, DEFAULT_COUNT_MAX_TIME))),
+
     // regex
     .regex_max_matches = boost::lexical_cast<size_t>(config.get(
         Configuration::SEARCH_REGEX_MAX_MATCHES, DEFAULT_REGEX_MAX_MATCHES)),
     .regex_max_time =
         std::chrono::milliseconds(boost::lexical_cast<size_t>(config.get(
             Configuration::SEARCH_REGEX_MAX_TIME, DEFAULT_REGEX_MAX_TIME))),
+
+    .parse_query = get_query_parser(config),
   };
   return sc;
 }
@@ -43,14 +87,32 @@ void Netspeak::initialize(const Configuration& config) {
       config.get_required_path(Configuration::PATH_TO_PHRASE_DICTIONARY);
   const auto cache_cap =
       config.get(Configuration::CACHE_CAPACITY, DEFAULT_CACHE_CAPCITY);
+  const auto regex_cache_cap = config.get(Configuration::CACHE_REGEX_CAPACITY,
+                                          DEFAULT_REGEX_CACHE_CAPCITY);
+  const auto query_cache_cap = config.get(Configuration::CACHE_QUERY_CAPACITY,
+                                          DEFAULT_QUERY_CACHE_CAPCITY);
   const auto lower_case =
       config.get_bool(Configuration::QUERY_LOWER_CASE, false);
   const auto hash_dir_dir =
       config.get_optional_path(Configuration::PATH_TO_HASH_DICTIONARY);
   const auto regex_dir =
       config.get_optional_path(Configuration::PATH_TO_REGEX_VOCABULARY);
+  const regex::DefaultRegexIndex::InitConfig regex_config = {
+    .threads = boost::lexical_cast<size_t>(
+        config.get(Configuration::SEARCH_REGEX_THREADS,
+                   std::to_string(std::thread::hardware_concurrency()))),
+    .trigram_index =
+        config.get_bool(Configuration::SEARCH_REGEX_TRIGRAM_INDEX, false),
+    .affix_index =
+        config.get_bool(Configuration::SEARCH_REGEX_AFFIX_INDEX, false),
+  };
+
+  const auto batch_threads = boost::lexical_cast<size_t>(
+      config.get(Configuration::SEARCH_BATCH_THREADS,
+                 std::to_string(std::thread::hardware_concurrency())));
 
   result_cache_.reserve(std::stoul(cache_cap));
+  norm_query_cache_.reserve(std::stoul(query_cache_cap));
 
   {
     auto pd_result = std::async([&]() {
@@ -91,8 +153,8 @@ void Netspeak::initialize(const Configuration& config) {
           std::string regexwords((std::istreambuf_iterator<char>(ifs)),
                                  (std::istreambuf_iterator<char>()));
           ifs.close();
-          regex_index_ =
-              std::make_shared<regex::DefaultRegexIndex>(std::move(regexwords));
+          regex_index_ = std::make_shared<regex::DefaultRegexIndex>(
+              std::move(regexwords), regex_config);
           break;
         }
       }
@@ -107,10 +169,16 @@ void Netspeak::initialize(const Configuration& config) {
   query_normalizer_ = QueryNormalizer({
       .regex_index = regex_index_,
       .dictionary = hash_dictionary_,
+      .vocabulary = phrase_corpus_.vocabulary(),
       .lower_case = lower_case,
+      .regex_cache_capacity = std::stoul(regex_cache_cap),
   });
 
   query_processor_.initialize(config);
+
+  if (batch_threads > 0) {
+    batch_pool_ = std::make_unique<util::ThreadPool>(batch_threads);
+  }
 }
 
 Properties Netspeak::properties() const {
@@ -130,6 +198,23 @@ Properties Netspeak::properties() const {
   std::ostringstream oss;
   result_cache_.list(oss, 100);
   properties[Properties::cache_top_100] = oss.str();
+  const auto regex_cache = query_normalizer_.regex_cache();
+  properties[Properties::cache_regex_size] =
+      std::to_string(regex_cache ? regex_cache->size() : 0);
+  properties[Properties::cache_regex_capacity] =
+      std::to_string(regex_cache ? regex_cache->capacity() : 0);
+  properties[Properties::cache_regex_access_count] =
+      std::to_string(regex_cache ? regex_cache->access_count() : 0);
+  properties[Properties::cache_regex_hit_rate] =
+      std::to_string(regex_cache ? regex_cache->hit_rate() : 0);
+  properties[Properties::cache_query_size] =
+      std::to_string(norm_query_cache_.size());
+  properties[Properties::cache_query_capacity] =
+      std::to_string(norm_query_cache_.capacity());
+  properties[Properties::cache_query_access_count] =
+      std::to_string(norm_query_cache_.access_count());
+  properties[Properties::cache_query_hit_rate] =
+      std::to_string(norm_query_cache_.hit_rate());
 
   // phrase corpus properties
   properties[Properties::phrase_corpus_1gram_count] =
@@ -161,9 +246,73 @@ Properties Netspeak::properties() const {
   properties[Properties::regex_vocabulary_size] = std::to_string(vocal_size);
   properties[Properties::regex_vocabulary_value_type] =
       std::string(typeid(regex::DefaultRegexIndex).name());
+  const auto trigram_index =
+      regex_index_ ? regex_index_->trigram_index() : nullptr;
+  properties[Properties::regex_trigram_index_size] =
+      std::to_string(trigram_index ? trigram_index->size() : 0);
+  const auto regex_memory = regex_index_
+                                ? regex_index_->memory_usage()
+                                : regex::DefaultRegexIndex::MemoryUsage{};
+  properties[Properties::regex_vocabulary_memory] =
+      std::to_string(regex_memory.vocabulary);
+  properties[Properties::regex_word_offsets_memory] =
+      std::to_string(regex_memory.word_offsets);
+  properties[Properties::regex_word_hash_table_memory] =
+      std::to_string(regex_memory.word_hash_table);
+  properties[Properties::regex_characters_memory] =
+      std::to_string(regex_memory.characters);
+  properties[Properties::regex_trigram_index_memory] =
+      std::to_string(regex_memory.trigram_index);
+  properties[Properties::regex_affix_index_memory] =
+      std::to_string(regex_memory.affix_index);
+
+  // search properties
+  const auto search_stats = stats();
+  const auto nanoseconds = [&](SearchStats::Stage stage) {
+    return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              search_stats.time(stage))
+                              .count());
+  };
+  properties[Properties::search_count] = std::to_string(search_stats.searches);
+  properties[Properties::search_time_parse] =
+      nanoseconds(SearchStats::Stage::PARSE);
+  properties[Properties::search_time_normalize] =
+      nanoseconds(SearchStats::Stage::NORMALIZE);
+  properties[Properties::search_time_postlist_index] =
+      nanoseconds(SearchStats::Stage::POSTLIST_INDEX);
+  properties[Properties::search_time_postlist_read] =
+      nanoseconds(SearchStats::Stage::POSTLIST_READ);
+  properties[Properties::search_time_intersect] =
+      nanoseconds(SearchStats::Stage::INTERSECT);
+  properties[Properties::search_time_merge] =
+      nanoseconds(SearchStats::Stage::MERGE);
+  properties[Properties::search_time_read_phrases] =
+      nanoseconds(SearchStats::Stage::READ_PHRASES);
+  properties[Properties::search_norm_query_count] =
+      std::to_string(search_stats.norm_queries);
+  properties[Properties::search_postlist_count] =
+      std::to_string(search_stats.postlists_read);
+  properties[Properties::search_postlist_bytes] =
+      std::to_string(search_stats.bytes_read);
+  properties[Properties::search_entry_count] =
+      std::to_string(search_stats.entries_scanned);
+  properties[Properties::search_cache_result_hits] =
+      std::to_string(search_stats.result_cache_hits);
+  properties[Properties::search_cache_query_hits] =
+      std::to_string(search_stats.query_cache_hits);
   return properties;
 }
 
+SearchStats Netspeak::stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+void Netspeak::add_stats_(const SearchStats& stats) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_ += stats;
+}
+
 
 service::Phrase::Word::Tag to_tag(const NormQuery::Unit& unit) {
   std::shared_ptr<const Query::Unit> source = unit.source().unit;
@@ -192,36 +341,131 @@ service::Phrase::Word::Tag to_tag(const NormQuery::Unit& unit) {
 }
 /**
  * @brief Converts the given search result item into a (service) phrase.
+ *
+ * The words of the item are moved into the phrase.
  */
 void set_response_phrase(service::Phrase& resp_phrase,
-                         const SearchResult::Item& item) {
+                         SearchResult::Item&& item) {
   resp_phrase.set_id(item.phrase.id());
   resp_phrase.set_frequency(item.phrase.freq());
 
   // words
-  const auto& words = item.phrase.words();
+  auto& words = item.phrase.words();
+  auto resp_words = resp_phrase.mutable_words();
+  resp_words->Reserve(words.size());
   for (size_t i = 0; i != words.size(); i++) {
-    auto resp_word = resp_phrase.add_words();
-    resp_word->set_text(words[i]);
+    auto resp_word = resp_words->Add();
+    resp_word->set_text(std::move(words[i]));
     resp_word->set_tag(to_tag(item.query->units()[i]));
   }
 }
 
+/**
+ * @brief Decodes the continuation token of the given request and changes the
+ * given search options such that they start right after the last phrase of the
+ * previous page.
+ *
+ * The search for the next page starts at the frequency of the last phrase of
+ * the previous page and skips the phrases of this frequency up to its id, so
+ * the page size stays the same no matter how many phrases share a frequency.
+ */
+void apply_continuation_token(const service::SearchRequest& request,
+                              SearchOptions& options) {
+  if (request.continuation_token().empty()) {
+    return;
+  }
+  ContinuationToken token;
+  if (!ContinuationToken::decode(request.continuation_token(), token) ||
+      token.request_hash != service::continuation_hash(request)) {
+    throw invalid_parameter_error("Invalid continuation token");
+  }
+
+  if (token.frequency <= options.max_phrase_frequency) {
+    options.max_phrase_frequency = token.frequency;
+    options.min_phrase_id = token.phrase_id + 1;
+  }
+}
+
+/**
+ * @brief Converts the given search stats into (service) search stats.
+ */
+void set_response_stats(service::SearchStats& resp_stats,
+                        const SearchStats& stats) {
+  const auto nanoseconds = [&](SearchStats::Stage stage) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               stats.time(stage))
+        .count();
+  };
+  resp_stats.set_parse_time(nanoseconds(SearchStats::Stage::PARSE));
+  resp_stats.set_normalize_time(nanoseconds(SearchStats::Stage::NORMALIZE));
+  resp_stats.set_postlist_index_time(
+      nanoseconds(SearchStats::Stage::POSTLIST_INDEX));
+  resp_stats.set_postlist_read_time(
+      nanoseconds(SearchStats::Stage::POSTLIST_READ));
+  resp_stats.set_intersect_time(nanoseconds(SearchStats::Stage::INTERSECT));
+  resp_stats.set_merge_time(nanoseconds(SearchStats::Stage::MERGE));
+  resp_stats.set_read_phrases_time(
+      nanoseconds(SearchStats::Stage::READ_PHRASES));
+  resp_stats.set_norm_queries(stats.norm_queries);
+  resp_stats.set_postlists_read(stats.postlists_read);
+  resp_stats.set_bytes_read(stats.bytes_read);
+  resp_stats.set_entries_scanned(stats.entries_scanned);
+  resp_stats.set_result_cache_hits(stats.result_cache_hits);
+  resp_stats.set_query_cache_hits(stats.query_cache_hits);
+}
+
 void Netspeak::search(const service::SearchRequest& request,
-                      service::SearchResponse& response) throw() {
+                      service::SearchResponse& response,
+                      std::shared_ptr<const Query> parsed_query) throw() {
+  SearchStats stats;
+  stats.searches = 1;
+  search_(request, std::move(parsed_query), response, stats);
+  if (request.debug()) {
+    set_response_stats(*response.mutable_stats(), stats);
+  }
+  add_stats_(stats);
+}
+
+void Netspeak::search_(const service::SearchRequest& request,
+                       std::shared_ptr<const Query> parsed_query,
+                       service::SearchResponse& response,
+                       SearchStats& stats) throw() {
   try {
-    // parse the query
-    const auto query = antlr4::parse_query(request.query());
+    // All temporary data of this request is allocated in this arena and freed
+    // at once at the end of the request.
+    util::RequestArena arena;
 
     // destruct the given request into options we can use
     const auto option_pair = to_options(request);
     const auto normalizer_options = option_pair.first;
-    const auto search_options = option_pair.second;
+    auto search_options = option_pair.second;
+
+    if (request.count_only()) {
+      // counts ignore the page size and the continuation token
+      const auto norm_queries = normalize_(request.query(), parsed_query,
+                                           normalizer_options, stats);
+      count_(search_options, *norm_queries, request.estimate_count(),
+             *response.mutable_result(), stats, arena.resource());
+      return;
+    }
+
+    // resume after the last phrase of the previous page
+    apply_continuation_token(request, search_options);
+
+    // parse and normalize the query
+    const auto norm_queries = normalize_(request.query(), parsed_query,
+                                         normalizer_options, stats);
 
     // perform the raw seach (returns phrases and phrase references)
-    auto raw_result = search_raw_(normalizer_options, search_options, query);
+    auto raw_result =
+        search_raw_(search_options, *norm_queries, stats, arena.resource());
     // resolve the phrase references and merge with the other phrases
-    auto phrase_result = merge_raw_result_(search_options, *raw_result);
+    std::unique_ptr<SearchResult> phrase_result;
+    {
+      StageTimer timer(stats, SearchStats::Stage::MERGE);
+      phrase_result = merge_raw_result_(search_options, *raw_result, stats,
+                                        arena.resource());
+    }
 
     // construct the result
     auto response_result = response.mutable_result();
@@ -231,15 +475,32 @@ void Netspeak::search(const service::SearchRequest& request,
         response_result->add_unknown_words(unknown);
       }
     }
+    auto& phrases = phrase_result->phrases();
+    const size_t page_size = request.max_phrases();
+    if (phrases.size() > page_size) {
+      phrases.erase(phrases.begin() + page_size, phrases.end());
+    }
+    // a full page might be followed by more phrases
+    if (page_size != 0 && phrases.size() == page_size) {
+      const auto& last = phrases.back().phrase;
+      const auto token =
+          service::next_continuation_token(request, last.freq(), last.id());
+      response_result->set_continuation_token(token.encode());
+    }
     // add phrases
-    for (const auto& phrase : phrase_result->phrases()) {
+    response_result->mutable_phrases()->Reserve(phrases.size());
+    for (auto& phrase : phrases) {
       auto resp_phrase = response_result->add_phrases();
-      set_response_phrase(*resp_phrase, phrase);
+      set_response_phrase(*resp_phrase, std::move(phrase));
     }
   } catch (const invalid_query_error& e) {
     auto resp_error = response.mutable_error();
     resp_error->set_kind(service::SearchResponse::Error::INVALID_QUERY);
     resp_error->set_message(e.what());
+  } catch (const invalid_parameter_error& e) {
+    auto resp_error = response.mutable_error();
+    resp_error->set_kind(service::SearchResponse::Error::INVALID_PARAMETER);
+    resp_error->set_message(e.what());
   } catch (const std::logic_error& e) {
     auto resp_error = response.mutable_error();
     resp_error->set_kind(service::SearchResponse::Error::INTERNAL_ERROR);
@@ -255,6 +516,145 @@ void Netspeak::search(const service::SearchRequest& request,
   }
 }
 
+/**
+ * @brief Returns a unique string representation for the given query and
+ * normalizer options.
+ */
+std::string norm_query_cache_key(const std::string& query,
+                                 const QueryNormalizer::Options& options) {
+  std::string key;
+  key.append(std::to_string(options.max_norm_queries)).push_back(' ');
+  key.append(std::to_string(options.min_length)).push_back(' ');
+  key.append(std::to_string(options.max_length)).push_back(' ');
+  key.append(std::to_string(options.max_regex_matches)).push_back(' ');
+  key.append(std::to_string(options.max_regex_time.count())).push_back(' ');
+  key.append(query);
+  return key;
+}
+
+const size_t Netspeak::EXACT_COUNT_COST = 10;
+
+size_t Netspeak::estimate_cost(
+    const service::SearchRequest& request,
+    std::shared_ptr<const Query>* parsed_query) throw() {
+  try {
+    const size_t factor =
+        request.count_only() && !request.estimate_count() ? EXACT_COUNT_COST
+                                                          : 1;
+    const auto normalizer_options = to_options(request).first;
+    const auto key = norm_query_cache_key(request.query(), normalizer_options);
+    // Only peek, so that requests which are rejected don't keep their norm
+    // queries in the cache.
+    const auto cached = norm_query_cache_.peek(key);
+    if (cached) {
+      return factor * cached->size();
+    }
+    // Without cached norm queries, the cost is estimated without searching
+    // for the matches of regexes. That's left to the search if it's admitted.
+    std::shared_ptr<const Query> query =
+        search_config_.parse_query(request.query());
+    const size_t cost =
+        factor * query_normalizer_.estimate(query, normalizer_options);
+    if (parsed_query) {
+      *parsed_query = std::move(query);
+    }
+    return cost;
+  } catch (...) {
+    // The search will report the error.
+    return 0;
+  }
+}
+
+void Netspeak::search_batch(
+    const std::vector<const service::SearchRequest*>& requests,
+    const std::vector<service::SearchResponse*>& responses,
+    const std::vector<std::shared_ptr<const Query>>& parsed_queries) throw() {
+  const size_t count = std::min(requests.size(), responses.size());
+
+  // Identical requests are only searched once. The i-th request is identical
+  // to the original[i]-th request.
+  std::vector<size_t> original(count);
+  std::vector<size_t> unique;
+  {
+    std::unordered_map<std::string, size_t> seen;
+    for (size_t i = 0; i != count; i++) {
+      const auto pair = seen.emplace(requests[i]->SerializeAsString(), i);
+      original[i] = pair.first->second;
+      if (pair.second) {
+        unique.push_back(i);
+      }
+    }
+  }
+
+  // The calling thread and some batch threads take the next unsearched request
+  // until all are done. The calling thread always helps, so the batch will
+  // finish even if the batch threads are busy with other batches. It only
+  // waits for the batch threads which started helping before it was done;
+  // tasks which start later return right away. The tasks may outlive this
+  // call, so they only share the state below.
+  struct BatchState {
+    std::vector<const service::SearchRequest*> requests;
+    std::vector<service::SearchResponse*> responses;
+    std::vector<std::shared_ptr<const Query>> parsed_queries;
+    std::vector<size_t> unique;
+    std::atomic<size_t> next{ 0 };
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t running = 0;
+    bool done = false;
+  };
+  const auto state = std::make_shared<BatchState>();
+  state->requests = requests;
+  state->responses = responses;
+  state->parsed_queries = parsed_queries;
+  state->parsed_queries.resize(count);
+  state->unique = std::move(unique);
+
+  const auto search_all = [this](BatchState& batch) {
+    for (size_t k = batch.next++; k < batch.unique.size(); k = batch.next++) {
+      const size_t i = batch.unique[k];
+      search(*batch.requests[i], *batch.responses[i],
+             batch.parsed_queries[i]);
+    }
+  };
+
+  const size_t helpers = batch_parallelism(state->unique.size()) - 1;
+  for (size_t i = 0; i != helpers; i++) {
+    batch_pool_->execute([state, search_all]() {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done) {
+          return;
+        }
+        state->running++;
+      }
+      search_all(*state);
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->running--;
+      state->cv.notify_one();
+    });
+  }
+  search_all(*state);
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done = true;
+    state->cv.wait(lock, [&]() { return state->running == 0; });
+  }
+
+  for (size_t i = 0; i != count; i++) {
+    if (original[i] != i) {
+      responses[i]->CopyFrom(*responses[original[i]]);
+    }
+  }
+}
+
+size_t Netspeak::batch_parallelism(size_t requests) const {
+  if (!batch_pool_ || requests <= 1) {
+    return 1;
+  }
+  return 1 + std::min(batch_pool_->size(), requests - 1);
+}
+
 
 std::pair<QueryNormalizer::Options, SearchOptions> Netspeak::to_options(
     const service::SearchRequest& request) {
@@ -279,6 +679,7 @@ std::pair<QueryNormalizer::Options, SearchOptions> Netspeak::to_options(
   SearchOptions s_options = {
     .max_phrase_count = request.max_phrases(),
     .max_phrase_frequency = max_freq,
+    .min_phrase_id = 0,
     .phrase_length_min = min_len,
     .phrase_length_max = max_len,
     // TODO: Replace these with configurable values
@@ -301,12 +702,15 @@ std::pair<QueryNormalizer::Options, SearchOptions> Netspeak::to_options(
 
 
 struct ref_ {
-  std::shared_ptr<const NormQuery> query;
+  // This points to the query of the \c RawResult::RefItem of the reference, so
+  // that we don't have to touch the reference count of the query for every
+  // reference.
+  const std::shared_ptr<const NormQuery>* query;
   Phrase::Id id;
   RawRefResult::Ref::Frequency freq;
 
   ref_() = delete;
-  ref_(std::shared_ptr<const NormQuery> query, Phrase::Id id,
+  ref_(const std::shared_ptr<const NormQuery>* query, Phrase::Id id,
        RawRefResult::Ref::Frequency freq)
       : query(query), id(id), freq(freq) {}
 
@@ -326,22 +730,46 @@ struct ref_ {
   }
 };
 
-std::unique_ptr<std::set<ref_>> merge_phrase_refs(
-    const std::vector<RawResult::RefItem>& raw_references) {
-  auto set = std::make_unique<std::set<ref_>>();
+/**
+ * @brief Sorts the given items and removes all but the first of equivalent
+ * items.
+ *
+ * This does the same as inserting all items into a \c std::set but without
+ * allocating a node for each item.
+ */
+template <typename T>
+void sort_unique(std::pmr::vector<T>& items) {
+  std::stable_sort(items.begin(), items.end());
+  const auto last = std::unique(
+      items.begin(), items.end(),
+      [](const T& a, const T& b) { return !(a < b) && !(b < a); });
+  items.erase(last, items.end());
+}
+
+std::pmr::vector<ref_> merge_phrase_refs(
+    const std::vector<RawResult::RefItem>& raw_references,
+    std::pmr::memory_resource* arena) {
+  size_t total = 0;
+  for (const auto& ref_item : raw_references) {
+    total += ref_item.result->refs().size();
+  }
 
+  std::pmr::vector<ref_> refs(arena);
+  refs.reserve(total);
   for (const auto& ref_item : raw_references) {
     const auto& query = ref_item.query;
     Phrase::Id::Length len = query->size();
     for (const auto& raw_ref : ref_item.result->refs()) {
-      set->insert(ref_(query, Phrase::Id(len, raw_ref.id()), raw_ref.freq()));
+      refs.emplace_back(&query, Phrase::Id(len, raw_ref.id()), raw_ref.freq());
     }
   }
 
-  return set;
+  sort_unique(refs);
+  return refs;
 }
 std::unique_ptr<SearchResult> Netspeak::merge_raw_result_(
-    const SearchOptions& options, const RawResult& raw_result) {
+    const SearchOptions& options, const RawResult& raw_result,
+    SearchStats& stats, std::pmr::memory_resource* arena) {
   auto search_result = std::make_unique<SearchResult>();
   util::vec_append(search_result->unknown_words(), raw_result.unknown_words());
 
@@ -351,92 +779,418 @@ std::unique_ptr<SearchResult> Netspeak::merge_raw_result_(
   }
 
   // Extract the top k unique phrase refs.
-  // TODO: This can done more efficiently
-  const auto unique_refs = merge_phrase_refs(raw_result.refs());
-  size_t top_k = std::min(unique_refs->size(), max_phrase_count);
-  std::vector<ref_> top_k_refs;
-  std::copy_n(unique_refs->begin(), top_k, std::back_inserter(top_k_refs));
+  auto unique_refs = merge_phrase_refs(raw_result.refs(), arena);
+  size_t top_k = std::min(unique_refs.size(), max_phrase_count);
+  unique_refs.erase(unique_refs.begin() + top_k, unique_refs.end());
 
   // Read all top k phrases found by wildcard queries.
   std::vector<Phrase::Id> tok_k_ref_ids;
-  for (const auto& ref : top_k_refs) {
+  tok_k_ref_ids.reserve(top_k);
+  for (const auto& ref : unique_refs) {
     tok_k_ref_ids.push_back(ref.id);
   }
-  auto ref_phrases = phrase_corpus_.read_phrases(tok_k_ref_ids);
+  std::vector<Phrase> ref_phrases;
+  {
+    StageTimer timer(stats, SearchStats::Stage::READ_PHRASES);
+    ref_phrases = phrase_corpus_.read_phrases(tok_k_ref_ids);
+  }
 
-  // Copy all phrases into a final *sorted* merge set.
-  std::set<SearchResult::Item> final_phrases;
+  // Copy all phrases into a final *sorted* merge list.
+  std::pmr::vector<SearchResult::Item> final_phrases(arena);
+  size_t raw_phrase_count = 0;
+  for (const auto& phrase_item : raw_result.phrases()) {
+    raw_phrase_count += phrase_item.result->phrases().size();
+  }
+  final_phrases.reserve(top_k + raw_phrase_count);
   // phrases from references
-  for (size_t i = 0; i != top_k_refs.size(); i++) {
-    final_phrases.insert(
-        SearchResult::Item(top_k_refs[i].query, ref_phrases[i]));
+  for (size_t i = 0; i != top_k; i++) {
+    final_phrases.emplace_back(*unique_refs[i].query,
+                               std::move(ref_phrases[i]));
   }
   // phrases from the raw result set
   for (const auto& phrase_item : raw_result.phrases()) {
     const auto& query = phrase_item.query;
     for (const auto& phrase : phrase_item.result->phrases()) {
-      final_phrases.insert(SearchResult::Item(query, phrase));
+      final_phrases.emplace_back(query, phrase);
     }
   }
+  sort_unique(final_phrases);
 
-  // Copy the final top k phrases into the search result.
+  // Move the final top k phrases into the search result.
   top_k = std::min(final_phrases.size(), max_phrase_count);
-  std::copy_n(final_phrases.begin(), top_k,
-              std::back_inserter(search_result->phrases()));
+  search_result->phrases().reserve(top_k);
+  std::move(final_phrases.begin(), final_phrases.begin() + top_k,
+            std::back_inserter(search_result->phrases()));
 
   return search_result;
 }
 
+struct stream_item_ {
+  // This points to one of the queries of the stream, so that we don't have to
+  // touch the reference count of the query for every item.
+  const std::shared_ptr<const NormQuery>* query;
+  Phrase::Id id;
+  Phrase::Frequency freq;
+  // The phrase of the item if it was found by a non-wildcard query. The
+  // phrases of references are read when they are sent.
+  const Phrase* phrase;
+
+  stream_item_() = delete;
+  stream_item_(const std::shared_ptr<const NormQuery>* query, Phrase::Id id,
+               Phrase::Frequency freq, const Phrase* phrase)
+      : query(query), id(id), freq(freq), phrase(phrase) {}
+
+  bool operator<(const stream_item_& rhs) const {
+    if (freq != rhs.freq) {
+      // sort by descending frequency
+      return freq > rhs.freq;
+    } else {
+      return id < rhs.id;
+    }
+  }
+};
+
+void set_response_error(service::SearchResponse& response,
+                        service::SearchResponse::Error::Kind kind,
+                        const std::string& message) {
+  response.Clear();
+  auto resp_error = response.mutable_error();
+  resp_error->set_kind(kind);
+  resp_error->set_message(message);
+}
+
+void Netspeak::search_stream(
+    const service::SearchRequest& request,
+    const std::function<bool(const service::SearchResponse&)>& writer,
+    std::shared_ptr<const Query> parsed_query) throw() {
+  service::SearchResponse response;
+  if (request.count_only()) {
+    // a count is a single number, so there is nothing to stream
+    search(request, response, std::move(parsed_query));
+    writer(response);
+    return;
+  }
+  SearchStats stats;
+  stats.searches = 1;
+  try {
+    util::RequestArena arena;
+
+    const auto option_pair = to_options(request);
+    const auto normalizer_options = option_pair.first;
+    auto search_options = option_pair.second;
+
+    apply_continuation_token(request, search_options);
+
+    const auto norm_queries = normalize_(request.query(), parsed_query,
+                                         normalizer_options, stats);
+
+    // The items of the stream point into these, so they have to be reserved
+    // up front.
+    std::vector<std::shared_ptr<const NormQuery>> queries;
+    queries.reserve(norm_queries->size());
+    std::vector<std::shared_ptr<const RawPhraseResult>> phrase_results;
+    std::set<std::string> unknown_words;
+
+    // All found but not yet sent phrases.
+    std::pmr::vector<stream_item_> items(arena.resource());
+    const size_t page_size = request.max_phrases();
+    size_t remaining = page_size;
+    // The last sent phrase.
+    uint64_t last_freq = 0;
+    uint64_t last_id = 0;
+    // Items of previous pages are never added.
+    const auto add_item = [&](const std::shared_ptr<const NormQuery>* query,
+                              Phrase::Id id, Phrase::Frequency freq,
+                              const Phrase* phrase) {
+      if (!search_options.skips(freq, id)) {
+        items.emplace_back(query, id, freq, phrase);
+      }
+    };
+
+    // Fills the response with all items that are more frequent than the
+    // given upper bound of the pending queries. The last response gets all
+    // remaining items. Returns whether there is anything to send.
+    const auto fill_response = [&](uint64_t max_pending_freq, bool last) {
+      sort_unique(items);
+      size_t count = 0;
+      while (count != items.size() && count != remaining &&
+             (last || items[count].freq > max_pending_freq)) {
+        count++;
+      }
+      if (count == 0 && !last) {
+        return false;
+      }
+
+      std::vector<Phrase::Id> ref_ids;
+      for (size_t i = 0; i != count; i++) {
+        if (!items[i].phrase) {
+          ref_ids.push_back(items[i].id);
+        }
+      }
+      std::vector<Phrase> ref_phrases;
+      {
+        StageTimer timer(stats, SearchStats::Stage::READ_PHRASES);
+        ref_phrases = phrase_corpus_.read_phrases(ref_ids);
+      }
+      auto ref_phrase = ref_phrases.begin();
+
+      response.Clear();
+      auto response_result = response.mutable_result();
+      response_result->mutable_phrases()->Reserve(count);
+      for (size_t i = 0; i != count; i++) {
+        const auto& item = items[i];
+        SearchResult::Item result_item(*item.query, Phrase(item.id, item.freq));
+        if (item.phrase) {
+          result_item.phrase = *item.phrase;
+        } else {
+          result_item.phrase = std::move(*ref_phrase++);
+        }
+        set_response_phrase(*response_result->add_phrases(),
+                            std::move(result_item));
+
+        last_freq = item.freq;
+        last_id = item.id;
+      }
+      if (last) {
+        for (const auto& unknown : unknown_words) {
+          if (!phrase_corpus_.contains(unknown)) {
+            response_result->add_unknown_words(unknown);
+          }
+        }
+        // a full page might be followed by more phrases
+        if (page_size != 0 && remaining == count) {
+          const auto token =
+              service::next_continuation_token(request, last_freq, last_id);
+          response_result->set_continuation_token(token.encode());
+        }
+      }
+
+      // Items after the remaining number of phrases will never be sent.
+      items.erase(items.begin(), items.begin() + count);
+      remaining -= count;
+      if (items.size() > remaining) {
+        items.erase(items.begin() + remaining, items.end());
+      }
+      return true;
+    };
+    const auto send_items = [&](uint64_t max_pending_freq, bool last) {
+      {
+        StageTimer timer(stats, SearchStats::Stage::MERGE);
+        if (!fill_response(max_pending_freq, last)) {
+          return true;
+        }
+      }
+      if (last && request.debug()) {
+        set_response_stats(*response.mutable_stats(), stats);
+      }
+      return writer(response);
+    };
+
+    // Non-wildcard queries are simple dictionary lookups, so they are searched
+    // first. Wildcard queries are searched by descending upper bound of the
+    // frequency of their phrases.
+    std::vector<std::pair<uint64_t, const NormQuery*>> pending;
+    for (const auto& query : *norm_queries) {
+      if (query.has_qmarks()) {
+        pending.emplace_back(
+            query_processor_.max_phrase_frequency(search_options, query),
+            &query);
+        continue;
+      }
+      queries.push_back(std::make_shared<const NormQuery>(query));
+      auto result = process_non_wildcard_query_(search_options, query);
+      unknown_words.insert(result->unknown_words().begin(),
+                           result->unknown_words().end());
+      for (const auto& phrase : result->phrases()) {
+        add_item(&queries.back(), phrase.id(), phrase.freq(), &phrase);
+      }
+      phrase_results.push_back(std::move(result));
+    }
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.first > b.first;
+                     });
+
+    bool open = true;
+    for (const auto& pair : pending) {
+      // No pending query can find a phrase more frequent than this one.
+      if (!send_items(pair.first, false)) {
+        open = false;
+        break;
+      }
+
+      const auto& query = *pair.second;
+      queries.push_back(std::make_shared<const NormQuery>(query));
+      const auto result = process_wildcard_query_(search_options, query, stats,
+                                                  arena.resource());
+      unknown_words.insert(result->unknown_words().begin(),
+                           result->unknown_words().end());
+      const Phrase::Id::Length len = query.size();
+      for (const auto& ref : result->refs()) {
+        add_item(&queries.back(), Phrase::Id(len, ref.id()), ref.freq(),
+                 nullptr);
+      }
+    }
+    if (open) {
+      send_items(0, true);
+    }
+    add_stats_(stats);
+    return;
+  } catch (const invalid_query_error& e) {
+    set_response_error(response, service::SearchResponse::Error::INVALID_QUERY,
+                       e.what());
+  } catch (const invalid_parameter_error& e) {
+    set_response_error(response,
+                       service::SearchResponse::Error::INVALID_PARAMETER,
+                       e.what());
+  } catch (const std::logic_error& e) {
+    set_response_error(response, service::SearchResponse::Error::INTERNAL_ERROR,
+                       e.what());
+  } catch (const std::exception& e) {
+    set_response_error(response, service::SearchResponse::Error::UNKNOWN,
+                       e.what());
+  } catch (...) {
+    set_response_error(response, service::SearchResponse::Error::UNKNOWN,
+                       "Unknown error");
+  }
+  if (request.debug()) {
+    set_response_stats(*response.mutable_stats(), stats);
+  }
+  add_stats_(stats);
+  writer(response);
+}
+
 
 /**
- * @brief Returns a unique string representation for the given query.
+ * @brief Returns the text of the given query as it is stored in the phrase
+ * dictionary.
+ *
+ * Words are joined using a single space and question marks are represented as
+ * \c ? .
  *
  * Note: This assumes that words do not contain spaces.
  */
 std::string norm_query_to_key(const NormQuery& query) {
+  size_t size = query.size();
+  for (const auto& unit : query.units()) {
+    size += unit.text()->size();
+  }
+
   std::string out;
-  auto it = query.units().begin();
-  auto end = query.units().end();
-  if (it != end) {
-    if (it->tag() == NormQuery::Unit::Tag::WORD) {
-      out.append(*it->text());
+  out.reserve(size);
+  for (const auto& unit : query.units()) {
+    if (&unit != &query.units().front()) {
+      out.push_back(' ');
+    }
+    if (unit.tag() == NormQuery::Unit::Tag::WORD) {
+      out.append(*unit.text());
     } else {
       out.push_back('?');
     }
-    it++;
   }
-  for (; it != end; it++) {
-    out.push_back(' ');
-    if (it->tag() == NormQuery::Unit::Tag::WORD) {
-      out.append(*it->text());
+  return out;
+}
+
+/**
+ * @brief Returns a unique key for the given query to be used by the result
+ * cache.
+ *
+ * Words with a known id are stored as 4 bytes. Only words which are not in the
+ * vocabulary are stored with their text (prefixed by their length). The key is
+ * a binary string and not meant to be human-readable.
+ */
+std::string norm_query_to_cache_key(const NormQuery& query) {
+  size_t size = 0;
+  for (const auto& unit : query.units()) {
+    size += 1;
+    if (unit.tag() == NormQuery::Unit::Tag::WORD) {
+      size += sizeof(WordId);
+      if (unit.id() == NormQuery::Unit::UNKNOWN_ID) {
+        size += unit.text()->size();
+      }
+    }
+  }
+
+  std::string out(size, '\0');
+  char* data = &out[0];
+  for (const auto& unit : query.units()) {
+    if (unit.tag() == NormQuery::Unit::Tag::QMARK) {
+      *data++ = '?';
+    } else if (unit.id() != NormQuery::Unit::UNKNOWN_ID) {
+      const WordId id = unit.id();
+      *data++ = 'w';
+      std::memcpy(data, &id, sizeof(id));
+      data += sizeof(id);
     } else {
-      out.push_back('?');
+      const auto& text = *unit.text();
+      const uint32_t length = text.size();
+      *data++ = 't';
+      std::memcpy(data, &length, sizeof(length));
+      data += sizeof(length);
+      std::memcpy(data, text.data(), text.size());
+      data += text.size();
     }
   }
   return out;
 }
 
+/**
+ * @brief Returns whether the given options start after the phrases of the
+ * given superset options (e.g. the next page of a search).
+ */
+bool is_later_page(const SearchOptions& superset,
+                   const SearchOptions& options) {
+  return superset.max_phrase_frequency > options.max_phrase_frequency ||
+         (superset.max_phrase_frequency == options.max_phrase_frequency &&
+          superset.min_phrase_id < options.min_phrase_id);
+}
+
 bool is_prunable_from(const SearchOptions& superset,
-                      const SearchOptions& options) {
-  return superset.max_phrase_frequency == options.max_phrase_frequency &&
-         superset.max_phrase_count >= options.max_phrase_count &&
-         superset.phrase_length_min <= options.phrase_length_min &&
-         superset.phrase_length_max >= options.phrase_length_max &&
-         superset.pruning_low >= options.pruning_low &&
-         superset.pruning_high >= options.pruning_high;
+                      const RawRefResult& superset_result,
+                      const SearchOptions& options,
+                      Phrase::Id::Length length) {
+  if (superset.max_phrase_frequency < options.max_phrase_frequency ||
+      superset.phrase_length_min > options.phrase_length_min ||
+      superset.phrase_length_max < options.phrase_length_max ||
+      superset.pruning_low < options.pruning_low ||
+      superset.pruning_high < options.pruning_high) {
+    return false;
+  }
+  if (!is_later_page(superset, options)) {
+    return superset.max_phrase_frequency == options.max_phrase_frequency &&
+           superset.min_phrase_id == options.min_phrase_id &&
+           superset.max_phrase_count >= options.max_phrase_count;
+  }
+
+  // A later page of a search resumes within the cached references. This is
+  // only possible if enough references follow the start of the page or if the
+  // cached result has all references.
+  const auto& refs = superset_result.refs();
+  if (refs.size() < superset.max_phrase_count) {
+    return true;
+  }
+  const auto following =
+      std::count_if(refs.begin(), refs.end(), [&](const auto& r) {
+        return !options.skips(r.freq(), Phrase::Id(length, r.id()));
+      });
+  return size_t(following) >= options.max_phrase_count;
 }
 std::shared_ptr<const RawRefResult> prune(const RawRefResult& result,
-                                          const SearchOptions& options) {
+                                          const SearchOptions& options,
+                                          Phrase::Id::Length length) {
   auto pruned = std::make_shared<RawRefResult>();
 
-  // Copy refs
+  // Copy refs. Like the query processor, all refs with the frequency of the
+  // last ref are copied, so that they can be ordered by id.
   if (options.max_phrase_count > 0) {
+    auto& refs = pruned->refs();
     for (const auto& ref : result.refs()) {
-      if (ref.freq() <= options.max_phrase_frequency) {
-        pruned->refs().push_back(ref);
-        if (pruned->refs().size() >= options.max_phrase_count) {
-          break;
-        }
+      if (refs.size() >= options.max_phrase_count &&
+          ref.freq() != refs.back().freq()) {
+        break;
+      }
+      if (!options.skips(ref.freq(), Phrase::Id(length, ref.id()))) {
+        refs.push_back(ref);
       }
     }
   }
@@ -447,23 +1201,103 @@ std::shared_ptr<const RawRefResult> prune(const RawRefResult& result,
   return pruned;
 }
 
+void Netspeak::count_(const SearchOptions& options,
+                      const std::vector<NormQuery>& norm_queries,
+                      bool estimate, service::SearchResponse::Result& result,
+                      SearchStats& stats, std::pmr::memory_resource* arena) {
+  // Counting has to see all phrases, so nothing is pruned.
+  SearchOptions count_options = options;
+  count_options.max_phrase_count = std::numeric_limits<uint32_t>::max();
+  count_options.pruning_high = std::numeric_limits<uint32_t>::max();
+  count_options.pruning_low = std::numeric_limits<uint32_t>::max();
+
+  // Norm queries of different lengths can't have common phrases, so only
+  // norm queries that share their length with another one have to be
+  // deduplicated.
+  std::unordered_map<size_t, size_t> length_count;
+  for (const auto& query : norm_queries) {
+    length_count[query.size()]++;
+  }
+  std::pmr::unordered_set<uint64_t> seen(arena);
+
+  // Exact counts read whole postlists. Norm queries with too long postlists
+  // and the ones left once the time is up are estimated instead.
+  const auto deadline =
+      std::chrono::steady_clock::now() + search_config_.count_max_time;
+
+  uint64_t phrase_count = 0;
+  uint64_t frequency_sum = 0;
+  std::vector<std::string> unknown_words;
+  for (const auto& query : norm_queries) {
+    const bool dedupe = length_count[query.size()] > 1;
+    const auto add = [&](Phrase::Id id, uint64_t freq) {
+      if (!dedupe || seen.insert(id).second) {
+        phrase_count++;
+        frequency_sum += freq;
+      }
+    };
+
+    if (!query.has_qmarks()) {
+      // a dictionary lookup is exact and cheaper than any estimate
+      const auto raw = process_non_wildcard_query_(count_options, query);
+      for (const auto& phrase : raw->phrases()) {
+        add(phrase.id(), phrase.freq());
+      }
+      util::vec_append(unknown_words, raw->unknown_words());
+    } else if (estimate ||
+               std::chrono::steady_clock::now() > deadline ||
+               query_processor_.postlist_size(query) >
+                   search_config_.count_max_entries) {
+      const auto counts =
+          query_processor_.estimate_count(count_options, query, stats);
+      phrase_count += counts.phrase_count;
+      frequency_sum += counts.frequency_sum;
+      util::vec_append(unknown_words, counts.unknown_words);
+    } else {
+      const Phrase::Id::Length len = query.size();
+      query_processor_.for_each_ref(
+          count_options, query, unknown_words,
+          [&](uint32_t id, uint32_t freq) { add(Phrase::Id(len, id), freq); },
+          stats, arena);
+    }
+  }
+
+  result.set_phrase_count(phrase_count);
+  result.set_frequency_sum(frequency_sum);
+  std::set<std::string> reported;
+  for (const auto& unknown : unknown_words) {
+    if (!phrase_corpus_.contains(unknown) && reported.insert(unknown).second) {
+      result.add_unknown_words(unknown);
+    }
+  }
+}
+
 std::shared_ptr<const RawRefResult> Netspeak::process_wildcard_query_(
-    const SearchOptions& options, const NormQuery& query) {
-  const auto query_key = norm_query_to_key(query);
+    const SearchOptions& options, const NormQuery& query, SearchStats& stats,
+    std::pmr::memory_resource* arena) {
+  const auto query_key = norm_query_to_cache_key(query);
   const auto cached_result = result_cache_.find(query_key);
 
   if (cached_result && cached_result->options == options) {
     // exact cache hit
+    stats.result_cache_hits++;
     return cached_result->result;
   } else if (cached_result &&
-             is_prunable_from(cached_result->options, options)) {
+             is_prunable_from(cached_result->options, *cached_result->result,
+                              options, query.size())) {
     // TODO: This very loose compatibility check may result in pathetically
     // small result sets.
-    return prune(*cached_result->result, options);
+    stats.result_cache_hits++;
+    return prune(*cached_result->result, options, query.size());
   } else {
     // can't serve from cache
-    auto final_result = query_processor_.process(options, query);
-    if (cached_result && !final_result->disjoint_with(*cached_result->result)) {
+    auto final_result =
+        query_processor_.process(options, query, stats, arena);
+    if (cached_result && is_later_page(cached_result->options, options)) {
+      // This is a later page of the cached result. Its references aren't
+      // added, so paging through a result doesn't grow the cached entry.
+    } else if (cached_result &&
+               !final_result->disjoint_with(*cached_result->result)) {
       // extend the cached phrase refences
 
       // TODO: These cached reference lists may grow to enormous sizes. Let's
@@ -491,8 +1325,8 @@ std::shared_ptr<const RawPhraseResult> Netspeak::process_non_wildcard_query_(
       phrase_dictionary_->Get(norm_query_to_key(query), freq_id_pair)) {
     // found the phrase
     uint64_t freq = freq_id_pair.e1();
-    if (freq <= options.max_phrase_frequency) {
-      Phrase::Id id(query.size(), freq_id_pair.e2());
+    Phrase::Id id(query.size(), freq_id_pair.e2());
+    if (!options.skips(freq, id)) {
       Phrase phrase(id, freq);
       for (const auto& unit : query.units()) {
         phrase.words().push_back(*unit.text());
@@ -514,18 +1348,52 @@ std::shared_ptr<const RawPhraseResult> Netspeak::process_non_wildcard_query_(
   return result;
 }
 
-std::unique_ptr<RawResult> Netspeak::search_raw_(
-    const QueryNormalizer::Options& normalizer_options,
-    const SearchOptions& options, std::shared_ptr<Query> query) {
-  // create norm queries
-  std::vector<NormQuery> normQueries;
-  query_normalizer_.normalize(query, normalizer_options, normQueries);
+std::shared_ptr<const std::vector<NormQuery>> Netspeak::normalize_(
+    const std::string& query, std::shared_ptr<const Query> parsed_query,
+    const QueryNormalizer::Options& normalizer_options, SearchStats& stats) {
+  const auto key = norm_query_cache_key(query, normalizer_options);
+  const auto cached = norm_query_cache_.find(key);
+  if (cached) {
+    stats.query_cache_hits++;
+    stats.norm_queries += cached->size();
+    return cached;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  if (!parsed_query) {
+    StageTimer timer(stats, SearchStats::Stage::PARSE);
+    parsed_query = search_config_.parse_query(query);
+  }
+  auto norm_queries = std::make_shared<std::vector<NormQuery>>();
+  bool complete;
+  {
+    StageTimer timer(stats, SearchStats::Stage::NORMALIZE);
+    complete = query_normalizer_.normalize(parsed_query, normalizer_options,
+                                           *norm_queries);
+  }
+  stats.norm_queries += norm_queries->size();
+
+  if (complete) {
+    // The cost of an entry is the time it took to compute it. Norm queries
+    // with incomplete regex matches are not cached because a later search
+    // might find more matches.
+    const std::chrono::duration<double, std::micro> cost =
+        std::chrono::steady_clock::now() - start;
+    norm_query_cache_.insert(key, norm_queries, cost.count());
+  }
+  return norm_queries;
+}
 
+std::unique_ptr<RawResult> Netspeak::search_raw_(
+    const SearchOptions& options, const std::vector<NormQuery>& norm_queries,
+    SearchStats& stats, std::pmr::memory_resource* arena) {
   // process the norm queries
   auto result = std::make_unique<RawResult>();
-  for (const auto& query : normQueries) {
+  for (const auto& query : norm_queries) {
     if (query.has_qmarks()) {
-      result->add_item(query, process_wildcard_query_(options, query));
+      result->add_item(query,
+                       process_wildcard_query_(options, query, stats, arena));
     } else {
       result->add_item(query, process_non_wildcard_query_(options, query));
     }
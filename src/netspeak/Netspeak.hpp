@@ -2,9 +2,13 @@
 #define NETSPEAK_NETSPEAK_HPP
 
 #include <algorithm>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -26,9 +30,14 @@
 #include "netspeak/model/RawResult.hpp"
 #include "netspeak/model/SearchOptions.hpp"
 #include "netspeak/model/SearchResult.hpp"
+#include "netspeak/model/SearchStats.hpp"
+#include "netspeak/parse.hpp"
 #include "netspeak/regex/DefaultRegexIndex.hpp"
 #include "netspeak/service/NetspeakService.pb.h"
+#include "netspeak/util/CostAwareCache.hpp"
 #include "netspeak/util/LfuCache.hpp"
+#include "netspeak/util/RequestArena.hpp"
+#include "netspeak/util/ThreadPool.hpp"
 #include "netspeak/util/check.hpp"
 #include "netspeak/util/logging.hpp"
 #include "netspeak/value/string_traits.hpp"
@@ -46,8 +55,82 @@ public:
 
   Properties properties() const;
 
+  /**
+   * @brief Returns the sum of the stats of all searches of this instance.
+   */
+  model::SearchStats stats() const;
+
+  /**
+   * @brief Searches the given request.
+   *
+   * If the query of the request was already parsed (see \c estimate_cost ),
+   * the parsed query can be given, so that it isn't parsed again.
+   */
   void search(const service::SearchRequest& request,
-              service::SearchResponse& response) throw();
+              service::SearchResponse& response,
+              std::shared_ptr<const model::Query> parsed_query = nullptr)
+      throw();
+
+  /**
+   * @brief Returns the number of norm queries the given request will search.
+   *
+   * Cached norm queries are counted if there are any. Otherwise this is an
+   * upper bound which is computed without searching for regex matches (see
+   * \c QueryNormalizer::estimate ). Exact counts (see \c count_only ) read
+   * whole postlists, so each of their norm queries costs
+   * \c EXACT_COUNT_COST. Invalid queries have a cost of 0.
+   *
+   * The cached norm queries are only looked up, so estimating the cost of a
+   * request doesn't change what the cache keeps. If the query has to be
+   * parsed and \c parsed_query isn't null, the parsed query is stored in it
+   * and can be passed to the search.
+   */
+  size_t estimate_cost(
+      const service::SearchRequest& request,
+      std::shared_ptr<const model::Query>* parsed_query = nullptr) throw();
+
+  /**
+   * @brief The admission cost of each norm query of an exact count.
+   */
+  static const size_t EXACT_COUNT_COST;
+
+  /**
+   * @brief Searches all given requests and writes the result of the i-th
+   * request into the i-th response.
+   *
+   * Identical requests are only searched once. The remaining requests are
+   * searched in parallel by the calling thread and the batch threads of this
+   * instance. Requests with common norm queries share their normalization and
+   * their postlists via the caches of this instance.
+   *
+   * The i-th of the given parsed queries (if any) is the parsed query of the
+   * i-th request or null.
+   */
+  void search_batch(
+      const std::vector<const service::SearchRequest*>& requests,
+      const std::vector<service::SearchResponse*>& responses,
+      const std::vector<std::shared_ptr<const model::Query>>& parsed_queries =
+          {}) throw();
+  /**
+   * @brief Returns the maximum number of threads \c search_batch searches a
+   * batch of the given number of requests with.
+   */
+  size_t batch_parallelism(size_t requests) const;
+
+  /**
+   * @brief Searches the given request and passes its phrases to the given
+   * writer as soon as they are known to be part of the result.
+   *
+   * The phrases of all responses are the phrases \c search returns for the
+   * request in the same order. The last response contains the unknown words
+   * of the query or the error of the search. The search stops early if the
+   * writer returns \c false. Like \c search , this takes the parsed query
+   * of the request if there is one.
+   */
+  void search_stream(
+      const service::SearchRequest& request,
+      const std::function<bool(const service::SearchResponse&)>& writer,
+      std::shared_ptr<const model::Query> parsed_query = nullptr) throw();
 
 
 private:
@@ -57,26 +140,71 @@ private:
   typedef model::RawRefResult RawRefResult;
   typedef model::RawResult RawResult;
   typedef model::SearchOptions SearchOptions;
+  typedef model::SearchStats SearchStats;
 
   std::pair<QueryNormalizer::Options, SearchOptions> to_options(
       const service::SearchRequest& request);
 
-  std::unique_ptr<SearchResult> merge_raw_result_(const SearchOptions& options,
-                                                  const RawResult& raw_result);
+  void search_(const service::SearchRequest& request,
+               std::shared_ptr<const Query> parsed_query,
+               service::SearchResponse& response, SearchStats& stats) throw();
+
+  std::unique_ptr<SearchResult> merge_raw_result_(
+      const SearchOptions& options, const RawResult& raw_result,
+      SearchStats& stats, std::pmr::memory_resource* arena);
 
   std::shared_ptr<const RawRefResult> process_wildcard_query_(
-      const SearchOptions& options, const NormQuery& query);
+      const SearchOptions& options, const NormQuery& query, SearchStats& stats,
+      std::pmr::memory_resource* arena);
   std::shared_ptr<const RawPhraseResult> process_non_wildcard_query_(
       const SearchOptions& options, const NormQuery& query);
 
+  /**
+   * @brief Sets the number of phrases of the given norm queries and the sum
+   * of their frequencies in the given result.
+   *
+   * If \c estimate is \c true, the numbers of wildcard queries are estimated
+   * from index metadata instead of being counted. Exact counts fall back to
+   * estimates for wildcard queries whose postlists have more than
+   * \c search_config::count_max_entries entries and for all wildcard queries
+   * left after \c search_config::count_max_time.
+   */
+  void count_(const SearchOptions& options,
+              const std::vector<NormQuery>& norm_queries, bool estimate,
+              service::SearchResponse::Result& result, SearchStats& stats,
+              std::pmr::memory_resource* arena);
+
+  /**
+   * @brief Parses and normalizes the given query.
+   *
+   * The norm queries of a query are cached. The query is only parsed if it
+   * isn't cached and \c parsed_query is null.
+   */
+  std::shared_ptr<const std::vector<NormQuery>> normalize_(
+      const std::string& query, std::shared_ptr<const Query> parsed_query,
+      const QueryNormalizer::Options& normalizer_options, SearchStats& stats);
+
+  /**
+   * @brief Searches the given norm queries.
+   *
+   * Temporary data structures are allocated in the given arena.
+   */
   std::unique_ptr<RawResult> search_raw_(
-      const QueryNormalizer::Options& normalizer_options,
-      const SearchOptions& options, std::shared_ptr<Query> query);
+      const SearchOptions& options, const std::vector<NormQuery>& norm_queries,
+      SearchStats& stats, std::pmr::memory_resource* arena);
+
+  /**
+   * @brief Adds the stats of a finished search to the stats of this instance.
+   */
+  void add_stats_(const SearchStats& stats);
 
   struct search_config {
     size_t max_norm_queries;
+    uint64_t count_max_entries;
+    std::chrono::nanoseconds count_max_time;
     size_t regex_max_matches;
     std::chrono::nanoseconds regex_max_time;
+    std::shared_ptr<Query> (*parse_query)(const std::string& query);
   };
   search_config get_search_config(const Configuration& config) const;
 
@@ -99,8 +227,12 @@ private:
   QueryNormalizer query_normalizer_;
   QueryProcessor<RetrievalStrategy3Tag> query_processor_;
   util::LfuCache<result_cache_item> result_cache_;
+  util::CostAwareCache<const std::vector<NormQuery>> norm_query_cache_;
   PhraseCorpus phrase_corpus_;
   search_config search_config_;
+  std::unique_ptr<util::ThreadPool> batch_pool_;
+  mutable std::mutex stats_mutex_;
+  SearchStats stats_;
 };
 
 } // namespace netspeak
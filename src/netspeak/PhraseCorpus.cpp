@@ -173,7 +173,7 @@ void PhraseCorpus::init_vocabulary_(const bfs::path& vocab_file) {
     builder.append(word, word_id);
   }
 
-  id_map.emplace(std::move(builder));
+  id_map = std::make_shared<const Vocabulary>(std::move(builder));
 }
 
 boost::optional<Phrase::Id::Length> parse_phrase_filename(
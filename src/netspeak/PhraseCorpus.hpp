@@ -1,12 +1,12 @@
 #ifndef NETSPEAK_PHRASE_CORPUS_HPP
 #define NETSPEAK_PHRASE_CORPUS_HPP
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <boost/filesystem.hpp>
-#include <boost/optional.hpp>
 
 #include "netspeak/invertedindex/ByteBuffer.hpp"
 #include "netspeak/model/Phrase.hpp"
@@ -31,6 +31,8 @@ public:
   static const std::string vocab_file;
   static const std::string phrase_file;
 
+  typedef util::StringIdMap<WordId> Vocabulary;
+
   PhraseCorpus();
   PhraseCorpus(const PhraseCorpus&) = delete;
   PhraseCorpus(const boost::filesystem::path& phrase_dir);
@@ -59,6 +61,13 @@ public:
   bool contains(const std::string& word) const;
   bool contains(const WordId& id) const;
 
+  /**
+   * @brief Returns the map from the words of the corpus to their ids.
+   */
+  std::shared_ptr<const Vocabulary> vocabulary() const {
+    return id_map;
+  }
+
   std::vector<Phrase> read_phrases(
       const std::vector<Phrase::Id>& phrase_ids) const;
 
@@ -73,7 +82,7 @@ private:
   /**
    * @brief This maps the id of a word to its string value and vise versa.
    */
-  boost::optional<util::StringIdMap<WordId>> id_map;
+  std::shared_ptr<const Vocabulary> id_map;
 
   /**
    * @brief A map from the length of a phrase to the file descriptor of the
@@ -11,6 +11,14 @@ PREFIX::cache_capacity("cache.capacity");
 PREFIX::cache_access_count("cache.access.count");
 PREFIX::cache_hit_rate("cache.hit.rate");
 PREFIX::cache_top_100("cache.top.100");
+PREFIX::cache_regex_size("cache.regex.size");
+PREFIX::cache_regex_capacity("cache.regex.capacity");
+PREFIX::cache_regex_access_count("cache.regex.access.count");
+PREFIX::cache_regex_hit_rate("cache.regex.hit.rate");
+PREFIX::cache_query_size("cache.query.size");
+PREFIX::cache_query_capacity("cache.query.capacity");
+PREFIX::cache_query_access_count("cache.query.access.count");
+PREFIX::cache_query_hit_rate("cache.query.hit.rate");
 
 // phrase corpus properties
 PREFIX::phrase_corpus_1gram_count("phrase.corpus.1gram.count");
@@ -44,5 +52,28 @@ PREFIX::hash_dictionary_value_type("hash.dictionary.value.type");
 // regex vocabulary properties
 PREFIX::regex_vocabulary_size("regex.vocabulary.size");
 PREFIX::regex_vocabulary_value_type("regex.vocabulary.value.type");
+PREFIX::regex_vocabulary_memory("regex.vocabulary.memory");
+PREFIX::regex_word_offsets_memory("regex.word-offsets.memory");
+PREFIX::regex_word_hash_table_memory("regex.word-hash-table.memory");
+PREFIX::regex_characters_memory("regex.characters.memory");
+PREFIX::regex_trigram_index_size("regex.trigram-index.size");
+PREFIX::regex_trigram_index_memory("regex.trigram-index.memory");
+PREFIX::regex_affix_index_memory("regex.affix-index.memory");
+
+// search properties
+PREFIX::search_count("search.count");
+PREFIX::search_time_parse("search.time.parse");
+PREFIX::search_time_normalize("search.time.normalize");
+PREFIX::search_time_postlist_index("search.time.postlist-index");
+PREFIX::search_time_postlist_read("search.time.postlist-read");
+PREFIX::search_time_intersect("search.time.intersect");
+PREFIX::search_time_merge("search.time.merge");
+PREFIX::search_time_read_phrases("search.time.read-phrases");
+PREFIX::search_norm_query_count("search.norm-query.count");
+PREFIX::search_postlist_count("search.postlist.count");
+PREFIX::search_postlist_bytes("search.postlist.bytes");
+PREFIX::search_entry_count("search.entry.count");
+PREFIX::search_cache_result_hits("search.cache.result.hits");
+PREFIX::search_cache_query_hits("search.cache.query.hits");
 
 } // namespace netspeak
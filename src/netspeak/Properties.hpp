@@ -20,6 +20,14 @@ public:
   static const std::string cache_access_count;
   static const std::string cache_hit_rate;
   static const std::string cache_top_100;
+  static const std::string cache_regex_size;
+  static const std::string cache_regex_capacity;
+  static const std::string cache_regex_access_count;
+  static const std::string cache_regex_hit_rate;
+  static const std::string cache_query_size;
+  static const std::string cache_query_capacity;
+  static const std::string cache_query_access_count;
+  static const std::string cache_query_hit_rate;
 
   // phrase corpus properties
   static const std::string phrase_corpus_1gram_count;
@@ -53,6 +61,29 @@ public:
   // regex vocabulary properties
   static const std::string regex_vocabulary_size;
   static const std::string regex_vocabulary_value_type;
+  static const std::string regex_vocabulary_memory;
+  static const std::string regex_word_offsets_memory;
+  static const std::string regex_word_hash_table_memory;
+  static const std::string regex_characters_memory;
+  static const std::string regex_trigram_index_size;
+  static const std::string regex_trigram_index_memory;
+  static const std::string regex_affix_index_memory;
+
+  // search properties (all times in nanoseconds)
+  static const std::string search_count;
+  static const std::string search_time_parse;
+  static const std::string search_time_normalize;
+  static const std::string search_time_postlist_index;
+  static const std::string search_time_postlist_read;
+  static const std::string search_time_intersect;
+  static const std::string search_time_merge;
+  static const std::string search_time_read_phrases;
+  static const std::string search_norm_query_count;
+  static const std::string search_postlist_count;
+  static const std::string search_postlist_bytes;
+  static const std::string search_entry_count;
+  static const std::string search_cache_result_hits;
+  static const std::string search_cache_query_hits;
 };
 
 } // namespace netspeak
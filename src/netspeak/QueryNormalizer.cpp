@@ -776,21 +776,22 @@ public:
     typedef NormQuery::Unit::Source Source;
 
     Tag tag;
+    WordId id;
     Text text;
     Source source;
 
     Unit() = delete;
-    Unit(Tag tag, const Text& text, const Source& source)
-        : tag(tag), text(text), source(source) {}
+    Unit(Tag tag, WordId id, const Text& text, const Source& source)
+        : tag(tag), id(id), text(text), source(source) {}
 
-    static Unit new_word(const Text& text, const Source& source) {
-      return Unit(Tag::WORD, text, source);
+    static Unit new_word(const Text& text, WordId id, const Source& source) {
+      return Unit(Tag::WORD, id, text, source);
     }
     static Unit new_qmark(const Source& source) {
-      return Unit(Tag::QMARK, QMARK_STR, source);
+      return Unit(Tag::QMARK, NormQuery::Unit::UNKNOWN_ID, QMARK_STR, source);
     }
     static Unit new_star(const Source& source) {
-      return Unit(Tag::STAR, STAR_STR, source);
+      return Unit(Tag::STAR, NormQuery::Unit::UNKNOWN_ID, STAR_STR, source);
     }
   };
 
@@ -835,6 +836,11 @@ public:
 class StarQueryConverter {
 public:
   QueryNormalizer::Options options;
+  /**
+   * @brief The vocabulary used to resolve the ids of words. This may be
+   * \c nullptr .
+   */
+  const QueryNormalizer::Vocabulary* vocabulary = nullptr;
 
   StarQueryConverter() = delete;
   explicit StarQueryConverter(const QueryNormalizer::Options& options)
@@ -847,11 +853,28 @@ public:
   }
 
 private:
+  /**
+   * @brief Returns a new star query unit for the given word.
+   *
+   * The id of the word is looked up here, once per word of the simple query,
+   * and not for every norm query the word will be part of.
+   */
+  StarQuery::Unit new_word(const SimpleQuery::Unit& unit) const {
+    WordId id = NormQuery::Unit::UNKNOWN_ID;
+    if (vocabulary) {
+      const auto it = vocabulary->find_for_word(unit.text());
+      if (it != vocabulary->end()) {
+        id = it->second;
+      }
+    }
+    return StarQuery::Unit::new_word(
+        std::make_shared<const std::string>(unit.text()), id, unit.source());
+  }
+
   void concat(std::vector<StarQuery>& queries, const SimpleQuery::Unit& unit) {
     switch (unit.tag()) {
       case SimpleQuery::Unit::Tag::WORD: {
-        const auto u = StarQuery::Unit::new_word(
-            std::make_shared<const std::string>(unit.text()), unit.source());
+        const auto u = new_word(unit);
         for (auto& q : queries) {
           q.push_back(u);
         }
@@ -923,8 +946,7 @@ private:
     switch (unit.tag()) {
       case SimpleQuery::Unit::Tag::WORD: {
         StarQuery q;
-        q.push_back(StarQuery::Unit::new_word(
-            std::make_shared<const std::string>(unit.text()), unit.source()));
+        q.push_back(new_word(unit));
         queries.push_back(std::move(q));
         break;
       }
@@ -971,6 +993,7 @@ private:
 class SimpleQueryNormalizer {
 public:
   QueryNormalizer::Options options;
+  const QueryNormalizer::Vocabulary* vocabulary = nullptr;
 
   SimpleQueryNormalizer() = delete;
   explicit SimpleQueryNormalizer(const QueryNormalizer::Options& options)
@@ -991,6 +1014,7 @@ public:
   void to_norm_queries(std::vector<NormQuery>& norm_queries,
                        const SimpleQuery& query) {
     StarQueryConverter star_conv(options);
+    star_conv.vocabulary = vocabulary;
     std::vector<StarQuery> star_queries = star_conv.to_star_queries(query);
 
     for (const auto& q : star_queries) {
@@ -1019,7 +1043,7 @@ private:
     for (const auto& u : query.units()) {
       switch (u.tag) {
         case StarQuery::Unit::Tag::WORD:
-          nq.units().push_back(NormQuery::Unit::word(u.text, u.source));
+          nq.units().push_back(NormQuery::Unit::word(u.text, u.id, u.source));
           break;
         case StarQuery::Unit::Tag::QMARK:
           nq.units().push_back(NormQuery::Unit::qmark(u.source));
@@ -1054,7 +1078,7 @@ private:
       for (const auto& u : query.units()) {
         switch (u.tag) {
           case StarQuery::Unit::Tag::WORD:
-            nq.units().push_back(NormQuery::Unit::word(u.text, u.source));
+            nq.units().push_back(NormQuery::Unit::word(u.text, u.id, u.source));
             break;
           case StarQuery::Unit::Tag::QMARK:
             nq.units().push_back(NormQuery::Unit::qmark(u.source));
@@ -1124,9 +1148,57 @@ size_t binary_search(size_t min, size_t max,
   return min;
 }
 
-void normalize_regexes(
+/**
+ * @brief Adds the indexes of the words matching the given regex to the given
+ * vector.
+ *
+ * If there is a cache, complete search results will be cached and later
+ * searches for the same regex will be served from the cache if possible.
+ *
+ * Returns \c false if the search was aborted because of the timeout.
+ */
+bool find_regex_matches(const std::string& regex, uint32_t max_matches,
+                        const QueryNormalizer::Options& options,
+                        const regex::RegexIndex& regex_index,
+                        QueryNormalizer::RegexCache* regex_cache,
+                        std::vector<uint32_t>& matches) {
+  if (regex_cache) {
+    const auto item = regex_cache->find(regex);
+    if (item && item->can_serve(max_matches)) {
+      const auto count = std::min(item->matches.size(), (size_t)max_matches);
+      matches.insert(matches.end(), item->matches.begin(),
+                     item->matches.begin() + count);
+      return true;
+    }
+  }
+
+  const auto regex_query = regex::parse_netspeak_regex_query(regex);
+  const auto offset = matches.size();
+  const bool complete = regex_index.match_query_indexes(
+      regex_query, matches, max_matches, options.max_regex_time);
+
+  if (regex_cache && complete) {
+    // An existing entry couldn't serve this request, so it has to have a
+    // smaller max_matches and we can replace it.
+    auto item = std::make_shared<QueryNormalizer::regex_cache_item>(
+        max_matches,
+        std::vector<uint32_t>(matches.begin() + offset, matches.end()));
+    regex_cache->update(regex, item);
+  }
+  return complete;
+}
+
+/**
+ * @brief Replaces all regexes with an alternation of matching words.
+ *
+ * Returns \c false if the search for matches was aborted for at least one
+ * regex.
+ */
+bool normalize_regexes(
     SimpleQuery& query, const QueryNormalizer::Options& options,
-    const std::shared_ptr<const regex::RegexIndex>& regex_index) {
+    const std::shared_ptr<const regex::RegexIndex>& regex_index,
+    QueryNormalizer::RegexCache* regex_cache) {
+  bool complete = true;
   const auto regexes = find_regexes(query);
   if (!regexes.empty()) {
     // try to find out with how many words we can replace each regex and still
@@ -1161,17 +1233,17 @@ void normalize_regexes(
       // TODO: What now?
       throw invalid_query_error("Query too complex");
     } else {
-      std::vector<std::string> matches;
+      std::vector<uint32_t> matches;
       for (auto regex_unit : regexes) {
-        const auto regex_query =
-            regex::parse_netspeak_regex_query(regex_unit->text());
-        regex_index->match_query(regex_query, matches, best_max_matches,
-                                 options.max_regex_time);
+        complete &= find_regex_matches(regex_unit->text(), best_max_matches,
+                                       options, *regex_index, regex_cache,
+                                       matches);
 
         const auto source = regex_unit->source();
         auto alt = SimpleQuery::Unit::new_alternation(source);
-        for (const auto& word : matches) {
-          alt.add_child(SimpleQuery::Unit::new_word(word, source));
+        for (const auto index : matches) {
+          alt.add_child(SimpleQuery::Unit::new_word(
+              regex_index->word_at_index(index), source));
         }
         matches.clear();
 
@@ -1179,9 +1251,10 @@ void normalize_regexes(
       }
     }
   }
+  return complete;
 }
 
-void QueryNormalizer::normalize(std::shared_ptr<const Query> query,
+bool QueryNormalizer::normalize(std::shared_ptr<const Query> query,
                                 const Options& options,
                                 std::vector<NormQuery>& norm_queries) {
   const auto query_length_range = query->length_range();
@@ -1190,7 +1263,7 @@ void QueryNormalizer::normalize(std::shared_ptr<const Query> query,
       query_length_range.min > options.max_length) {
     // In this case, we just cannot create any norm queries that fulfill the
     // normalization options.
-    return;
+    return true;
   }
 
   bool allow_regex = !!regex_index_ && options.max_regex_matches > 0 &&
@@ -1208,16 +1281,50 @@ void QueryNormalizer::normalize(std::shared_ptr<const Query> query,
   optimizer.optimize(simple);
 
   // replaces all regexes with a list of words
-  normalize_regexes(simple, options, regex_index_);
+  const bool complete =
+      normalize_regexes(simple, options, regex_index_, regex_cache_.get());
 
   // create norm queries
   SimpleQueryNormalizer normalizer(options);
+  normalizer.vocabulary = vocabulary_.get();
   normalizer.to_norm_queries(norm_queries, simple);
+  return complete;
+}
+
+size_t QueryNormalizer::estimate(std::shared_ptr<const Query> query,
+                                 const Options& options) const {
+  const auto query_length_range = query->length_range();
+  if (query_length_range.empty() ||
+      query_length_range.max < options.min_length ||
+      query_length_range.min > options.max_length) {
+    return 0;
+  }
+
+  bool allow_regex = !!regex_index_ && options.max_regex_matches > 0 &&
+                     options.max_regex_time > std::chrono::nanoseconds(0);
+
+  QuerySimplifier simplifier(options);
+  simplifier.dictionary = dictionary_;
+  simplifier.allow_regex = allow_regex;
+  simplifier.lower_case = lower_case;
+  SimpleQuery simple = simplifier.to_simple(query);
+
+  SimpleQueryOptimizer optimizer;
+  optimizer.optimize(simple);
+
+  const auto estimate =
+      NormQueryCounter(options).estimate(simple)(options.max_regex_matches);
+  return (size_t)std::min(estimate, (uint64_t)options.max_norm_queries);
 }
 
 QueryNormalizer::QueryNormalizer(InitConfig config)
     : regex_index_(config.regex_index),
       dictionary_(config.dictionary),
-      lower_case(config.lower_case) {}
+      vocabulary_(config.vocabulary),
+      lower_case(config.lower_case) {
+  if (config.regex_cache_capacity > 0) {
+    regex_cache_ = std::make_shared<RegexCache>(config.regex_cache_capacity);
+  }
+}
 
 } // namespace netspeak
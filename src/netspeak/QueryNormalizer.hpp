@@ -8,30 +8,77 @@
 #include "netspeak/Dictionaries.hpp"
 #include "netspeak/model/NormQuery.hpp"
 #include "netspeak/model/Query.hpp"
+#include "netspeak/model/typedefs.hpp"
 #include "netspeak/regex/RegexIndex.hpp"
+#include "netspeak/util/LfuCache.hpp"
+#include "netspeak/util/StringIdMap.hpp"
 
 
 namespace netspeak {
 
-// TODO: cache for regex queries
-
-
 /**
  * This class is responsable for normalizing queries.
  *
  * A norm query (normalized query)
  */
 class QueryNormalizer {
+public:
+  /**
+   * @brief The cached matches of a regex.
+   *
+   * The matches are the word indexes returned by
+   * \c RegexIndex::match_query_indexes for the given \c max_matches . Since
+   * matches are sorted, the entry can also serve any smaller \c max_matches
+   * by truncation. If there are fewer matches than \c max_matches , the
+   * entry contains all matches of the regex and can serve any request.
+   */
+  struct regex_cache_item {
+    uint32_t max_matches;
+    std::vector<uint32_t> matches;
+
+    regex_cache_item() = delete;
+    regex_cache_item(uint32_t max_matches, std::vector<uint32_t> matches)
+        : max_matches(max_matches), matches(std::move(matches)) {}
+
+    bool can_serve(uint32_t max_matches) const {
+      return max_matches <= this->max_matches ||
+             matches.size() < this->max_matches;
+    }
+  };
+  typedef util::LfuCache<regex_cache_item> RegexCache;
+  typedef util::StringIdMap<model::WordId> Vocabulary;
+
 private:
   std::shared_ptr<regex::RegexIndex> regex_index_;
   std::shared_ptr<Dictionaries::Map> dictionary_;
+  std::shared_ptr<const Vocabulary> vocabulary_;
   bool lower_case;
+  /**
+   * @brief A cache from the text of a regex to its matches.
+   *
+   * This is \c nullptr if regexes are not cached.
+   */
+  std::shared_ptr<RegexCache> regex_cache_;
 
 public:
   struct InitConfig {
     std::shared_ptr<regex::RegexIndex> regex_index = nullptr;
     std::shared_ptr<Dictionaries::Map> dictionary = nullptr;
+    /**
+     * @brief The vocabulary of the corpus.
+     *
+     * If given, the words of norm queries will have the id of the word in the
+     * vocabulary. Otherwise, all words will have an unknown id.
+     */
+    std::shared_ptr<const Vocabulary> vocabulary = nullptr;
     bool lower_case = false;
+    /**
+     * @brief The maximum number of regexes whose matches will be cached.
+     *
+     * Only the results of regex searches which were not aborted by the
+     * timeout are cached. 0 disables the cache.
+     */
+    size_t regex_cache_capacity = 0;
   };
 
   QueryNormalizer() {}
@@ -71,9 +118,34 @@ public:
     std::chrono::nanoseconds max_regex_time;
   };
 
-  void normalize(std::shared_ptr<const model::Query> query,
+  /**
+   * @brief Adds the norm queries of the given query to the given vector.
+   *
+   * Returns \c false if the search for regex matches was aborted because of
+   * \c Options::max_regex_time . The norm queries might then be different for
+   * the same query and options in the future.
+   */
+  bool normalize(std::shared_ptr<const model::Query> query,
                  const Options& options,
                  std::vector<model::NormQuery>& norm_queries);
+
+  /**
+   * @brief Returns an upper bound for the number of norm queries
+   * \c normalize would add for the given query.
+   *
+   * Unlike \c normalize , this doesn't search for the matches of regexes. Each
+   * regex is assumed to match \c Options::max_regex_matches words. The bound
+   * is at most \c Options::max_norm_queries .
+   */
+  size_t estimate(std::shared_ptr<const model::Query> query,
+                  const Options& options) const;
+
+  /**
+   * @brief Returns the regex cache or \c nullptr if regexes are not cached.
+   */
+  const RegexCache* regex_cache() const {
+    return regex_cache_.get();
+  }
 };
 
 } // namespace netspeak
@@ -6,14 +6,18 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <unordered_set>
 #include <vector>
 
+#include <boost/iterator/function_output_iterator.hpp>
+
 #include "netspeak/Configuration.hpp"
 #include "netspeak/RetrievalStrategy.hpp"
 #include "netspeak/model/NormQuery.hpp"
 #include "netspeak/model/RawRefResult.hpp"
 #include "netspeak/model/SearchOptions.hpp"
+#include "netspeak/model/SearchStats.hpp"
 #include "netspeak/util/check.hpp"
 #include "netspeak/util/logging.hpp"
 
@@ -48,7 +52,7 @@ private:
     }
   };
 
-  typedef std::unordered_set<index_entry_type, hash, equal>
+  typedef std::pmr::unordered_set<index_entry_type, hash, equal>
       intersection_set_type;
 
 public:
@@ -62,68 +66,163 @@ public:
     return strategy_.properties();
   }
 
-  std::shared_ptr<RawRefResult> process(const SearchOptions& options,
-                                        const NormQuery& query) {
+  /**
+   * @brief Returns the phrase references of the given query.
+   *
+   * All temporary data structures (e.g. the intersection sets) will be
+   * allocated using the given memory resource. The returned result doesn't
+   * use the memory resource.
+   *
+   * The work done is added to the given search stats.
+   */
+  std::shared_ptr<RawRefResult> process(
+      const SearchOptions& options, const NormQuery& query,
+      SearchStats& search_stats,
+      std::pmr::memory_resource* arena = std::pmr::get_default_resource()) {
     auto query_result = std::make_shared<RawRefResult>();
-    process_(options, *query_result, query);
+    std::pmr::vector<index_entry_type> index_entries(arena);
+    intersect_(options, query, query_result->unknown_words(), search_stats,
+               arena, std::back_inserter(index_entries));
+
+    query_result->refs().reserve(index_entries.size());
+    for (const auto& index_entry : index_entries) {
+      uint32_t freq = traits::get_phrase_frequency(index_entry);
+      uint32_t id = traits::get_phrase_id(index_entry);
+      query_result->refs().push_back(RawRefResult::Ref(id, freq));
+    }
     return query_result;
   }
 
+  /**
+   * @brief Calls the given function for every phrase reference of the given
+   * query without storing the references.
+   *
+   * The function is called with the id and the frequency of each reference.
+   * Unknown words of the query are appended to \c unknown_words.
+   */
+  template <typename Fn>
+  void for_each_ref(
+      const SearchOptions& options, const NormQuery& query,
+      std::vector<std::string>& unknown_words, Fn fn,
+      SearchStats& search_stats,
+      std::pmr::memory_resource* arena = std::pmr::get_default_resource()) {
+    intersect_(options, query, unknown_words, search_stats, arena,
+               boost::make_function_output_iterator(
+                   [&fn](const index_entry_type& index_entry) {
+                     fn(traits::get_phrase_id(index_entry),
+                        traits::get_phrase_frequency(index_entry));
+                   }));
+  }
+
+  /**
+   * @brief Returns an estimate of the number of phrase references
+   * \c process would return for the given query if the max phrase count was
+   * unlimited.
+   *
+   * The estimate is computed from index metadata only and is a lot cheaper
+   * than processing the query.
+   */
+  count_type estimate_count(const SearchOptions& options,
+                            const NormQuery& query,
+                            SearchStats& search_stats) {
+    return strategy_.estimate_count(options, query, search_stats);
+  }
+
+  /**
+   * @brief Returns the total number of entries of the postlists \c process
+   * has to read to find all phrase references of the given query.
+   *
+   * This only reads the heads of the postlists.
+   */
+  uint64_t postlist_size(const NormQuery& query) {
+    return strategy_.postlist_size(query);
+  }
+
+  /**
+   * @brief Returns an upper bound for the frequency of the phrase references
+   * \c process will return for the given query.
+   *
+   * This is a lot cheaper than processing the query.
+   */
+  uint64_t max_phrase_frequency(const SearchOptions& options,
+                                const NormQuery& query) {
+    return std::min(options.max_phrase_frequency,
+                    strategy_.max_phrase_frequency(query));
+  }
+
 private:
-  void process_(const SearchOptions& options, RawRefResult& query_result,
-                const NormQuery& query) {
+  template <typename OutputIterator>
+  void intersect_(const SearchOptions& options, const NormQuery& query,
+                  std::vector<std::string>& unknown_words,
+                  SearchStats& search_stats, std::pmr::memory_resource* arena,
+                  OutputIterator output) {
     std::vector<typename RetrievalStrategyTag::unit_metadata> unit_metadata;
     strategy_.initialize_query(options, query, unit_metadata);
     std::sort(unit_metadata.begin(), unit_metadata.end());
 
-    intersection_set_type src_set;
-    intersection_set_type dst_set;
+    intersection_set_type src_set(arena);
+    intersection_set_type dst_set(arena);
     intersection_set_type* src_set_ptr(&src_set);
     intersection_set_type* dst_set_ptr(&dst_set);
 
-    std::vector<index_entry_type> index_entries;
     uint64_t cur_max_phrase_frequency = options.max_phrase_frequency;
 
+    // Skip the phrases of previous pages. All phrases of the query have its
+    // length, so the global min phrase id is a local id within its phrases.
+    resume_type resume;
+    resume.frequency = options.max_phrase_frequency;
+    const uint64_t min_length = options.min_phrase_id >> 32;
+    if (min_length > query.size() && cur_max_phrase_frequency != 0) {
+      // all phrases of the max frequency were returned
+      cur_max_phrase_frequency--;
+    } else if (min_length == query.size()) {
+      resume.phrase_id = static_cast<uint32_t>(options.min_phrase_id);
+    }
+
     for (auto it = unit_metadata.begin(); it != unit_metadata.end(); ++it) {
       if (it == unit_metadata.begin()) {
         // this is the first word
         if (it == unit_metadata.end() - 1) {
           // ...and the last word
           const stats_type stats(strategy_.initialize_result_set(
-              *it, query, cur_max_phrase_frequency, options.max_phrase_count,
-              std::back_inserter(index_entries)));
+              *it, query, cur_max_phrase_frequency, resume,
+              options.max_phrase_count, search_stats, output));
+          search_stats.entries_scanned += stats.eval_index_entry_count;
           if (!stats.unknown_word.empty()) {
-            query_result.unknown_words().push_back(stats.unknown_word);
+            unknown_words.push_back(stats.unknown_word);
           }
         } else {
           // ...but not the last word
           const stats_type stats(strategy_.initialize_result_set(
-              *it, query, cur_max_phrase_frequency,
-              std::numeric_limits<size_t>::max(),
+              *it, query, cur_max_phrase_frequency, resume,
+              std::numeric_limits<size_t>::max(), search_stats,
               std::inserter(*src_set_ptr, src_set_ptr->end())));
+          search_stats.entries_scanned += stats.eval_index_entry_count;
           cur_max_phrase_frequency = stats.max_phrase_frequency;
           if (!stats.unknown_word.empty()) {
-            query_result.unknown_words().push_back(stats.unknown_word);
+            unknown_words.push_back(stats.unknown_word);
           }
         }
       } else if (it == unit_metadata.end() - 1) {
         // perform last intersection and copy
-        // matches directly into final result vector
+        // matches directly into the output
         const stats_type stats(strategy_.intersect_result_set(
-            *src_set_ptr, *it, query, cur_max_phrase_frequency,
-            options.max_phrase_count, std::back_inserter(index_entries)));
+            *src_set_ptr, *it, query, cur_max_phrase_frequency, resume,
+            options.max_phrase_count, search_stats, output));
+        search_stats.entries_scanned += stats.eval_index_entry_count;
         if (!stats.unknown_word.empty()) {
-          query_result.unknown_words().push_back(stats.unknown_word);
+          unknown_words.push_back(stats.unknown_word);
         }
       } else {
         // perform intermediate intersection
         const stats_type stats(strategy_.intersect_result_set(
-            *src_set_ptr, *it, query, cur_max_phrase_frequency,
-            std::numeric_limits<size_t>::max(),
+            *src_set_ptr, *it, query, cur_max_phrase_frequency, resume,
+            std::numeric_limits<size_t>::max(), search_stats,
             std::inserter(*dst_set_ptr, dst_set_ptr->end())));
+        search_stats.entries_scanned += stats.eval_index_entry_count;
         cur_max_phrase_frequency = stats.max_phrase_frequency;
         if (!stats.unknown_word.empty()) {
-          query_result.unknown_words().push_back(stats.unknown_word);
+          unknown_words.push_back(stats.unknown_word);
         }
         std::swap(src_set_ptr, dst_set_ptr);
         dst_set_ptr->clear();
@@ -131,12 +230,6 @@ private:
       if (src_set_ptr->empty())
         break;
     }
-
-    for (const auto& index_entry : index_entries) {
-      uint32_t freq = traits::get_phrase_frequency(index_entry);
-      uint32_t id = traits::get_phrase_id(index_entry);
-      query_result.refs().push_back(RawRefResult::Ref(id, freq));
-    }
   }
 
 private:
@@ -1,10 +1,14 @@
 #ifndef NETSPEAK_RETRIEVAL_STRATEGY_HPP
 #define NETSPEAK_RETRIEVAL_STRATEGY_HPP
 
+#include <string>
+#include <vector>
+
 #include "netspeak/Configuration.hpp"
 #include "netspeak/Properties.hpp"
 #include "netspeak/model/NormQuery.hpp"
 #include "netspeak/model/SearchOptions.hpp"
+#include "netspeak/model/SearchStats.hpp"
 
 namespace netspeak {
 
@@ -40,6 +44,32 @@ struct stats_type {
   std::string unknown_word;
 };
 
+/**
+ * The position of a search after the last phrase of a previous page within the
+ * phrases of one norm query. Index entries with the given frequency and a
+ * (local) phrase id below the given one were returned by previous pages.
+ */
+struct resume_type {
+  resume_type() : frequency(), phrase_id() {}
+  uint64_t frequency;
+  uint32_t phrase_id;
+
+  bool skips(uint64_t freq, uint32_t id) const {
+    return freq == frequency && id < phrase_id;
+  }
+};
+
+/**
+ * The (estimated) number of phrases of a query and the sum of their
+ * frequencies.
+ */
+struct count_type {
+  count_type() : phrase_count(), frequency_sum() {}
+  uint64_t phrase_count;
+  uint64_t frequency_sum;
+  std::vector<std::string> unknown_words;
+};
+
 /**
  * Primary template to define the common interface of retrieval strategies.
  * Customized strategies have to specialize this template by providing a unique
@@ -55,18 +85,54 @@ public:
       const SearchOptions& options, const model::NormQuery& query,
       std::vector<typename RetrievalStrategyTag::unit_metadata>& metadata);
 
+  /**
+   * Returns an upper bound for the frequency of all phrases the strategy will
+   * find for the given query.
+   */
+  uint64_t max_phrase_frequency(const model::NormQuery& query);
+
+  /**
+   * Returns an estimate of the number of phrases the strategy will find for
+   * the given query and the sum of their frequencies without intersecting
+   * any postlists.
+   */
+  count_type estimate_count(const SearchOptions& options,
+                            const model::NormQuery& query,
+                            model::SearchStats& search_stats);
+
+  /**
+   * Returns the total number of entries of the postlists the strategy has to
+   * read to find all phrases of the given query. Only the heads of the
+   * postlists are read.
+   */
+  uint64_t postlist_size(const model::NormQuery& query);
+
+  /**
+   * Copies the entries of the postlist of the given unit to the given output.
+   *
+   * Entries above the max frequency and entries skipped by the given resume
+   * position are left out. Once \c max_phrase_count entries were copied, the
+   * remaining entries with the frequency of the last copied one are still
+   * copied, so that the phrases of this frequency can be ordered by id.
+   */
   template <typename OutputIterator>
   const stats_type initialize_result_set(
       const typename RetrievalStrategyTag::unit_metadata& unit_meta,
       const model::NormQuery& query, uint64_t max_phrase_frequency,
-      uint64_t max_phrase_count, OutputIterator output);
+      const resume_type& resume, uint64_t max_phrase_count,
+      model::SearchStats& search_stats, OutputIterator output);
 
+  /**
+   * Same as \c initialize_result_set but only for entries in the given
+   * intersection set.
+   */
   template <typename IntersectionSet, typename OutputIterator>
   const stats_type intersect_result_set(
       const IntersectionSet& input,
       const typename RetrievalStrategyTag::unit_metadata& unit_meta,
       const model::NormQuery& query, size_t max_phrase_frequency,
-      size_t max_phrase_count, OutputIterator& output);
+      const resume_type& resume, size_t max_phrase_count,
+      model::SearchStats& search_stats, OutputIterator& output);
 
   Properties properties() const;
 };
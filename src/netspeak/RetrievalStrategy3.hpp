@@ -1,6 +1,7 @@
 #ifndef NETSPEAK_RETRIEVAL_STRATEGY_3_HPP
 #define NETSPEAK_RETRIEVAL_STRATEGY_3_HPP
 
+#include <cstdio>
 #include <memory>
 #include <string>
 
@@ -10,6 +11,7 @@
 #include "netspeak/invertedindex/Searcher.hpp"
 #include "netspeak/model/NormQuery.hpp"
 #include "netspeak/model/SearchOptions.hpp"
+#include "netspeak/model/SearchStats.hpp"
 #include "netspeak/value/pair.hpp"
 
 namespace netspeak {
@@ -82,6 +84,10 @@ struct index_entry_traits<RetrievalStrategy3Tag> {
  *   for that reason the postlists are indexed as well (postlist_index_).
  * - For the very first retrieved postlist (see method initialize_result_set)
  *   we can determine such (jumpin-) frequency from the query.
+ *
+ * The time spent on the postlist index, on reading postlists and on scanning
+ * them is added to the given search stats together with the number and the
+ * size of all postlists read.
  */
 template <>
 class RetrievalStrategy<RetrievalStrategy3Tag> {
@@ -146,45 +152,130 @@ public:
     }
   }
 
+  uint64_t max_phrase_frequency(const NormQuery& query) {
+    return compute_jumpin_frequency_(query);
+  }
+
+  /**
+   * The phrases of a query are a subset of the postlist of each of its words,
+   * so the estimate is the number of entries of the smallest postlist below
+   * the max frequency. The length of a postlist is read from its head and the
+   * frequencies of its entries are interpolated between the points of the
+   * postlist index. Postlists too short to be indexed are read completely.
+   *
+   * The postlist of a query with a single word contains exactly the phrases
+   * of the query, so its phrase count is exact unless the max frequency
+   * excludes some of them.
+   */
+  count_type estimate_count(const SearchOptions& options,
+                            const NormQuery& query,
+                            SearchStats& search_stats) {
+    const uint64_t jumpin_freq = compute_jumpin_frequency_(query);
+    const uint64_t max_freq =
+        std::min(options.max_phrase_frequency, jumpin_freq);
+
+    size_t word_count = 0;
+    for (const auto& unit : query.units()) {
+      if (unit.tag() == NormQuery::Unit::Tag::WORD) {
+        ++word_count;
+      }
+    }
+
+    count_type result;
+    bool first = true;
+    for (size_t i = 0; i != query.size(); ++i) {
+      if (query.units()[i].tag() != NormQuery::Unit::Tag::WORD) {
+        continue;
+      }
+      unit_metadata meta;
+      meta.position = i;
+      const std::string key = make_key(query, meta);
+
+      invertedindex::Head head;
+      if (!phrase_index_.search_head(key, head)) {
+        result.unknown_words.push_back(*query.units()[i].text());
+        result.phrase_count = 0;
+        result.frequency_sum = 0;
+        first = false;
+        continue;
+      }
+
+      count_type estimate =
+          estimate_postlist_(key, head, max_freq, search_stats);
+      if (word_count == 1 && max_freq == jumpin_freq) {
+        // the jump-in frequency is an upper bound for all entries
+        estimate.phrase_count = head.value_count;
+      }
+      if (first || estimate.phrase_count < result.phrase_count) {
+        result.phrase_count = estimate.phrase_count;
+        result.frequency_sum = estimate.frequency_sum;
+        first = false;
+      }
+    }
+    return result;
+  }
+
+  uint64_t postlist_size(const NormQuery& query) {
+    uint64_t size = 0;
+    for (size_t i = 0; i != query.size(); ++i) {
+      if (query.units()[i].tag() != NormQuery::Unit::Tag::WORD) {
+        continue;
+      }
+      unit_metadata meta;
+      meta.position = i;
+      invertedindex::Head head;
+      if (phrase_index_.search_head(make_key(query, meta), head)) {
+        size += head.value_count;
+      }
+    }
+    return size;
+  }
+
   template <typename OutputIterator>
   const stats_type initialize_result_set(const unit_metadata& meta,
                                          const NormQuery& query,
                                          uint64_t max_phrase_frequency,
+                                         const resume_type& resume,
                                          uint64_t max_phrase_count,
+                                         SearchStats& search_stats,
                                          OutputIterator output) {
     max_phrase_frequency =
         std::min(max_phrase_frequency, compute_jumpin_frequency_(query));
 
     stats_type stats;
     std::shared_ptr<invertedindex::Postlist<index_entry_type> > postlist(
-        search_(make_key(query, meta), max_phrase_frequency, meta.pruning));
+        search_(make_key(query, meta), max_phrase_frequency, meta.pruning,
+                search_stats));
     if (!postlist) {
       stats.unknown_word = *(query.units()[meta.position].text());
       return stats;
     }
-
-    // The first of the following two _while_ loops has two tasks:
-    // (1) Skip values of the postlist with invalid frequency
-    // (2) Select the frequency of the first valid _index_entry_
+    StageTimer timer(search_stats, SearchStats::Stage::INTERSECT);
 
     index_entry_type index_entry;
-    while (postlist->next(index_entry) && max_phrase_count != 0) {
+    bool first = true;
+    uint64_t last_frequency = 0;
+    while (postlist->next(index_entry)) {
+      const uint64_t frequency = traits::get_phrase_frequency(index_entry);
+      if (max_phrase_count == 0 && (first || frequency != last_frequency)) {
+        break;
+      }
+      ++stats.eval_index_entry_count;
       // Depending on the resolution of the postlist index,
       // search_() can only roughly satisfy the _max_freq_ condition,
       // so we have to check this condition here again.
-      ++stats.eval_index_entry_count;
-      if (traits::get_phrase_frequency(index_entry) <= max_phrase_frequency) {
+      if (frequency > max_phrase_frequency ||
+          resume.skips(frequency, traits::get_phrase_id(index_entry))) {
+        continue;
+      }
+      if (first) {
+        stats.max_phrase_frequency = frequency;
+        first = false;
+      }
+      if (max_phrase_count != 0) {
         --max_phrase_count;
-        stats.max_phrase_frequency = traits::get_phrase_frequency(index_entry);
-        *output = index_entry;
-        ++output;
-        break;
       }
-    }
-    // Copy all remaining index entries.
-    while (postlist->next(index_entry) && max_phrase_count != 0) {
-      --max_phrase_count;
-      ++stats.eval_index_entry_count;
+      last_frequency = frequency;
       *output = index_entry;
       ++output;
     }
@@ -197,43 +288,47 @@ public:
                                         const unit_metadata& meta,
                                         const NormQuery& query,
                                         size_t max_phrase_frequency,
+                                        const resume_type& resume,
                                         size_t max_phrase_count,
+                                        SearchStats& search_stats,
                                         OutputIterator output) {
     stats_type stats;
     std::shared_ptr<invertedindex::Postlist<index_entry_type> > postlist =
-        search_(make_key(query, meta), max_phrase_frequency, meta.pruning);
+        search_(make_key(query, meta), max_phrase_frequency, meta.pruning,
+                search_stats);
     if (!postlist) {
       stats.unknown_word = *(query.units()[meta.position].text());
       return stats;
     }
-
-    // The first of the following two _while_ loops has two reasons:
-    // (1) Skip values of the postlist with invalid frequency
-    // (2) Select the frequency of the first valid _index_entry_
+    StageTimer timer(search_stats, SearchStats::Stage::INTERSECT);
 
     index_entry_type index_entry;
-    while (postlist->next(index_entry) && max_phrase_count != 0) {
+    bool first = true;
+    uint64_t last_frequency = 0;
+    while (postlist->next(index_entry)) {
+      const uint64_t frequency = traits::get_phrase_frequency(index_entry);
+      if (max_phrase_count == 0 && (first || frequency != last_frequency)) {
+        break;
+      }
+      ++stats.eval_index_entry_count;
       // Depending on the resolution of the postlist index,
       // search_() can only roughly satisfy the _max_freq_ condition,
       // so we have to check this condition here again.
-      ++stats.eval_index_entry_count;
-      if (traits::get_phrase_frequency(index_entry) <= max_phrase_frequency &&
-          input.find(index_entry) != input.end()) {
-        --max_phrase_count;
-        stats.max_phrase_frequency = traits::get_phrase_frequency(index_entry);
-        *output = index_entry;
-        ++output;
-        break;
+      if (frequency > max_phrase_frequency ||
+          resume.skips(frequency, traits::get_phrase_id(index_entry)) ||
+          input.find(index_entry) == input.end()) {
+        continue;
       }
-    }
-    // Copy all remaining index entries.
-    while (postlist->next(index_entry) && max_phrase_count != 0) {
-      ++stats.eval_index_entry_count;
-      if (input.find(index_entry) != input.end()) {
+      if (first) {
+        stats.max_phrase_frequency = frequency;
+        first = false;
+      }
+      if (max_phrase_count != 0) {
         --max_phrase_count;
-        *output = index_entry;
-        ++output;
       }
+      last_frequency = frequency;
+      *output = index_entry;
+      ++output;
     }
     stats.min_phrase_frequency = traits::get_phrase_frequency(index_entry);
     return stats;
@@ -268,12 +363,24 @@ public:
   }
 
 private:
+  /**
+   * @brief Returns the key of the postlist of the given unit of the query.
+   *
+   * E.g. "2:0_hello" for the first unit of the query `hello ?`.
+   */
   static const std::string make_key(const NormQuery& query,
                                     const unit_metadata& meta) {
-    std::ostringstream oss;
-    oss << query.size() << ':' << meta.position << '_'
-        << *(query.units()[meta.position].text());
-    return oss.str();
+    // The length and position prefix fits into a small stack buffer, so the
+    // key itself only needs a single allocation (if any).
+    char prefix[48];
+    const int prefix_len = std::snprintf(prefix, sizeof(prefix), "%zu:%zu_",
+                                         query.size(), meta.position);
+    const auto& word = *(query.units()[meta.position].text());
+
+    std::string key;
+    key.reserve(prefix_len + word.size());
+    key.append(prefix, prefix_len).append(word);
+    return key;
   }
 
   /**
@@ -335,33 +442,123 @@ private:
     return min_frequency;
   }
 
+  /**
+   * @brief Estimates the number of entries of the given postlist with a
+   * frequency of at most \c max_freq and the sum of their frequencies.
+   */
+  count_type estimate_postlist_(const std::string& key,
+                                const invertedindex::Head& head,
+                                uint64_t max_freq, SearchStats& search_stats) {
+    count_type result;
+
+    // The postlist index contains the frequency of the entry at each quantile
+    // of the total frequency of the postlist.
+    std::vector<postlist_index_value_type> points;
+    {
+      StageTimer timer(search_stats, SearchStats::Stage::POSTLIST_INDEX);
+      std::unique_ptr<invertedindex::Postlist<postlist_index_value_type> >
+          meta_postlist(postlist_index_.search_postlist(key));
+      if (meta_postlist) {
+        postlist_index_value_type point;
+        while (meta_postlist->next(point)) {
+          points.push_back(point);
+        }
+      }
+    }
+
+    if (points.empty()) {
+      // short postlists are not indexed but cheap to read
+      std::unique_ptr<invertedindex::Postlist<index_entry_type> > postlist(
+          read_postlist_(key, 0, std::numeric_limits<uint32_t>::max(),
+                         search_stats));
+      StageTimer timer(search_stats, SearchStats::Stage::INTERSECT);
+      index_entry_type entry;
+      while (postlist && postlist->next(entry)) {
+        ++search_stats.entries_scanned;
+        const uint64_t freq = traits::get_phrase_frequency(entry);
+        if (freq <= max_freq) {
+          ++result.phrase_count;
+          result.frequency_sum += freq;
+        }
+      }
+      return result;
+    }
+
+    // Interpolate linearly between the points. The entries before the first
+    // point and after the last point have the frequency of that point.
+    double count = 0;
+    double sum = 0;
+    const auto add_segment = [&](double x0, double f0, double x1, double f1) {
+      if (x1 <= x0 || f1 > max_freq) {
+        return;
+      }
+      if (f0 > max_freq) {
+        // only the part below the max frequency
+        x0 += (x1 - x0) * (f0 - max_freq) / (f0 - f1);
+        f0 = max_freq;
+      }
+      count += x1 - x0;
+      sum += (x1 - x0) * (f0 + f1) / 2;
+    };
+    add_segment(0, points.front().e2(), points.front().e1(),
+                points.front().e2());
+    for (size_t i = 1; i != points.size(); ++i) {
+      add_segment(points[i - 1].e1(), points[i - 1].e2(), points[i].e1(),
+                  points[i].e2());
+    }
+    add_segment(points.back().e1(), points.back().e2(), head.value_count,
+                points.back().e2());
+
+    result.phrase_count = static_cast<uint64_t>(count + 0.5);
+    result.frequency_sum = static_cast<uint64_t>(sum + 0.5);
+    return result;
+  }
+
+  /**
+   * @brief Reads the given range of the postlist of the given key from the
+   * phrase index.
+   */
+  std::unique_ptr<invertedindex::Postlist<index_entry_type> > read_postlist_(
+      const std::string& key, uint32_t begin, uint32_t length,
+      SearchStats& search_stats) {
+    StageTimer timer(search_stats, SearchStats::Stage::POSTLIST_READ);
+    auto postlist = phrase_index_.search_postlist(key, begin, length);
+    if (postlist) {
+      ++search_stats.postlists_read;
+      search_stats.bytes_read += postlist->byte_size();
+    }
+    return postlist;
+  }
+
   std::shared_ptr<invertedindex::Postlist<index_entry_type> > search_(
-      const std::string& key, size_t max_freq, uint32_t pruning) {
+      const std::string& key, size_t max_freq, uint32_t pruning,
+      SearchStats& search_stats) {
     // Get index_begin from max_freq (jumpin frequency).
     size_t idx_begin = 0;
-    postlist_index_value_type prev_index_value;
-    postlist_index_value_type cur_index_value;
-    std::unique_ptr<invertedindex::Postlist<postlist_index_value_type> >
-        meta_postlist(postlist_index_.search_postlist(key));
-    if (meta_postlist) {
-      while (meta_postlist->next(cur_index_value)) {
-        if (cur_index_value.e2() == max_freq) {
-          idx_begin = cur_index_value.e1();
-          break;
-        }
-        if (cur_index_value.e2() < max_freq) {
-          // choose the value before, otherwise
-          // entries will be lost in some cases
-          idx_begin = prev_index_value.e1();
-          break;
+    {
+      StageTimer timer(search_stats, SearchStats::Stage::POSTLIST_INDEX);
+      postlist_index_value_type prev_index_value;
+      postlist_index_value_type cur_index_value;
+      std::unique_ptr<invertedindex::Postlist<postlist_index_value_type> >
+          meta_postlist(postlist_index_.search_postlist(key));
+      if (meta_postlist) {
+        while (meta_postlist->next(cur_index_value)) {
+          if (cur_index_value.e2() <= max_freq) {
+            // choose the value before, otherwise
+            // entries will be lost in some cases
+            // (this includes points with the frequency max_freq because a
+            // point can be in the middle of a run of equal frequencies)
+            idx_begin = prev_index_value.e1();
+            break;
+          }
+          prev_index_value = cur_index_value;
         }
-        prev_index_value = cur_index_value;
       }
     }
 
     // Read postlist from ngram index.
     return std::shared_ptr<invertedindex::Postlist<index_entry_type> >(
-        phrase_index_.search_postlist(key, idx_begin, pruning));
+        read_postlist_(key, idx_begin, pruning, search_stats));
   }
 
   typedef value::pair<uint32_t, uint32_t> postlist_index_value_type;
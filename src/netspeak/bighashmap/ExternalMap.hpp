@@ -5,9 +5,9 @@
 
 #include <cmph.h>
 
-#include <mutex>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <boost/filesystem/fstream.hpp>
 
@@ -65,15 +65,12 @@ private:
     data_ = util::fopen(dat_file, "rb");
   }
 
-  inline bool ReadEntry(uint64_t offset, Entry& entry, std::false_type) const {
-    util::fseek(data_, offset, SEEK_SET);
-    return EntryTraits::read_from(entry, data_);
-  }
-
-  // Thread-safe version.
-  inline bool ReadEntry(uint64_t offset, Entry& entry, std::true_type) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return ReadEntry(offset, entry, std::false_type());
+  // The read is positional, so it's thread safe without locking and the file
+  // can be shared with forked processes.
+  inline void ReadEntry(uint64_t offset, Entry& entry) const {
+    std::vector<char> buffer(EntryTraits::size_of(entry));
+    util::pread(fileno(data_), buffer.data(), buffer.size(), offset);
+    EntryTraits::copy_from(entry, buffer.data());
   }
 
 public:
@@ -94,12 +91,8 @@ public:
     Entry entry;
     const uint64_t offset = Base::Hash(key) * EntryTraits::size_of(entry);
 
-    // Seek to table entry on disk and read it.
-    if (!ReadEntry(offset, entry, IsThreadSafeSwitch())) {
-      DEBUG_LOG("Key", key);
-      DEBUG_LOG("File offset", offset);
-      util::throw_runtime_error("EntryTraits::read_from failed");
-    }
+    // Read the table entry from disk.
+    ReadEntry(offset, entry);
     // Compute checksum and reject value on mismatch.
     const Checksum checksum(util::hash<Checksum>(key));
     if (entry.e1() != checksum) {
@@ -116,7 +109,6 @@ public:
 
 private:
   FILE* data_;
-  mutable std::mutex mutex_;
 };
 
 } // namespace bighashmap
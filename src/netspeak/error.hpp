@@ -15,6 +15,12 @@ struct invalid_query_error : public tracable_runtime_error {
   virtual ~invalid_query_error() throw() override {}
 };
 
+struct invalid_parameter_error : public tracable_runtime_error {
+  invalid_parameter_error(const std::string& what)
+      : tracable_runtime_error(what) {}
+  virtual ~invalid_parameter_error() throw() override {}
+};
+
 
 /**
  * @brief The query_error_message struct
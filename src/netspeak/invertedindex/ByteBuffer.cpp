@@ -66,6 +66,11 @@ void ByteBuffer::read(FILE* fs) {
   rewind();
 }
 
+void ByteBuffer::read(int fd, uint64_t offset) {
+  util::pread(fd, buffer_->data.get(), size(), offset);
+  rewind();
+}
+
 void ByteBuffer::write(FILE* fs) const {
   util::fwrite(begin(), 1, size(), fs);
 }
@@ -111,6 +111,7 @@ public: // methods
   size_t tell() const;
   void rewind();
   void read(FILE* fs);
+  void read(int fd, uint64_t offset);
   void write(FILE* fs) const;
 
   /**
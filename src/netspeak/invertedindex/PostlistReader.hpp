@@ -28,33 +28,60 @@ private:
   PostlistReader();
 
 public:
+  /**
+   * Reads the postlist at the current offset of the given file and moves the
+   * offset to the end of the postlist.
+   */
   static std::unique_ptr<Postlist<T>> read(
       const boost::filesystem::path& path, FILE* file, uint32_t index_begin = 0,
       uint32_t value_count = std::numeric_limits<uint32_t>::max(),
       uint32_t page_size = swap_type::default_pagesize) {
+    uint64_t offset = util::ftell(file);
+    auto postlist = read(path, fileno(file), offset, index_begin, value_count,
+                         page_size);
+    util::fseek(file, offset, SEEK_SET);
+    return postlist;
+  }
+
+  /**
+   * Reads the postlist at the given offset of the given file and sets the
+   * offset to the end of the postlist.
+   *
+   * The offset of the file itself isn't used, so concurrent reads of the same
+   * file don't have to be synchronized.
+   */
+  static std::unique_ptr<Postlist<T>> read(
+      const boost::filesystem::path& path, int fd, uint64_t& offset,
+      uint32_t index_begin = 0,
+      uint32_t value_count = std::numeric_limits<uint32_t>::max(),
+      uint32_t page_size = swap_type::default_pagesize) {
     std::unique_ptr<Postlist<T>> postlist;
 
     // load postlist head
     Head head;
-    util::fread(&head, sizeof(head), 1, file);
+    util::pread(fd, &head, sizeof(head), offset);
     index_begin = std::min(index_begin, head.value_count);
     value_count = std::min(value_count, head.value_count - index_begin);
-    std::size_t begin_of_payload = util::ftell(file);
+    std::size_t begin_of_payload = offset + sizeof(head);
     if (head.value_size == 0) // variable value size
     {
+      const std::size_t begin_of_sizes = begin_of_payload;
       begin_of_payload += head.value_count * sizeof(size_vector::value_type);
 
       // read value sizes to skip [0, index_begin)
       size_vector value_sizes(index_begin);
-      util::fread(value_sizes.data(), sizeof(size_vector::value_type),
-                  value_sizes.size(), file);
+      util::pread(fd, value_sizes.data(),
+                  value_sizes.size() * sizeof(size_vector::value_type),
+                  begin_of_sizes);
       const std::size_t offset_of_index_begin = std::accumulate(
           value_sizes.begin(), value_sizes.end(), begin_of_payload);
 
       // read value sizes to use [index_begin, index_begin + value_count)
       value_sizes.resize(value_count);
-      util::fread(value_sizes.data(), sizeof(size_vector::value_type),
-                  value_sizes.size(), file);
+      util::pread(fd, value_sizes.data(),
+                  value_sizes.size() * sizeof(size_vector::value_type),
+                  begin_of_sizes +
+                      index_begin * sizeof(size_vector::value_type));
       const std::size_t total_payload_size =
           std::accumulate(value_sizes.begin(), value_sizes.end(), 0);
 
@@ -73,9 +100,9 @@ public:
       } else {
         // read payload into buffer
         page_type page(total_payload_size);
-        util::fseek(file, offset_of_index_begin, SEEK_SET);
-        util::log((__FILE__), (__LINE__), "util::ftell", util::ftell(file));
-        page.buffer_.read(file);
+        util::log((__FILE__), (__LINE__), "util::ftell",
+                  offset_of_index_begin);
+        page.buffer_.read(fd, offset_of_index_begin);
         postlist.reset(new Postlist<T>(new_head, page, value_sizes));
       }
     } else {
@@ -96,13 +123,11 @@ public:
       } else {
         // read payload to use into buffer
         page_type page(total_payload_size);
-        util::fseek(file, offset_of_index_begin, SEEK_SET);
-        page.buffer_.read(file);
+        page.buffer_.read(fd, offset_of_index_begin);
         postlist.reset(new Postlist<T>(new_head, page));
       }
     }
-    const std::size_t end_of_postlist = begin_of_payload + head.total_size;
-    util::fseek(file, end_of_postlist, SEEK_SET);
+    offset = begin_of_payload + head.total_size;
     return postlist;
   }
 };
@@ -4,8 +4,6 @@
 #define NETSPEAK_INVERTEDINDEX_STORAGE_READER_HPP
 
 #include <memory>
-#include <mutex>
-#include <type_traits>
 
 #include <boost/filesystem.hpp>
 
@@ -19,6 +17,13 @@ namespace invertedindex {
 
 namespace bfs = boost::filesystem;
 
+/**
+ * Reads postlists from the data files of a storage.
+ *
+ * All reads are positional (see \c util::pread), so they are thread safe
+ * without any locking. The data files can also be shared with forked
+ * processes.
+ */
 template <typename T, bool ThreadSafe>
 class StorageReader {
 private:
@@ -26,37 +31,6 @@ private:
   typedef std::vector<bfs::path> PathVector;
   typedef typename StorageWriter<T>::Address Address;
   typedef bighashmap::BigHashMap<Address, ThreadSafe> Map;
-  typedef std::integral_constant<bool, ThreadSafe> IsThreadSafe;
-
-  inline bool ReadHead(FILE* file, uint32_t offset, Head& head,
-                       std::false_type) const {
-    util::fseek(file, offset, SEEK_SET);
-    util::fread(&head, sizeof(head), 1, file);
-    return true;
-  }
-
-  // Thread-safe version.
-  inline bool ReadHead(FILE* file, uint32_t offset, Head& head,
-                       std::true_type) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return ReadHead(file, offset, head, std::false_type());
-  }
-
-  inline std::unique_ptr<Postlist<T> > ReadPostlist(
-      const bfs::path& path, FILE* file, uint32_t offset, uint32_t begin,
-      uint32_t length, uint32_t page_size, std::false_type) const {
-    util::fseek(file, offset, SEEK_SET);
-    return PostlistReader<T>::read(path, file, begin, length, page_size);
-  }
-
-  // Thread-safe version.
-  inline std::unique_ptr<Postlist<T> > ReadPostlist(
-      const bfs::path& path, FILE* file, uint32_t offset, uint32_t begin,
-      uint32_t length, uint32_t page_size, std::true_type) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return ReadPostlist(path, file, offset, begin, length, page_size,
-                        std::false_type());
-  }
 
 public:
   StorageReader() {}
@@ -108,8 +82,8 @@ public:
     Address address;
     if (table_ && table_->Get(key, address) && address.e1() < files_.size()) {
       FILE* file = files_[address.e1()];
-      const uint32_t offset = address.e2();
-      return ReadHead(file, offset, head, IsThreadSafe());
+      util::pread(fileno(file), &head, sizeof(head), address.e2());
+      return true;
     }
     return false;
   }
@@ -136,10 +110,10 @@ public:
     std::unique_ptr<Postlist<T> > postlist;
     if (table_ && table_->Get(key, address) && address.e1() < files_.size()) {
       FILE* file = files_[address.e1()];
-      const uint32_t offset = address.e2();
+      uint64_t offset = address.e2();
       const bfs::path& path = paths_[address.e1()];
-      postlist = ReadPostlist(path, file, offset, begin, length, page_size,
-                              IsThreadSafe());
+      postlist = PostlistReader<T>::read(path, fileno(file), offset, begin,
+                                         length, page_size);
     }
     return postlist;
   }
@@ -148,7 +122,6 @@ private:
   std::unique_ptr<Map> table_;
   FileVector files_;
   PathVector paths_;
-  mutable std::mutex mutex_;
 };
 
 } // namespace invertedindex
@@ -0,0 +1,55 @@
+#include "netspeak/model/ContinuationToken.hpp"
+
+
+namespace netspeak {
+namespace model {
+
+
+// The binary format starts with a version byte followed by all fields in
+// little endian.
+const uint8_t TOKEN_VERSION = 2;
+const size_t TOKEN_SIZE = 1 + 8 + 8 + 8;
+
+template <typename T>
+void write_le(std::string& out, T value) {
+  for (size_t i = 0; i != sizeof(T); i++) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    value >>= 8;
+  }
+}
+template <typename T>
+T read_le(const char*& data) {
+  T value = 0;
+  for (size_t i = 0; i != sizeof(T); i++) {
+    value |= static_cast<T>(static_cast<uint8_t>(*data++)) << (8 * i);
+  }
+  return value;
+}
+
+std::string ContinuationToken::encode() const {
+  std::string out;
+  out.reserve(TOKEN_SIZE);
+  out.push_back(static_cast<char>(TOKEN_VERSION));
+  write_le(out, request_hash);
+  write_le(out, frequency);
+  write_le(out, phrase_id);
+  return out;
+}
+
+bool ContinuationToken::decode(const std::string& data,
+                               ContinuationToken& token) {
+  if (data.size() != TOKEN_SIZE ||
+      static_cast<uint8_t>(data[0]) != TOKEN_VERSION) {
+    return false;
+  }
+
+  const char* p = data.data() + 1;
+  token.request_hash = read_le<uint64_t>(p);
+  token.frequency = read_le<uint64_t>(p);
+  token.phrase_id = read_le<uint64_t>(p);
+  return true;
+}
+
+
+} // namespace model
+} // namespace netspeak
@@ -0,0 +1,56 @@
+#ifndef NETSPEAK_MODEL_CONTINUATION_TOKEN_HPP
+#define NETSPEAK_MODEL_CONTINUATION_TOKEN_HPP
+
+#include <cstdint>
+#include <string>
+
+
+namespace netspeak {
+namespace model {
+
+
+/**
+ * @brief The position of a search after the last phrase of a page of results.
+ *
+ * Phrases are totally ordered by descending frequency and ascending id, so the
+ * last returned phrase is enough to know where the next page starts. The
+ * search of the next page skips all phrases up to this one, so it doesn't
+ * depend on how many phrases share a frequency.
+ *
+ * The token is sent to clients as an opaque binary string.
+ */
+struct ContinuationToken {
+public:
+  /**
+   * @brief A hash of the request that returned the token.
+   *
+   * This is used to reject tokens of other requests.
+   */
+  uint64_t request_hash;
+  /**
+   * @brief The frequency of the last returned phrase.
+   */
+  uint64_t frequency;
+  /**
+   * @brief The id of the last returned phrase.
+   */
+  uint64_t phrase_id;
+
+  /**
+   * @brief Returns the binary representation of this token.
+   */
+  std::string encode() const;
+  /**
+   * @brief Parses the given binary representation of a token.
+   *
+   * Returns \c false if the given string isn't a valid token.
+   */
+  static bool decode(const std::string& data, ContinuationToken& token);
+};
+
+
+} // namespace model
+} // namespace netspeak
+
+
+#endif
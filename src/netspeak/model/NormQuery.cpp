@@ -16,10 +16,13 @@ typedef NormQuery::Unit Unit;
 const Unit::Text QMARK_STR = std::make_shared<std::string>("?");
 
 Unit Unit::word(const Text& text, const Source& source) {
-  return Unit(Tag::WORD, text, source);
+  return Unit(Tag::WORD, UNKNOWN_ID, text, source);
+}
+Unit Unit::word(const Text& text, WordId id, const Source& source) {
+  return Unit(Tag::WORD, id, text, source);
 }
 Unit Unit::qmark(const Source& source) {
-  return Unit(Tag::QMARK, QMARK_STR, source);
+  return Unit(Tag::QMARK, UNKNOWN_ID, QMARK_STR, source);
 }
 
 bool Unit::operator==(const Unit& rhs) const {
@@ -27,6 +30,9 @@ bool Unit::operator==(const Unit& rhs) const {
     return false;
   }
   if (tag() == Unit::Tag::WORD) {
+    if (id() != UNKNOWN_ID && rhs.id() != UNKNOWN_ID) {
+      return id() == rhs.id();
+    }
     return *text() == *rhs.text();
   }
   return true;
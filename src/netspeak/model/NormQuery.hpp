@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "netspeak/model/Query.hpp"
+#include "netspeak/model/typedefs.hpp"
 
 namespace netspeak {
 namespace model {
@@ -16,6 +17,10 @@ namespace model {
 // To keep things performant, norm queries and their units are extremely
 // light-weight. Units are little more than two shared pointers and a tag and
 // norm queries are just a wrapper around a vector.
+//
+// Words are resolved to their id in the vocabulary of the corpus during
+// normalization, so that norm queries can be compared and used as cache keys
+// without looking at the text of their words.
 
 
 /**
@@ -30,6 +35,11 @@ public:
     QMARK,
   };
   typedef std::shared_ptr<const std::string> Text;
+  /**
+   * @brief The id of words which are not in the vocabulary and of question
+   * marks.
+   */
+  static constexpr WordId UNKNOWN_ID = UINT32_MAX;
   struct Source {
     std::shared_ptr<const Query> query;
     std::shared_ptr<const Query::Unit> unit;
@@ -40,6 +50,7 @@ public:
 
 private:
   Tag tag_;
+  WordId id_;
   Text text_;
   Source source_;
 
@@ -50,11 +61,19 @@ public:
   const Text& text() const {
     return text_;
   }
+  /**
+   * @brief Returns the id of the word in the vocabulary or \c UNKNOWN_ID .
+   */
+  WordId id() const {
+    return id_;
+  }
   const Source& source() const {
     return source_;
   }
 
   static NormQueryUnit__ word(const Text& text, const Source& source);
+  static NormQueryUnit__ word(const Text& text, WordId id,
+                              const Source& source);
   static NormQueryUnit__ qmark(const Source& source);
 
   bool operator==(const NormQueryUnit__& rhs) const;
@@ -63,8 +82,8 @@ public:
   }
 
 private:
-  NormQueryUnit__(Tag tag, const Text& text, const Source& source)
-      : tag_(tag), text_(text), source_(source) {}
+  NormQueryUnit__(Tag tag, WordId id, const Text& text, const Source& source)
+      : tag_(tag), id_(id), text_(text), source_(source) {}
   NormQueryUnit__() = delete;
 };
 
@@ -12,6 +12,14 @@ struct SearchOptions {
 public:
   uint32_t max_phrase_count;
   uint64_t max_phrase_frequency;
+  /**
+   * @brief Phrases with a frequency of \c max_phrase_frequency and a (global)
+   * id below this one are skipped.
+   *
+   * This resumes a search after the last phrase of a previous page. 0 skips
+   * nothing.
+   */
+  uint64_t min_phrase_id;
 
   uint32_t phrase_length_min;
   uint32_t phrase_length_max;
@@ -22,6 +30,7 @@ public:
   bool operator==(const SearchOptions& rhs) const {
     return max_phrase_count == rhs.max_phrase_count &&
            max_phrase_frequency == rhs.max_phrase_frequency &&
+           min_phrase_id == rhs.min_phrase_id &&
            phrase_length_min == rhs.phrase_length_min &&
            phrase_length_max == rhs.phrase_length_max &&
            pruning_high == rhs.pruning_high && pruning_low == rhs.pruning_low;
@@ -29,6 +38,15 @@ public:
   bool operator!=(const SearchOptions& rhs) const {
     return !(*this == rhs);
   }
+
+  /**
+   * @brief Returns whether the phrase with the given frequency and (global) id
+   * is excluded by the max phrase frequency or the min phrase id.
+   */
+  bool skips(uint64_t freq, uint64_t id) const {
+    return freq > max_phrase_frequency ||
+           (freq == max_phrase_frequency && id < min_phrase_id);
+  }
 };
 
 
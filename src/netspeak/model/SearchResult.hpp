@@ -2,6 +2,7 @@
 #define NETSPEAK_MODEL_SEARCH_RESULT_HPP
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "netspeak/model/NormQuery.hpp"
@@ -21,6 +22,8 @@ public:
     Item() = delete;
     Item(const std::shared_ptr<const NormQuery>& query, const Phrase& phrase)
         : query(query), phrase(phrase) {}
+    Item(const std::shared_ptr<const NormQuery>& query, Phrase&& phrase)
+        : query(query), phrase(std::move(phrase)) {}
 
     inline bool operator==(const Item& rhs) const {
       return phrase == rhs.phrase;
@@ -0,0 +1,99 @@
+#ifndef NETSPEAK_MODEL_SEARCH_STATS_HPP
+#define NETSPEAK_MODEL_SEARCH_STATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+
+namespace netspeak {
+namespace model {
+
+
+/**
+ * @brief The time searches spent in each of their stages and the work they
+ * did.
+ *
+ * Stats are always collected, so they have to be cheap: A stage is timed by
+ * reading a steady clock twice and all counters are plain integers. The stats
+ * of a search are only used by the thread doing the search.
+ */
+struct SearchStats {
+public:
+  typedef std::chrono::steady_clock clock;
+
+  enum class Stage {
+    /** Parsing the query. */
+    PARSE,
+    /** Normalizing the parsed query (including regexes). */
+    NORMALIZE,
+    /** Searching the postlist index for the start of postlists. */
+    POSTLIST_INDEX,
+    /** Reading postlists from the phrase index. */
+    POSTLIST_READ,
+    /** Scanning and intersecting postlists. */
+    INTERSECT,
+    /** Merging the results of all norm queries (including READ_PHRASES). */
+    MERGE,
+    /** Reading phrases from the phrase corpus. */
+    READ_PHRASES,
+  };
+  static const size_t STAGE_COUNT = 7;
+
+  std::array<clock::duration, STAGE_COUNT> stage_times = {};
+
+  uint64_t searches = 0;
+  uint64_t norm_queries = 0;
+  uint64_t postlists_read = 0;
+  uint64_t bytes_read = 0;
+  uint64_t entries_scanned = 0;
+  uint64_t result_cache_hits = 0;
+  uint64_t query_cache_hits = 0;
+
+  clock::duration& time(Stage stage) {
+    return stage_times[static_cast<size_t>(stage)];
+  }
+  const clock::duration& time(Stage stage) const {
+    return stage_times[static_cast<size_t>(stage)];
+  }
+
+  SearchStats& operator+=(const SearchStats& rhs) {
+    for (size_t i = 0; i != STAGE_COUNT; i++) {
+      stage_times[i] += rhs.stage_times[i];
+    }
+    searches += rhs.searches;
+    norm_queries += rhs.norm_queries;
+    postlists_read += rhs.postlists_read;
+    bytes_read += rhs.bytes_read;
+    entries_scanned += rhs.entries_scanned;
+    result_cache_hits += rhs.result_cache_hits;
+    query_cache_hits += rhs.query_cache_hits;
+    return *this;
+  }
+};
+
+/**
+ * @brief Adds the time between its construction and its destruction to a
+ * stage of the given stats.
+ */
+class StageTimer {
+private:
+  SearchStats::clock::duration& time_;
+  SearchStats::clock::time_point start_;
+
+public:
+  StageTimer() = delete;
+  StageTimer(const StageTimer&) = delete;
+  StageTimer(SearchStats& stats, SearchStats::Stage stage)
+      : time_(stats.time(stage)), start_(SearchStats::clock::now()) {}
+  ~StageTimer() {
+    time_ += SearchStats::clock::now() - start_;
+  }
+};
+
+
+} // namespace model
+} // namespace netspeak
+
+
+#endif
@@ -0,0 +1,514 @@
+#include "netspeak/parse.hpp"
+
+#include <sstream>
+#include <vector>
+
+#include "netspeak/error.hpp"
+#include "netspeak/util/string.hpp"
+
+
+namespace netspeak {
+
+using namespace model;
+
+typedef Query::Unit Unit;
+typedef Query::Unit::Tag Tag;
+
+
+/**
+ * @brief The token types of the lexer grammar in \c conf/grammar .
+ *
+ * The order of the token types is the order of the lexer rules. If two rules
+ * match the same number of characters, the earlier rule wins.
+ */
+enum class TokenType {
+  QMARK,
+  PLUS,
+  ASTERISK,
+  ASSOCIATION,
+  HASH,
+  LBRACE,
+  RBRACE,
+  LBRACKET,
+  RBRACKET,
+  DBLQUOTE,
+  REGEXWORD,
+  WORD,
+  BACKSLASH,
+  END_OF_QUERY,
+};
+
+struct query_token {
+  TokenType type;
+  size_t begin;
+  size_t end;
+};
+
+
+/**
+ * @brief Returns the number of bytes of the whitespace character at the given
+ * position or 0 if there is no whitespace character.
+ */
+size_t whitespace_length(const std::string& query, size_t i) {
+  const auto byte = [&](size_t index) -> unsigned char {
+    return index < query.size() ? query[index] : 0;
+  };
+
+  switch (byte(i)) {
+    case '\t':
+    case '\v':
+    case '\f':
+    case ' ':
+    case '\r':
+    case '\n':
+      return 1;
+    case 0xC2: // U+00A0
+      return byte(i + 1) == 0xA0 ? 2 : 0;
+    case 0xE1: // U+1680
+      return byte(i + 1) == 0x9A && byte(i + 2) == 0x80 ? 3 : 0;
+    case 0xE2: // U+2000 - U+200B and U+202F
+      if (byte(i + 1) == 0x80) {
+        const auto last = byte(i + 2);
+        if ((last >= 0x80 && last <= 0x8B) || last == 0xAF) {
+          return 3;
+        }
+      }
+      return 0;
+    case 0xE3: // U+3000
+      return byte(i + 1) == 0x80 && byte(i + 2) == 0x80 ? 3 : 0;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Returns whether the byte at the given position is part of a \c CHAR
+ * of the lexer grammar.
+ *
+ * Since whitespace characters are the only non-ASCII characters which aren't
+ * \c CHAR s, all bytes of a multi-byte character can be treated as one
+ * \c CHAR each.
+ */
+bool is_char(const std::string& query, size_t i) {
+  if (i >= query.size()) {
+    return false;
+  }
+  switch (query[i]) {
+    case '?':
+    case '+':
+    case '*':
+    case '#':
+    case '{':
+    case '\\':
+    case '}':
+    case '[':
+    case ']':
+    case '"':
+    case '|':
+    case '.':
+      return false;
+    default:
+      return whitespace_length(query, i) == 0;
+  }
+}
+
+/**
+ * @brief A hand-written lexer for the lexer grammar in \c conf/grammar .
+ *
+ * Just like the ANTLR lexer, this will always use the rule which matches the
+ * most characters.
+ */
+class QueryTokenizer {
+private:
+  const std::string& query_;
+  size_t pos_ = 0;
+
+public:
+  QueryTokenizer(const std::string& query) : query_(query) {}
+  QueryTokenizer(const QueryTokenizer&) = delete;
+
+  query_token next() {
+    while (pos_ < query_.size()) {
+      const size_t ws = whitespace_length(query_, pos_);
+      if (ws == 0) {
+        break;
+      }
+      pos_ += ws;
+    }
+    if (pos_ >= query_.size()) {
+      return { TokenType::END_OF_QUERY, pos_, pos_ };
+    }
+
+    TokenType type = TokenType::BACKSLASH;
+    size_t length = 0;
+    const auto candidate = [&](TokenType t, size_t len) {
+      // candidates have to be given in the order of the lexer rules
+      if (len > length) {
+        type = t;
+        length = len;
+      }
+    };
+
+    switch (query_[pos_]) {
+      case '?':
+        candidate(TokenType::QMARK, 1);
+        break;
+      case '+':
+        candidate(TokenType::PLUS, 1);
+        break;
+      case '*':
+        candidate(TokenType::ASTERISK, 1);
+        break;
+      case '.':
+        if (dot_run_length(pos_) >= 2) {
+          candidate(TokenType::ASTERISK, dot_run_length(pos_));
+        }
+        break;
+      case '|':
+        candidate(TokenType::ASSOCIATION, 1);
+        break;
+      case '#':
+        candidate(TokenType::HASH, 1);
+        break;
+      case '{':
+        candidate(TokenType::LBRACE, 1);
+        break;
+      case '}':
+        candidate(TokenType::RBRACE, 1);
+        break;
+      case '[':
+        candidate(TokenType::LBRACKET, 1);
+        break;
+      case ']':
+        candidate(TokenType::RBRACKET, 1);
+        break;
+      case '"':
+        candidate(TokenType::DBLQUOTE, 1);
+        break;
+      default:
+        break;
+    }
+    candidate(TokenType::REGEXWORD, regex_word_length(pos_));
+    candidate(TokenType::WORD, word_length(pos_));
+    candidate(TokenType::BACKSLASH, 1);
+
+    const query_token token{ type, pos_, pos_ + length };
+    pos_ += length;
+    return token;
+  }
+
+private:
+  size_t dot_run_length(size_t i) const {
+    size_t j = i;
+    while (j < query_.size() && query_[j] == '.') {
+      j++;
+    }
+    return j - i;
+  }
+
+  /**
+   * @brief Returns the length of the \c CHAR , \c '.' , or
+   * \c WILDCARDSINWORDS at the given position.
+   */
+  size_t word_atom_length(size_t i) const {
+    if (i >= query_.size()) {
+      return 0;
+    }
+    if (query_[i] == '.' || is_char(query_, i)) {
+      return 1;
+    }
+    if (query_[i] == '\\' && i + 1 < query_.size() &&
+        whitespace_length(query_, i + 1) == 0) {
+      return 2;
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Returns the length of the \c REGEX at the given position ignoring
+   * \c DOT_CHAR .
+   */
+  size_t regex_atom_length(size_t i) const {
+    switch (query_[i]) {
+      case '?':
+      case '*':
+      case '+':
+        return 1;
+      case '[':
+      case '{': {
+        const char close = query_[i] == '[' ? ']' : '}';
+        size_t j = i + 1;
+        while (is_char(query_, j)) {
+          j++;
+        }
+        if (j > i + 1 && j < query_.size() && query_[j] == close) {
+          return j + 1 - i;
+        }
+        return 0;
+      }
+      default:
+        return 0;
+    }
+  }
+
+  size_t word_length(size_t i) const {
+    size_t j = i;
+    size_t len;
+    while ((len = word_atom_length(j)) > 0) {
+      j += len;
+    }
+    return j - i;
+  }
+
+  /**
+   * @brief Returns the length of the \c REGEXWORD at the given position or 0.
+   *
+   * Both alternatives of the \c REGEXWORD rule match any sequence of words and
+   * regexes which contains at least one regex and is made of at least two
+   * parts. Because a word can always be split into its characters, the longest
+   * \c REGEXWORD is the longest sequence of word characters and regexes if
+   * that sequence contains a regex and more than one character or regex.
+   */
+  size_t regex_word_length(size_t i) const {
+    size_t j = i;
+    size_t parts = 0;
+    size_t dots = 0;
+    bool has_regex = false;
+
+    while (j < query_.size()) {
+      size_t len = regex_atom_length(j);
+      if (len > 0) {
+        has_regex = true;
+        dots = 0;
+      } else if ((len = word_atom_length(j)) > 0) {
+        // two or more unescaped dots are a DOT_CHAR
+        if (query_[j] == '.') {
+          if (++dots >= 2) {
+            has_regex = true;
+          }
+        } else {
+          dots = 0;
+        }
+      } else {
+        break;
+      }
+      j += len;
+      parts++;
+    }
+
+    if (has_regex && parts >= 2) {
+      return j - i;
+    }
+    return 0;
+  }
+};
+
+
+/**
+ * @brief Unescapes backslashes in the given word.
+ */
+std::string unescape_word(const std::string& query, size_t begin, size_t end) {
+  std::string word;
+  word.reserve(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    if (query[i] == '\\' && i + 1 < end) {
+      i++;
+    }
+    word.push_back(query[i]);
+  }
+  return word;
+}
+
+/**
+ * @brief A recursive-descent parser for the parser grammar in
+ * \c conf/grammar .
+ *
+ * The grammar is LL(1), so one token of lookahead is all the parser needs.
+ * Each rule of the grammar is implemented by one method.
+ */
+class QueryTreeBuilder {
+private:
+  const std::string& query_;
+  QueryTokenizer tokenizer_;
+  query_token current_;
+
+public:
+  QueryTreeBuilder(const std::string& query)
+      : query_(query), tokenizer_(query), current_(tokenizer_.next()) {}
+  QueryTreeBuilder(const QueryTreeBuilder&) = delete;
+
+  std::shared_ptr<Query> parse() {
+    const auto query = std::make_shared<Query>();
+    const auto& alternatives = query->alternatives();
+
+    // query: units (association units)* EOF;
+    alternatives->add_child(parse_units());
+    while (current_.type == TokenType::ASSOCIATION) {
+      advance();
+      alternatives->add_child(parse_units());
+    }
+    if (current_.type != TokenType::END_OF_QUERY) {
+      syntax_error("extraneous input '" + current_text() +
+                   "' expecting <EOF>");
+    }
+
+    return query;
+  }
+
+private:
+  void advance() {
+    current_ = tokenizer_.next();
+  }
+
+  std::string current_text() const {
+    if (current_.type == TokenType::END_OF_QUERY) {
+      return "<EOF>";
+    }
+    return query_.substr(current_.begin, current_.end - current_.begin);
+  }
+
+  /**
+   * @brief Throws an \c invalid_query_error at the current token.
+   *
+   * The message has the same format as the errors of the ANTLR parser.
+   */
+  [[noreturn]] void syntax_error(const std::string& message) const {
+    // ANTLR counts code points, not bytes
+    size_t column = 0;
+    for (size_t i = 0; i < current_.begin; i++) {
+      if ((query_[i] & 0xC0) != 0x80) {
+        column++;
+      }
+    }
+    size_t length = 0;
+    for (size_t i = current_.begin; i < current_.end; i++) {
+      if ((query_[i] & 0xC0) != 0x80) {
+        length++;
+      }
+    }
+
+    std::stringstream what;
+    what << "(1:" << (column + 1) << ", 1:" << (column + length) << ") "
+         << message;
+    throw invalid_query_error(what.str());
+  }
+
+  void expect(TokenType type, const std::string& expected) {
+    if (current_.type != type) {
+      syntax_error("mismatched input '" + current_text() + "' expecting " +
+                   expected);
+    }
+    advance();
+  }
+
+  std::shared_ptr<Unit> terminal(Tag tag) {
+    auto unit = Unit::terminal(tag, current_text());
+    advance();
+    return unit;
+  }
+
+  std::shared_ptr<Unit> word(Tag tag) {
+    auto unit =
+        Unit::terminal(tag, unescape_word(query_, current_.begin, current_.end));
+    advance();
+    return unit;
+  }
+
+  // units: unit*;
+  std::shared_ptr<Unit> parse_units() {
+    const auto units = Unit::non_terminal(Tag::CONCAT);
+    while (true) {
+      switch (current_.type) {
+        case TokenType::WORD:
+          units->add_child(word(Tag::WORD));
+          break;
+        case TokenType::REGEXWORD:
+          units->add_child(terminal(Tag::REGEX));
+          break;
+        case TokenType::LBRACKET:
+          units->add_child(parse_set(Tag::OPTIONSET, TokenType::RBRACKET));
+          break;
+        case TokenType::LBRACE:
+          units->add_child(parse_set(Tag::ORDERSET, TokenType::RBRACE));
+          break;
+        case TokenType::HASH:
+          // dictset: HASH_TOKEN word;
+          advance();
+          if (current_.type != TokenType::WORD) {
+            syntax_error("mismatched input '" + current_text() +
+                         "' expecting WORD_TOKEN");
+          }
+          units->add_child(word(Tag::DICTSET));
+          break;
+        case TokenType::QMARK:
+          units->add_child(terminal(Tag::QMARK));
+          break;
+        case TokenType::PLUS:
+          units->add_child(terminal(Tag::PLUS));
+          break;
+        case TokenType::ASTERISK:
+          units->add_child(terminal(Tag::STAR));
+          break;
+        default:
+          return units;
+      }
+    }
+  }
+
+  // optionset: LBRACKET_TOKEN (regexword | word | phrase)* RBRACKET_TOKEN;
+  // orderset: LBRACE_TOKEN (regexword | word | phrase)* RBRACE_TOKEN;
+  std::shared_ptr<Unit> parse_set(Tag tag, TokenType close) {
+    const auto set = Unit::non_terminal(tag);
+    advance();
+    while (true) {
+      switch (current_.type) {
+        case TokenType::WORD:
+          set->add_child(word(Tag::WORD));
+          break;
+        case TokenType::REGEXWORD:
+          set->add_child(terminal(Tag::REGEX));
+          break;
+        case TokenType::DBLQUOTE:
+          set->add_child(parse_phrase());
+          break;
+        default:
+          expect(close, close == TokenType::RBRACKET ? "']'" : "'}'");
+          return set;
+      }
+    }
+  }
+
+  // phrase: DBLQUOTE_TOKEN (regexword | word)* DBLQUOTE_TOKEN;
+  std::shared_ptr<Unit> parse_phrase() {
+    const auto phrase = Unit::non_terminal(Tag::CONCAT);
+    advance();
+    while (true) {
+      switch (current_.type) {
+        case TokenType::WORD:
+          phrase->add_child(word(Tag::WORD));
+          break;
+        case TokenType::REGEXWORD:
+          phrase->add_child(terminal(Tag::REGEX));
+          break;
+        default:
+          expect(TokenType::DBLQUOTE, "'\"'");
+          return phrase;
+      }
+    }
+  }
+};
+
+
+std::shared_ptr<Query> parse_query(const std::string& query) {
+  if (query.size() > 2000) {
+    throw invalid_query_error("Query too long");
+  }
+  if (!util::is_valid_utf8(query)) {
+    throw invalid_query_error("The query is not valid UTF-8");
+  }
+
+  QueryTreeBuilder builder(query);
+  return builder.parse();
+}
+
+} // namespace netspeak
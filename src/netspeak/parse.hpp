@@ -0,0 +1,25 @@
+#ifndef NETSPEAK_PARSE_HPP
+#define NETSPEAK_PARSE_HPP
+
+#include <memory>
+#include <string>
+
+#include "netspeak/model/Query.hpp"
+
+
+namespace netspeak {
+
+/**
+ * @brief Parses the given Netspeak query.
+ *
+ * This is a hand-written lexer and recursive-descent parser for the grammar in
+ * \c conf/grammar . It returns the same queries as \c antlr4::parse_query but
+ * doesn't need the ANTLR runtime and is a lot faster.
+ *
+ * @throws invalid_query_error If the given query is not a valid query.
+ */
+std::shared_ptr<model::Query> parse_query(const std::string& query);
+
+} // namespace netspeak
+
+#endif // NETSPEAK_PARSE_HPP
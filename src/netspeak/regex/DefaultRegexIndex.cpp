@@ -1,17 +1,21 @@
 #include "netspeak/regex/DefaultRegexIndex.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <codecvt>
+#include <condition_variable>
+#include <cstring>
 #include <functional>
 #include <future>
 #include <locale>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
-#include <boost/regex.hpp>
-
 #include "netspeak/regex/RegexIndex.hpp"
+#include "netspeak/regex/RegexMatcher.hpp"
 #include "netspeak/regex/RegexQuery.hpp"
 
 
@@ -52,19 +56,29 @@ namespace regex {
  * the offset and length of every word in the vocabulary in the order of
  * occurrence (first offset is the first word and so on).
  *
- * This, among other things, allows us to match regular expressions more
- * efficiently. We can now define a string which has to match the regular
- * expression (of the query) as a whole. This is huge because the RE engine
- * doesn't have to move the matcher accross the string, potentially, character
- * by character. Instead it can jump from word to word resulting in a
+ * This, among other things, allows us to match regex queries more
+ * efficiently. We can now define a string which has to match the query as a
+ * whole. This is huge because the matcher (see \c RegexMatcher ) doesn't have
+ * to move accross the string, potentially, character by character. Instead it
+ * can jump from word to word resulting in a
  * considerable speedup (4~10x faster on average). Since we also known the exact
  * length of each word, we can reject some word based on their length alone.
  *
- * The only cost is the memory to store all the offsets and length. We need 4
- * bytes per offset and 2 bytes per length (plus some padding for memory
- * alignment by the compiler), so 8 bytes per entry. The datasets of European
- * languages have between 10e6 and 20e6 words, so the list will need between
- * 80MB and 160MB of memory which is about the size of the vocabulary itself.
+ * The only cost is the memory to store all the offsets. To keep this small,
+ * all empty lines are removed from the vocabulary, so that every word is
+ * followed by exactly one `\n`. The length of a word can then be derived from
+ * its offset and the offset of the next word. The offsets are a non-decreasing
+ * sequence, so they are stored using Elias-Fano coding which needs about 2
+ * bits plus log2 of the average word length per word (5-6 bits for European
+ * languages).
+ *
+ * Decoding the offset of every word would make scans slower, so we also keep
+ * the length of every word in one byte. Words with a length of
+ * `LONG_WORD_LENGTH` or more are marked with `LONG_WORD_LENGTH` and get their
+ * length from the offsets. A scan only decodes the offset of the first word of
+ * its chunk and steps through the rest of the chunk by length, which is as fast
+ * as reading plain offsets. Together, offsets and lengths need about 14 bits
+ * per word instead of the 8 bytes a plain offset-length pair would need.
  *
  *
  * # Unicode character set
@@ -80,12 +94,10 @@ namespace regex {
  * `[fF]oo` can be simplified to `foo` and similarly, `(B)ar` (`()` denotes
  * optional words) can be simplified to `ar`.
  *
- * This won't need a lot of memory, only 4 bytes per unique character in the
- * vocabulary plus the overhead of the \c std::unordered_set implementation. The
- * English dataset contains about 500 unique characters but for Asian language
- * this number much larger with around 50K unique characters. So even assuming
- * the worst-case, we can safely say that the set won't require more than about
- * 2MB of memory.
+ * Almost all characters are part of the Basic Multilingual Plane (BMP), so we
+ * use a bitmap of 8KB for all BMP characters and a sorted list for the few
+ * other characters. This is faster and smaller than a hash set even for Asian
+ * languages with around 50K unique characters.
  *
  *
  * # Word hash table
@@ -112,159 +124,164 @@ namespace regex {
  * their combinations blow up very fast and for small number of combinations
  * (basically just one `?`), it is usually faster to use other methods.
  *
- * The hash table is implemented using linear probing, so we only need to know
- * how many 4 byte slots the table has. Since the size of the hash table n will
- * be a power of two, we will choose the next power of two of the number of
- * words w as a base. This will cause n to be 1.5 time greater than w on
- * average. However it is very important that there are enough free slot for the
- * lookup to be efficient, so if n and w are relatively close (n < w * 1.5), we
- * will double n. This means that n will be in the interval [w * 1.5, w * 3).
- * Given the datasets of European languages, this will result in  between
- * 60MB/120MB and 120MB/240MB for the hash table.
+ * The hash table is implemented using linear probing with n = w * 1.5 slots of
+ * 4 bytes for w words. The slot of a hash is computed via multiply-shift, so n
+ * doesn't have to be a power of two. Each slot contains the index of a word in
+ * its lower bits (25 bits for 20e6 words) and a fingerprint of the hash of the
+ * word in its upper bits. When probing, only slots with a matching
+ * fingerprint require a comparison with the actual word. This means that the
+ * hash table needs 6 bytes per word (60MB/120MB for the datasets of European
+ * languages) and that most lookups will touch the vocabulary at most once.
+ *
+ *
+ * # Parallel regex matching
+ *
+ * Queries which cannot be answered using the hash table have to be matched
+ * against every word in the word list. To do this faster, the word list is
+ * split into chunks of a fixed number of words. Chunks are claimed in order by
+ * the searching thread and a number of helper threads from a pool owned by the
+ * index. The searching thread always participates, so a query will make
+ * progress even if all helper threads are busy with other queries.
+ *
+ * The matches of each chunk are kept separately, so that they can be
+ * concatenated in vocabulary order once the scan is done. The scan is stopped
+ * as soon as the chunks that have been completely scanned and that form a
+ * prefix of the word list contain at least \c max_matches matches. All chunks
+ * after that prefix cannot contribute to the result anyway.
+ *
+ * The timeout is a global budget for all threads. If the timeout is reached,
+ * only the matches of the longest scanned prefix of the word list will be
+ * returned. This is the same result a single thread would have returned had it
+ * scanned that prefix.
+ *
+ *
+ * # Trigram index (optional)
+ *
+ * Even with multiple threads, a scan has to look at every word. Queries with
+ * a literal of at least 3 bytes (e.g. `*tion`, `pre?ent*`) can be answered
+ * faster using an inverted index from the byte trigrams of all words to the
+ * (sorted) indexes of the words containing them. Every match of the query has
+ * to contain all trigrams of the literals of the query, so the intersection of
+ * their lists is a (usually small) superset of the matches. The candidates are
+ * then verified one by one. Since candidates are in vocabulary order, we can
+ * stop as soon as \c max_matches words have been found.
+ *
+ * If the shortest list is too long, the intersection won't be selective enough
+ * and a scan is used instead.
+ *
+ * The lists are delta and variable-byte encoded. Most deltas fit into 1 or 2
+ * bytes, so the index needs about as much memory as the vocabulary itself.
+ * Since this is a lot, the index has to be enabled explicitly.
+ *
+ *
+ * # Prefix and suffix arrays (optional)
+ *
+ * Queries like `inform*` or `*ization` are very common. All words with a given
+ * prefix form a contiguous range in a list of all words sorted
+ * lexicographically, so we keep such a list (the _prefix array_) of word
+ * indexes. Similarly, the _suffix array_ contains all word indexes sorted by
+ * the reversed (UTF-8 bytes of) words. The range of words with a given
+ * prefix/suffix can then be found with two binary searches.
+ *
+ * Since the vocabulary is sorted by frequency, the top-k words of a range are
+ * the k smallest word indexes of the range. If the query is just a prefix or
+ * suffix followed/preceded by a star, every word in the range is a match and
+ * we only have to select the k smallest indexes. Otherwise, all words of the
+ * range are verified in order. In the latter case, the range will only be
+ * used if it's small enough.
+ *
+ * The arrays need 4 bytes per word each.
  */
 
-uint32_t next_pow_of_2(uint32_t n) {
-  n--;
-  n |= n >> 1;
-  n |= n >> 2;
-  n |= n >> 4;
-  n |= n >> 8;
-  n |= n >> 16;
-  n++;
-  return n;
-}
-
-uint32_t hash_word(const std::string& str, std::string::size_type offset,
-                   std::string::size_type length) {
-  uint32_t h = 0x12345678U;
-
-  // the Java hashcode implementation
-  std::string::size_type end = offset + length;
-  for (; offset != end; offset++) {
-    h = h * 31 + str[offset];
+uint64_t hash_word(const char* word, size_t length) {
+  // FNV-1a
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < length; i++) {
+    h = (h ^ static_cast<uint8_t>(word[i])) * 0x100000001b3ULL;
   }
 
+  // the finalizer of MurmurHash3 to make all bits depend on all input bytes
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
   return h;
 }
 
-bool contains_unknown_characters(
-    const std::u32string& str,
-    const std::unordered_set<char32_t>& known_chars) {
-  for (auto it = str.begin(); it != str.end(); it++) {
-    if (known_chars.find(*it) == known_chars.end()) {
-      // character is not in the set of all characters
-      return true;
-    }
-  }
-  return false;
+/**
+ * @brief Returns the slot of the given hash in a hash table with the given
+ * number of slots.
+ */
+inline size_t hash_slot(uint64_t hash, size_t slots) {
+  return static_cast<size_t>(((hash >> 32) * slots) >> 32);
 }
 
-void regex_pattern_append_char(std::u32string& pattern, char32_t c) {
-  switch (c) {
-    case '+':
-    case '*':
-    case '?':
-    case '|':
-    case '\\':
-    case '/':
-    case '(':
-    case ')':
-    case '[':
-    case ']':
-    case '{':
-    case '}':
-    case '.':
-    case '-':
-    case '^':
-    case '$':
-      pattern.push_back('\\');
-      pattern.push_back(c);
-      break;
-    default:
-      pattern.push_back(c);
-      break;
+bool DefaultRegexIndex::is_known_char(char32_t c) const {
+  if (c < bmp_chars_.size()) {
+    return bmp_chars_.test(c);
   }
+  return std::binary_search(supplementary_chars_.begin(),
+                            supplementary_chars_.end(), c);
 }
 
-std::string create_regex_pattern(const RegexQuery& query) {
-  std::u32string pattern;
-
-  for (const auto& unit : query.get_units()) {
-    switch (unit.type) {
-      case RegexUnit::Type::QMARK:
-        // https://stackoverflow.com/a/13163802/7595472
-        pattern.append(
-            U"(?:[\\x00-\\x7F]|(?:[\\xC2-\\xDF]|\\xE0[\\xA0-\\xBF]|\\xED["
-            U"\\x80-"
-            U"\\x9F]|(?:[\\xE1-\\xEC]|[\\xEE-\\xEF]|\\xF0[\\x90-\\xBF]|["
-            U"\\xF1-"
-            U"\\xF3][\\x80-\\xBF]|\\xF4[\\x80-\\x8F])[\\x80-\\xBF])[\\x80-"
-            U"\\xBF])");
-        break;
-
-      case RegexUnit::Type::STAR:
-        pattern.append(U".*");
-        break;
-
-      case RegexUnit::Type::CHAR_SET: {
-        pattern.append(U"(?:");
-        bool first = true;
-        for (const auto c : unit.value) {
-          if (first) {
-            first = false;
-          } else {
-            pattern.push_back('|');
-          }
-          regex_pattern_append_char(pattern, c);
-        }
-        pattern.append(U")");
-        break;
-      }
-
-      case RegexUnit::Type::OPTIONAL_WORD:
-        pattern.append(U"(?:");
-        for (const auto c : unit.value) {
-          regex_pattern_append_char(pattern, c);
-        }
-        pattern.append(U")?");
-        break;
-
-      default:
-        for (const auto c : unit.value) {
-          regex_pattern_append_char(pattern, c);
-        }
-        break;
+bool DefaultRegexIndex::contains_unknown_characters(
+    const std::u32string& str) const {
+  for (const auto c : str) {
+    if (!is_known_char(c)) {
+      // character is not in the set of all characters
+      return true;
     }
   }
-
-  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
-  return conv.to_bytes(pattern);
+  return false;
 }
 
+std::vector<DefaultRegexIndex::WordEntry>
+DefaultRegexIndex::initialize_words() {
+  std::vector<WordEntry> words;
 
-void DefaultRegexIndex::initialize_words() {
-  words_ = std::vector<struct WordEntry>();
+  // every word (including the last one) has to be followed by a \n
+  if (!vocabulary_.empty() && vocabulary_.back() != '\n') {
+    vocabulary_.push_back('\n');
+  }
 
-  // split vocabulary into words
-  std::string::size_type pos;
-  std::string::size_type prev = 0;
-  while ((pos = vocabulary_.find('\n', prev)) != std::string::npos) {
-    auto const length = pos - prev;
+  // split vocabulary into words and remove empty lines in-place
+  size_t write = 0;
+  size_t prev = 0;
+  while (prev < vocabulary_.size()) {
+    const size_t pos = vocabulary_.find('\n', prev);
+    const size_t length = pos - prev;
     if (length > 0) {
-      WordEntry entry = { (uint32_t)prev, (uint16_t)length };
-      words_.push_back(entry);
+      words.push_back({ (uint32_t)write, (uint32_t)length });
+      if (write != prev) {
+        std::memmove(&vocabulary_[write], &vocabulary_[prev], length);
+      }
+      write += length;
+      vocabulary_[write++] = '\n';
     }
     prev = pos + 1;
   }
-  if (vocabulary_.size() > prev) {
-    WordEntry entry = { (uint32_t)prev, (uint16_t)(vocabulary_.size() - prev) };
-    words_.push_back(entry);
+  vocabulary_.resize(write);
+  vocabulary_.shrink_to_fit();
+
+  word_count_ = words.size();
+  word_offsets_ = util::EliasFano(words.size() + 1, vocabulary_.size());
+  for (const auto& entry : words) {
+    word_offsets_.push_back(entry.offset);
+  }
+  word_offsets_.push_back(vocabulary_.size());
+
+  word_lengths_.reserve(words.size());
+  for (const auto& entry : words) {
+    word_lengths_.push_back(
+        (uint8_t)std::min<uint32_t>(entry.length, LONG_WORD_LENGTH));
   }
 
-  words_.shrink_to_fit();
+  return words;
 }
 
-void DefaultRegexIndex::initialize_all_chars() {
+void DefaultRegexIndex::initialize_all_chars(
+    const std::vector<WordEntry>& words) {
   // Since C++ provides no easy way to just iterate all UTF-32 characters of a
   // UTF-8 string, we use the std::string to std::u23string methods on
   // substrings of the whole vocabulary. This will keep the memory overhead
@@ -272,72 +289,179 @@ void DefaultRegexIndex::initialize_all_chars() {
 
   std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
 
-  // resever a few slots for good measure
-  all_chars_ = std::unordered_set<char32_t>();
-  all_chars_.reserve(10000);
+  std::unordered_set<char32_t> supplementary;
 
   // one substring will have this many words.
   size_t group_size = 1024;
-  for (size_t i = 0; i < words_.size(); i += group_size) {
-    size_t from = (size_t)words_[i].offset;
+  for (size_t i = 0; i < words.size(); i += group_size) {
+    size_t from = (size_t)words[i].offset;
     size_t to;
-    if (i + group_size < words_.size()) {
-      to = words_[i + group_size].offset;
+    if (i + group_size < words.size()) {
+      to = words[i + group_size].offset;
     } else {
       to = vocabulary_.size();
     }
 
     const std::string& sub = vocabulary_.substr(from, to - from);
     std::u32string u32 = conv.from_bytes(sub);
-    all_chars_.insert(u32.begin(), u32.end());
+    for (const auto c : u32) {
+      if (c < bmp_chars_.size()) {
+        bmp_chars_.set(c);
+      } else {
+        supplementary.insert(c);
+      }
+    }
   }
 
-  all_chars_.erase('\n');
-  all_chars_.erase('\r');
+  bmp_chars_.reset('\n');
+  bmp_chars_.reset('\r');
+
+  supplementary_chars_.assign(supplementary.begin(), supplementary.end());
+  std::sort(supplementary_chars_.begin(), supplementary_chars_.end());
+}
+
+/**
+ * @brief Returns the fingerprint of the given hash shifted into the upper bits
+ * of a hash table slot.
+ */
+inline uint32_t hash_fingerprint(uint64_t hash, uint32_t index_bits) {
+  return static_cast<uint32_t>((hash << index_bits) & 0xFFFFFFFFULL) &
+         ~static_cast<uint32_t>((uint64_t(1) << index_bits) - 1);
 }
 
-void DefaultRegexIndex::initialize_word_hash_table() {
+void DefaultRegexIndex::initialize_word_hash_table(
+    const std::vector<WordEntry>& words) {
+  // The index of a word has to fit into the lower bits of a slot. Since
+  // 2^index_bits > words.size(), a slot can never be UINT32_MAX.
+  hash_table_index_bits_ = 0;
+  while ((uint64_t(1) << hash_table_index_bits_) <= words.size()) {
+    hash_table_index_bits_++;
+  }
+
   // the hash table will be implemented via linear probing, so we need enough
   // spaces between entries.
-  size_t n = next_pow_of_2(words_.size());
-  if (n < words_.size() + (words_.size() / 2))
-    n *= 2; // n is too small, so let's make it bigger
+  const size_t n = words.size() + (words.size() / 2) + 1;
+  word_hash_table_ = std::vector<uint32_t>(n, UINT32_MAX);
 
-  word_hash_table_ = std::vector<uint32_t>(n);
+  // insert all words
+  for (uint32_t index = 0, count = words.size(); index < count; index++) {
+    const auto entry = words[index];
+    const uint64_t hash =
+        hash_word(vocabulary_.data() + entry.offset, entry.length);
+    size_t slot = hash_slot(hash, n);
 
-  // initialize all slots of the hash table as empty
-  for (size_t i = 0; i < n; i++) {
-    word_hash_table_[i] = UINT32_MAX;
+    while (word_hash_table_[slot] != UINT32_MAX) {
+      // linear probing
+      slot = slot + 1 == n ? 0 : slot + 1;
+    }
+    word_hash_table_[slot] =
+        hash_fingerprint(hash, hash_table_index_bits_) | index;
   }
+}
 
-  // insert all words
-  const uint32_t mask = n - 1;
-  for (uint32_t index = 0, count = words_.size(); index < count; index++) {
-    const auto entry = words_[index];
-    uint32_t hash = hash_word(vocabulary_, entry.offset, entry.length) & mask;
-
-    while (true) {
-      if (word_hash_table_[hash] == UINT32_MAX) {
-        // empty slot
-        word_hash_table_[hash] = index;
-        break;
-      }
+void DefaultRegexIndex::initialize_trigram_index(
+    const std::vector<WordEntry>& words) {
+  TrigramIndex::Builder builder;
+  for (const auto& entry : words) {
+    builder.append(vocabulary_.data() + entry.offset, entry.length);
+  }
+  trigram_index_ = std::make_unique<TrigramIndex>(std::move(builder));
+}
 
-      // linear probing
-      hash = (hash + 1) & mask;
+/**
+ * @brief Returns whether the UTF-8 bytes of \c a are less than the UTF-8 bytes
+ * of \c b .
+ */
+inline int compare_bytes(const char* a, size_t a_length, const char* b,
+                         size_t b_length) {
+  const int c = std::memcmp(a, b, std::min(a_length, b_length));
+  if (c != 0) {
+    return c;
+  }
+  return a_length < b_length ? -1 : (a_length > b_length ? 1 : 0);
+}
+/**
+ * @brief Same as \c compare_bytes but compares the reversed bytes.
+ */
+inline int compare_reversed_bytes(const char* a, size_t a_length,
+                                  const char* b, size_t b_length) {
+  const size_t length = std::min(a_length, b_length);
+  for (size_t i = 1; i <= length; i++) {
+    const uint8_t x = static_cast<uint8_t>(a[a_length - i]);
+    const uint8_t y = static_cast<uint8_t>(b[b_length - i]);
+    if (x != y) {
+      return x < y ? -1 : 1;
     }
   }
+  return a_length < b_length ? -1 : (a_length > b_length ? 1 : 0);
+}
+
+void DefaultRegexIndex::initialize_prefix_array(
+    const std::vector<WordEntry>& words) {
+  prefix_array_.resize(words.size());
+  for (uint32_t i = 0; i < words.size(); i++) {
+    prefix_array_[i] = i;
+  }
+  const char* data = vocabulary_.data();
+  std::sort(prefix_array_.begin(), prefix_array_.end(),
+            [&](uint32_t a, uint32_t b) {
+              const auto x = words[a];
+              const auto y = words[b];
+              return compare_bytes(data + x.offset, x.length, data + y.offset,
+                                   y.length) < 0;
+            });
+}
+
+void DefaultRegexIndex::initialize_suffix_array(
+    const std::vector<WordEntry>& words) {
+  suffix_array_.resize(words.size());
+  for (uint32_t i = 0; i < words.size(); i++) {
+    suffix_array_[i] = i;
+  }
+  const char* data = vocabulary_.data();
+  std::sort(suffix_array_.begin(), suffix_array_.end(),
+            [&](uint32_t a, uint32_t b) {
+              const auto x = words[a];
+              const auto y = words[b];
+              return compare_reversed_bytes(data + x.offset, x.length,
+                                            data + y.offset, y.length) < 0;
+            });
 }
 
 DefaultRegexIndex::DefaultRegexIndex(std::string vocabulary)
+    : DefaultRegexIndex(std::move(vocabulary), InitConfig()) {}
+DefaultRegexIndex::DefaultRegexIndex(std::string vocabulary, InitConfig config)
     : vocabulary_(std::move(vocabulary)) {
-  initialize_words();
-
-  // these two operations are independent and can be done in parallel
-  auto f1 = std::async([&]() { initialize_all_chars(); });
-  auto f2 = std::async([&]() { initialize_word_hash_table(); });
+  const auto words = initialize_words();
+
+  // these operations are independent and can be done in parallel
+  auto f1 = std::async([&]() { initialize_all_chars(words); });
+  auto f2 = std::async([&]() { initialize_word_hash_table(words); });
+  auto f3 = std::async([&]() {
+    if (config.trigram_index) {
+      initialize_trigram_index(words);
+    }
+  });
+  auto f4 = std::async([&]() {
+    if (config.affix_index) {
+      initialize_prefix_array(words);
+    }
+  });
+  auto f5 = std::async([&]() {
+    if (config.affix_index) {
+      initialize_suffix_array(words);
+    }
+  });
   f1.get();
   f2.get();
+  f3.get();
+  f4.get();
+  f5.get();
+
+  // the searching thread is one of the threads
+  if (config.threads > 1) {
+    scan_pool_ = std::make_unique<util::ThreadPool>(config.threads - 1);
+  }
 }
 
 
@@ -349,7 +473,7 @@ RegexQuery DefaultRegexIndex::optimize_query(const RegexQuery& query) const {
 
     switch (unit.type) {
       case RegexUnit::Type::WORD:
-        if (contains_unknown_characters(value, all_chars_)) {
+        if (contains_unknown_characters(value)) {
           // add the empty set causing the query to reject all words
           builder.add(RegexUnit::char_set(U""));
         } else {
@@ -359,7 +483,7 @@ RegexQuery DefaultRegexIndex::optimize_query(const RegexQuery& query) const {
         break;
 
       case RegexUnit::Type::OPTIONAL_WORD:
-        if (contains_unknown_characters(value, all_chars_)) {
+        if (contains_unknown_characters(value)) {
           // An optional word which contains an unknown character cannot be
           // matched, so we don't add it to the new query.
         } else {
@@ -369,11 +493,11 @@ RegexQuery DefaultRegexIndex::optimize_query(const RegexQuery& query) const {
         break;
 
       case RegexUnit::Type::CHAR_SET: {
-        if (contains_unknown_characters(value, all_chars_)) {
+        if (contains_unknown_characters(value)) {
           // remove all unknown character from the character set
           std::unordered_set<char32_t> set;
           for (const auto& c : value) {
-            if (all_chars_.find(c) != all_chars_.end()) {
+            if (is_known_char(c)) {
               set.insert(c);
             }
           }
@@ -400,32 +524,51 @@ std::string DefaultRegexIndex::word_from_entry(const WordEntry& entry) const {
   return vocabulary_.substr(entry.offset, entry.length);
 }
 std::string DefaultRegexIndex::word_at_index(uint32_t index) const {
-  return word_from_entry(words_[index]);
+  return word_from_entry(entry_at(index));
 }
 uint32_t DefaultRegexIndex::find_word(const std::string& word) const {
-  const uint32_t mask = word_hash_table_.size() - 1;
-  uint32_t hash = hash_word(word, 0, word.size()) & mask;
+  const size_t n = word_hash_table_.size();
+  const uint32_t index_mask = (uint64_t(1) << hash_table_index_bits_) - 1;
+  const uint64_t hash = hash_word(word.data(), word.size());
+  const uint32_t fingerprint = hash_fingerprint(hash, hash_table_index_bits_);
+  size_t slot = hash_slot(hash, n);
 
   while (true) {
-    auto index = word_hash_table_[hash];
-    if (index == UINT32_MAX)
+    const auto value = word_hash_table_[slot];
+    if (value == UINT32_MAX)
       return UINT32_MAX; // not found
 
-    // found a candidate
-    const auto entry = words_[index];
+    if ((value & ~index_mask) == fingerprint) {
+      // found a candidate
+      const uint32_t index = value & index_mask;
+      const auto entry = entry_at(index);
 
-    // compare words
-    if (entry.length == word.size() &&
-        vocabulary_.compare(entry.offset, entry.length, word) == 0) {
-      // found the given word in the vocabulary
-      return index;
+      // compare words
+      if (entry.length == word.size() &&
+          vocabulary_.compare(entry.offset, entry.length, word) == 0) {
+        // found the given word in the vocabulary
+        return index;
+      }
     }
 
     // the candidate isn't the given word
-    hash = (hash + 1) & UINT32_MAX;
+    slot = slot + 1 == n ? 0 : slot + 1;
   }
 }
 
+DefaultRegexIndex::MemoryUsage DefaultRegexIndex::memory_usage() const {
+  return {
+    .vocabulary = vocabulary_.capacity(),
+    .word_offsets = word_offsets_.memory_usage() + word_lengths_.capacity(),
+    .word_hash_table = word_hash_table_.capacity() * sizeof(uint32_t),
+    .characters = sizeof(bmp_chars_) +
+                  supplementary_chars_.capacity() * sizeof(char32_t),
+    .trigram_index = trigram_index_ ? trigram_index_->memory_usage() : 0,
+    .affix_index = (prefix_array_.capacity() + suffix_array_.capacity()) *
+                   sizeof(uint32_t),
+  };
+}
+
 
 /**
  * @brief A UTF8 encoded regex unit which describes a finite formal language.
@@ -497,7 +640,7 @@ void match_query_hash_lookup_impl(
   }
 }
 void DefaultRegexIndex::match_query_hash_lookup(
-    const RegexQuery& query, std::vector<std::string>& matches,
+    const RegexQuery& query, std::vector<uint32_t>& matches,
     uint32_t max_matches) const {
   const auto stack = finite_query_to_utf8(query);
   std::string temp_word;
@@ -513,63 +656,399 @@ void DefaultRegexIndex::match_query_hash_lookup(
   if (count) {
     // add words without duplicates
     uint32_t last_index = indexes[0];
-    matches.push_back(word_at_index(last_index));
+    matches.push_back(last_index);
     uint32_t added = 1;
     for (size_t i = 1; i < count && added < max_matches; i++) {
       const auto index = indexes[i];
       if (index != last_index) {
         last_index = index;
-        matches.push_back(word_at_index(last_index));
+        matches.push_back(last_index);
         added++;
       }
     }
   }
 }
 
-void DefaultRegexIndex::match_query_regex(
-    const RegexQuery& query, std::vector<std::string>& matches,
-    uint32_t max_matches, std::chrono::nanoseconds timeout) const {
-  // build a regex and match it against all words.
-  const boost::regex expression(create_regex_pattern(query));
-  const uint16_t min_length = query.min_utf8_input_length();
-  const uint16_t max_length = query.max_utf8_input_length();
+/**
+ * @brief Returns the number of leading units of the given query which form a
+ * literal and appends the literal to \c literal .
+ */
+size_t leading_literal(const std::vector<RegexUnit>& units,
+                       std::u32string& literal) {
+  size_t count = 0;
+  for (const auto& unit : units) {
+    if (unit.type == RegexUnit::Type::WORD ||
+        (unit.type == RegexUnit::Type::CHAR_SET && unit.value.size() == 1)) {
+      literal.append(unit.value);
+      count++;
+    } else {
+      break;
+    }
+  }
+  return count;
+}
+/**
+ * @brief Same as \c leading_literal but for the trailing units.
+ */
+size_t trailing_literal(const std::vector<RegexUnit>& units,
+                        std::u32string& literal) {
+  size_t count = 0;
+  for (auto it = units.rbegin(); it != units.rend(); it++) {
+    const auto& unit = *it;
+    if (unit.type == RegexUnit::Type::WORD ||
+        (unit.type == RegexUnit::Type::CHAR_SET && unit.value.size() == 1)) {
+      literal.insert(0, unit.value);
+      count++;
+    } else {
+      break;
+    }
+  }
+  return count;
+}
 
-  const auto start = std::chrono::steady_clock::now();
-  uint32_t matches_added = 0;
-  for (size_t i = 0; i < words_.size(); i++) {
-    const auto entry = words_[i];
+bool DefaultRegexIndex::find_affix_range(const RegexQuery& query,
+                                         affix_range& range) const {
+  if (prefix_array_.empty()) {
+    return false;
+  }
+
+  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
+  const auto& units = query.get_units();
+  const char* data = vocabulary_.data();
+  bool found = false;
+
+  std::u32string prefix;
+  const size_t prefix_units = leading_literal(units, prefix);
+  if (!prefix.empty()) {
+    const std::string p = conv.to_bytes(prefix);
+    // compare only the first p.size() bytes of each word
+    const auto begin = std::lower_bound(
+        prefix_array_.begin(), prefix_array_.end(), p,
+        [&](uint32_t index, const std::string& key) {
+          const auto e = entry_at(index);
+          return compare_bytes(data + e.offset, e.length, key.data(),
+                               key.size()) < 0;
+        });
+    const auto end = std::upper_bound(
+        begin, prefix_array_.cend(), p,
+        [&](const std::string& key, uint32_t index) {
+          const auto e = entry_at(index);
+          const size_t length = std::min((size_t)e.length, key.size());
+          return compare_bytes(key.data(), key.size(), data + e.offset,
+                               length) < 0;
+        });
+    range = { begin, end,
+              prefix_units + 1 == units.size() &&
+                  units.back().type == RegexUnit::Type::STAR };
+    found = true;
+  }
+
+  std::u32string suffix;
+  const size_t suffix_units = trailing_literal(units, suffix);
+  if (!suffix.empty()) {
+    const std::string s = conv.to_bytes(suffix);
+    const auto begin = std::lower_bound(
+        suffix_array_.begin(), suffix_array_.end(), s,
+        [&](uint32_t index, const std::string& key) {
+          const auto e = entry_at(index);
+          return compare_reversed_bytes(data + e.offset, e.length, key.data(),
+                                        key.size()) < 0;
+        });
+    const auto end = std::upper_bound(
+        begin, suffix_array_.cend(), s,
+        [&](const std::string& key, uint32_t index) {
+          const auto e = entry_at(index);
+          const size_t length = std::min((size_t)e.length, key.size());
+          return compare_reversed_bytes(key.data(), key.size(),
+                                        data + e.offset + e.length - length,
+                                        length) < 0;
+        });
+    const bool exact = suffix_units + 1 == units.size() &&
+                       units.front().type == RegexUnit::Type::STAR;
+    if (!found || (size_t)(end - begin) < range.size()) {
+      range = { begin, end, exact };
+    }
+    found = true;
+  }
+
+  return found;
+}
+
+bool DefaultRegexIndex::match_query_affix_range(
+    const RegexQuery& query, const affix_range& range,
+    std::vector<uint32_t>& matches, uint32_t max_matches,
+    std::chrono::nanoseconds timeout) const {
+  if (range.exact) {
+    // all words in the range are matches, so we just need the top-k
+    const size_t offset = matches.size();
+    matches.resize(offset + std::min((size_t)max_matches, range.size()));
+    std::partial_sort_copy(range.begin, range.end, matches.begin() + offset,
+                           matches.end());
+    return true;
+  }
 
-    if (entry.length < min_length || entry.length > max_length) {
-      // we can reject this word based on length alone
-      continue;
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  const RegexMatcher matcher(query);
+
+  std::vector<uint32_t> candidates(range.begin, range.end);
+  std::sort(candidates.begin(), candidates.end());
+
+  uint32_t matches_added = 0;
+  for (size_t i = 0; i < candidates.size() && matches_added < max_matches;
+       i++) {
+    // check the time every now and then
+    if (i % 256 == 255 && std::chrono::steady_clock::now() > deadline) {
+      return false;
     }
 
-    const auto begin = vocabulary_.begin() + entry.offset;
-    const auto end = vocabulary_.begin() + (entry.offset + entry.length);
-    if (boost::regex_match(begin, end, expression)) {
-      // found a match
-      matches.push_back(word_from_entry(entry));
+    const auto entry = entry_at(candidates[i]);
+    if (matcher.match(vocabulary_.data() + entry.offset, entry.length)) {
+      matches.push_back(candidates[i]);
       matches_added++;
-      if (matches_added >= max_matches)
-        break; // done
     }
+  }
+  return true;
+}
 
+/**
+ * @brief The candidates of the trigram index or a range of the prefix/suffix
+ * arrays will only be verified if their number is at most the number of words
+ * divided by this value. Otherwise, a scan is used.
+ */
+const size_t MAX_CANDIDATES_DIVISOR = 16;
+
+bool DefaultRegexIndex::match_query_candidates(
+    const RegexQuery& query, TrigramIndex::Candidates& candidates,
+    std::vector<uint32_t>& matches, uint32_t max_matches,
+    std::chrono::nanoseconds timeout) const {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  const RegexMatcher matcher(query);
+
+  uint32_t matches_added = 0;
+  uint32_t checked = 0;
+  uint32_t index;
+  while (matches_added < max_matches && candidates.next(index)) {
     // check the time every now and then
-    if (i % 256 == 0) {
-      if ((std::chrono::steady_clock::now() - start) > timeout)
-        break; // timeout
+    if (++checked % 256 == 0 && std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+
+    const auto entry = entry_at(index);
+    if (matcher.match(vocabulary_.data() + entry.offset, entry.length)) {
+      matches.push_back(index);
+      matches_added++;
     }
   }
+  return true;
 }
 
+/**
+ * @brief The number of words per chunk of a chunked regex scan.
+ *
+ * Smaller chunks allow the scan to stop sooner after enough matches have been
+ * found while larger chunks reduce the synchronization overhead.
+ */
+const size_t REGEX_SCAN_CHUNK_SIZE = 1 << 14;
 
-void DefaultRegexIndex::match_query(const RegexQuery& query,
-                                    std::vector<std::string>& matches,
-                                    uint32_t max_matches,
-                                    std::chrono::nanoseconds timeout) const {
+/**
+ * @brief The shared state of a single chunked regex scan.
+ *
+ * The state is shared between the searching thread and all helper threads.
+ * Helper threads might start only after the searching thread is done, so the
+ * state owns everything it needs.
+ */
+struct DefaultRegexIndex::chunked_scan {
+  enum class ChunkState : uint8_t { PENDING, PARTIAL, COMPLETE };
+
+  const RegexMatcher matcher;
+  const uint32_t max_matches;
+  const std::chrono::steady_clock::time_point deadline;
+  const size_t chunk_count;
+
+  /**
+   * @brief The indexes of all matches of each chunk.
+   *
+   * Each chunk is only written to by the thread that claimed it.
+   */
+  std::vector<std::vector<uint32_t>> chunk_matches;
+  std::vector<ChunkState> chunk_states;
+
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  std::atomic<bool> stopped;
+  /**
+   * @brief The index of the next chunk to be claimed.
+   */
+  size_t next_chunk = 0;
+  /**
+   * @brief The number of chunks that have been claimed but not finished.
+   */
+  size_t running = 0;
+  /**
+   * @brief The chunks [0, confirmed) have been scanned completely.
+   */
+  size_t confirmed = 0;
+  /**
+   * @brief The number of matches of all confirmed chunks.
+   */
+  size_t confirmed_matches = 0;
+
+  chunked_scan(const RegexQuery& query, uint32_t max_matches,
+               std::chrono::steady_clock::time_point deadline,
+               size_t chunk_count)
+      : matcher(query),
+        max_matches(max_matches),
+        deadline(deadline),
+        chunk_count(chunk_count),
+        chunk_matches(chunk_count),
+        chunk_states(chunk_count, ChunkState::PENDING),
+        stopped(false) {}
+};
+
+void DefaultRegexIndex::scan_chunks(chunked_scan& scan) const {
+  while (true) {
+    size_t chunk;
+    {
+      std::lock_guard<std::mutex> lock(scan.mutex);
+      if (scan.stopped || scan.next_chunk >= scan.chunk_count) {
+        return;
+      }
+      chunk = scan.next_chunk++;
+      scan.running++;
+    }
+
+    // scan the chunk
+    auto& matches = scan.chunk_matches[chunk];
+    bool complete = true;
+    const size_t begin_index = chunk * REGEX_SCAN_CHUNK_SIZE;
+    const size_t end_index =
+        std::min(begin_index + REGEX_SCAN_CHUNK_SIZE, word_count_);
+    // Every word is followed by exactly one \n, so only the offset of the
+    // first word has to be decoded. All other words follow from the lengths.
+    const char* next_word = vocabulary_.data() + word_offsets_[begin_index];
+    for (size_t i = begin_index; i < end_index; i++) {
+      const char* word = next_word;
+      const size_t length = word_length(i);
+      next_word = word + length + 1;
+
+      // check the time and whether the scan was stopped every now and then
+      if (i % 256 == 0) {
+        if (scan.stopped ||
+            std::chrono::steady_clock::now() > scan.deadline) {
+          complete = false;
+          break;
+        }
+      }
+
+      if (scan.matcher.match(word, length)) {
+        // found a match
+        matches.push_back(i);
+        if (matches.size() >= scan.max_matches) {
+          // the rest of this chunk cannot contribute to the result
+          break;
+        }
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(scan.mutex);
+      scan.running--;
+      if (complete) {
+        scan.chunk_states[chunk] = chunked_scan::ChunkState::COMPLETE;
+
+        // extend the confirmed prefix of chunks
+        while (scan.confirmed < scan.chunk_count &&
+               scan.chunk_states[scan.confirmed] ==
+                   chunked_scan::ChunkState::COMPLETE) {
+          scan.confirmed_matches += scan.chunk_matches[scan.confirmed].size();
+          scan.confirmed++;
+        }
+        if (scan.confirmed_matches >= scan.max_matches) {
+          scan.stopped = true; // done
+        }
+      } else {
+        scan.chunk_states[chunk] = chunked_scan::ChunkState::PARTIAL;
+        scan.stopped = true; // timeout (or stopped by another thread)
+      }
+    }
+    scan.done_cv.notify_all();
+  }
+}
+
+bool DefaultRegexIndex::match_query_regex(
+    const RegexQuery& query, std::vector<uint32_t>& matches,
+    uint32_t max_matches, std::chrono::nanoseconds timeout) const {
+  affix_range range;
+  if (find_affix_range(query, range) &&
+      (range.exact ||
+       range.size() <= word_count_ / MAX_CANDIDATES_DIVISOR)) {
+    return match_query_affix_range(query, range, matches, max_matches,
+                                   timeout);
+  }
+
+  if (trigram_index_) {
+    const auto trigrams = TrigramIndex::required_trigrams(query);
+    if (!trigrams.empty()) {
+      auto candidates = trigram_index_->candidates(trigrams);
+      if (candidates.estimate() <=
+          word_count_ / MAX_CANDIDATES_DIVISOR) {
+        return match_query_candidates(query, candidates, matches,
+                                      max_matches, timeout);
+      }
+    }
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  const size_t chunk_count =
+      (word_count_ + REGEX_SCAN_CHUNK_SIZE - 1) / REGEX_SCAN_CHUNK_SIZE;
+
+  // compile the query and match it against all words.
+  const auto scan =
+      std::make_shared<chunked_scan>(query, max_matches, deadline, chunk_count);
+
+  if (scan_pool_ && chunk_count > 1) {
+    const size_t helpers = std::min(scan_pool_->size(), chunk_count - 1);
+    for (size_t i = 0; i < helpers; i++) {
+      scan_pool_->execute([this, scan]() { scan_chunks(*scan); });
+    }
+  }
+  scan_chunks(*scan);
+
+  {
+    // wait for all claimed chunks to be finished and prevent helper threads
+    // which haven't started yet from claiming new chunks
+    std::unique_lock<std::mutex> lock(scan->mutex);
+    scan->done_cv.wait(lock, [&]() { return scan->running == 0; });
+    scan->stopped = true;
+  }
+
+  // concatenate the matches of the longest prefix of scanned chunks
+  uint32_t matches_added = 0;
+  for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+    for (const auto index : scan->chunk_matches[chunk]) {
+      matches.push_back(index);
+      matches_added++;
+      if (matches_added >= max_matches) {
+        // done, no matter the state of this chunk and all later ones
+        return true;
+      }
+    }
+    if (scan->chunk_states[chunk] != chunked_scan::ChunkState::COMPLETE) {
+      // Later chunks may have matches but we didn't scan this chunk
+      // completely, so this is where the scanned prefix ends.
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool DefaultRegexIndex::match_query_indexes(
+    const RegexQuery& query, std::vector<uint32_t>& matches,
+    uint32_t max_matches, std::chrono::nanoseconds timeout) const {
   // no matches are required
   if (max_matches == 0) {
-    return;
+    return true;
   }
 
   const RegexQuery& q = optimize_query(query);
@@ -578,16 +1057,16 @@ void DefaultRegexIndex::match_query(const RegexQuery& query,
     // the query will match all words
     // Note: Technically, the empty word may be part of the index, but that's
     // unlikely because it doesn't make sense in the context of Netspeak.
-    uint32_t to_add = std::min(max_matches, (uint32_t)words_.size());
+    uint32_t to_add = std::min(max_matches, (uint32_t)word_count_);
     for (uint32_t i = 0; i < to_add; i++) {
-      matches.push_back(word_at_index(i));
+      matches.push_back(i);
     }
-    return;
+    return true;
   }
 
   if (query.reject_all()) {
     // if the query will reject all words anyway, so there's nothing to do.
-    return;
+    return true;
   }
 
   if (q.combinations_upper_bound() < 1000) {
@@ -595,11 +1074,11 @@ void DefaultRegexIndex::match_query(const RegexQuery& query,
     // We can reasonably assume that we're going to be faster than any
     // timeout, so we will just ignore it.
     match_query_hash_lookup(query, matches, max_matches);
-    return;
+    return true;
   }
 
   // do regex matching
-  match_query_regex(query, matches, max_matches, timeout);
+  return match_query_regex(query, matches, max_matches, timeout);
 }
 
 } // namespace regex
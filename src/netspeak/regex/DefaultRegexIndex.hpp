@@ -1,17 +1,19 @@
 #ifndef NETSPEAK_REGEX_DEFAULT_REGEX_INDEX_HPP
 #define NETSPEAK_REGEX_DEFAULT_REGEX_INDEX_HPP
 
+#include <bitset>
 #include <chrono>
 #include <codecvt>
 #include <locale>
+#include <memory>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
-#include <boost/regex.hpp>
-
 #include "netspeak/regex/RegexIndex.hpp"
 #include "netspeak/regex/RegexQuery.hpp"
+#include "netspeak/regex/TrigramIndex.hpp"
+#include "netspeak/util/EliasFano.hpp"
+#include "netspeak/util/ThreadPool.hpp"
 
 
 namespace netspeak {
@@ -21,7 +23,45 @@ class DefaultRegexIndex : public RegexIndex {
 public: // types
   struct WordEntry {
     uint32_t offset;
-    uint16_t length;
+    uint32_t length;
+  };
+
+  /**
+   * @brief The number of bytes used by each component of the index.
+   */
+  struct MemoryUsage {
+    size_t vocabulary;
+    size_t word_offsets;
+    size_t word_hash_table;
+    size_t characters;
+    size_t trigram_index;
+    size_t affix_index;
+  };
+
+  struct InitConfig {
+    /**
+     * @brief The maximum number of threads used to match a single regex query
+     * against the vocabulary.
+     *
+     * This includes the thread calling \c match_query , so a value of 0 or 1
+     * means that the vocabulary will be scanned by the calling thread alone.
+     */
+    size_t threads = 1;
+    /**
+     * @brief Whether to build a trigram index over the vocabulary.
+     *
+     * The trigram index speeds up queries with long literals (e.g. `*tion`)
+     * considerably but needs about as much memory as the vocabulary itself.
+     */
+    bool trigram_index = false;
+    /**
+     * @brief Whether to build sorted prefix and suffix arrays over the
+     * vocabulary.
+     *
+     * These make queries with a literal prefix or suffix (e.g. `inform*` or
+     * `*ization`) a lot faster and need 8 bytes per word.
+     */
+    bool affix_index = false;
   };
 
 private: // state
@@ -30,24 +70,105 @@ private: // state
    */
   std::string vocabulary_;
   /**
-   * @brief A list of entries of every word in \c vocabulary .
+   * @brief The offsets of all words in \c vocabulary_ followed by the size of
+   * \c vocabulary_ .
+   *
+   * Every word is followed by exactly one \c \n , so the length of a word is
+   * the difference of its offset and the next offset minus 1.
+   */
+  util::EliasFano word_offsets_;
+  /**
+   * @brief The length of every word or \c LONG_WORD_LENGTH if the word is
+   * that long or longer.
+   *
+   * Scans walk through the vocabulary with these lengths because that's
+   * faster than decoding the offsets of all words.
    */
-  std::vector<struct WordEntry> words_;
+  std::vector<uint8_t> word_lengths_;
+  static const uint8_t LONG_WORD_LENGTH = UINT8_MAX;
+  size_t word_count_ = 0;
   /**
-   * @brief A set of all characters in the vocabulary.
+   * @brief All characters of the Basic Multilingual Plane in the vocabulary.
    */
-  std::unordered_set<char32_t> all_chars_;
+  std::bitset<0x10000> bmp_chars_;
+  /**
+   * @brief All other characters in the vocabulary in ascending order.
+   */
+  std::vector<char32_t> supplementary_chars_;
   /**
    * @brief A hash table containing all words.
+   *
+   * Each slot contains the index of a word in its lower
+   * \c hash_table_index_bits_ bits and a fingerprint of the hash of the word in
+   * its remaining upper bits.
    */
   std::vector<uint32_t> word_hash_table_;
+  uint32_t hash_table_index_bits_ = 0;
+  /**
+   * @brief An inverted index from trigrams to words.
+   *
+   * This is \c nullptr if the index was not requested.
+   */
+  std::unique_ptr<TrigramIndex> trigram_index_;
+  /**
+   * @brief The indexes of all words sorted by the words.
+   *
+   * This is empty if the affix index was not requested.
+   */
+  std::vector<uint32_t> prefix_array_;
+  /**
+   * @brief The indexes of all words sorted by the reversed words.
+   *
+   * This is empty if the affix index was not requested.
+   */
+  std::vector<uint32_t> suffix_array_;
+  /**
+   * @brief The worker threads used to scan the word list in parallel.
+   *
+   * This is \c nullptr if the index is single-threaded. It has to be the last
+   * member, so that the pool is destroyed (and all of its tasks are finished)
+   * before any of the data its tasks use.
+   */
+  std::unique_ptr<util::ThreadPool> scan_pool_;
 
 private: // initialization functions
-  void initialize_words();
-  void initialize_all_chars();
-  void initialize_word_hash_table();
+  /**
+   * @brief Removes all empty lines from the vocabulary and initializes the word
+   * offsets.
+   *
+   * The returned list of words is only needed during construction.
+   */
+  std::vector<WordEntry> initialize_words();
+  void initialize_all_chars(const std::vector<WordEntry>& words);
+  void initialize_word_hash_table(const std::vector<WordEntry>& words);
+  void initialize_trigram_index(const std::vector<WordEntry>& words);
+  void initialize_prefix_array(const std::vector<WordEntry>& words);
+  void initialize_suffix_array(const std::vector<WordEntry>& words);
 
 private: // functions
+  /**
+   * @brief Returns the entry of the word at the given index in the word list.
+   */
+  WordEntry entry_at(uint32_t index) const {
+    return { (uint32_t)word_offsets_[index], (uint32_t)word_length(index) };
+  }
+  /**
+   * @brief Returns the length of the word at the given index in the word list.
+   */
+  size_t word_length(uint32_t index) const {
+    const uint8_t length = word_lengths_[index];
+    if (length != LONG_WORD_LENGTH) {
+      return length;
+    }
+    return word_offsets_[index + 1] - word_offsets_[index] - 1;
+  }
+
+  /**
+   * @brief Returns whether the given character is part of the vocabulary.
+   */
+  bool is_known_char(char32_t c) const;
+  bool contains_unknown_characters(const std::u32string& str) const;
+
   /**
    * @brief Returns the word string from the given entry.
    *
@@ -55,15 +176,6 @@ private: // functions
    * @return std::string
    */
   std::string word_from_entry(const WordEntry& entry) const;
-  /**
-   * @brief Returns the word at the given index in the word list.
-   *
-   * 0 will returns the first word, 1 the second, and so on.
-   *
-   * @param index
-   * @return std::string
-   */
-  std::string word_at_index(uint32_t index) const;
 
   /**
    * @brief Returns the index of the given word or \c UINT32_MAX if the given
@@ -84,14 +196,54 @@ private: // functions
   RegexQuery optimize_query(const RegexQuery& query) const;
 
   void match_query_hash_lookup(const RegexQuery& query,
-                               std::vector<std::string>& matches,
+                               std::vector<uint32_t>& matches,
                                uint32_t max_matches) const;
 
-  void match_query_regex(const RegexQuery& query,
-                         std::vector<std::string>& matches,
-                         uint32_t max_matches,
+  bool match_query_regex(const RegexQuery& query,
+                         std::vector<uint32_t>& matches, uint32_t max_matches,
                          std::chrono::nanoseconds timeout) const;
 
+  struct affix_range {
+    std::vector<uint32_t>::const_iterator begin;
+    std::vector<uint32_t>::const_iterator end;
+    /**
+     * @brief Whether all words in the range are matches of the query.
+     */
+    bool exact;
+
+    size_t size() const {
+      return end - begin;
+    }
+  };
+  /**
+   * @brief Returns the smallest range of the prefix or suffix array containing
+   * all words that might match the given query.
+   *
+   * This returns \c false if the query has neither a literal prefix nor a
+   * literal suffix or if there is no affix index.
+   */
+  bool find_affix_range(const RegexQuery& query, affix_range& range) const;
+  bool match_query_affix_range(const RegexQuery& query,
+                               const affix_range& range,
+                               std::vector<uint32_t>& matches,
+                               uint32_t max_matches,
+                               std::chrono::nanoseconds timeout) const;
+
+  bool match_query_candidates(const RegexQuery& query,
+                              TrigramIndex::Candidates& candidates,
+                              std::vector<uint32_t>& matches,
+                              uint32_t max_matches,
+                              std::chrono::nanoseconds timeout) const;
+
+  struct chunked_scan;
+  /**
+   * @brief Claims and scans chunks of the word list until there are no chunks
+   * left or the scan was stopped.
+   *
+   * This is called by the searching thread and by all helper threads.
+   */
+  void scan_chunks(chunked_scan& scan) const;
+
 public:
   /**
    * @brief Construct a new Regex Index object.
@@ -102,6 +254,7 @@ public:
    * @param vocabulary The by \c \n separated words to search in.
    */
   DefaultRegexIndex(std::string vocabulary);
+  DefaultRegexIndex(std::string vocabulary, InitConfig config);
   DefaultRegexIndex(const DefaultRegexIndex&) = delete;
   ~DefaultRegexIndex() override{};
 
@@ -110,17 +263,32 @@ public:
   }
 
   /**
-   * @brief Adds all words matching the given query to the given vector.
+   * @brief Returns the trigram index or \c nullptr if the index doesn't have
+   * one.
+   */
+  const TrigramIndex* trigram_index() const {
+    return trigram_index_.get();
+  }
+
+  /**
+   * @brief Returns the number of bytes used by the components of the index.
+   */
+  MemoryUsage memory_usage() const;
+
+  /**
+   * @brief Returns the word at the given index in the word list.
+   *
+   * 0 will returns the first word, 1 the second, and so on.
    *
-   * @param query The query which will be used to match words.
-   * @param matches The vector to which the matches will be added.
-   * @param max_matches The maximum number of words to add to \c matches
-   * @param timeout The amount of time after which the search for more words
-   * will be aborted.
+   * @param index
+   * @return std::string
    */
-  void match_query(const RegexQuery& query, std::vector<std::string>& matches,
-                   uint32_t max_matches,
-                   std::chrono::nanoseconds timeout) const override;
+  std::string word_at_index(uint32_t index) const override;
+
+  bool match_query_indexes(const RegexQuery& query,
+                           std::vector<uint32_t>& matches,
+                           uint32_t max_matches,
+                           std::chrono::nanoseconds timeout) const override;
 };
 
 } // namespace regex
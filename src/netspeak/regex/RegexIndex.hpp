@@ -15,6 +15,32 @@ class RegexIndex {
 public:
   virtual ~RegexIndex() {}
 
+  /**
+   * @brief Adds the indexes of all words matching the given query to the given
+   * vector.
+   *
+   * The indexes are added in ascending order, so the matches of a smaller
+   * \c max_matches are always a prefix of the matches of a larger one.
+   *
+   * @param query The query which will be used to match words.
+   * @param matches The vector to which the indexes of the matches will be
+   * added.
+   * @param max_matches The maximum number of indexes to add to \c matches
+   * @param timeout The amount of time after which the search for more words
+   * will be aborted.
+   * @return \c false if the search was aborted because of the timeout and
+   * \c true otherwise.
+   */
+  virtual bool match_query_indexes(const RegexQuery& query,
+                                   std::vector<uint32_t>& matches,
+                                   uint32_t max_matches,
+                                   std::chrono::nanoseconds timeout) const = 0;
+
+  /**
+   * @brief Returns the word at the given index.
+   */
+  virtual std::string word_at_index(uint32_t index) const = 0;
+
   /**
    * @brief Adds all words matching the given query to the given vector.
    *
@@ -24,10 +50,15 @@ public:
    * @param timeout The amount of time after which the search for more words
    * will be aborted.
    */
-  virtual void match_query(const RegexQuery& query,
-                           std::vector<std::string>& matches,
-                           uint32_t max_matches,
-                           std::chrono::nanoseconds timeout) const = 0;
+  void match_query(const RegexQuery& query, std::vector<std::string>& matches,
+                   uint32_t max_matches,
+                   std::chrono::nanoseconds timeout) const {
+    std::vector<uint32_t> indexes;
+    match_query_indexes(query, indexes, max_matches, timeout);
+    for (const auto index : indexes) {
+      matches.push_back(word_at_index(index));
+    }
+  }
 };
 
 } // namespace regex
@@ -0,0 +1,386 @@
+#include "netspeak/regex/RegexMatcher.hpp"
+
+#include <algorithm>
+#include <codecvt>
+#include <cstring>
+#include <locale>
+
+
+namespace netspeak {
+namespace regex {
+
+/*
+ * # Why not a general regex engine?
+ *
+ * Regex queries only have 5 types of units, so a general regex engine is
+ * overkill. Worse, a `?` has to be expressed as a large alternation of UTF-8
+ * byte sequences which general engines don't handle well.
+ *
+ * # Matching
+ *
+ * A query `S0*S1*...*Sk` (each Si doesn't contain stars) accepts a word iff
+ * the word can be split into `S0`, anything, `S1`, anything, ..., `Sk`. Since a
+ * star can absorb anything, it's always best to end each segment `Si` (i < k)
+ * as early as possible. This means that we only have to find the minimum end
+ * of each segment after the (minimum) end of the previous one. No backtracking
+ * across stars is necessary, so the time it takes to match a word is linear in
+ * the length of the word times the number of segments.
+ *
+ * The only units which can cause a segment to match in more than one way are
+ * optional words. These are rare and short, so they are handled by simple
+ * recursion.
+ *
+ * # UTF-8
+ *
+ * The matcher works on bytes. All units consume whole UTF-8 characters and
+ * segments are only tried at character boundaries, so a match can never start
+ * or end in the middle of a character.
+ */
+
+const size_t NO_MATCH = SIZE_MAX;
+
+inline bool is_continuation_byte(char c) {
+  return (static_cast<uint8_t>(c) & 0xC0) == 0x80;
+}
+
+inline size_t utf8_char_length(char lead) {
+  const uint8_t c = static_cast<uint8_t>(lead);
+  if (c < 0x80)
+    return 1;
+  if (c < 0xC0)
+    return 0; // continuation byte
+  if (c < 0xE0)
+    return 2;
+  if (c < 0xF0)
+    return 3;
+  return 4;
+}
+
+inline char32_t decode_utf8_char(const char* bytes, size_t length) {
+  const uint8_t lead = static_cast<uint8_t>(bytes[0]);
+  char32_t c;
+  switch (length) {
+    case 2:
+      c = lead & 0x1F;
+      break;
+    case 3:
+      c = lead & 0x0F;
+      break;
+    default:
+      c = lead & 0x07;
+      break;
+  }
+  for (size_t i = 1; i < length; i++) {
+    c = (c << 6) | (static_cast<uint8_t>(bytes[i]) & 0x3F);
+  }
+  return c;
+}
+
+/**
+ * @brief Returns the position of the first occurrence of \c literal in
+ * \c word[from..length) or \c NO_MATCH .
+ */
+inline size_t find_literal(const std::string& literal, const char* word,
+                           size_t length, size_t from) {
+  if (from + literal.size() > length) {
+    return NO_MATCH;
+  }
+  const void* found;
+  if (literal.size() == 1) {
+    found = std::memchr(word + from, literal.front(), length - from);
+  } else {
+    found = memmem(word + from, length - from, literal.data(), literal.size());
+  }
+  if (found == nullptr) {
+    return NO_MATCH;
+  }
+  return static_cast<const char*>(found) - word;
+}
+
+
+RegexMatcher::RegexMatcher(const RegexQuery& query)
+    : segments_(1),
+      min_length_(query.min_utf8_input_length()),
+      max_length_(query.max_utf8_input_length()),
+      reject_all_(query.reject_all()) {
+  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
+
+  for (const auto& unit : query.get_units()) {
+    auto& atoms = segments_.back().atoms;
+
+    switch (unit.type) {
+      case RegexUnit::Type::STAR:
+        segments_.emplace_back();
+        break;
+
+      case RegexUnit::Type::QMARK: {
+        Atom atom;
+        atom.type = Atom::Type::ANY_CHAR;
+        atoms.push_back(std::move(atom));
+        break;
+      }
+
+      case RegexUnit::Type::OPTIONAL_WORD: {
+        if (unit.value.empty()) {
+          break; // matches the empty word only
+        }
+        Atom atom;
+        atom.type = Atom::Type::OPTIONAL_LITERAL;
+        atom.literal = conv.to_bytes(unit.value);
+        atoms.push_back(std::move(atom));
+        break;
+      }
+
+      case RegexUnit::Type::CHAR_SET:
+        if (unit.value.size() != 1) {
+          Atom atom;
+          atom.type = Atom::Type::CHAR_SET;
+          for (const auto c : unit.value) {
+            if (c < 128) {
+              atom.ascii.set(c);
+            } else {
+              atom.non_ascii.push_back(c);
+            }
+          }
+          std::sort(atom.non_ascii.begin(), atom.non_ascii.end());
+          atoms.push_back(std::move(atom));
+          break;
+        }
+        // a character set with only one character is a literal
+        [[fallthrough]];
+
+      case RegexUnit::Type::WORD: {
+        const auto bytes = conv.to_bytes(unit.value);
+        if (bytes.empty()) {
+          break;
+        }
+        if (!atoms.empty() && atoms.back().type == Atom::Type::LITERAL) {
+          // merge consecutive literals
+          atoms.back().literal.append(bytes);
+        } else {
+          Atom atom;
+          atom.type = Atom::Type::LITERAL;
+          atom.literal = bytes;
+          atoms.push_back(std::move(atom));
+        }
+        break;
+      }
+    }
+  }
+
+  for (auto& segment : segments_) {
+    for (const auto& atom : segment.atoms) {
+      switch (atom.type) {
+        case Atom::Type::LITERAL:
+          segment.min_length += atom.literal.size();
+          segment.max_length += atom.literal.size();
+          break;
+        case Atom::Type::OPTIONAL_LITERAL:
+          segment.max_length += atom.literal.size();
+          break;
+        default:
+          segment.min_length += 1;
+          segment.max_length += 4;
+          break;
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Returns the end of the match of the given (non-optional) atom at the
+ * given position or \c NO_MATCH .
+ */
+size_t RegexMatcher::match_atom(const Atom& atom, const char* word,
+                                size_t length, size_t pos) {
+  switch (atom.type) {
+    case Atom::Type::LITERAL: {
+      const auto size = atom.literal.size();
+      if (pos + size <= length &&
+          std::memcmp(word + pos, atom.literal.data(), size) == 0) {
+        return pos + size;
+      }
+      return NO_MATCH;
+    }
+
+    case Atom::Type::ANY_CHAR: {
+      if (pos >= length) {
+        return NO_MATCH;
+      }
+      const auto char_length = utf8_char_length(word[pos]);
+      if (char_length == 0 || pos + char_length > length) {
+        return NO_MATCH;
+      }
+      return pos + char_length;
+    }
+
+    case Atom::Type::CHAR_SET: {
+      if (pos >= length) {
+        return NO_MATCH;
+      }
+      const auto char_length = utf8_char_length(word[pos]);
+      if (char_length == 1) {
+        return atom.ascii.test(static_cast<uint8_t>(word[pos])) ? pos + 1
+                                                                 : NO_MATCH;
+      }
+      if (char_length == 0 || pos + char_length > length) {
+        return NO_MATCH;
+      }
+      const char32_t c = decode_utf8_char(word + pos, char_length);
+      if (std::binary_search(atom.non_ascii.begin(), atom.non_ascii.end(),
+                             c)) {
+        return pos + char_length;
+      }
+      return NO_MATCH;
+    }
+
+    default:
+      return NO_MATCH;
+  }
+}
+
+/**
+ * @brief Returns the minimum end of all matches of the atoms
+ * \c [atom, segment.atoms.size()) of the given segment starting at \c pos or
+ * \c NO_MATCH .
+ */
+size_t RegexMatcher::min_end(const Segment& segment, size_t atom,
+                             const char* word, size_t length, size_t pos) {
+  for (; atom < segment.atoms.size(); atom++) {
+    const auto& a = segment.atoms[atom];
+    if (a.type == Atom::Type::OPTIONAL_LITERAL) {
+      const size_t without = min_end(segment, atom + 1, word, length, pos);
+      const auto size = a.literal.size();
+      if (pos + size <= length &&
+          std::memcmp(word + pos, a.literal.data(), size) == 0) {
+        const size_t with =
+            min_end(segment, atom + 1, word, length, pos + size);
+        return std::min(without, with);
+      }
+      return without;
+    }
+
+    pos = match_atom(a, word, length, pos);
+    if (pos == NO_MATCH) {
+      return NO_MATCH;
+    }
+  }
+  return pos;
+}
+
+/**
+ * @brief Returns whether the atoms \c [atom, segment.atoms.size()) of the given
+ * segment match \c word[pos..length) exactly.
+ */
+bool RegexMatcher::ends_at_end(const Segment& segment, size_t atom,
+                               const char* word, size_t length, size_t pos) {
+  for (; atom < segment.atoms.size(); atom++) {
+    const auto& a = segment.atoms[atom];
+    if (a.type == Atom::Type::OPTIONAL_LITERAL) {
+      if (ends_at_end(segment, atom + 1, word, length, pos)) {
+        return true;
+      }
+      const auto size = a.literal.size();
+      return pos + size <= length &&
+             std::memcmp(word + pos, a.literal.data(), size) == 0 &&
+             ends_at_end(segment, atom + 1, word, length, pos + size);
+    }
+
+    pos = match_atom(a, word, length, pos);
+    if (pos == NO_MATCH) {
+      return false;
+    }
+  }
+  return pos == length;
+}
+
+/**
+ * @brief Returns the minimum end of all matches of the given segment starting
+ * at or after \c from or \c NO_MATCH .
+ */
+size_t RegexMatcher::find_min_end(const Segment& segment, const char* word,
+                                  size_t length, size_t from) {
+  size_t best = NO_MATCH;
+  size_t start = from;
+  while (start + segment.min_length <= std::min(length, best - 1)) {
+    if (segment.starts_with_literal()) {
+      // jump to the next occurrence of the literal
+      start = find_literal(segment.atoms.front().literal, word, length, start);
+      if (start == NO_MATCH || start + segment.min_length >= best) {
+        break;
+      }
+    } else if (start < length && is_continuation_byte(word[start])) {
+      start++;
+      continue;
+    }
+
+    best = std::min(best, min_end(segment, 0, word, length, start));
+    start++;
+  }
+  return best;
+}
+
+/**
+ * @brief Returns whether the given segment matches a suffix of the word which
+ * starts at or after \c from .
+ */
+bool RegexMatcher::find_suffix(const Segment& segment, const char* word,
+                               size_t length, size_t from) {
+  if (length < from + segment.min_length) {
+    return false;
+  }
+  size_t start = length - segment.min_length;
+  const size_t first = length >= from + segment.max_length
+                           ? length - segment.max_length
+                           : from;
+  while (true) {
+    if (start == length || !is_continuation_byte(word[start])) {
+      if (ends_at_end(segment, 0, word, length, start)) {
+        return true;
+      }
+    }
+    if (start == first) {
+      return false;
+    }
+    start--;
+  }
+}
+
+
+bool RegexMatcher::match(const char* word, size_t length) const {
+  if (reject_all_ || length < min_length_ || length > max_length_) {
+    return false;
+  }
+
+  const auto& first = segments_.front();
+  const auto& last = segments_.back();
+
+  // cheap checks for literal prefixes and suffixes
+  if (first.starts_with_literal()) {
+    const auto& literal = first.atoms.front().literal;
+    if (std::memcmp(word, literal.data(), literal.size()) != 0) {
+      return false;
+    }
+  }
+  if (last.ends_with_literal()) {
+    const auto& literal = last.atoms.back().literal;
+    if (std::memcmp(word + length - literal.size(), literal.data(),
+                    literal.size()) != 0) {
+      return false;
+    }
+  }
+
+  if (segments_.size() == 1) {
+    return ends_at_end(first, 0, word, length, 0);
+  }
+
+  size_t pos = min_end(first, 0, word, length, 0);
+  for (size_t i = 1; pos != NO_MATCH && i < segments_.size() - 1; i++) {
+    pos = find_min_end(segments_[i], word, length, pos);
+  }
+  return pos != NO_MATCH && find_suffix(last, word, length, pos);
+}
+
+} // namespace regex
+} // namespace netspeak
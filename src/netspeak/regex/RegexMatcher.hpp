@@ -0,0 +1,117 @@
+#ifndef NETSPEAK_REGEX_REGEX_MATCHER_HPP
+#define NETSPEAK_REGEX_REGEX_MATCHER_HPP
+
+#include <bitset>
+#include <string>
+#include <vector>
+
+#include "netspeak/regex/RegexQuery.hpp"
+
+
+namespace netspeak {
+namespace regex {
+
+/**
+ * @brief A matcher that decides whether a UTF-8 encoded word is accepted by a
+ * given \c RegexQuery .
+ *
+ * The matcher is compiled straight from the units of the query and works on
+ * the UTF-8 bytes of the word directly. The query is split at its stars into
+ * segments that don't contain stars. The first segment has to match a prefix
+ * of the word, the last segment has to match a suffix of the word, and all
+ * other segments have to be found in between in order. Segments that start
+ * with a literal are searched for using \c memchr and \c memmem .
+ *
+ * A matcher is immutable and can be used by any number of threads at once.
+ */
+class RegexMatcher {
+private:
+  struct Atom {
+    enum class Type : uint8_t { LITERAL, OPTIONAL_LITERAL, ANY_CHAR, CHAR_SET };
+
+    Type type;
+    /**
+     * @brief The UTF-8 bytes of a (optional) literal.
+     */
+    std::string literal;
+    /**
+     * @brief All ASCII characters of a character set.
+     */
+    std::bitset<128> ascii;
+    /**
+     * @brief All non-ASCII characters of a character set in ascending order.
+     */
+    std::vector<char32_t> non_ascii;
+  };
+
+  struct Segment {
+    std::vector<Atom> atoms;
+    size_t min_length = 0;
+    size_t max_length = 0;
+
+    bool starts_with_literal() const {
+      return !atoms.empty() && atoms.front().type == Atom::Type::LITERAL;
+    }
+    bool ends_with_literal() const {
+      return !atoms.empty() && atoms.back().type == Atom::Type::LITERAL;
+    }
+  };
+
+  /**
+   * @brief The star-separated segments of the query.
+   *
+   * This always contains at least one segment. If it contains only one, the
+   * query doesn't contain stars.
+   */
+  std::vector<Segment> segments_;
+  size_t min_length_;
+  size_t max_length_;
+  bool reject_all_;
+
+  static size_t match_atom(const Atom& atom, const char* word, size_t length,
+                           size_t pos);
+  static size_t min_end(const Segment& segment, size_t atom, const char* word,
+                        size_t length, size_t pos);
+  static bool ends_at_end(const Segment& segment, size_t atom, const char* word,
+                          size_t length, size_t pos);
+  static size_t find_min_end(const Segment& segment, const char* word,
+                             size_t length, size_t from);
+  static bool find_suffix(const Segment& segment, const char* word,
+                          size_t length, size_t from);
+
+public:
+  explicit RegexMatcher(const RegexQuery& query);
+
+  /**
+   * @brief Returns the minimum number of UTF-8 bytes an accepted word has.
+   */
+  size_t min_length() const {
+    return min_length_;
+  }
+  /**
+   * @brief Returns the maximum number of UTF-8 bytes an accepted word has.
+   *
+   * This is \c SIZE_MAX if the query contains stars.
+   */
+  size_t max_length() const {
+    return max_length_;
+  }
+
+  /**
+   * @brief Returns whether the given UTF-8 encoded word is accepted.
+   *
+   * The word has to be valid UTF-8.
+   *
+   * @param word A pointer to the first byte of the word.
+   * @param length The number of bytes of the word.
+   */
+  bool match(const char* word, size_t length) const;
+  bool match(const std::string& word) const {
+    return match(word.data(), word.size());
+  }
+};
+
+} // namespace regex
+} // namespace netspeak
+
+#endif // NETSPEAK_REGEX_REGEX_MATCHER_HPP
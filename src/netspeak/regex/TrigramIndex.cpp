@@ -0,0 +1,212 @@
+#include "netspeak/regex/TrigramIndex.hpp"
+
+#include <algorithm>
+#include <codecvt>
+#include <locale>
+
+
+namespace netspeak {
+namespace regex {
+
+inline TrigramIndex::Trigram trigram_at(const char* bytes) {
+  return (static_cast<uint32_t>(static_cast<uint8_t>(bytes[0])) << 16) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(bytes[1])) << 8) |
+         static_cast<uint32_t>(static_cast<uint8_t>(bytes[2]));
+}
+
+void append_trigrams(const char* bytes, size_t length,
+                     std::vector<TrigramIndex::Trigram>& trigrams) {
+  for (size_t i = 0; i + 3 <= length; i++) {
+    trigrams.push_back(trigram_at(bytes + i));
+  }
+}
+
+void sort_unique(std::vector<TrigramIndex::Trigram>& trigrams) {
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+}
+
+
+void TrigramIndex::Builder::append(const char* word, size_t length) {
+  const uint32_t id = next_id_++;
+
+  word_trigrams_.clear();
+  append_trigrams(word, length, word_trigrams_);
+  sort_unique(word_trigrams_);
+
+  for (const auto trigram : word_trigrams_) {
+    auto& l = lists_[trigram];
+    // variable-byte encoding of the delta to the previous id
+    uint32_t delta = l.count == 0 ? id : id - l.last_id;
+    while (delta >= 0x80) {
+      l.bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+      delta >>= 7;
+    }
+    l.bytes.push_back(static_cast<uint8_t>(delta));
+    l.last_id = id;
+    l.count++;
+  }
+}
+
+
+TrigramIndex::TrigramIndex(Builder&& builder) {
+  trigrams_.reserve(builder.lists_.size());
+  for (const auto& pair : builder.lists_) {
+    trigrams_.push_back(pair.first);
+  }
+  std::sort(trigrams_.begin(), trigrams_.end());
+
+  size_t total_bytes = 0;
+  for (const auto& pair : builder.lists_) {
+    total_bytes += pair.second.bytes.size();
+  }
+
+  counts_.reserve(trigrams_.size());
+  offsets_.reserve(trigrams_.size() + 1);
+  lists_.reserve(total_bytes);
+  for (const auto trigram : trigrams_) {
+    auto& l = builder.lists_[trigram];
+    counts_.push_back(l.count);
+    offsets_.push_back(lists_.size());
+    lists_.insert(lists_.end(), l.bytes.begin(), l.bytes.end());
+    // free the memory of the builder as we go
+    std::vector<uint8_t>().swap(l.bytes);
+  }
+  offsets_.push_back(lists_.size());
+
+  builder.lists_.clear();
+}
+
+
+std::vector<TrigramIndex::Trigram> TrigramIndex::required_trigrams(
+    const RegexQuery& query) {
+  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
+  std::vector<Trigram> trigrams;
+
+  std::u32string literal;
+  auto flush = [&]() {
+    if (literal.size() > 0) {
+      const auto bytes = conv.to_bytes(literal);
+      append_trigrams(bytes.data(), bytes.size(), trigrams);
+      literal.clear();
+    }
+  };
+
+  for (const auto& unit : query.get_units()) {
+    switch (unit.type) {
+      case RegexUnit::Type::WORD:
+        literal.append(unit.value);
+        break;
+      case RegexUnit::Type::CHAR_SET:
+        if (unit.value.size() == 1) {
+          literal.append(unit.value);
+        } else {
+          flush();
+        }
+        break;
+      default:
+        flush();
+        break;
+    }
+  }
+  flush();
+
+  sort_unique(trigrams);
+  return trigrams;
+}
+
+TrigramIndex::Candidates TrigramIndex::candidates(
+    const std::vector<Trigram>& trigrams) const {
+  Candidates result;
+  result.estimate_ = SIZE_MAX;
+
+  std::vector<std::pair<uint32_t, Candidates::cursor>> cursors;
+  for (const auto trigram : trigrams) {
+    const auto it =
+        std::lower_bound(trigrams_.begin(), trigrams_.end(), trigram);
+    if (it == trigrams_.end() || *it != trigram) {
+      // no word contains this trigram
+      result.estimate_ = 0;
+      result.cursors_.clear();
+      return result;
+    }
+
+    const size_t index = it - trigrams_.begin();
+    Candidates::cursor c = { lists_.data() + offsets_[index],
+                             lists_.data() + offsets_[index + 1], 0, true };
+    c.next();
+    cursors.emplace_back(counts_[index], c);
+    result.estimate_ = std::min(result.estimate_, (size_t)counts_[index]);
+  }
+
+  // The shortest list leads the intersection.
+  std::sort(cursors.begin(), cursors.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  for (const auto& pair : cursors) {
+    result.cursors_.push_back(pair.second);
+  }
+  return result;
+}
+
+
+void TrigramIndex::Candidates::cursor::next() {
+  if (pos == end) {
+    valid = false;
+    return;
+  }
+  uint32_t delta = 0;
+  int shift = 0;
+  while (*pos & 0x80) {
+    delta |= static_cast<uint32_t>(*pos & 0x7F) << shift;
+    shift += 7;
+    pos++;
+  }
+  delta |= static_cast<uint32_t>(*pos) << shift;
+  pos++;
+  value += delta;
+}
+
+void TrigramIndex::Candidates::cursor::advance_to(uint32_t target) {
+  while (valid && value < target) {
+    next();
+  }
+}
+
+bool TrigramIndex::Candidates::next(uint32_t& id) {
+  if (cursors_.empty()) {
+    return false;
+  }
+
+  auto& lead = cursors_.front();
+  if (started_) {
+    lead.next();
+  }
+  started_ = true;
+
+  while (lead.valid) {
+    const uint32_t target = lead.value;
+    bool found = true;
+    for (size_t i = 1; i < cursors_.size(); i++) {
+      auto& c = cursors_[i];
+      c.advance_to(target);
+      if (!c.valid) {
+        lead.valid = false;
+        return false;
+      }
+      if (c.value != target) {
+        lead.advance_to(c.value);
+        found = false;
+        break;
+      }
+    }
+    if (found) {
+      id = target;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace regex
+} // namespace netspeak
@@ -0,0 +1,157 @@
+#ifndef NETSPEAK_REGEX_TRIGRAM_INDEX_HPP
+#define NETSPEAK_REGEX_TRIGRAM_INDEX_HPP
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "netspeak/regex/RegexQuery.hpp"
+
+
+namespace netspeak {
+namespace regex {
+
+/**
+ * @brief An inverted index from the byte trigrams of words to the ids of the
+ * words which contain them.
+ *
+ * Words are identified by their position in the order in which they were added
+ * to the \c Builder . The id list of each trigram is sorted in ascending order
+ * and compressed using delta and variable-byte encoding.
+ *
+ * Trigrams are taken over the UTF-8 bytes of words. Since every literal of a
+ * regex query is valid UTF-8 too, a word can only match a query if it contains
+ * all byte trigrams of the literals of the query.
+ */
+class TrigramIndex {
+public:
+  typedef uint32_t Trigram;
+
+  class Builder {
+  private:
+    struct list {
+      std::vector<uint8_t> bytes;
+      uint32_t last_id = 0;
+      uint32_t count = 0;
+    };
+
+    std::unordered_map<Trigram, list> lists_;
+    std::vector<Trigram> word_trigrams_;
+    uint32_t next_id_ = 0;
+    friend class TrigramIndex;
+
+  public:
+    Builder() {}
+    Builder(const Builder&) = delete;
+
+    /**
+     * @brief Adds the next word to the index.
+     *
+     * The first word will have the id 0, the second the id 1, and so on.
+     */
+    void append(const char* word, size_t length);
+  };
+
+  /**
+   * @brief An iterator over the ids of all words which contain all of a given
+   * set of trigrams.
+   */
+  class Candidates {
+  private:
+    struct cursor {
+      const uint8_t* pos;
+      const uint8_t* end;
+      uint32_t value;
+      bool valid;
+
+      void next();
+      void advance_to(uint32_t target);
+    };
+
+    std::vector<cursor> cursors_;
+    size_t estimate_;
+    bool started_ = false;
+    friend class TrigramIndex;
+
+  public:
+    /**
+     * @brief Returns an upper bound for the number of candidates.
+     */
+    size_t estimate() const {
+      return estimate_;
+    }
+
+    /**
+     * @brief Sets \c id to the next candidate and returns \c true or returns
+     * \c false if there are no more candidates.
+     *
+     * Candidates are returned in ascending order.
+     */
+    bool next(uint32_t& id);
+  };
+
+private:
+  /**
+   * @brief All trigrams of the index in ascending order.
+   */
+  std::vector<Trigram> trigrams_;
+  /**
+   * @brief The id count of the list of each trigram.
+   */
+  std::vector<uint32_t> counts_;
+  /**
+   * @brief The offset of the list of each trigram in \c lists_ .
+   *
+   * This has one more entry than \c trigrams_ , so that the end of the last
+   * list is known as well.
+   */
+  std::vector<uint64_t> offsets_;
+  /**
+   * @brief The compressed id lists of all trigrams concatenated.
+   */
+  std::vector<uint8_t> lists_;
+
+public:
+  explicit TrigramIndex(Builder&& builder);
+  TrigramIndex(const TrigramIndex&) = delete;
+
+  /**
+   * @brief Returns the trigrams which every word matched by the given query
+   * has to contain.
+   *
+   * The returned list is empty if the query doesn't contain literals with at
+   * least 3 bytes.
+   */
+  static std::vector<Trigram> required_trigrams(const RegexQuery& query);
+
+  /**
+   * @brief Returns the candidates for words containing all of the given
+   * trigrams.
+   *
+   * The list of trigrams must not be empty.
+   */
+  Candidates candidates(const std::vector<Trigram>& trigrams) const;
+
+  /**
+   * @brief Returns the number of distinct trigrams.
+   */
+  size_t size() const {
+    return trigrams_.size();
+  }
+
+  /**
+   * @brief Returns the number of bytes used by the index.
+   */
+  size_t memory_usage() const {
+    return trigrams_.size() * sizeof(Trigram) +
+           counts_.size() * sizeof(uint32_t) +
+           offsets_.size() * sizeof(uint64_t) + lists_.size();
+  }
+};
+
+} // namespace regex
+} // namespace netspeak
+
+#endif // NETSPEAK_REGEX_TRIGRAM_INDEX_HPP
@@ -0,0 +1,130 @@
+#include "netspeak/service/AdmissionControl.hpp"
+
+#include "boost/lexical_cast.hpp"
+
+#include "netspeak/error.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+AdmissionControl::Limits AdmissionControl::Limits::from_config(
+    const Configuration& config) {
+  auto get = [&](const std::string& key) {
+    return boost::lexical_cast<size_t>(config.get(key, "0"));
+  };
+
+  Limits limits;
+  limits.max_concurrent = get(Configuration::ADMISSION_MAX_CONCURRENT);
+  limits.max_concurrent_cost =
+      get(Configuration::ADMISSION_MAX_CONCURRENT_COST);
+  limits.max_concurrent_per_client =
+      get(Configuration::ADMISSION_MAX_CONCURRENT_PER_CLIENT);
+  limits.max_queue_time =
+      std::chrono::milliseconds(get(Configuration::ADMISSION_MAX_QUEUE_TIME));
+  return limits;
+}
+
+
+AdmissionControl::Ticket::~Ticket() {
+  if (control_) {
+    control_->release_(*this);
+  }
+}
+
+
+AdmissionControl::AdmissionControl(const Limits& limits) : limits_(limits) {}
+
+bool AdmissionControl::can_admit_(size_t cost, size_t parallelism) const {
+  if (limits_.max_concurrent != 0 && running_ != 0 &&
+      running_ + parallelism > limits_.max_concurrent) {
+    return false;
+  }
+  if (limits_.max_concurrent_cost != 0 && running_ != 0 &&
+      running_cost_ + cost > limits_.max_concurrent_cost) {
+    return false;
+  }
+  return true;
+}
+
+grpc::Status AdmissionControl::admit(
+    const std::string& client, size_t cost,
+    std::chrono::system_clock::time_point deadline, Ticket& ticket,
+    size_t parallelism) {
+  if (ticket.control_) {
+    throw tracable_logic_error("The ticket is already in use.");
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  const bool limit_client =
+      limits_.max_concurrent_per_client != 0 && !client.empty();
+  if (limit_client) {
+    // Waiting searches count as well, so concurrent requests of one client
+    // can't all pass this check and queue up behind each other.
+    auto it = per_client_.find(client);
+    if (it != per_client_.end() &&
+        it->second >= limits_.max_concurrent_per_client) {
+      return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                          "Too many concurrent searches for this client");
+    }
+    per_client_[client]++;
+  }
+
+  if (!can_admit_(cost, parallelism)) {
+    // Wait for the queue time limit but not past the deadline of the request.
+    // The deadline is converted to the steady clock, so waiting isn't affected
+    // by changes of the system time.
+    const auto now = std::chrono::steady_clock::now();
+    auto wait_until = now + limits_.max_queue_time;
+    const auto until_deadline = deadline - std::chrono::system_clock::now();
+    if (until_deadline < limits_.max_queue_time) {
+      wait_until = now + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             until_deadline);
+    }
+
+    if (!cv_.wait_until(lock, wait_until, [&]() {
+          return can_admit_(cost, parallelism);
+        })) {
+      if (limit_client) {
+        leave_client_(client);
+      }
+      return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                          "Too many concurrent searches");
+    }
+  }
+
+  running_ += parallelism;
+  running_cost_ += cost;
+
+  ticket.control_ = this;
+  ticket.cost_ = cost;
+  ticket.parallelism_ = parallelism;
+  if (limit_client) {
+    ticket.client_ = client;
+  }
+  return grpc::Status::OK;
+}
+
+void AdmissionControl::release_(const Ticket& ticket) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ -= ticket.parallelism_;
+    running_cost_ -= ticket.cost_;
+    if (!ticket.client_.empty()) {
+      leave_client_(ticket.client_);
+    }
+  }
+  cv_.notify_all();
+}
+
+void AdmissionControl::leave_client_(const std::string& client) {
+  auto it = per_client_.find(client);
+  if (--it->second == 0) {
+    per_client_.erase(it);
+  }
+}
+
+
+} // namespace service
+} // namespace netspeak
@@ -0,0 +1,139 @@
+#ifndef NETSPEAK_SERVICE_ADMISSION_CONTROL_HPP
+#define NETSPEAK_SERVICE_ADMISSION_CONTROL_HPP
+
+
+#include <grpcpp/support/status.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "netspeak/Configuration.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief Decides which searches of a corpus are allowed to run.
+ *
+ * Searches which can't be admitted right away wait for other searches to
+ * finish. Searches which can't be admitted in time are rejected with
+ * \c RESOURCE_EXHAUSTED, so an overloaded server answers some requests quickly
+ * instead of answering all requests slowly.
+ *
+ * The limits are:
+ *
+ * 1. The number of concurrent searches. A batch of searches counts as the
+ *    number of searches it runs in parallel. A batch which alone exceeds the
+ *    limit is only admitted when no other search is running.
+ * 2. The total cost of all concurrent searches. The cost of a search is the
+ *    number of its norm queries. A search whose cost alone exceeds the limit
+ *    is only admitted when no other search is running.
+ * 3. The number of running and waiting searches of a single client (tracking
+ *    id). Searches above this limit are rejected without waiting, so a single
+ *    (batch) client can't fill the queue. Requests without a tracking id are
+ *    not subject to this limit.
+ *
+ * A limit of 0 means unlimited. The exception is the queue time: with a queue
+ * time of 0, searches which can't be admitted right away are rejected. All
+ * operations of this class are thread-safe.
+ */
+class AdmissionControl {
+public:
+  struct Limits {
+    size_t max_concurrent = 0;
+    size_t max_concurrent_cost = 0;
+    size_t max_concurrent_per_client = 0;
+    /**
+     * @brief The maximum time a search will wait to be admitted.
+     *
+     * Unlike the other limits, 0 doesn't mean unlimited. Searches which can't
+     * be admitted right away are rejected without waiting.
+     */
+    std::chrono::milliseconds max_queue_time = std::chrono::milliseconds(0);
+
+    static Limits from_config(const Configuration& config);
+  };
+
+  /**
+   * @brief The admission of a single search. The search is done when its
+   * ticket is destroyed.
+   */
+  class Ticket {
+  private:
+    AdmissionControl* control_ = nullptr;
+    std::string client_;
+    size_t cost_ = 0;
+    size_t parallelism_ = 0;
+
+    friend class AdmissionControl;
+
+  public:
+    Ticket() {}
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+  };
+
+private:
+  Limits limits_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t running_ = 0;
+  size_t running_cost_ = 0;
+  /**
+   * @brief The number of running and waiting searches of each client.
+   */
+  std::unordered_map<std::string, size_t> per_client_;
+
+public:
+  AdmissionControl() = delete;
+  AdmissionControl(const AdmissionControl&) = delete;
+  explicit AdmissionControl(const Limits& limits);
+
+  const Limits& limits() const {
+    return limits_;
+  }
+  /**
+   * @brief Returns whether the cost of searches is used to admit them.
+   *
+   * If not, the cost of searches doesn't have to be computed.
+   */
+  bool uses_cost() const {
+    return limits_.max_concurrent_cost != 0;
+  }
+
+  /**
+   * @brief Tries to admit a search (or a batch of searches) with the given
+   * cost.
+   *
+   * This blocks until the search is admitted, the queue time limit is
+   * reached, or the given deadline of the request passed. The returned status
+   * is either OK (the given ticket now holds the admission) or
+   * \c RESOURCE_EXHAUSTED.
+   *
+   * @param client The tracking id of the client. May be empty.
+   * @param cost The number of norm queries of the search.
+   * @param deadline The deadline of the request.
+   * @param ticket An unused ticket.
+   * @param parallelism The number of searches which run concurrently under
+   * this admission.
+   */
+  grpc::Status admit(const std::string& client, size_t cost,
+                     std::chrono::system_clock::time_point deadline,
+                     Ticket& ticket, size_t parallelism = 1);
+
+private:
+  bool can_admit_(size_t cost, size_t parallelism) const;
+  void leave_client_(const std::string& client);
+  void release_(const Ticket& ticket);
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
@@ -0,0 +1,643 @@
+#include "netspeak/service/AsyncProxyServer.hpp"
+
+#include <google/protobuf/arena.h>
+#include <grpcpp/alarm.h>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "netspeak/error.hpp"
+#include "netspeak/service/corpora.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A completion queue tag of a forwarded call.
+ */
+class ProxyCall {
+public:
+  virtual ~ProxyCall() {}
+  /**
+   * @brief Advances the call after the last operation on it completed.
+   *
+   * @param ok Whether the operation completed successfully.
+   */
+  virtual void proceed(bool ok) = 0;
+};
+
+void set_unknown_corpus(SearchResponse& response) {
+  auto error = response.mutable_error();
+  error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+  error->set_message("Unknown corpus");
+}
+
+/**
+ * @brief Returns a byte buffer that shares the given bytes.
+ */
+grpc::ByteBuffer to_byte_buffer(const ResponseCache::Bytes& bytes) {
+  auto owner = new ResponseCache::Bytes(bytes);
+  grpc::Slice slice(
+      const_cast<char*>(bytes->data()), bytes->size(),
+      [](void* user_data) {
+        delete static_cast<ResponseCache::Bytes*>(user_data);
+      },
+      owner);
+  return grpc::ByteBuffer(&slice, 1);
+}
+
+/**
+ * @brief A \c Search call.
+ *
+ * The call is received, forwarded to its backend, and finished. If the search
+ * is hedged, it's forwarded to a second backend after the hedge delay and the
+ * first successful response is relayed. A search in multiple corpora is
+ * forwarded as one search per corpus and finished once all of them completed.
+ *
+ * Requests and responses are handled as raw bytes, so cached responses are
+ * sent as they are. If another call is computing the same response, the call
+ * waits for it.
+ *
+ * The call deletes itself once it's done and all of its forwarded calls
+ * completed.
+ */
+class ForwardSearchCall final : public ProxyCall {
+private:
+  enum class State { RECEIVING, WAITING, FORWARDING, FINISHING };
+
+  /**
+   * @brief A forwarded call to a single backend.
+   */
+  struct Attempt final : public ProxyCall {
+    ForwardSearchCall* call;
+    Backend* backend;
+    std::chrono::steady_clock::time_point start;
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SearchResponse>> reader;
+    SearchResponse* response;
+    grpc::Status status;
+
+    void proceed(bool) override {
+      call->attempted(*this);
+    }
+  };
+  /**
+   * @brief A forwarded search in one corpus of a search in multiple corpora.
+   */
+  struct CorpusForward final : public ProxyCall {
+    ForwardSearchCall* call;
+    std::unique_ptr<LoadBalanceProxy::CorpusSearch> search;
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SearchResponse>> reader;
+    SearchResponse* response;
+    grpc::Status status;
+
+    void proceed(bool) override {
+      call->corpus_forwarded(*this);
+    }
+  };
+  /**
+   * @brief The alarm that starts the hedged attempt.
+   */
+  struct Hedge final : public ProxyCall {
+    ForwardSearchCall* call;
+    grpc::Alarm alarm;
+
+    void proceed(bool ok) override {
+      call->hedge(ok);
+    }
+  };
+  /**
+   * @brief The alarm that moves a waiting call back to its completion queue
+   * once the response it waits for is filled.
+   */
+  struct Wake final : public ProxyCall {
+    ForwardSearchCall* call;
+    grpc::Alarm alarm;
+
+    void proceed(bool) override {
+      call->woken();
+    }
+  };
+
+  AsyncProxyServer& server_;
+  grpc::ServerCompletionQueue* cq_;
+  grpc::ServerContext context_;
+  grpc::ByteBuffer request_buffer_;
+  /**
+   * @brief The arena of the request, the response, and the responses of all
+   * forwarded calls.
+   */
+  google::protobuf::Arena arena_;
+  SearchRequest* request_;
+  SearchResponse* response_;
+  grpc::ServerAsyncResponseWriter<grpc::ByteBuffer> responder_;
+  std::array<Attempt, 2> attempts_;
+  size_t started_ = 0;
+  std::vector<std::unique_ptr<CorpusForward>> corpus_forwards_;
+  Hedge hedge_;
+  Wake wake_;
+  /**
+   * @brief The cache key if this call has to fill the cache.
+   */
+  std::string cache_key_;
+  bool filling_ = false;
+  ResponseCache::Bytes cached_;
+  /**
+   * @brief The number of attempts, corpus forwards, and alarms that didn't
+   * complete yet.
+   */
+  size_t pending_ = 0;
+  bool alarm_set_ = false;
+  bool done_ = false;
+  uint64_t req_id_ = 0;
+  State state_ = State::RECEIVING;
+
+public:
+  ForwardSearchCall(AsyncProxyServer& server, grpc::ServerCompletionQueue* cq)
+      : server_(server),
+        cq_(cq),
+        arena_(),
+        request_(
+            google::protobuf::Arena::CreateMessage<SearchRequest>(&arena_)),
+        response_(
+            google::protobuf::Arena::CreateMessage<SearchResponse>(&arena_)),
+        responder_(&context_) {
+    server_.async_service_.RequestSearch(&context_, &request_buffer_,
+                                         &responder_, cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    switch (state_) {
+      case State::RECEIVING: {
+        if (!ok) {
+          delete this;
+          return;
+        }
+
+        // accept the next call
+        if (!server_.shutting_down_) {
+          new ForwardSearchCall(server_, cq_);
+        }
+
+        auto status = grpc::SerializationTraits<SearchRequest>::Deserialize(
+            &request_buffer_, request_);
+        if (!status.ok()) {
+          state_ = State::FINISHING;
+          responder_.FinishWithError(status, this);
+          return;
+        }
+
+        if (server_.logger_) {
+          req_id_ = server_.logger_->log_search(context_, *request_);
+        }
+
+        auto cache = server_.proxy_.cache();
+        if (cache) {
+          // The key is the request serialized by us, so the same request
+          // always has the same key.
+          cache_key_ = request_->SerializeAsString();
+          auto lookup = cache->lookup(
+              cache_key_, cached_,
+              [this](const ResponseCache::Bytes& bytes) { wake(bytes); });
+          if (lookup == ResponseCache::Lookup::HIT) {
+            // Cached responses are never errors, so there's nothing to log.
+            finish_bytes(cached_, grpc::Status::OK);
+            return;
+          } else if (lookup == ResponseCache::Lookup::PENDING) {
+            state_ = State::WAITING;
+            pending_++;
+            return;
+          }
+          filling_ = true;
+        }
+
+        route();
+        break;
+      }
+      case State::WAITING:
+      case State::FORWARDING:
+        // only attempts and alarms complete while waiting or forwarding
+        break;
+      case State::FINISHING:
+        done_ = true;
+        release();
+        break;
+    }
+  }
+
+private:
+  void route() {
+    if (request_->corpora_size() != 0) {
+      forward_corpora();
+      return;
+    }
+
+    auto backend = server_.proxy_.route(*request_);
+    if (!backend) {
+      set_unknown_corpus(*response_);
+      finish(grpc::Status::OK);
+      return;
+    }
+
+    state_ = State::FORWARDING;
+    forward(backend);
+    const auto delay = server_.proxy_.hedge_delay(*request_);
+    if (delay.count() > 0) {
+      hedge_.call = this;
+      // gRPC deadlines have to be system clock time points
+      hedge_.alarm.Set(
+          cq_,
+          std::chrono::system_clock::now() +
+              std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                  delay),
+          &hedge_);
+      alarm_set_ = true;
+      pending_++;
+    }
+  }
+
+  void forward(Backend* backend) {
+    auto& attempt = attempts_[started_++];
+    attempt.call = this;
+    attempt.backend = backend;
+    attempt.start = std::chrono::steady_clock::now();
+    attempt.context = grpc::ClientContext::FromServerContext(context_);
+    backend->begin_call();
+    attempt.reader =
+        backend->stub().AsyncSearch(attempt.context.get(), *request_, cq_);
+    attempt.response =
+        google::protobuf::Arena::CreateMessage<SearchResponse>(&arena_);
+    attempt.reader->Finish(attempt.response, &attempt.status, &attempt);
+    pending_++;
+  }
+
+  void attempted(Attempt& attempt) {
+    attempt.backend->end_call();
+    pending_--;
+
+    // The first successful response wins. A failed response only wins if
+    // there's no other pending attempt.
+    const bool other_pending = pending_ > (alarm_set_ ? 1u : 0u);
+    const bool wins = attempt.status.ok() || !other_pending;
+    if (state_ == State::FORWARDING && wins) {
+      for (size_t i = 0; i < started_; i++) {
+        if (&attempts_[i] != &attempt) {
+          attempts_[i].context->TryCancel();
+        }
+      }
+      if (alarm_set_) {
+        hedge_.alarm.Cancel();
+      }
+      if (attempt.status.ok()) {
+        server_.proxy_.record_latency(
+            *request_, std::chrono::steady_clock::now() - attempt.start);
+      }
+      // both are on the arena of the call, so this doesn't copy
+      response_->Swap(attempt.response);
+      finish(attempt.status);
+      return;
+    }
+    release();
+  }
+
+  void forward_corpora() {
+    auto searches = server_.proxy_.split_corpora(*request_, *response_);
+    if (searches.empty()) {
+      finish(grpc::Status::OK);
+      return;
+    }
+
+    // All forwards complete on the queue of this call, so they are never
+    // handled concurrently.
+    state_ = State::FORWARDING;
+    for (auto& search : searches) {
+      corpus_forwards_.push_back(std::make_unique<CorpusForward>());
+      auto& forward = *corpus_forwards_.back();
+      forward.call = this;
+      forward.search = std::move(search);
+      forward.context = grpc::ClientContext::FromServerContext(context_);
+      forward.search->backend->begin_call();
+      forward.reader = forward.search->backend->stub().AsyncSearch(
+          forward.context.get(), forward.search->request, cq_);
+      forward.response =
+          google::protobuf::Arena::CreateMessage<SearchResponse>(&arena_);
+      forward.reader->Finish(forward.response, &forward.status, &forward);
+      pending_++;
+    }
+  }
+
+  void corpus_forwarded(CorpusForward& forward) {
+    forward.search->backend->end_call();
+    if (--pending_ != 0) {
+      return;
+    }
+
+    auto& responses = *response_->mutable_corpus_responses();
+    for (auto& forward : corpus_forwards_) {
+      auto& resp = responses[forward->search->index];
+      if (forward->status.ok()) {
+        resp.Swap(forward->response);
+      } else {
+        set_corpus_error(forward->status, resp);
+      }
+    }
+    finish(grpc::Status::OK);
+  }
+
+  void hedge(bool ok) {
+    alarm_set_ = false;
+    pending_--;
+    if (ok && state_ == State::FORWARDING && started_ == 1) {
+      forward(server_.proxy_.route(*request_, attempts_[0].backend));
+    }
+    release();
+  }
+
+  /**
+   * @brief Called by the thread that filled the response this call waits for.
+   */
+  void wake(const ResponseCache::Bytes& bytes) {
+    cached_ = bytes;
+    wake_.call = this;
+    wake_.alarm.Set(cq_, std::chrono::system_clock::now(), &wake_);
+  }
+
+  void woken() {
+    pending_--;
+    if (cached_) {
+      finish_bytes(cached_, grpc::Status::OK);
+    } else {
+      // the response of the other call can't be used
+      route();
+    }
+  }
+
+  void finish(const grpc::Status& status) {
+    ResponseCache::Bytes bytes =
+        std::make_shared<const std::string>(response_->SerializeAsString());
+    if (filling_) {
+      const bool cacheable =
+          status.ok() && LoadBalanceProxy::is_cacheable(*response_);
+      server_.proxy_.cache()->fill(cache_key_, cacheable ? bytes : nullptr);
+      filling_ = false;
+    }
+    if (server_.logger_) {
+      server_.logger_->log_search_result(req_id_, context_, *request_,
+                                         *response_, status);
+    }
+    finish_bytes(bytes, status);
+  }
+
+  void finish_bytes(const ResponseCache::Bytes& bytes,
+                    const grpc::Status& status) {
+    state_ = State::FINISHING;
+    if (status.ok()) {
+      responder_.Finish(to_byte_buffer(bytes), status, this);
+    } else {
+      responder_.FinishWithError(status, this);
+    }
+  }
+
+  /**
+   * @brief Deletes the call if it's done.
+   */
+  void release() {
+    if (done_ && pending_ == 0) {
+      delete this;
+    }
+  }
+};
+
+/**
+ * @brief A \c SearchBatch call.
+ *
+ * The batch is split into one batch per backend and all of them are forwarded
+ * at once. The call is finished after the last backend responded. It deletes
+ * itself once it's done.
+ */
+class ForwardBatchCall final : public ProxyCall {
+private:
+  /**
+   * @brief The forwarded batch of a single backend.
+   */
+  struct Forward final : public ProxyCall {
+    ForwardBatchCall* call;
+    std::unique_ptr<LoadBalanceProxy::SubBatch> batch;
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SearchBatchResponse>>
+        reader;
+    SearchBatchResponse* response;
+    grpc::Status status;
+
+    void proceed(bool) override {
+      call->forwarded(*this);
+    }
+  };
+
+  AsyncProxyServer& server_;
+  grpc::ServerCompletionQueue* cq_;
+  grpc::ServerContext context_;
+  /**
+   * @brief The arena of the request, the response, and the responses of all
+   * forwarded batches.
+   */
+  google::protobuf::Arena arena_;
+  SearchBatchRequest* request_;
+  SearchBatchResponse* response_;
+  grpc::ServerAsyncResponseWriter<SearchBatchResponse> responder_;
+  std::vector<std::unique_ptr<Forward>> forwards_;
+  size_t pending_ = 0;
+  uint64_t req_id_ = 0;
+  bool received_ = false;
+
+public:
+  ForwardBatchCall(AsyncProxyServer& server, grpc::ServerCompletionQueue* cq)
+      : server_(server),
+        cq_(cq),
+        arena_(),
+        request_(google::protobuf::Arena::CreateMessage<SearchBatchRequest>(
+            &arena_)),
+        response_(google::protobuf::Arena::CreateMessage<SearchBatchResponse>(
+            &arena_)),
+        responder_(&context_) {
+    server_.async_service_.RequestSearchBatch(&context_, request_, &responder_,
+                                              cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (received_ || !ok) {
+      // the call is finished
+      delete this;
+      return;
+    }
+    received_ = true;
+
+    // accept the next call
+    if (!server_.shutting_down_) {
+      new ForwardBatchCall(server_, cq_);
+    }
+
+    if (server_.logger_) {
+      req_id_ = server_.logger_->log_search_batch(context_, *request_);
+    }
+
+    auto batches = server_.proxy_.split_batch(*request_, *response_);
+    if (batches.empty()) {
+      finish(grpc::Status::OK);
+      return;
+    }
+
+    // All forwards complete on the queue of this call, so they are never
+    // handled concurrently.
+    pending_ = batches.size();
+    for (auto& batch : batches) {
+      forwards_.push_back(std::make_unique<Forward>());
+      auto& forward = *forwards_.back();
+      forward.call = this;
+      forward.batch = std::move(batch);
+      forward.context = grpc::ClientContext::FromServerContext(context_);
+      forward.batch->backend->begin_call();
+      forward.reader = forward.batch->backend->stub().AsyncSearchBatch(
+          forward.context.get(), forward.batch->request, cq_);
+      forward.response =
+          google::protobuf::Arena::CreateMessage<SearchBatchResponse>(&arena_);
+      forward.reader->Finish(forward.response, &forward.status, &forward);
+    }
+  }
+
+private:
+  void forwarded(Forward& forward) {
+    forward.batch->backend->end_call();
+    if (--pending_ != 0) {
+      return;
+    }
+
+    grpc::Status status;
+    for (auto& forward : forwards_) {
+      status = forward->status;
+      if (status.ok()) {
+        status = LoadBalanceProxy::merge_batch(*forward->batch,
+                                               *forward->response, *response_);
+      }
+      if (!status.ok()) {
+        break;
+      }
+    }
+    finish(status);
+  }
+
+  void finish(const grpc::Status& status) {
+    if (server_.logger_) {
+      server_.logger_->log_search_batch_result(req_id_, context_, *request_,
+                                               *response_, status);
+    }
+    responder_.Finish(*response_, status, this);
+  }
+};
+
+class ProxyCorporaCall final : public ProxyCall {
+private:
+  AsyncProxyServer& server_;
+  grpc::ServerCompletionQueue* cq_;
+  grpc::ServerContext context_;
+  CorporaRequest request_;
+  CorporaResponse response_;
+  grpc::ServerAsyncResponseWriter<CorporaResponse> responder_;
+  bool finished_ = false;
+
+public:
+  ProxyCorporaCall(AsyncProxyServer& server, grpc::ServerCompletionQueue* cq)
+      : server_(server), cq_(cq), responder_(&context_) {
+    server_.async_service_.RequestGetCorpora(&context_, &request_, &responder_,
+                                             cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (finished_ || !ok) {
+      delete this;
+      return;
+    }
+
+    // accept the next call
+    if (!server_.shutting_down_) {
+      new ProxyCorporaCall(server_, cq_);
+    }
+
+    // The proxy knows its corpora, so this doesn't block.
+    auto status =
+        server_.service_->GetCorpora(&context_, &request_, &response_);
+    finished_ = true;
+    responder_.Finish(response_, status, this);
+  }
+};
+
+
+AsyncProxyServer::AsyncProxyServer(
+    std::unique_ptr<NetspeakService::Service> service,
+    const LoadBalanceProxy& proxy, RequestLogger* logger,
+    grpc::ServerBuilder& builder, const Options& options)
+    : service_(std::move(service)),
+      proxy_(proxy),
+      logger_(logger),
+      async_service_(service_.get()),
+      cqs_(),
+      server_(),
+      network_threads_(),
+      shutting_down_(false) {
+  if (!service_) {
+    throw std::logic_error("The service of an AsyncProxyServer is null.");
+  }
+  if (options.completion_queues == 0) {
+    throw tracable_logic_error(
+        "An AsyncProxyServer needs at least one completion queue.");
+  }
+
+  builder.RegisterService(&async_service_);
+  for (size_t i = 0; i < options.completion_queues; i++) {
+    cqs_.push_back(builder.AddCompletionQueue());
+  }
+  server_ = builder.BuildAndStart();
+  if (!server_) {
+    throw std::runtime_error("Unable to start the server.");
+  }
+
+  for (auto& cq : cqs_) {
+    new ForwardSearchCall(*this, &*cq);
+    new ForwardBatchCall(*this, &*cq);
+    new ProxyCorporaCall(*this, &*cq);
+    network_threads_.emplace_back([this, &cq]() { poll(&*cq); });
+  }
+}
+
+AsyncProxyServer::~AsyncProxyServer() {
+  shutting_down_ = true;
+  // This cancels all calls and with them all forwarded calls. The network
+  // threads keep polling, so every call can finish.
+  server_->Shutdown();
+  for (auto& cq : cqs_) {
+    cq->Shutdown();
+  }
+  for (auto& thread : network_threads_) {
+    thread.join();
+  }
+}
+
+void AsyncProxyServer::wait() {
+  server_->Wait();
+}
+
+void AsyncProxyServer::poll(grpc::ServerCompletionQueue* cq) {
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<ProxyCall*>(tag)->proceed(ok);
+  }
+}
+
+
+} // namespace service
+} // namespace netspeak
@@ -0,0 +1,128 @@
+#ifndef NETSPEAK_SERVICE_ASYNC_PROXY_SERVER_HPP
+#define NETSPEAK_SERVICE_ASYNC_PROXY_SERVER_HPP
+
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/byte_buffer.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "netspeak/service/LoadBalanceProxy.hpp"
+#include "netspeak/service/NetspeakService.grpc.pb.h"
+#include "netspeak/service/NetspeakService.pb.h"
+#include "netspeak/service/RequestLogger.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A gRPC server that forwards calls to the backends of a
+ * \c LoadBalanceProxy without blocking any thread.
+ *
+ * Calls are received on a number of completion queues, each of which is
+ * polled by its own network thread. A received search is forwarded with the
+ * asynchronous client API on the completion queue it was received on, and its
+ * response is relayed once the backend responded. A network thread therefore
+ * never waits for a backend, and the number of concurrent calls is bounded by
+ * the backends instead of the threads of the proxy. Searches are hedged the
+ * same way \c LoadBalanceProxy hedges them, using an alarm on the completion
+ * queue instead of a blocking wait. Cached responses of the proxy are sent
+ * without being parsed or serialized again.
+ *
+ * The deadline of a call is propagated to the forwarded call, and cancelling
+ * a call cancels the forwarded call too.
+ *
+ * Streaming searches (\c SearchStream) are forwarded by the given service on
+ * gRPC's synchronous threads instead.
+ *
+ * The server is started by the constructor and shut down by the destructor.
+ */
+class AsyncProxyServer {
+public:
+  struct Options {
+    /**
+     * @brief The number of completion queues and network threads.
+     */
+    size_t completion_queues;
+  };
+
+private:
+  /**
+   * @brief The service registered at the server.
+   *
+   * All unary methods are asynchronous and \c Search is raw, so cached
+   * responses don't have to be serialized. \c SearchStream is forwarded to
+   * the given service.
+   */
+  class AsyncService final
+      : public NetspeakService::WithRawMethod_Search<
+            NetspeakService::WithAsyncMethod_GetCorpora<
+                NetspeakService::WithAsyncMethod_SearchBatch<
+                    NetspeakService::Service>>> {
+  private:
+    NetspeakService::Service* service_;
+
+  public:
+    AsyncService(NetspeakService::Service* service) : service_(service) {}
+
+    grpc::Status SearchStream(
+        grpc::ServerContext* context, const SearchRequest* request,
+        grpc::ServerWriter<SearchResponse>* writer) override {
+      return service_->SearchStream(context, request, writer);
+    }
+  };
+
+  std::unique_ptr<NetspeakService::Service> service_;
+  const LoadBalanceProxy& proxy_;
+  RequestLogger* logger_;
+  AsyncService async_service_;
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+  std::unique_ptr<grpc::Server> server_;
+  std::vector<std::thread> network_threads_;
+  std::atomic<bool> shutting_down_;
+
+public:
+  AsyncProxyServer() = delete;
+  AsyncProxyServer(const AsyncProxyServer&) = delete;
+  /**
+   * @brief Builds and starts a new server.
+   *
+   * The listening ports have to be added to the given builder beforehand.
+   *
+   * @param service The service handling \c GetCorpora and \c SearchStream.
+   * This is either \c proxy itself or a \c RequestLogger of it.
+   * @param proxy The proxy whose routing is used to forward searches. It has
+   * to be owned by \c service.
+   * @param logger The logger of \c service or \c nullptr if the calls aren't
+   * logged.
+   * @param builder
+   * @param options
+   */
+  AsyncProxyServer(std::unique_ptr<NetspeakService::Service> service,
+                   const LoadBalanceProxy& proxy, RequestLogger* logger,
+                   grpc::ServerBuilder& builder, const Options& options);
+  ~AsyncProxyServer();
+
+  /**
+   * @brief Blocks until the server is shut down.
+   */
+  void wait();
+
+private:
+  friend class ForwardSearchCall;
+  friend class ForwardBatchCall;
+  friend class ProxyCorporaCall;
+
+  void poll(grpc::ServerCompletionQueue* cq);
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
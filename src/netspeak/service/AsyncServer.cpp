@@ -0,0 +1,213 @@
+#include "netspeak/service/AsyncServer.hpp"
+
+#include <google/protobuf/arena.h>
+
+#include <exception>
+
+#include "netspeak/error.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief The state of a single call.
+ *
+ * A call is its own completion queue tag. It deletes itself once it's done.
+ */
+class Call {
+public:
+  virtual ~Call() {}
+  /**
+   * @brief Advances the call after the last operation on it completed.
+   *
+   * @param ok Whether the operation completed successfully.
+   */
+  virtual void proceed(bool ok) = 0;
+};
+
+/**
+ * @brief A call of one of the search methods (\c Search or \c SearchBatch).
+ *
+ * The search itself is executed by a search thread.
+ */
+template <class Request, class Response>
+class SearchCall final : public Call {
+public:
+  typedef void (AsyncServer::AsyncService::*RequestMethod)(
+      grpc::ServerContext*, Request*,
+      grpc::ServerAsyncResponseWriter<Response>*, grpc::CompletionQueue*,
+      grpc::ServerCompletionQueue*, void*);
+  typedef grpc::Status (NetspeakService::Service::*ServiceMethod)(
+      grpc::ServerContext*, const Request*, Response*);
+
+private:
+  AsyncServer& server_;
+  grpc::ServerCompletionQueue* cq_;
+  RequestMethod request_method_;
+  ServiceMethod service_method_;
+  grpc::ServerContext context_;
+  google::protobuf::Arena arena_;
+  Request* request_;
+  Response* response_;
+  grpc::ServerAsyncResponseWriter<Response> responder_;
+  bool finished_ = false;
+
+public:
+  SearchCall(AsyncServer& server, grpc::ServerCompletionQueue* cq,
+             RequestMethod request_method, ServiceMethod service_method)
+      : server_(server),
+        cq_(cq),
+        request_method_(request_method),
+        service_method_(service_method),
+        context_(),
+        arena_(),
+        request_(google::protobuf::Arena::CreateMessage<Request>(&arena_)),
+        response_(google::protobuf::Arena::CreateMessage<Response>(&arena_)),
+        responder_(&context_) {
+    (server_.async_service_.*request_method_)(&context_, request_, &responder_,
+                                              cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (finished_ || !ok) {
+      delete this;
+      return;
+    }
+
+    // accept the next call
+    if (!server_.shutting_down_) {
+      new SearchCall(server_, cq_, request_method_, service_method_);
+    }
+
+    bool queued = server_.search_pool_->try_execute(
+        [this]() { search(); }, server_.max_queued_searches_);
+    if (!queued) {
+      finished_ = true;
+      responder_.FinishWithError(
+          grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                       "Too many queued searches"),
+          this);
+    }
+  }
+
+private:
+  void search() {
+    grpc::Status status;
+    try {
+      status = ((*server_.service_).*service_method_)(&context_, request_,
+                                                      response_);
+    } catch (const std::exception& e) {
+      status = grpc::Status(grpc::StatusCode::INTERNAL, e.what());
+    }
+    finished_ = true;
+    responder_.Finish(*response_, status, this);
+  }
+};
+
+class GetCorporaCall final : public Call {
+private:
+  AsyncServer& server_;
+  grpc::ServerCompletionQueue* cq_;
+  grpc::ServerContext context_;
+  CorporaRequest request_;
+  CorporaResponse response_;
+  grpc::ServerAsyncResponseWriter<CorporaResponse> responder_;
+  bool finished_ = false;
+
+public:
+  GetCorporaCall(AsyncServer& server, grpc::ServerCompletionQueue* cq)
+      : server_(server), cq_(cq), responder_(&context_) {
+    server_.async_service_.RequestGetCorpora(&context_, &request_, &responder_,
+                                             cq_, cq_, this);
+  }
+
+  void proceed(bool ok) override {
+    if (finished_ || !ok) {
+      delete this;
+      return;
+    }
+
+    // accept the next call
+    if (!server_.shutting_down_) {
+      new GetCorporaCall(server_, cq_);
+    }
+
+    // This is cheap, so it's done on the network thread.
+    auto status =
+        server_.service_->GetCorpora(&context_, &request_, &response_);
+    finished_ = true;
+    responder_.Finish(response_, status, this);
+  }
+};
+
+
+AsyncServer::AsyncServer(std::unique_ptr<NetspeakService::Service> service,
+                         grpc::ServerBuilder& builder, const Options& options)
+    : service_(std::move(service)),
+      async_service_(service_.get()),
+      cqs_(),
+      server_(),
+      search_pool_(),
+      network_threads_(),
+      max_queued_searches_(options.max_queued_searches),
+      shutting_down_(false) {
+  if (!service_) {
+    throw std::logic_error("The service of an AsyncServer is null.");
+  }
+  if (options.completion_queues == 0 || options.search_threads == 0) {
+    throw tracable_logic_error("An AsyncServer needs at least one completion "
+                               "queue and at least one search thread.");
+  }
+
+  builder.RegisterService(&async_service_);
+  for (size_t i = 0; i < options.completion_queues; i++) {
+    cqs_.push_back(builder.AddCompletionQueue());
+  }
+  server_ = builder.BuildAndStart();
+  if (!server_) {
+    throw std::runtime_error("Unable to start the server.");
+  }
+
+  search_pool_ = std::make_unique<util::ThreadPool>(options.search_threads);
+  for (auto& cq : cqs_) {
+    new SearchCall<SearchRequest, SearchResponse>(
+        *this, &*cq, &AsyncService::RequestSearch,
+        &NetspeakService::Service::Search);
+    new SearchCall<SearchBatchRequest, SearchBatchResponse>(
+        *this, &*cq, &AsyncService::RequestSearchBatch,
+        &NetspeakService::Service::SearchBatch);
+    new GetCorporaCall(*this, &*cq);
+    network_threads_.emplace_back([this, &cq]() { poll(&*cq); });
+  }
+}
+
+AsyncServer::~AsyncServer() {
+  shutting_down_ = true;
+  server_->Shutdown();
+  // All queued searches will still finish their calls, so the search threads
+  // have to be done before the completion queues can be shut down.
+  search_pool_.reset();
+  for (auto& cq : cqs_) {
+    cq->Shutdown();
+  }
+  for (auto& thread : network_threads_) {
+    thread.join();
+  }
+}
+
+void AsyncServer::wait() {
+  server_->Wait();
+}
+
+void AsyncServer::poll(grpc::ServerCompletionQueue* cq) {
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<Call*>(tag)->proceed(ok);
+  }
+}
+
+
+} // namespace service
+} // namespace netspeak
@@ -0,0 +1,126 @@
+#ifndef NETSPEAK_SERVICE_ASYNC_SERVER_HPP
+#define NETSPEAK_SERVICE_ASYNC_SERVER_HPP
+
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "netspeak/service/NetspeakService.grpc.pb.h"
+#include "netspeak/service/NetspeakService.pb.h"
+#include "netspeak/util/ThreadPool.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A gRPC server that handles the calls of a Netspeak service using
+ * completion queues instead of gRPC's synchronous thread pool.
+ *
+ * Calls are received on a number of completion queues, each of which is
+ * polled by its own network thread. Searches are then executed by a separate
+ * pool of search threads (one search thread per call, also for batches), so
+ * slow searches (e.g. because of blocking index
+ * I/O) never keep the network threads from accepting new calls.
+ *
+ * The number of searches waiting for a search thread is bounded. Searches
+ * that don't fit into the queue are rejected with \c RESOURCE_EXHAUSTED right
+ * away.
+ *
+ * Streaming searches (\c SearchStream) write their responses while they are
+ * searching, so they are forwarded to the service by gRPC's synchronous
+ * threads instead.
+ *
+ * The server is started by the constructor and shut down by the destructor.
+ */
+class AsyncServer {
+public:
+  struct Options {
+    /**
+     * @brief The number of completion queues and network threads.
+     */
+    size_t completion_queues;
+    /**
+     * @brief The number of threads executing searches.
+     */
+    size_t search_threads;
+    /**
+     * @brief The maximum number of searches waiting for a search thread.
+     */
+    size_t max_queued_searches;
+  };
+
+private:
+  /**
+   * @brief The service registered at the server.
+   *
+   * All unary methods are asynchronous. \c SearchStream is forwarded to the
+   * given service.
+   */
+  class AsyncService final
+      : public NetspeakService::WithAsyncMethod_Search<
+            NetspeakService::WithAsyncMethod_GetCorpora<
+                NetspeakService::WithAsyncMethod_SearchBatch<
+                    NetspeakService::Service>>> {
+  private:
+    NetspeakService::Service* service_;
+
+  public:
+    AsyncService(NetspeakService::Service* service) : service_(service) {}
+
+    grpc::Status SearchStream(
+        grpc::ServerContext* context, const SearchRequest* request,
+        grpc::ServerWriter<SearchResponse>* writer) override {
+      return service_->SearchStream(context, request, writer);
+    }
+  };
+
+  std::unique_ptr<NetspeakService::Service> service_;
+  AsyncService async_service_;
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+  std::unique_ptr<grpc::Server> server_;
+  std::unique_ptr<util::ThreadPool> search_pool_;
+  std::vector<std::thread> network_threads_;
+  size_t max_queued_searches_;
+  std::atomic<bool> shutting_down_;
+
+public:
+  AsyncServer() = delete;
+  AsyncServer(const AsyncServer&) = delete;
+  /**
+   * @brief Builds and starts a new server for the given service.
+   *
+   * The listening ports have to be added to the given builder beforehand.
+   *
+   * @param service The service handling all calls. Its methods have to be
+   * thread-safe.
+   * @param builder
+   * @param options
+   */
+  AsyncServer(std::unique_ptr<NetspeakService::Service> service,
+              grpc::ServerBuilder& builder, const Options& options);
+  ~AsyncServer();
+
+  /**
+   * @brief Blocks until the server is shut down.
+   */
+  void wait();
+
+private:
+  template <class Request, class Response>
+  friend class SearchCall;
+  friend class GetCorporaCall;
+
+  void poll(grpc::ServerCompletionQueue* cq);
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
@@ -0,0 +1,53 @@
+#include "netspeak/service/Backend.hpp"
+
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "netspeak/error.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+Backend::Backend(const std::string& address, size_t channels, double weight)
+    : address_(address),
+      weight_(weight),
+      channels_(),
+      stubs_(),
+      next_(0),
+      outstanding_(0) {
+  if (channels == 0) {
+    throw tracable_logic_error("A backend needs at least one channel.");
+  }
+  if (!(weight > 0)) {
+    throw tracable_logic_error("The weight of a backend has to be positive.");
+  }
+
+  for (size_t i = 0; i < channels; i++) {
+    // Channels with the same arguments share their connection unless each
+    // of them has its own subchannel pool.
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    auto channel = grpc::CreateCustomChannel(
+        address, grpc::InsecureChannelCredentials(), args);
+    channels_.push_back(channel);
+    stubs_.push_back(NetspeakService::NewStub(channel));
+  }
+}
+
+bool Backend::available() const {
+  for (const auto& channel : channels_) {
+    if (channel->GetState(false) != GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      return true;
+    }
+  }
+  return false;
+}
+
+NetspeakService::Stub& Backend::stub() const {
+  return *stubs_[next_++ % stubs_.size()];
+}
+
+} // namespace service
+} // namespace netspeak
@@ -0,0 +1,92 @@
+#ifndef NETSPEAK_SERVICE_BACKEND_HPP
+#define NETSPEAK_SERVICE_BACKEND_HPP
+
+
+#include <grpcpp/channel.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "netspeak/service/NetspeakService.grpc.pb.h"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A Netspeak server a proxy forwards requests to.
+ *
+ * gRPC multiplexes all calls of a channel over a single HTTP/2 connection,
+ * which becomes the bottleneck of a busy proxy. A backend therefore owns a
+ * pool of channels, each with its own connection, and spreads calls over them
+ * round robin.
+ *
+ * A backend also counts the calls that were forwarded to it but didn't finish
+ * yet, so that proxies can balance the load of their backends. Its weight is
+ * its share of the load relative to other backends, e.g. a backend with weight
+ * 2 is meant to handle twice as many searches as a backend with weight 1.
+ *
+ * All operations of this class are thread safe.
+ */
+class Backend {
+private:
+  std::string address_;
+  double weight_;
+  std::vector<std::shared_ptr<grpc::Channel>> channels_;
+  std::vector<std::unique_ptr<NetspeakService::Stub>> stubs_;
+  mutable std::atomic<size_t> next_;
+  std::atomic<size_t> outstanding_;
+
+public:
+  Backend() = delete;
+  Backend(const Backend&) = delete;
+  /**
+   * @brief Creates a new backend with the given number of channels to the
+   * server at the given address.
+   */
+  Backend(const std::string& address, size_t channels, double weight = 1);
+
+  const std::string& address() const {
+    return address_;
+  }
+  double weight() const {
+    return weight_;
+  }
+
+  /**
+   * @brief Returns whether the server is believed to be reachable.
+   *
+   * A server is unreachable while all channels failed to connect to it, e.g.
+   * while it restarts. This doesn't start any connection attempts.
+   */
+  bool available() const;
+
+  /**
+   * @brief Returns the stub of the next channel of the pool.
+   */
+  NetspeakService::Stub& stub() const;
+
+  /**
+   * @brief Returns the number of outstanding calls.
+   */
+  size_t outstanding() const {
+    return outstanding_;
+  }
+  /**
+   * @brief Counts a call as outstanding until \c end_call is called for it.
+   */
+  void begin_call() {
+    outstanding_++;
+  }
+  void end_call() {
+    outstanding_--;
+  }
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
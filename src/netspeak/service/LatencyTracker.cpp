@@ -0,0 +1,63 @@
+#include "netspeak/service/LatencyTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "netspeak/error.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+LatencyTracker::LatencyTracker(uint64_t max_samples)
+    : mutex_(), counts_(), samples_(0), max_samples_(max_samples) {
+  if (max_samples < 2) {
+    throw tracable_logic_error("A latency tracker needs at least 2 samples.");
+  }
+}
+
+void LatencyTracker::record(std::chrono::nanoseconds latency) {
+  const double ns = std::max<double>(1, latency.count());
+  const size_t bucket =
+      std::min(static_cast<size_t>(std::log2(ns) * BUCKETS_PER_POWER),
+               BUCKET_COUNT - 1);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (samples_ >= max_samples_) {
+    samples_ = 0;
+    for (auto& count : counts_) {
+      count /= 2;
+      samples_ += count;
+    }
+  }
+  counts_[bucket]++;
+  samples_++;
+}
+
+uint64_t LatencyTracker::samples() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return samples_;
+}
+
+std::chrono::nanoseconds LatencyTracker::percentile(double p) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (samples_ == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+
+  const double rank = std::min(std::max(p, 0.0), 100.0) * samples_ / 100;
+  uint64_t seen = 0;
+  size_t bucket = 0;
+  for (; bucket < BUCKET_COUNT - 1; bucket++) {
+    seen += counts_[bucket];
+    if (seen >= rank && seen > 0) {
+      break;
+    }
+  }
+  // the upper bound of the bucket
+  const double ns = std::exp2(double(bucket + 1) / BUCKETS_PER_POWER);
+  return std::chrono::nanoseconds(static_cast<int64_t>(std::ceil(ns)));
+}
+
+} // namespace service
+} // namespace netspeak
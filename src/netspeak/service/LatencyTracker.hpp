@@ -0,0 +1,59 @@
+#ifndef NETSPEAK_SERVICE_LATENCY_TRACKER_HPP
+#define NETSPEAK_SERVICE_LATENCY_TRACKER_HPP
+
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A histogram of recent latencies.
+ *
+ * Latencies are counted in logarithmic buckets with 4 buckets per power of
+ * two, so percentiles are accurate to about 19%. Once the histogram holds
+ * \c max_samples latencies, all counts are halved, so old latencies fade out.
+ *
+ * All operations of this class are thread safe.
+ */
+class LatencyTracker {
+private:
+  static const size_t BUCKETS_PER_POWER = 4;
+  // the last bucket ends at 2^42ns which is more than an hour
+  static const size_t BUCKET_COUNT = 42 * BUCKETS_PER_POWER;
+
+  mutable std::mutex mutex_;
+  std::array<uint64_t, BUCKET_COUNT> counts_;
+  uint64_t samples_;
+  uint64_t max_samples_;
+
+public:
+  LatencyTracker() = delete;
+  LatencyTracker(const LatencyTracker&) = delete;
+  explicit LatencyTracker(uint64_t max_samples);
+
+  void record(std::chrono::nanoseconds latency);
+
+  /**
+   * @brief Returns the number of latencies in the histogram.
+   */
+  uint64_t samples() const;
+
+  /**
+   * @brief Returns an upper bound of the given percentile (0-100) of all
+   * latencies in the histogram.
+   *
+   * If there are no latencies, zero will be returned.
+   */
+  std::chrono::nanoseconds percentile(double p) const;
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
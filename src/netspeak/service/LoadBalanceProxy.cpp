@@ -1,6 +1,12 @@
 #include "netspeak/service/LoadBalanceProxy.hpp"
 
+#include <array>
+#include <cmath>
+#include <future>
+
 #include "netspeak/error.hpp"
+#include "netspeak/service/corpora.hpp"
+#include "netspeak/util/checksum.hpp"
 #include "netspeak/util/service.hpp"
 
 namespace netspeak {
@@ -23,16 +29,16 @@ void check_compatible(const Corpus& a, const Corpus& b) {
   }
 }
 
-void initialize_from_stubs(
-    const LoadBalanceProxy::StubVector& stubs,
-    std::unordered_map<std::string, std::vector<LoadBalanceProxy::StubPtr>>&
+void initialize_from_backends(
+    const LoadBalanceProxy::BackendVector& backends,
+    std::unordered_map<std::string, std::vector<LoadBalanceProxy::BackendPtr>>&
         services,
     std::vector<Corpus>& corpora) {
   std::unordered_map<std::string, Corpus> corpora_map;
 
-  for (const auto& pair : stubs) {
+  for (const auto& pair : backends) {
     const auto& corpus = pair.first;
-    const auto& stub = pair.second;
+    const auto& backend = pair.second;
     const auto& key = corpus.key();
 
     // add or check the current corpus
@@ -44,20 +50,44 @@ void initialize_from_stubs(
       check_compatible(corpora_it->second, corpus);
     }
 
-    // add the stub
-    auto it = services.find(key);
-    if (it == services.end()) {
-      std::vector<LoadBalanceProxy::StubPtr> list{ stub };
-      services.emplace(key, list);
-    } else {
-      it->second.push_back(stub);
-    }
+    // add the backend
+    services[key].push_back(backend);
   }
 }
 
-LoadBalanceProxy::LoadBalanceProxy(const StubVector& stubs)
-    : services_(), corpora_() {
-  initialize_from_stubs(stubs, services_, corpora_);
+/**
+ * @brief The number of latencies of a corpus that are tracked.
+ */
+const uint64_t TRACKED_LATENCIES = 10000;
+/**
+ * @brief The minimum number of latencies of a corpus before its searches are
+ * hedged.
+ */
+const uint64_t MIN_HEDGE_LATENCIES = 100;
+
+LoadBalanceProxy::LoadBalanceProxy(const BackendVector& backends)
+    : LoadBalanceProxy(backends, Options()) {}
+LoadBalanceProxy::LoadBalanceProxy(const BackendVector& backends,
+                                   const Options& options)
+    : services_(), corpora_(), options_(options), latencies_(), cache_() {
+  if (!(options.load_factor >= 1)) {
+    throw tracable_logic_error("The load factor has to be at least 1.");
+  }
+  if (!(options.hedge_percentile >= 0 && options.hedge_percentile < 100)) {
+    throw tracable_logic_error(
+        "The hedge percentile has to be at least 0 and less than 100.");
+  }
+
+  initialize_from_backends(backends, services_, corpora_);
+  if (options.hedge_percentile > 0) {
+    for (const auto& corpus : corpora_) {
+      latencies_.emplace(corpus.key(),
+                         std::make_unique<LatencyTracker>(TRACKED_LATENCIES));
+    }
+  }
+  if (options.cache.max_bytes > 0) {
+    cache_ = std::make_unique<ResponseCache>(options.cache);
+  }
 }
 
 
@@ -78,38 +108,517 @@ uint64_t bit_mix(uint64_t x) {
   return x * UINT64_C(0x2545F4914F6CDD1D);
 }
 
-grpc::Status LoadBalanceProxy::Search_(grpc::ServerContext*,
+/**
+ * @brief Returns the weighted rendezvous score of the given service for a
+ * query with the given (mixed) hash.
+ *
+ * The score is `-weight / ln(u)` where `u` is uniformly distributed in (0, 1).
+ * Each service therefore has the highest score for a share of all queries
+ * that's proportional to its weight.
+ *
+ * @param hash
+ * @param service
+ */
+double rendezvous_score(uint64_t hash, const Backend& service) {
+  const auto mixed = bit_mix(hash ^ util::hash64(service.address()));
+  // the upper 53 bits as a double in (0, 1)
+  const double u = (double(mixed >> 11) + 0.5) / double(UINT64_C(1) << 53);
+  return -service.weight() / std::log(u);
+}
+
+/**
+ * @brief Returns the service a search for the given request will be forwarded
+ * to.
+ *
+ * @param services A non-empty list of services.
+ * @param request
+ * @param load_factor
+ * @param exclude
+ */
+Backend* choose_service(
+    const std::vector<LoadBalanceProxy::BackendPtr>& services,
+    const SearchRequest& request, double load_factor, const Backend* exclude) {
+  if (services.size() == 1) {
+    // There's only one service available, so just forward the request.
+    return services[0].get();
+  }
+
+  // There are at least two services, so we have to choose which one to
+  // forward to. To be more cache friendly, every query prefers the services in
+  // an order given by the hash of the query and the address of the service
+  // (weighted rendezvous hashing). Adding, removing, or restarting a service
+  // only moves the queries that preferred it, so the caches of all other
+  // services stay warm.
+  // The hash will then be processed further to prevent bad hashes. This extra
+  // processing is necessary as an attacker could exploit weaknesses in the
+  // hash function provided by C++ to redirect a huge workload to one service.
+  //
+  // To bound the load of each service, a service isn't chosen while it has
+  // more than `load_factor` times its weighted share of all outstanding calls
+  // (including this one). At least one service is always below that bound.
+  const auto hash = bit_mix(std::hash<std::string>{}(request.query()));
+
+  // Unreachable services are skipped unless all other services are
+  // unreachable too.
+  std::vector<Backend*> candidates;
+  candidates.reserve(services.size());
+  for (const auto& service : services) {
+    if (service.get() != exclude && service->available()) {
+      candidates.push_back(service.get());
+    }
+  }
+  if (candidates.empty()) {
+    for (const auto& service : services) {
+      if (service.get() != exclude) {
+        candidates.push_back(service.get());
+      }
+    }
+  }
+
+  double total = 1;
+  double total_weight = 0;
+  for (const auto service : candidates) {
+    total += double(service->outstanding());
+    total_weight += service->weight();
+  }
+
+  Backend* best = nullptr;
+  double best_score = 0;
+  Backend* least_loaded = nullptr;
+  double least_load = 0;
+  for (const auto service : candidates) {
+    const auto outstanding = double(service->outstanding());
+    const auto load = outstanding / service->weight();
+    if (!least_loaded || load < least_load) {
+      least_loaded = service;
+      least_load = load;
+    }
+    const auto bound =
+        std::ceil(load_factor * total * service->weight() / total_weight);
+    if (outstanding < bound) {
+      const auto score = rendezvous_score(hash, *service);
+      if (!best || score > best_score) {
+        best = service;
+        best_score = score;
+      }
+    }
+  }
+  return best ? best : least_loaded;
+}
+
+Backend* LoadBalanceProxy::route(const SearchRequest& request,
+                                 const Backend* exclude) const {
+  auto it = services_.find(request.corpus());
+  if (it == services_.end()) {
+    return nullptr;
+  }
+  return choose_service(it->second, request, options_.load_factor, exclude);
+}
+
+std::chrono::nanoseconds LoadBalanceProxy::hedge_delay(
+    const SearchRequest& request) const {
+  auto it = latencies_.find(request.corpus());
+  if (it == latencies_.end() || services_.at(it->first).size() < 2 ||
+      it->second->samples() < MIN_HEDGE_LATENCIES) {
+    return std::chrono::nanoseconds(0);
+  }
+  return it->second->percentile(options_.hedge_percentile);
+}
+
+void LoadBalanceProxy::record_latency(const SearchRequest& request,
+                                      std::chrono::nanoseconds latency) const {
+  auto it = latencies_.find(request.corpus());
+  if (it != latencies_.end()) {
+    it->second->record(latency);
+  }
+}
+
+bool LoadBalanceProxy::is_cacheable(const SearchResponse& response) {
+  // Errors (e.g. unknown corpora) are cheap to compute, so they aren't worth
+  // the space.
+  if (response.has_error()) {
+    return false;
+  }
+  // The stats of debug requests describe a single search.
+  if (response.has_stats()) {
+    return false;
+  }
+  for (const auto& corpus_response : response.corpus_responses()) {
+    if (corpus_response.has_error() || corpus_response.has_stats()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::unique_ptr<LoadBalanceProxy::CorpusSearch>>
+LoadBalanceProxy::split_corpora(const SearchRequest& request,
+                                SearchResponse& response) const {
+  std::vector<std::unique_ptr<CorpusSearch>> searches;
+  if (!check_corpora(request, response)) {
+    return searches;
+  }
+
+  const auto& corpora = request.corpora();
+  auto& responses = *response.mutable_corpus_responses();
+  responses.Reserve(corpora.size());
+  for (int i = 0; i < corpora.size(); i++) {
+    auto resp = responses.Add();
+
+    auto search = std::make_unique<CorpusSearch>();
+    search->request.CopyFrom(request);
+    search->request.clear_corpora();
+    search->request.set_corpus(corpora[i]);
+    search->index = i;
+    search->backend = route(search->request);
+    if (!search->backend) {
+      auto error = resp->mutable_error();
+      error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+      error->set_message("Unknown corpus");
+      continue;
+    }
+    searches.push_back(std::move(search));
+  }
+  return searches;
+}
+
+grpc::Status LoadBalanceProxy::Search_(grpc::ServerContext* context,
                                        const SearchRequest* request,
                                        SearchResponse* response) const {
-  const auto& services_ref = services_;
+  if (!cache_) {
+    return ForwardSearch_(context, request, response);
+  }
+
+  const auto key = request->SerializeAsString();
+  ResponseCache::Bytes bytes;
+  auto promise = std::make_shared<std::promise<ResponseCache::Bytes>>();
+  auto lookup = cache_->lookup(key, bytes, [promise](const auto& filled) {
+    promise->set_value(filled);
+  });
+
+  switch (lookup) {
+    case ResponseCache::Lookup::HIT:
+      response->ParseFromString(*bytes);
+      return grpc::Status::OK;
+
+    case ResponseCache::Lookup::PENDING: {
+      // wait for the search of another call
+      auto future = promise->get_future();
+      const auto deadline = context->deadline();
+      if (deadline == std::chrono::system_clock::time_point::max()) {
+        future.wait();
+      } else if (future.wait_until(deadline) == std::future_status::timeout) {
+        return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED,
+                            "Deadline exceeded");
+      }
+      bytes = future.get();
+      if (bytes) {
+        response->ParseFromString(*bytes);
+        return grpc::Status::OK;
+      }
+      // the response of the other call can't be used
+      return ForwardSearch_(context, request, response);
+    }
+
+    default: {
+      auto status = ForwardSearch_(context, request, response);
+      if (status.ok() && is_cacheable(*response)) {
+        bytes = std::make_shared<const std::string>(
+            response->SerializeAsString());
+      }
+      cache_->fill(key, bytes);
+      return status;
+    }
+  }
+}
+
+grpc::Status LoadBalanceProxy::ForwardSearch_(grpc::ServerContext* context,
+                                              const SearchRequest* request,
+                                              SearchResponse* response) const {
+  if (request->corpora_size() != 0) {
+    return ForwardCorpora_(context, request, response);
+  }
 
-  auto it = services_ref.find(request->corpus());
+  auto backend = route(*request);
   // check the corpus
-  if (it == services_ref.end()) {
+  if (!backend) {
     auto error = response->mutable_error();
     error->set_kind(SearchResponse::Error::INVALID_CORPUS);
     error->set_message("Unknown corpus");
     return grpc::Status::OK;
   }
 
-  const auto& services = it->second;
+  const auto delay = hedge_delay(*request);
+  if (delay.count() > 0) {
+    return HedgedSearch_(context, request, response, backend, delay);
+  }
 
-  grpc::ClientContext context;
-  if (services.size() == 1) {
-    // There's only one service available, so just forward the request.
-    return services[0]->Search(&context, *request, response);
-  } else {
-    // There are at least two services, so we have to choose which one to
-    // forward to. To be more cache friendly, the service will be chosen based
-    // on the hash of the query.
-    // The hash will then be processed further to prevent bad hashes. This extra
-    // processing is necessary as an attacker could exploit weaknesses in the
-    // hash function provided by C++ to redirect a huge workload to one service.
+  const auto start = std::chrono::steady_clock::now();
+  auto client_context = grpc::ClientContext::FromServerContext(*context);
+  backend->begin_call();
+  auto status =
+      backend->stub().Search(client_context.get(), *request, response);
+  backend->end_call();
+  if (status.ok()) {
+    record_latency(*request, std::chrono::steady_clock::now() - start);
+  }
+  return status;
+}
+
+grpc::Status LoadBalanceProxy::ForwardCorpora_(
+    grpc::ServerContext* context, const SearchRequest* request,
+    SearchResponse* response) const {
+  struct call {
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SearchResponse>> reader;
+    SearchResponse response;
+    grpc::Status status;
+  };
+
+  const auto searches = split_corpora(*request, *response);
+
+  // forward all searches at once and wait for all of them
+  std::vector<call> calls(searches.size());
+  grpc::CompletionQueue cq;
+  for (size_t i = 0; i < searches.size(); i++) {
+    auto& c = calls[i];
+    c.context = grpc::ClientContext::FromServerContext(*context);
+    searches[i]->backend->begin_call();
+    c.reader = searches[i]->backend->stub().AsyncSearch(
+        c.context.get(), searches[i]->request, &cq);
+    c.reader->Finish(&c.response, &c.status, &c);
+  }
+  void* tag;
+  bool ok;
+  for (size_t i = 0; i < calls.size(); i++) {
+    cq.Next(&tag, &ok);
+  }
+  cq.Shutdown();
+  while (cq.Next(&tag, &ok)) {
+  }
+  for (const auto& search : searches) {
+    search->backend->end_call();
+  }
+
+  // merge the responses
+  auto& responses = *response->mutable_corpus_responses();
+  for (size_t i = 0; i < searches.size(); i++) {
+    auto& c = calls[i];
+    auto& resp = responses[searches[i]->index];
+    if (c.status.ok()) {
+      resp.Swap(&c.response);
+    } else {
+      set_corpus_error(c.status, resp);
+    }
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status LoadBalanceProxy::HedgedSearch_(
+    grpc::ServerContext* context, const SearchRequest* request,
+    SearchResponse* response, Backend* backend,
+    std::chrono::nanoseconds delay) const {
+  struct attempt {
+    Backend* backend;
+    std::chrono::steady_clock::time_point start;
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SearchResponse>> reader;
+    SearchResponse response;
+    grpc::Status status;
+  };
+
+  std::array<attempt, 2> attempts;
+  size_t started = 0;
+  size_t pending = 0;
+  grpc::CompletionQueue cq;
+  const auto forward = [&](Backend* b) {
+    auto& a = attempts[started++];
+    a.backend = b;
+    a.start = std::chrono::steady_clock::now();
+    a.context = grpc::ClientContext::FromServerContext(*context);
+    b->begin_call();
+    a.reader = b->stub().AsyncSearch(a.context.get(), *request, &cq);
+    a.reader->Finish(&a.response, &a.status, &a);
+    pending++;
+  };
+
+  // Wait for the first backend until the delay passed, then hedge. The first
+  // successful response wins. A failed response only wins if there's no other
+  // pending call, so errors aren't hedged before the delay passed.
+  // gRPC deadlines have to be system clock time points
+  const auto hedge_time =
+      std::chrono::system_clock::now() +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(delay);
+  forward(backend);
+  attempt* winner = nullptr;
+  void* tag;
+  bool ok;
+  while (!winner) {
+    if (started == 1) {
+      auto next = cq.AsyncNext(&tag, &ok, hedge_time);
+      if (next == grpc::CompletionQueue::TIMEOUT) {
+        forward(route(*request, backend));
+        continue;
+      }
+    } else {
+      cq.Next(&tag, &ok);
+    }
+    auto a = static_cast<attempt*>(tag);
+    a->backend->end_call();
+    pending--;
+    if (a->status.ok() || pending == 0) {
+      winner = a;
+    }
+  }
+
+  // cancel the loser and wait for it
+  for (size_t i = 0; i < started; i++) {
+    if (&attempts[i] != winner) {
+      attempts[i].context->TryCancel();
+    }
+  }
+  while (pending > 0) {
+    cq.Next(&tag, &ok);
+    static_cast<attempt*>(tag)->backend->end_call();
+    pending--;
+  }
+  cq.Shutdown();
+  while (cq.Next(&tag, &ok)) {
+  }
+
+  if (winner->status.ok()) {
+    record_latency(*request, std::chrono::steady_clock::now() - winner->start);
+    response->Swap(&winner->response);
+  }
+  return winner->status;
+}
+
+grpc::Status LoadBalanceProxy::SearchStream_(
+    grpc::ServerContext* context, const SearchRequest* request,
+    grpc::ServerWriter<SearchResponse>* writer) const {
+  auto backend = route(*request);
+  // check the corpus
+  if (!backend) {
+    SearchResponse response;
+    auto error = response.mutable_error();
+    error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+    error->set_message("Unknown corpus");
+    writer->Write(response);
+    return grpc::Status::OK;
+  }
+
+  auto client_context = grpc::ClientContext::FromServerContext(*context);
+  backend->begin_call();
+  auto reader = backend->stub().SearchStream(client_context.get(), *request);
+  SearchResponse response;
+  while (reader->Read(&response)) {
+    if (!writer->Write(response)) {
+      // the client is gone, so the search can stop
+      client_context->TryCancel();
+      break;
+    }
+  }
+  auto status = reader->Finish();
+  backend->end_call();
+  return status;
+}
+
+std::vector<std::unique_ptr<LoadBalanceProxy::SubBatch>>
+LoadBalanceProxy::split_batch(const SearchBatchRequest& request,
+                              SearchBatchResponse& response) const {
+  const auto& requests = request.requests();
+  auto& responses = *response.mutable_responses();
+  responses.Reserve(requests.size());
+
+  std::vector<std::unique_ptr<SubBatch>> batches;
+  std::unordered_map<Backend*, SubBatch*> batch_map;
+  for (int i = 0; i < requests.size(); i++) {
+    const auto& req = requests[i];
+    auto resp = responses.Add();
 
-    const auto hash = std::hash<std::string>{}(request->query());
-    const auto index = bit_mix(hash) % services.size();
-    return services[index]->Search(&context, *request, response);
+    auto backend = route(req);
+    if (!backend) {
+      auto error = resp->mutable_error();
+      error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+      error->set_message("Unknown corpus");
+      continue;
+    }
+
+    auto& batch = batch_map[backend];
+    if (!batch) {
+      batches.push_back(std::make_unique<SubBatch>());
+      batch = batches.back().get();
+      batch->backend = backend;
+    }
+    batch->request.add_requests()->CopyFrom(req);
+    batch->indexes.push_back(i);
   }
+  return batches;
+}
+
+grpc::Status LoadBalanceProxy::merge_batch(const SubBatch& batch,
+                                           SearchBatchResponse& batch_response,
+                                           SearchBatchResponse& response) {
+  auto& batch_responses = *batch_response.mutable_responses();
+  if (batch_responses.size() != static_cast<int>(batch.indexes.size())) {
+    return grpc::Status(grpc::StatusCode::INTERNAL,
+                        "Invalid number of batch responses");
+  }
+  auto& responses = *response.mutable_responses();
+  for (size_t j = 0; j < batch.indexes.size(); j++) {
+    responses[batch.indexes[j]].Swap(&batch_responses[j]);
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status LoadBalanceProxy::SearchBatch_(
+    grpc::ServerContext* context, const SearchBatchRequest* request,
+    SearchBatchResponse* response) const {
+  struct call {
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<SearchBatchResponse>>
+        reader;
+    SearchBatchResponse response;
+    grpc::Status status;
+  };
+
+  const auto batches = split_batch(*request, *response);
+
+  // forward all batches at once and wait for all of them
+  std::vector<call> calls(batches.size());
+  grpc::CompletionQueue cq;
+  for (size_t i = 0; i < batches.size(); i++) {
+    auto& c = calls[i];
+    c.context = grpc::ClientContext::FromServerContext(*context);
+    batches[i]->backend->begin_call();
+    c.reader = batches[i]->backend->stub().AsyncSearchBatch(
+        c.context.get(), batches[i]->request, &cq);
+    c.reader->Finish(&c.response, &c.status, &c);
+  }
+  void* tag;
+  bool ok;
+  for (size_t i = 0; i < calls.size(); i++) {
+    cq.Next(&tag, &ok);
+  }
+  cq.Shutdown();
+  while (cq.Next(&tag, &ok)) {
+  }
+  for (const auto& batch : batches) {
+    batch->backend->end_call();
+  }
+
+  // merge the responses
+  for (size_t i = 0; i < batches.size(); i++) {
+    auto& c = calls[i];
+    if (!c.status.ok()) {
+      return c.status;
+    }
+    auto status = merge_batch(*batches[i], c.response, *response);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return grpc::Status::OK;
 }
 
 grpc::Status LoadBalanceProxy::GetCorpora_(grpc::ServerContext*,
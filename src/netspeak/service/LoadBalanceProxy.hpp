@@ -2,11 +2,16 @@
 #define NETSPEAK_SERVICE_LOAD_BALANCE_PROXY_HPP
 
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
+#include "netspeak/service/Backend.hpp"
+#include "netspeak/service/LatencyTracker.hpp"
 #include "netspeak/service/NetspeakService.grpc.pb.h"
 #include "netspeak/service/NetspeakService.pb.h"
+#include "netspeak/service/ResponseCache.hpp"
 
 
 namespace netspeak {
@@ -19,21 +24,104 @@ namespace service {
  * Two indexes are compatible if their corpus key is different or if all their
  * coprus information (key, language, name) is equal.
  *
+ * Searches are routed by consistent hashing with bounded loads: each query
+ * prefers the backends of its corpus in a fixed order (weighted rendezvous
+ * hashing), so searches for the same query hit the same caches, but a backend
+ * is skipped while it has more than \c load_factor times its weighted share of
+ * the outstanding calls of its corpus. If all backends are skipped, the
+ * backend with the fewest outstanding calls per weight is chosen. A slow
+ * backend therefore quickly stops getting new searches. Adding or removing a
+ * backend only moves the queries that prefer it, and unreachable backends
+ * (e.g. during a rolling restart) are skipped until they're back.
+ *
+ * Optionally, searches are hedged: if a backend didn't respond after the
+ * \c hedge_percentile of recent latencies of its corpus, the search is sent to
+ * a second backend too. The first successful response wins and the other call
+ * is cancelled.
+ *
+ * Optionally, successful responses of single searches are cached. Identical
+ * requests that arrive while a response is being computed wait for it instead
+ * of being forwarded too.
+ *
+ * A search in multiple corpora is split into one search per corpus and all of
+ * them are forwarded concurrently. These searches aren't hedged, but the
+ * combined response is cached like any other.
+ *
+ * The requests of a batch are split into one batch per index. Each request is
+ * forwarded to the index a single search for it would be forwarded to and all
+ * batches are forwarded concurrently. The responses of a streaming search are
+ * relayed as soon as they arrive. The deadline of a call is propagated to the
+ * forwarded calls and cancelling a call cancels them too.
+ *
+ * The service itself forwards synchronously, i.e. each call blocks a server
+ * thread until its backend responded. \c AsyncProxyServer uses the routing of
+ * this class to forward without blocking.
+ *
  * All operations of this class are thread safe.
  */
 class LoadBalanceProxy final : public NetspeakService::Service {
 public:
-  typedef std::shared_ptr<NetspeakService::Stub> StubPtr;
-  typedef std::vector<std::pair<Corpus, StubPtr>> StubVector;
+  typedef std::shared_ptr<Backend> BackendPtr;
+  typedef std::vector<std::pair<Corpus, BackendPtr>> BackendVector;
+
+  /**
+   * @brief The requests of a batch that are forwarded to the same backend.
+   */
+  struct SubBatch {
+    Backend* backend;
+    SearchBatchRequest request;
+    /**
+     * @brief The index of each request in the original batch.
+     */
+    std::vector<int> indexes;
+  };
+
+  /**
+   * @brief The search in a single corpus of a search in multiple corpora.
+   */
+  struct CorpusSearch {
+    Backend* backend;
+    SearchRequest request;
+    /**
+     * @brief The index of the corpus in the original request.
+     */
+    int index;
+  };
+
+  struct Options {
+    /**
+     * @brief The maximum number of outstanding calls of a backend relative to
+     * the average of its corpus before searches are routed away from it.
+     *
+     * Values close to 1 balance the load more evenly, larger values keep more
+     * queries on their preferred backend.
+     */
+    double load_factor = 1.25;
+    /**
+     * @brief The percentile (0-100) of recent latencies after which a search
+     * is hedged.
+     *
+     * 0 disables hedging.
+     */
+    double hedge_percentile = 0;
+    /**
+     * @brief The response cache. A budget of 0 bytes disables it.
+     */
+    ResponseCache::Options cache;
+  };
 
 private:
-  std::unordered_map<std::string, std::vector<StubPtr>> services_;
+  std::unordered_map<std::string, std::vector<BackendPtr>> services_;
   std::vector<Corpus> corpora_;
+  Options options_;
+  std::unordered_map<std::string, std::unique_ptr<LatencyTracker>> latencies_;
+  std::unique_ptr<ResponseCache> cache_;
 
 public:
   LoadBalanceProxy() = delete;
   LoadBalanceProxy(const LoadBalanceProxy&) = delete;
-  LoadBalanceProxy(const StubVector& stubs);
+  LoadBalanceProxy(const BackendVector& backends);
+  LoadBalanceProxy(const BackendVector& backends, const Options& options);
   ~LoadBalanceProxy() override {}
   grpc::Status Search(grpc::ServerContext* context,
                       const SearchRequest* request,
@@ -45,6 +133,16 @@ public:
                           CorporaResponse* response) override {
     return GetCorpora_(context, request, response);
   }
+  grpc::Status SearchBatch(grpc::ServerContext* context,
+                           const SearchBatchRequest* request,
+                           SearchBatchResponse* response) override {
+    return SearchBatch_(context, request, response);
+  }
+  grpc::Status SearchStream(
+      grpc::ServerContext* context, const SearchRequest* request,
+      grpc::ServerWriter<SearchResponse>* writer) override {
+    return SearchStream_(context, request, writer);
+  }
 
 private:
   // These functions exists because we cannot declare the override as `const`.
@@ -54,11 +152,117 @@ private:
   grpc::Status Search_(grpc::ServerContext* context,
                        const SearchRequest* request,
                        SearchResponse* response) const;
+  grpc::Status ForwardSearch_(grpc::ServerContext* context,
+                              const SearchRequest* request,
+                              SearchResponse* response) const;
+  grpc::Status ForwardCorpora_(grpc::ServerContext* context,
+                               const SearchRequest* request,
+                               SearchResponse* response) const;
+  grpc::Status HedgedSearch_(grpc::ServerContext* context,
+                             const SearchRequest* request,
+                             SearchResponse* response, Backend* backend,
+                             std::chrono::nanoseconds delay) const;
   grpc::Status GetCorpora_(grpc::ServerContext* context,
                            const CorporaRequest* request,
                            CorporaResponse* response) const;
+  grpc::Status SearchBatch_(grpc::ServerContext* context,
+                            const SearchBatchRequest* request,
+                            SearchBatchResponse* response) const;
+  grpc::Status SearchStream_(grpc::ServerContext* context,
+                             const SearchRequest* request,
+                             grpc::ServerWriter<SearchResponse>* writer) const;
 
 public:
+  /**
+   * @brief Returns the backend a search for the given request is forwarded to
+   * or \c nullptr if the corpus of the request is unknown.
+   *
+   * The backend is chosen based on the current number of outstanding calls of
+   * all backends, so callers have to count their calls using
+   * \c Backend::begin_call and \c Backend::end_call.
+   *
+   * @param request
+   * @param exclude A backend that won't be returned unless it's the only
+   * backend of the corpus, e.g. the backend a search is hedged against.
+   */
+  Backend* route(const SearchRequest& request,
+                 const Backend* exclude = nullptr) const;
+
+  /**
+   * @brief Returns the time after which a search for the given request should
+   * be hedged or zero if it shouldn't be hedged.
+   *
+   * Searches aren't hedged if hedging is disabled, if the corpus has only one
+   * backend, or if too few latencies were recorded for the corpus.
+   *
+   * @param request
+   */
+  std::chrono::nanoseconds hedge_delay(const SearchRequest& request) const;
+
+  /**
+   * @brief Records the latency of a successful search for the given request.
+   *
+   * This does nothing if hedging is disabled.
+   *
+   * @param request
+   * @param latency
+   */
+  void record_latency(const SearchRequest& request,
+                      std::chrono::nanoseconds latency) const;
+
+  /**
+   * @brief Returns the response cache or \c nullptr if responses aren't
+   * cached.
+   */
+  ResponseCache* cache() const {
+    return cache_.get();
+  }
+  /**
+   * @brief Returns whether the given response of a successful search may be
+   * cached.
+   *
+   * @param response
+   */
+  static bool is_cacheable(const SearchResponse& response);
+
+  /**
+   * @brief Splits the given search in multiple corpora into one search per
+   * corpus.
+   *
+   * \c response gets one corpus response per corpus. The responses of unknown
+   * corpora are set to an error, all others are left empty. If the request
+   * is invalid, the error is set in \c response and no searches are returned.
+   *
+   * @param request
+   * @param response
+   */
+  std::vector<std::unique_ptr<CorpusSearch>> split_corpora(
+      const SearchRequest& request, SearchResponse& response) const;
+
+  /**
+   * @brief Splits the given batch into one batch per backend.
+   *
+   * \c response gets one response per request. The responses of requests for
+   * unknown corpora are set to an error, all others are left empty.
+   *
+   * @param request
+   * @param response
+   */
+  std::vector<std::unique_ptr<SubBatch>> split_batch(
+      const SearchBatchRequest& request, SearchBatchResponse& response) const;
+
+  /**
+   * @brief Moves the responses of the given sub-batch to their place in the
+   * response of the original batch.
+   *
+   * @param batch
+   * @param batch_response The response of the backend for the sub-batch.
+   * @param response
+   */
+  static grpc::Status merge_batch(const SubBatch& batch,
+                                  SearchBatchResponse& batch_response,
+                                  SearchBatchResponse& response);
+
   /**
    * @brief Returns the whether the two corpora are compatible by the definition
    * of this proxy.
@@ -25,6 +25,8 @@ namespace service {
 static const char* NetspeakService_method_names[] = {
   "/netspeak.service.NetspeakService/Search",
   "/netspeak.service.NetspeakService/GetCorpora",
+  "/netspeak.service.NetspeakService/SearchBatch",
+  "/netspeak.service.NetspeakService/SearchStream",
 };
 
 std::unique_ptr< NetspeakService::Stub> NetspeakService::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -36,6 +38,8 @@ std::unique_ptr< NetspeakService::Stub> NetspeakService::NewStub(const std::shar
 NetspeakService::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel)
   : channel_(channel), rpcmethod_Search_(NetspeakService_method_names[0], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_GetCorpora_(NetspeakService_method_names[1], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_SearchBatch_(NetspeakService_method_names[2], ::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_SearchStream_(NetspeakService_method_names[3], ::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
   {}
 
 ::grpc::Status NetspeakService::Stub::Search(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::netspeak::service::SearchResponse* response) {
@@ -94,6 +98,50 @@ void NetspeakService::Stub::experimental_async::GetCorpora(::grpc::ClientContext
   return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::netspeak::service::CorporaResponse>::Create(channel_.get(), cq, rpcmethod_GetCorpora_, context, request, false);
 }
 
+::grpc::Status NetspeakService::Stub::SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::netspeak::service::SearchBatchResponse* response) {
+  return ::grpc::internal::BlockingUnaryCall(channel_.get(), rpcmethod_SearchBatch_, context, request, response);
+}
+
+void NetspeakService::Stub::experimental_async::SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_SearchBatch_, context, request, response, std::move(f));
+}
+
+void NetspeakService::Stub::experimental_async::SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, std::function<void(::grpc::Status)> f) {
+  ::grpc_impl::internal::CallbackUnaryCall(stub_->channel_.get(), stub_->rpcmethod_SearchBatch_, context, request, response, std::move(f));
+}
+
+void NetspeakService::Stub::experimental_async::SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_SearchBatch_, context, request, response, reactor);
+}
+
+void NetspeakService::Stub::experimental_async::SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) {
+  ::grpc_impl::internal::ClientCallbackUnaryFactory::Create(stub_->channel_.get(), stub_->rpcmethod_SearchBatch_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>* NetspeakService::Stub::AsyncSearchBatchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::netspeak::service::SearchBatchResponse>::Create(channel_.get(), cq, rpcmethod_SearchBatch_, context, request, true);
+}
+
+::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>* NetspeakService::Stub::PrepareAsyncSearchBatchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncResponseReaderFactory< ::netspeak::service::SearchBatchResponse>::Create(channel_.get(), cq, rpcmethod_SearchBatch_, context, request, false);
+}
+
+::grpc::ClientReader< ::netspeak::service::SearchResponse>* NetspeakService::Stub::SearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request) {
+  return ::grpc_impl::internal::ClientReaderFactory< ::netspeak::service::SearchResponse>::Create(channel_.get(), rpcmethod_SearchStream_, context, request);
+}
+
+void NetspeakService::Stub::experimental_async::SearchStream(::grpc::ClientContext* context, ::netspeak::service::SearchRequest* request, ::grpc::experimental::ClientReadReactor< ::netspeak::service::SearchResponse>* reactor) {
+  ::grpc_impl::internal::ClientCallbackReaderFactory< ::netspeak::service::SearchResponse>::Create(stub_->channel_.get(), stub_->rpcmethod_SearchStream_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>* NetspeakService::Stub::AsyncSearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc_impl::internal::ClientAsyncReaderFactory< ::netspeak::service::SearchResponse>::Create(channel_.get(), cq, rpcmethod_SearchStream_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>* NetspeakService::Stub::PrepareAsyncSearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc_impl::internal::ClientAsyncReaderFactory< ::netspeak::service::SearchResponse>::Create(channel_.get(), cq, rpcmethod_SearchStream_, context, request, false, nullptr);
+}
+
 NetspeakService::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       NetspeakService_method_names[0],
@@ -105,6 +153,16 @@ NetspeakService::Service::Service() {
       ::grpc::internal::RpcMethod::NORMAL_RPC,
       new ::grpc::internal::RpcMethodHandler< NetspeakService::Service, ::netspeak::service::CorporaRequest, ::netspeak::service::CorporaResponse>(
           std::mem_fn(&NetspeakService::Service::GetCorpora), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      NetspeakService_method_names[2],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< NetspeakService::Service, ::netspeak::service::SearchBatchRequest, ::netspeak::service::SearchBatchResponse>(
+          std::mem_fn(&NetspeakService::Service::SearchBatch), this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      NetspeakService_method_names[3],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< NetspeakService::Service, ::netspeak::service::SearchRequest, ::netspeak::service::SearchResponse>(
+          std::mem_fn(&NetspeakService::Service::SearchStream), this)));
 }
 
 NetspeakService::Service::~Service() {
@@ -124,6 +182,20 @@ NetspeakService::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status NetspeakService::Service::SearchBatch(::grpc::ServerContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status NetspeakService::Service::SearchStream(::grpc::ServerContext* context, const ::netspeak::service::SearchRequest* request, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace netspeak
 }  // namespace service
@@ -51,6 +51,22 @@ class NetspeakService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::CorporaResponse>> PrepareAsyncGetCorpora(::grpc::ClientContext* context, const ::netspeak::service::CorporaRequest& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::CorporaResponse>>(PrepareAsyncGetCorporaRaw(context, request, cq));
     }
+    virtual ::grpc::Status SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::netspeak::service::SearchBatchResponse* response) = 0;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchBatchResponse>> AsyncSearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchBatchResponse>>(AsyncSearchBatchRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchBatchResponse>> PrepareAsyncSearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchBatchResponse>>(PrepareAsyncSearchBatchRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::netspeak::service::SearchResponse>> SearchStream(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::netspeak::service::SearchResponse>>(SearchStreamRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::netspeak::service::SearchResponse>> AsyncSearchStream(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::netspeak::service::SearchResponse>>(AsyncSearchStreamRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::netspeak::service::SearchResponse>> PrepareAsyncSearchStream(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::netspeak::service::SearchResponse>>(PrepareAsyncSearchStreamRaw(context, request, cq));
+    }
     class experimental_async_interface {
      public:
       virtual ~experimental_async_interface() {}
@@ -78,6 +94,23 @@ class NetspeakService final {
       #else
       virtual void GetCorpora(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::CorporaResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
       #endif
+      virtual void SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, std::function<void(::grpc::Status)>) = 0;
+      virtual void SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, std::function<void(::grpc::Status)>) = 0;
+      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      virtual void SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      #else
+      virtual void SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
+      #endif
+      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      virtual void SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      #else
+      virtual void SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) = 0;
+      #endif
+      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      virtual void SearchStream(::grpc::ClientContext* context, ::netspeak::service::SearchRequest* request, ::grpc::ClientReadReactor< ::netspeak::service::SearchResponse>* reactor) = 0;
+      #else
+      virtual void SearchStream(::grpc::ClientContext* context, ::netspeak::service::SearchRequest* request, ::grpc::experimental::ClientReadReactor< ::netspeak::service::SearchResponse>* reactor) = 0;
+      #endif
     };
     #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
     typedef class experimental_async_interface async_interface;
@@ -91,6 +124,11 @@ class NetspeakService final {
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchResponse>* PrepareAsyncSearchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::CorporaResponse>* AsyncGetCorporaRaw(::grpc::ClientContext* context, const ::netspeak::service::CorporaRequest& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::CorporaResponse>* PrepareAsyncGetCorporaRaw(::grpc::ClientContext* context, const ::netspeak::service::CorporaRequest& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchBatchResponse>* AsyncSearchBatchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::netspeak::service::SearchBatchResponse>* PrepareAsyncSearchBatchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::netspeak::service::SearchResponse>* SearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::netspeak::service::SearchResponse>* AsyncSearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::netspeak::service::SearchResponse>* PrepareAsyncSearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -109,6 +147,22 @@ class NetspeakService final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::netspeak::service::CorporaResponse>> PrepareAsyncGetCorpora(::grpc::ClientContext* context, const ::netspeak::service::CorporaRequest& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::netspeak::service::CorporaResponse>>(PrepareAsyncGetCorporaRaw(context, request, cq));
     }
+    ::grpc::Status SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::netspeak::service::SearchBatchResponse* response) override;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>> AsyncSearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>>(AsyncSearchBatchRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>> PrepareAsyncSearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>>(PrepareAsyncSearchBatchRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReader< ::netspeak::service::SearchResponse>> SearchStream(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::netspeak::service::SearchResponse>>(SearchStreamRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>> AsyncSearchStream(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>>(AsyncSearchStreamRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>> PrepareAsyncSearchStream(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>>(PrepareAsyncSearchStreamRaw(context, request, cq));
+    }
     class experimental_async final :
       public StubInterface::experimental_async_interface {
      public:
@@ -136,6 +190,23 @@ class NetspeakService final {
       #else
       void GetCorpora(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::CorporaResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
       #endif
+      void SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, std::function<void(::grpc::Status)>) override;
+      void SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, std::function<void(::grpc::Status)>) override;
+      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      void SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
+      #else
+      void SearchBatch(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
+      #endif
+      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      void SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::ClientUnaryReactor* reactor) override;
+      #else
+      void SearchBatch(::grpc::ClientContext* context, const ::grpc::ByteBuffer* request, ::netspeak::service::SearchBatchResponse* response, ::grpc::experimental::ClientUnaryReactor* reactor) override;
+      #endif
+      #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      void SearchStream(::grpc::ClientContext* context, ::netspeak::service::SearchRequest* request, ::grpc::ClientReadReactor< ::netspeak::service::SearchResponse>* reactor) override;
+      #else
+      void SearchStream(::grpc::ClientContext* context, ::netspeak::service::SearchRequest* request, ::grpc::experimental::ClientReadReactor< ::netspeak::service::SearchResponse>* reactor) override;
+      #endif
      private:
       friend class Stub;
       explicit experimental_async(Stub* stub): stub_(stub) { }
@@ -151,8 +222,15 @@ class NetspeakService final {
     ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchResponse>* PrepareAsyncSearchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::netspeak::service::CorporaResponse>* AsyncGetCorporaRaw(::grpc::ClientContext* context, const ::netspeak::service::CorporaRequest& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::netspeak::service::CorporaResponse>* PrepareAsyncGetCorporaRaw(::grpc::ClientContext* context, const ::netspeak::service::CorporaRequest& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>* AsyncSearchBatchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::netspeak::service::SearchBatchResponse>* PrepareAsyncSearchBatchRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchBatchRequest& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::netspeak::service::SearchResponse>* SearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request) override;
+    ::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>* AsyncSearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::netspeak::service::SearchResponse>* PrepareAsyncSearchStreamRaw(::grpc::ClientContext* context, const ::netspeak::service::SearchRequest& request, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_Search_;
     const ::grpc::internal::RpcMethod rpcmethod_GetCorpora_;
+    const ::grpc::internal::RpcMethod rpcmethod_SearchBatch_;
+    const ::grpc::internal::RpcMethod rpcmethod_SearchStream_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -162,6 +240,8 @@ class NetspeakService final {
     virtual ~Service();
     virtual ::grpc::Status Search(::grpc::ServerContext* context, const ::netspeak::service::SearchRequest* request, ::netspeak::service::SearchResponse* response);
     virtual ::grpc::Status GetCorpora(::grpc::ServerContext* context, const ::netspeak::service::CorporaRequest* request, ::netspeak::service::CorporaResponse* response);
+    virtual ::grpc::Status SearchBatch(::grpc::ServerContext* context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response);
+    virtual ::grpc::Status SearchStream(::grpc::ServerContext* context, const ::netspeak::service::SearchRequest* request, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* writer);
   };
   template <class BaseClass>
   class WithAsyncMethod_Search : public BaseClass {
@@ -203,7 +283,47 @@ class NetspeakService final {
       ::grpc::Service::RequestAsyncUnary(1, context, request, response, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_Search<WithAsyncMethod_GetCorpora<Service > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_SearchBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_SearchBatch() {
+      ::grpc::Service::MarkMethodAsync(2);
+    }
+    ~WithAsyncMethod_SearchBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchBatch(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSearchBatch(::grpc::ServerContext* context, ::netspeak::service::SearchBatchRequest* request, ::grpc::ServerAsyncResponseWriter< ::netspeak::service::SearchBatchResponse>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(2, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_SearchStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_SearchStream() {
+      ::grpc::Service::MarkMethodAsync(3);
+    }
+    ~WithAsyncMethod_SearchStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchStream(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSearchStream(::grpc::ServerContext* context, ::netspeak::service::SearchRequest* request, ::grpc::ServerAsyncWriter< ::netspeak::service::SearchResponse>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(3, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_Search<WithAsyncMethod_GetCorpora<WithAsyncMethod_SearchBatch<WithAsyncMethod_SearchStream<Service > > > > AsyncService;
   template <class BaseClass>
   class ExperimentalWithCallbackMethod_Search : public BaseClass {
    private:
@@ -298,11 +418,96 @@ class NetspeakService final {
     #endif
       { return nullptr; }
   };
+  template <class BaseClass>
+  class ExperimentalWithCallbackMethod_SearchBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    ExperimentalWithCallbackMethod_SearchBatch() {
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      ::grpc::Service::
+    #else
+      ::grpc::Service::experimental().
+    #endif
+        MarkMethodCallback(2,
+          new ::grpc_impl::internal::CallbackUnaryHandler< ::netspeak::service::SearchBatchRequest, ::netspeak::service::SearchBatchResponse>(
+            [this](
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+                   ::grpc::CallbackServerContext*
+    #else
+                   ::grpc::experimental::CallbackServerContext*
+    #endif
+                     context, const ::netspeak::service::SearchBatchRequest* request, ::netspeak::service::SearchBatchResponse* response) { return this->SearchBatch(context, request, response); }));}
+    void SetMessageAllocatorFor_SearchBatch(
+        ::grpc::experimental::MessageAllocator< ::netspeak::service::SearchBatchRequest, ::netspeak::service::SearchBatchResponse>* allocator) {
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(2);
+    #else
+      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::experimental().GetHandler(2);
+    #endif
+      static_cast<::grpc_impl::internal::CallbackUnaryHandler< ::netspeak::service::SearchBatchRequest, ::netspeak::service::SearchBatchResponse>*>(handler)
+              ->SetMessageAllocator(allocator);
+    }
+    ~ExperimentalWithCallbackMethod_SearchBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchBatch(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+    virtual ::grpc::ServerUnaryReactor* SearchBatch(
+      ::grpc::CallbackServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/)
+    #else
+    virtual ::grpc::experimental::ServerUnaryReactor* SearchBatch(
+      ::grpc::experimental::CallbackServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/)
+    #endif
+      { return nullptr; }
+  };
+  template <class BaseClass>
+  class ExperimentalWithCallbackMethod_SearchStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    ExperimentalWithCallbackMethod_SearchStream() {
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      ::grpc::Service::
+    #else
+      ::grpc::Service::experimental().
+    #endif
+        MarkMethodCallback(3,
+          new ::grpc_impl::internal::CallbackServerStreamingHandler< ::netspeak::service::SearchRequest, ::netspeak::service::SearchResponse>(
+            [this](
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+                   ::grpc::CallbackServerContext*
+    #else
+                   ::grpc::experimental::CallbackServerContext*
+    #endif
+                     context, const ::netspeak::service::SearchRequest* request) { return this->SearchStream(context, request); }));
+    }
+    ~ExperimentalWithCallbackMethod_SearchStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchStream(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+    virtual ::grpc::ServerWriteReactor< ::netspeak::service::SearchResponse>* SearchStream(
+      ::grpc::CallbackServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/)
+    #else
+    virtual ::grpc::experimental::ServerWriteReactor< ::netspeak::service::SearchResponse>* SearchStream(
+      ::grpc::experimental::CallbackServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/)
+    #endif
+      { return nullptr; }
+  };
   #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
-  typedef ExperimentalWithCallbackMethod_Search<ExperimentalWithCallbackMethod_GetCorpora<Service > > CallbackService;
+  typedef ExperimentalWithCallbackMethod_Search<ExperimentalWithCallbackMethod_GetCorpora<ExperimentalWithCallbackMethod_SearchBatch<ExperimentalWithCallbackMethod_SearchStream<Service > > > > CallbackService;
   #endif
 
-  typedef ExperimentalWithCallbackMethod_Search<ExperimentalWithCallbackMethod_GetCorpora<Service > > ExperimentalCallbackService;
+  typedef ExperimentalWithCallbackMethod_Search<ExperimentalWithCallbackMethod_GetCorpora<ExperimentalWithCallbackMethod_SearchBatch<ExperimentalWithCallbackMethod_SearchStream<Service > > > > ExperimentalCallbackService;
   template <class BaseClass>
   class WithGenericMethod_Search : public BaseClass {
    private:
@@ -338,6 +543,40 @@ class NetspeakService final {
     }
   };
   template <class BaseClass>
+  class WithGenericMethod_SearchBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_SearchBatch() {
+      ::grpc::Service::MarkMethodGeneric(2);
+    }
+    ~WithGenericMethod_SearchBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchBatch(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_SearchStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_SearchStream() {
+      ::grpc::Service::MarkMethodGeneric(3);
+    }
+    ~WithGenericMethod_SearchStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchStream(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
   class WithRawMethod_Search : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -378,6 +617,46 @@ class NetspeakService final {
     }
   };
   template <class BaseClass>
+  class WithRawMethod_SearchBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_SearchBatch() {
+      ::grpc::Service::MarkMethodRaw(2);
+    }
+    ~WithRawMethod_SearchBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchBatch(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSearchBatch(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(2, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_SearchStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_SearchStream() {
+      ::grpc::Service::MarkMethodRaw(3);
+    }
+    ~WithRawMethod_SearchStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchStream(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestSearchStream(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(3, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class ExperimentalWithRawCallbackMethod_Search : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -454,6 +733,82 @@ class NetspeakService final {
       { return nullptr; }
   };
   template <class BaseClass>
+  class ExperimentalWithRawCallbackMethod_SearchBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    ExperimentalWithRawCallbackMethod_SearchBatch() {
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      ::grpc::Service::
+    #else
+      ::grpc::Service::experimental().
+    #endif
+        MarkMethodRawCallback(2,
+          new ::grpc_impl::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+                   ::grpc::CallbackServerContext*
+    #else
+                   ::grpc::experimental::CallbackServerContext*
+    #endif
+                     context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->SearchBatch(context, request, response); }));
+    }
+    ~ExperimentalWithRawCallbackMethod_SearchBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchBatch(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+    virtual ::grpc::ServerUnaryReactor* SearchBatch(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)
+    #else
+    virtual ::grpc::experimental::ServerUnaryReactor* SearchBatch(
+      ::grpc::experimental::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)
+    #endif
+      { return nullptr; }
+  };
+  template <class BaseClass>
+  class ExperimentalWithRawCallbackMethod_SearchStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    ExperimentalWithRawCallbackMethod_SearchStream() {
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+      ::grpc::Service::
+    #else
+      ::grpc::Service::experimental().
+    #endif
+        MarkMethodRawCallback(3,
+          new ::grpc_impl::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+                   ::grpc::CallbackServerContext*
+    #else
+                   ::grpc::experimental::CallbackServerContext*
+    #endif
+                     context, const::grpc::ByteBuffer* request) { return this->SearchStream(context, request); }));
+    }
+    ~ExperimentalWithRawCallbackMethod_SearchStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status SearchStream(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    #ifdef GRPC_CALLBACK_API_NONEXPERIMENTAL
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* SearchStream(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)
+    #else
+    virtual ::grpc::experimental::ServerWriteReactor< ::grpc::ByteBuffer>* SearchStream(
+      ::grpc::experimental::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)
+    #endif
+      { return nullptr; }
+  };
+  template <class BaseClass>
   class WithStreamedUnaryMethod_Search : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -493,9 +848,49 @@ class NetspeakService final {
     // replace default version of method with streamed unary
     virtual ::grpc::Status StreamedGetCorpora(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::netspeak::service::CorporaRequest,::netspeak::service::CorporaResponse>* server_unary_streamer) = 0;
   };
-  typedef WithStreamedUnaryMethod_Search<WithStreamedUnaryMethod_GetCorpora<Service > > StreamedUnaryService;
-  typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_Search<WithStreamedUnaryMethod_GetCorpora<Service > > StreamedService;
+  template <class BaseClass>
+  class WithStreamedUnaryMethod_SearchBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithStreamedUnaryMethod_SearchBatch() {
+      ::grpc::Service::MarkMethodStreamed(2,
+        new ::grpc::internal::StreamedUnaryHandler< ::netspeak::service::SearchBatchRequest, ::netspeak::service::SearchBatchResponse>(std::bind(&WithStreamedUnaryMethod_SearchBatch<BaseClass>::StreamedSearchBatch, this, std::placeholders::_1, std::placeholders::_2)));
+    }
+    ~WithStreamedUnaryMethod_SearchBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status SearchBatch(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchBatchRequest* /*request*/, ::netspeak::service::SearchBatchResponse* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with streamed unary
+    virtual ::grpc::Status StreamedSearchBatch(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::netspeak::service::SearchBatchRequest,::netspeak::service::SearchBatchResponse>* server_unary_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_SearchStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_SearchStream() {
+      ::grpc::Service::MarkMethodStreamed(3,
+        new ::grpc::internal::SplitServerStreamingHandler< ::netspeak::service::SearchRequest, ::netspeak::service::SearchResponse>(std::bind(&WithSplitStreamingMethod_SearchStream<BaseClass>::StreamedSearchStream, this, std::placeholders::_1, std::placeholders::_2)));
+    }
+    ~WithSplitStreamingMethod_SearchStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status SearchStream(::grpc::ServerContext* /*context*/, const ::netspeak::service::SearchRequest* /*request*/, ::grpc::ServerWriter< ::netspeak::service::SearchResponse>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedSearchStream(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::netspeak::service::SearchRequest,::netspeak::service::SearchResponse>* server_split_streamer) = 0;
+  };
+  typedef WithStreamedUnaryMethod_Search<WithStreamedUnaryMethod_GetCorpora<WithStreamedUnaryMethod_SearchBatch<Service > > > StreamedUnaryService;
+  typedef WithSplitStreamingMethod_SearchStream<Service > SplitStreamedService;
+  typedef WithStreamedUnaryMethod_Search<WithStreamedUnaryMethod_GetCorpora<WithStreamedUnaryMethod_SearchBatch<WithSplitStreamingMethod_SearchStream<Service > > > > StreamedService;
 };
 
 }  // namespace service
@@ -18,8 +18,11 @@ extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID:
 extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<1> scc_info_Phrase_NetspeakService_2eproto;
 extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_Phrase_Word_NetspeakService_2eproto;
 extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_PhraseConstraints_NetspeakService_2eproto;
+extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<1> scc_info_SearchRequest_NetspeakService_2eproto;
+extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<3> scc_info_SearchResponse_NetspeakService_2eproto;
 extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_SearchResponse_Error_NetspeakService_2eproto;
 extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<1> scc_info_SearchResponse_Result_NetspeakService_2eproto;
+extern PROTOBUF_INTERNAL_EXPORT_NetspeakService_2eproto ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_SearchStats_NetspeakService_2eproto;
 namespace netspeak {
 namespace service {
 class SearchRequestDefaultTypeInternal {
@@ -64,6 +67,18 @@ class CorporaResponseDefaultTypeInternal {
  public:
   ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<CorporaResponse> _instance;
 } _CorporaResponse_default_instance_;
+class SearchBatchRequestDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<SearchBatchRequest> _instance;
+} _SearchBatchRequest_default_instance_;
+class SearchBatchResponseDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<SearchBatchResponse> _instance;
+} _SearchBatchResponse_default_instance_;
+class SearchStatsDefaultTypeInternal {
+ public:
+  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<SearchStats> _instance;
+} _SearchStats_default_instance_;
 }  // namespace service
 }  // namespace netspeak
 static void InitDefaultsscc_info_CorporaRequest_NetspeakService_2eproto() {
@@ -152,6 +167,36 @@ static void InitDefaultsscc_info_PhraseConstraints_NetspeakService_2eproto() {
 ::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_PhraseConstraints_NetspeakService_2eproto =
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_PhraseConstraints_NetspeakService_2eproto}, {}};
 
+static void InitDefaultsscc_info_SearchBatchRequest_NetspeakService_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::netspeak::service::_SearchBatchRequest_default_instance_;
+    new (ptr) ::netspeak::service::SearchBatchRequest();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::netspeak::service::SearchBatchRequest::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<1> scc_info_SearchBatchRequest_NetspeakService_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 1, 0, InitDefaultsscc_info_SearchBatchRequest_NetspeakService_2eproto}, {
+      &scc_info_SearchRequest_NetspeakService_2eproto.base,}};
+
+static void InitDefaultsscc_info_SearchBatchResponse_NetspeakService_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::netspeak::service::_SearchBatchResponse_default_instance_;
+    new (ptr) ::netspeak::service::SearchBatchResponse();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::netspeak::service::SearchBatchResponse::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<1> scc_info_SearchBatchResponse_NetspeakService_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 1, 0, InitDefaultsscc_info_SearchBatchResponse_NetspeakService_2eproto}, {
+      &scc_info_SearchResponse_NetspeakService_2eproto.base,}};
+
 static void InitDefaultsscc_info_SearchRequest_NetspeakService_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
@@ -178,10 +223,11 @@ static void InitDefaultsscc_info_SearchResponse_NetspeakService_2eproto() {
   ::netspeak::service::SearchResponse::InitAsDefaultInstance();
 }
 
-::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<2> scc_info_SearchResponse_NetspeakService_2eproto =
-    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 2, 0, InitDefaultsscc_info_SearchResponse_NetspeakService_2eproto}, {
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<3> scc_info_SearchResponse_NetspeakService_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 3, 0, InitDefaultsscc_info_SearchResponse_NetspeakService_2eproto}, {
       &scc_info_SearchResponse_Result_NetspeakService_2eproto.base,
-      &scc_info_SearchResponse_Error_NetspeakService_2eproto.base,}};
+      &scc_info_SearchResponse_Error_NetspeakService_2eproto.base,
+      &scc_info_SearchStats_NetspeakService_2eproto.base,}};
 
 static void InitDefaultsscc_info_SearchResponse_Error_NetspeakService_2eproto() {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
@@ -212,7 +258,21 @@ static void InitDefaultsscc_info_SearchResponse_Result_NetspeakService_2eproto()
     {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 1, 0, InitDefaultsscc_info_SearchResponse_Result_NetspeakService_2eproto}, {
       &scc_info_Phrase_NetspeakService_2eproto.base,}};
 
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_NetspeakService_2eproto[10];
+static void InitDefaultsscc_info_SearchStats_NetspeakService_2eproto() {
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  {
+    void* ptr = &::netspeak::service::_SearchStats_default_instance_;
+    new (ptr) ::netspeak::service::SearchStats();
+    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
+  }
+  ::netspeak::service::SearchStats::InitAsDefaultInstance();
+}
+
+::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_SearchStats_NetspeakService_2eproto =
+    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_SearchStats_NetspeakService_2eproto}, {}};
+
+static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_NetspeakService_2eproto[13];
 static const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* file_level_enum_descriptors_NetspeakService_2eproto[2];
 static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_NetspeakService_2eproto = nullptr;
 
@@ -226,6 +286,11 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_NetspeakService_2eproto::offse
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, corpus_),
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, max_phrases_),
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, phrase_constraints_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, continuation_token_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, count_only_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, estimate_count_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, corpora_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchRequest, debug_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::netspeak::service::PhraseConstraints, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -256,6 +321,9 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_NetspeakService_2eproto::offse
   ~0u,  // no _weak_field_map_
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse_Result, phrases_),
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse_Result, unknown_words_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse_Result, continuation_token_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse_Result, phrase_count_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse_Result, frequency_sum_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse_Error, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -270,6 +338,8 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_NetspeakService_2eproto::offse
   ~0u,  // no _weak_field_map_
   offsetof(::netspeak::service::SearchResponseDefaultTypeInternal, result_),
   offsetof(::netspeak::service::SearchResponseDefaultTypeInternal, error_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse, corpus_responses_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse, stats_),
   PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchResponse, response_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::netspeak::service::CorporaRequest, _internal_metadata_),
@@ -290,18 +360,51 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_NetspeakService_2eproto::offse
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   PROTOBUF_FIELD_OFFSET(::netspeak::service::CorporaResponse, corpora_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchBatchRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchBatchRequest, requests_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchBatchResponse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchBatchResponse, responses_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, parse_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, normalize_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, postlist_index_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, postlist_read_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, intersect_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, merge_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, read_phrases_time_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, norm_queries_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, postlists_read_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, bytes_read_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, entries_scanned_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, result_cache_hits_),
+  PROTOBUF_FIELD_OFFSET(::netspeak::service::SearchStats, query_cache_hits_),
 };
 static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, -1, sizeof(::netspeak::service::SearchRequest)},
-  { 9, -1, sizeof(::netspeak::service::PhraseConstraints)},
-  { 17, -1, sizeof(::netspeak::service::Phrase_Word)},
-  { 24, -1, sizeof(::netspeak::service::Phrase)},
-  { 32, -1, sizeof(::netspeak::service::SearchResponse_Result)},
-  { 39, -1, sizeof(::netspeak::service::SearchResponse_Error)},
-  { 46, -1, sizeof(::netspeak::service::SearchResponse)},
-  { 54, -1, sizeof(::netspeak::service::CorporaRequest)},
-  { 59, -1, sizeof(::netspeak::service::Corpus)},
-  { 67, -1, sizeof(::netspeak::service::CorporaResponse)},
+  { 14, -1, sizeof(::netspeak::service::PhraseConstraints)},
+  { 22, -1, sizeof(::netspeak::service::Phrase_Word)},
+  { 29, -1, sizeof(::netspeak::service::Phrase)},
+  { 37, -1, sizeof(::netspeak::service::SearchResponse_Result)},
+  { 47, -1, sizeof(::netspeak::service::SearchResponse_Error)},
+  { 54, -1, sizeof(::netspeak::service::SearchResponse)},
+  { 64, -1, sizeof(::netspeak::service::CorporaRequest)},
+  { 69, -1, sizeof(::netspeak::service::Corpus)},
+  { 77, -1, sizeof(::netspeak::service::CorporaResponse)},
+  { 83, -1, sizeof(::netspeak::service::SearchBatchRequest)},
+  { 89, -1, sizeof(::netspeak::service::SearchBatchResponse)},
+  { 95, -1, sizeof(::netspeak::service::SearchStats)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -315,65 +418,95 @@ static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] =
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::netspeak::service::_CorporaRequest_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::netspeak::service::_Corpus_default_instance_),
   reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::netspeak::service::_CorporaResponse_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::netspeak::service::_SearchBatchRequest_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::netspeak::service::_SearchBatchResponse_default_instance_),
+  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::netspeak::service::_SearchStats_default_instance_),
 };
 
 const char descriptor_table_protodef_NetspeakService_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\025NetspeakService.proto\022\020netspeak.servic"
-  "e\"\204\001\n\rSearchRequest\022\r\n\005query\030\001 \001(\t\022\016\n\006co"
+  "e\"\354\001\n\rSearchRequest\022\r\n\005query\030\001 \001(\t\022\016\n\006co"
   "rpus\030\002 \001(\t\022\023\n\013max_phrases\030\003 \001(\r\022\?\n\022phras"
   "e_constraints\030\004 \001(\0132#.netspeak.service.P"
-  "hraseConstraints\"P\n\021PhraseConstraints\022\025\n"
-  "\rfrequency_max\030\001 \001(\004\022\021\n\twords_min\030\002 \001(\r\022"
-  "\021\n\twords_max\030\003 \001(\r\"\276\002\n\006Phrase\022\n\n\002id\030\001 \001("
-  "\004\022\021\n\tfrequency\030\002 \001(\004\022,\n\005words\030\003 \003(\0132\035.ne"
-  "tspeak.service.Phrase.Word\032\346\001\n\004Word\022.\n\003t"
-  "ag\030\001 \001(\0162!.netspeak.service.Phrase.Word."
-  "Tag\022\014\n\004text\030\002 \001(\t\"\237\001\n\003Tag\022\010\n\004WORD\020\000\022\022\n\016W"
-  "ORD_FOR_QMARK\020\001\022\021\n\rWORD_FOR_STAR\020\002\022\023\n\017WO"
-  "RD_IN_DICTSET\020\003\022\024\n\020WORD_IN_ORDERSET\020\004\022\025\n"
-  "\021WORD_IN_OPTIONSET\020\005\022\021\n\rWORD_FOR_PLUS\020\006\022"
-  "\022\n\016WORD_FOR_REGEX\020\007\"\231\003\n\016SearchResponse\0229"
-  "\n\006result\030\001 \001(\0132\'.netspeak.service.Search"
-  "Response.ResultH\000\0227\n\005error\030\002 \001(\0132&.netsp"
-  "eak.service.SearchResponse.ErrorH\000\032J\n\006Re"
-  "sult\022)\n\007phrases\030\001 \003(\0132\030.netspeak.service"
-  ".Phrase\022\025\n\runknown_words\030\002 \003(\t\032\272\001\n\005Error"
-  "\0229\n\004kind\030\001 \001(\0162+.netspeak.service.Search"
-  "Response.Error.Kind\022\017\n\007message\030\002 \001(\t\"e\n\004"
-  "Kind\022\013\n\007UNKNOWN\020\000\022\022\n\016INTERNAL_ERROR\020\001\022\025\n"
-  "\021INVALID_PARAMETER\020d\022\021\n\rINVALID_QUERY\020n\022"
-  "\022\n\016INVALID_CORPUS\020oB\n\n\010response\"\020\n\016Corpo"
-  "raRequest\"5\n\006Corpus\022\013\n\003key\030\001 \001(\t\022\014\n\004name"
-  "\030\002 \001(\t\022\020\n\010language\030\003 \001(\t\"<\n\017CorporaRespo"
-  "nse\022)\n\007corpora\030\001 \003(\0132\030.netspeak.service."
-  "Corpus2\261\001\n\017NetspeakService\022K\n\006Search\022\037.n"
-  "etspeak.service.SearchRequest\032 .netspeak"
-  ".service.SearchResponse\022Q\n\nGetCorpora\022 ."
-  "netspeak.service.CorporaRequest\032!.netspe"
-  "ak.service.CorporaResponseB\030\n\024org.netspe"
-  "ak.serviceH\001b\006proto3"
+  "hraseConstraints\022\032\n\022continuation_token\030\005"
+  " \001(\014\022\022\n\ncount_only\030\006 \001(\010\022\026\n\016estimate_cou"
+  "nt\030\007 \001(\010\022\017\n\007corpora\030\010 \003(\t\022\r\n\005debug\030\t \001(\010"
+  "\"P\n\021PhraseConstraints\022\025\n\rfrequency_max\030\001"
+  " \001(\004\022\021\n\twords_min\030\002 \001(\r\022\021\n\twords_max\030\003 \001"
+  "(\r\"\276\002\n\006Phrase\022\n\n\002id\030\001 \001(\004\022\021\n\tfrequency\030\002"
+  " \001(\004\022,\n\005words\030\003 \003(\0132\035.netspeak.service.P"
+  "hrase.Word\032\346\001\n\004Word\022.\n\003tag\030\001 \001(\0162!.netsp"
+  "eak.service.Phrase.Word.Tag\022\014\n\004text\030\002 \001("
+  "\t\"\237\001\n\003Tag\022\010\n\004WORD\020\000\022\022\n\016WORD_FOR_QMARK\020\001\022"
+  "\021\n\rWORD_FOR_STAR\020\002\022\023\n\017WORD_IN_DICTSET\020\003\022"
+  "\024\n\020WORD_IN_ORDERSET\020\004\022\025\n\021WORD_IN_OPTIONS"
+  "ET\020\005\022\021\n\rWORD_FOR_PLUS\020\006\022\022\n\016WORD_FOR_REGE"
+  "X\020\007\"\315\004\n\016SearchResponse\0229\n\006result\030\001 \001(\0132\'"
+  ".netspeak.service.SearchResponse.ResultH"
+  "\000\0227\n\005error\030\002 \001(\0132&.netspeak.service.Sear"
+  "chResponse.ErrorH\000\022:\n\020corpus_responses\030\003"
+  " \003(\0132 .netspeak.service.SearchResponse\022,"
+  "\n\005stats\030\004 \001(\0132\035.netspeak.service.SearchS"
+  "tats\032\223\001\n\006Result\022)\n\007phrases\030\001 \003(\0132\030.netsp"
+  "eak.service.Phrase\022\025\n\runknown_words\030\002 \003("
+  "\t\022\032\n\022continuation_token\030\003 \001(\014\022\024\n\014phrase_"
+  "count\030\004 \001(\004\022\025\n\rfrequency_sum\030\005 \001(\004\032\272\001\n\005E"
+  "rror\0229\n\004kind\030\001 \001(\0162+.netspeak.service.Se"
+  "archResponse.Error.Kind\022\017\n\007message\030\002 \001(\t"
+  "\"e\n\004Kind\022\013\n\007UNKNOWN\020\000\022\022\n\016INTERNAL_ERROR\020"
+  "\001\022\025\n\021INVALID_PARAMETER\020d\022\021\n\rINVALID_QUER"
+  "Y\020n\022\022\n\016INVALID_CORPUS\020oB\n\n\010response\"\020\n\016C"
+  "orporaRequest\"5\n\006Corpus\022\013\n\003key\030\001 \001(\t\022\014\n\004"
+  "name\030\002 \001(\t\022\020\n\010language\030\003 \001(\t\"<\n\017CorporaR"
+  "esponse\022)\n\007corpora\030\001 \003(\0132\030.netspeak.serv"
+  "ice.Corpus\"G\n\022SearchBatchRequest\0221\n\010requ"
+  "ests\030\001 \003(\0132\037.netspeak.service.SearchRequ"
+  "est\"J\n\023SearchBatchResponse\0223\n\tresponses\030"
+  "\001 \003(\0132 .netspeak.service.SearchResponse\""
+  "\311\002\n\013SearchStats\022\022\n\nparse_time\030\001 \001(\004\022\026\n\016n"
+  "ormalize_time\030\002 \001(\004\022\033\n\023postlist_index_ti"
+  "me\030\003 \001(\004\022\032\n\022postlist_read_time\030\004 \001(\004\022\026\n\016"
+  "intersect_time\030\005 \001(\004\022\022\n\nmerge_time\030\006 \001(\004"
+  "\022\031\n\021read_phrases_time\030\007 \001(\004\022\024\n\014norm_quer"
+  "ies\030\010 \001(\004\022\026\n\016postlists_read\030\t \001(\004\022\022\n\nbyt"
+  "es_read\030\n \001(\004\022\027\n\017entries_scanned\030\013 \001(\004\022\031"
+  "\n\021result_cache_hits\030\014 \001(\004\022\030\n\020query_cache"
+  "_hits\030\r \001(\0042\342\002\n\017NetspeakService\022K\n\006Searc"
+  "h\022\037.netspeak.service.SearchRequest\032 .net"
+  "speak.service.SearchResponse\022Q\n\nGetCorpo"
+  "ra\022 .netspeak.service.CorporaRequest\032!.n"
+  "etspeak.service.CorporaResponse\022Z\n\013Searc"
+  "hBatch\022$.netspeak.service.SearchBatchReq"
+  "uest\032%.netspeak.service.SearchBatchRespo"
+  "nse\022S\n\014SearchStream\022\037.netspeak.service.S"
+  "earchRequest\032 .netspeak.service.SearchRe"
+  "sponse0\001B\030\n\024org.netspeak.serviceH\001b\006prot"
+  "o3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_NetspeakService_2eproto_deps[1] = {
 };
-static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_NetspeakService_2eproto_sccs[10] = {
+static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_NetspeakService_2eproto_sccs[13] = {
   &scc_info_CorporaRequest_NetspeakService_2eproto.base,
   &scc_info_CorporaResponse_NetspeakService_2eproto.base,
   &scc_info_Corpus_NetspeakService_2eproto.base,
   &scc_info_Phrase_NetspeakService_2eproto.base,
   &scc_info_Phrase_Word_NetspeakService_2eproto.base,
   &scc_info_PhraseConstraints_NetspeakService_2eproto.base,
+  &scc_info_SearchBatchRequest_NetspeakService_2eproto.base,
+  &scc_info_SearchBatchResponse_NetspeakService_2eproto.base,
   &scc_info_SearchRequest_NetspeakService_2eproto.base,
   &scc_info_SearchResponse_NetspeakService_2eproto.base,
   &scc_info_SearchResponse_Error_NetspeakService_2eproto.base,
   &scc_info_SearchResponse_Result_NetspeakService_2eproto.base,
+  &scc_info_SearchStats_NetspeakService_2eproto.base,
 };
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_NetspeakService_2eproto_once;
 static bool descriptor_table_NetspeakService_2eproto_initialized = false;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_NetspeakService_2eproto = {
-  &descriptor_table_NetspeakService_2eproto_initialized, descriptor_table_protodef_NetspeakService_2eproto, "NetspeakService.proto", 1340,
-  &descriptor_table_NetspeakService_2eproto_once, descriptor_table_NetspeakService_2eproto_sccs, descriptor_table_NetspeakService_2eproto_deps, 10, 0,
+  &descriptor_table_NetspeakService_2eproto_initialized, descriptor_table_protodef_NetspeakService_2eproto, "NetspeakService.proto", 2282,
+  &descriptor_table_NetspeakService_2eproto_once, descriptor_table_NetspeakService_2eproto_sccs, descriptor_table_NetspeakService_2eproto_deps, 13, 0,
   schemas, file_default_instances, TableStruct_NetspeakService_2eproto::offsets,
-  file_level_metadata_NetspeakService_2eproto, 10, file_level_enum_descriptors_NetspeakService_2eproto, file_level_service_descriptors_NetspeakService_2eproto,
+  file_level_metadata_NetspeakService_2eproto, 13, file_level_enum_descriptors_NetspeakService_2eproto, file_level_service_descriptors_NetspeakService_2eproto,
 };
 
 // Force running AddDescriptors() at dynamic initialization time.
@@ -463,7 +596,8 @@ SearchRequest::SearchRequest()
 }
 SearchRequest::SearchRequest(const SearchRequest& from)
   : ::PROTOBUF_NAMESPACE_ID::Message(),
-      _internal_metadata_(nullptr) {
+      _internal_metadata_(nullptr),
+      corpora_(from.corpora_) {
   _internal_metadata_.MergeFrom(from._internal_metadata_);
   query_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   if (!from._internal_query().empty()) {
@@ -473,12 +607,18 @@ SearchRequest::SearchRequest(const SearchRequest& from)
   if (!from._internal_corpus().empty()) {
     corpus_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.corpus_);
   }
+  continuation_token_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  if (!from._internal_continuation_token().empty()) {
+    continuation_token_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.continuation_token_);
+  }
   if (from._internal_has_phrase_constraints()) {
     phrase_constraints_ = new ::netspeak::service::PhraseConstraints(*from.phrase_constraints_);
   } else {
     phrase_constraints_ = nullptr;
   }
-  max_phrases_ = from.max_phrases_;
+  ::memcpy(&max_phrases_, &from.max_phrases_,
+    static_cast<size_t>(reinterpret_cast<char*>(&debug_) -
+    reinterpret_cast<char*>(&max_phrases_)) + sizeof(debug_));
   // @@protoc_insertion_point(copy_constructor:netspeak.service.SearchRequest)
 }
 
@@ -486,9 +626,10 @@ void SearchRequest::SharedCtor() {
   ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_SearchRequest_NetspeakService_2eproto.base);
   query_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   corpus_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  continuation_token_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   ::memset(&phrase_constraints_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&max_phrases_) -
-      reinterpret_cast<char*>(&phrase_constraints_)) + sizeof(max_phrases_));
+      reinterpret_cast<char*>(&debug_) -
+      reinterpret_cast<char*>(&phrase_constraints_)) + sizeof(debug_));
 }
 
 SearchRequest::~SearchRequest() {
@@ -499,6 +640,7 @@ SearchRequest::~SearchRequest() {
 void SearchRequest::SharedDtor() {
   query_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   corpus_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  continuation_token_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   if (this != internal_default_instance()) delete phrase_constraints_;
 }
 
@@ -517,13 +659,17 @@ void SearchRequest::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  corpora_.Clear();
   query_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   corpus_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  continuation_token_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
   if (GetArenaNoVirtual() == nullptr && phrase_constraints_ != nullptr) {
     delete phrase_constraints_;
   }
   phrase_constraints_ = nullptr;
-  max_phrases_ = 0u;
+  ::memset(&max_phrases_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&debug_) -
+      reinterpret_cast<char*>(&max_phrases_)) + sizeof(debug_));
   _internal_metadata_.Clear();
 }
 
@@ -566,6 +712,49 @@ const char* SearchRequest::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_
           CHK_(ptr);
         } else goto handle_unusual;
         continue;
+      // bytes continuation_token = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 42)) {
+          auto str = _internal_mutable_continuation_token();
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // bool count_only = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 48)) {
+          count_only_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // bool estimate_count = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 56)) {
+          estimate_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // repeated string corpora = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 66)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            auto str = _internal_add_corpora();
+            ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
+            CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "netspeak.service.SearchRequest.corpora"));
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<66>(ptr));
+        } else goto handle_unusual;
+        continue;
+      // bool debug = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 72)) {
+          debug_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -626,6 +815,40 @@ failure:
         4, _Internal::phrase_constraints(this), target, stream);
   }
 
+  // bytes continuation_token = 5;
+  if (this->continuation_token().size() > 0) {
+    target = stream->WriteBytesMaybeAliased(
+        5, this->_internal_continuation_token(), target);
+  }
+
+  // bool count_only = 6;
+  if (this->count_only() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(6, this->_internal_count_only(), target);
+  }
+
+  // bool estimate_count = 7;
+  if (this->estimate_count() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(7, this->_internal_estimate_count(), target);
+  }
+
+  // repeated string corpora = 8;
+  for (int i = 0, n = this->_internal_corpora_size(); i < n; i++) {
+    const auto& s = this->_internal_corpora(i);
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      s.data(), static_cast<int>(s.length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "netspeak.service.SearchRequest.corpora");
+    target = stream->WriteString(8, s, target);
+  }
+
+  // bool debug = 9;
+  if (this->debug() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(9, this->_internal_debug(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target, stream);
@@ -642,6 +865,14 @@ size_t SearchRequest::ByteSizeLong() const {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  // repeated string corpora = 8;
+  total_size += 1 *
+      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(corpora_.size());
+  for (int i = 0, n = corpora_.size(); i < n; i++) {
+    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      corpora_.Get(i));
+  }
+
   // string query = 1;
   if (this->query().size() > 0) {
     total_size += 1 +
@@ -656,6 +887,13 @@ size_t SearchRequest::ByteSizeLong() const {
         this->_internal_corpus());
   }
 
+  // bytes continuation_token = 5;
+  if (this->continuation_token().size() > 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_continuation_token());
+  }
+
   // .netspeak.service.PhraseConstraints phrase_constraints = 4;
   if (this->has_phrase_constraints()) {
     total_size += 1 +
@@ -670,6 +908,21 @@ size_t SearchRequest::ByteSizeLong() const {
         this->_internal_max_phrases());
   }
 
+  // bool count_only = 6;
+  if (this->count_only() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // bool estimate_count = 7;
+  if (this->estimate_count() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // bool debug = 9;
+  if (this->debug() != 0) {
+    total_size += 1 + 1;
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
         _internal_metadata_, total_size, &_cached_size_);
@@ -701,6 +954,7 @@ void SearchRequest::MergeFrom(const SearchRequest& from) {
   ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
   (void) cached_has_bits;
 
+  corpora_.MergeFrom(from.corpora_);
   if (from.query().size() > 0) {
 
     query_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.query_);
@@ -709,12 +963,25 @@ void SearchRequest::MergeFrom(const SearchRequest& from) {
 
     corpus_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.corpus_);
   }
+  if (from.continuation_token().size() > 0) {
+
+    continuation_token_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.continuation_token_);
+  }
   if (from.has_phrase_constraints()) {
     _internal_mutable_phrase_constraints()->::netspeak::service::PhraseConstraints::MergeFrom(from._internal_phrase_constraints());
   }
   if (from.max_phrases() != 0) {
     _internal_set_max_phrases(from._internal_max_phrases());
   }
+  if (from.count_only() != 0) {
+    _internal_set_count_only(from._internal_count_only());
+  }
+  if (from.estimate_count() != 0) {
+    _internal_set_estimate_count(from._internal_estimate_count());
+  }
+  if (from.debug() != 0) {
+    _internal_set_debug(from._internal_debug());
+  }
 }
 
 void SearchRequest::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
@@ -738,12 +1005,18 @@ bool SearchRequest::IsInitialized() const {
 void SearchRequest::InternalSwap(SearchRequest* other) {
   using std::swap;
   _internal_metadata_.Swap(&other->_internal_metadata_);
+  corpora_.InternalSwap(&other->corpora_);
   query_.Swap(&other->query_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
     GetArenaNoVirtual());
   corpus_.Swap(&other->corpus_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
     GetArenaNoVirtual());
+  continuation_token_.Swap(&other->continuation_token_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+    GetArenaNoVirtual());
   swap(phrase_constraints_, other->phrase_constraints_);
   swap(max_phrases_, other->max_phrases_);
+  swap(count_only_, other->count_only_);
+  swap(estimate_count_, other->estimate_count_);
+  swap(debug_, other->debug_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata SearchRequest::GetMetadata() const {
@@ -1485,11 +1758,22 @@ SearchResponse_Result::SearchResponse_Result(const SearchResponse_Result& from)
       phrases_(from.phrases_),
       unknown_words_(from.unknown_words_) {
   _internal_metadata_.MergeFrom(from._internal_metadata_);
+  continuation_token_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  if (!from._internal_continuation_token().empty()) {
+    continuation_token_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.continuation_token_);
+  }
+  ::memcpy(&phrase_count_, &from.phrase_count_,
+    static_cast<size_t>(reinterpret_cast<char*>(&frequency_sum_) -
+    reinterpret_cast<char*>(&phrase_count_)) + sizeof(frequency_sum_));
   // @@protoc_insertion_point(copy_constructor:netspeak.service.SearchResponse.Result)
 }
 
 void SearchResponse_Result::SharedCtor() {
   ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_SearchResponse_Result_NetspeakService_2eproto.base);
+  continuation_token_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  ::memset(&phrase_count_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&frequency_sum_) -
+      reinterpret_cast<char*>(&phrase_count_)) + sizeof(frequency_sum_));
 }
 
 SearchResponse_Result::~SearchResponse_Result() {
@@ -1498,6 +1782,7 @@ SearchResponse_Result::~SearchResponse_Result() {
 }
 
 void SearchResponse_Result::SharedDtor() {
+  continuation_token_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
 }
 
 void SearchResponse_Result::SetCachedSize(int size) const {
@@ -1517,6 +1802,10 @@ void SearchResponse_Result::Clear() {
 
   phrases_.Clear();
   unknown_words_.Clear();
+  continuation_token_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  ::memset(&phrase_count_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&frequency_sum_) -
+      reinterpret_cast<char*>(&phrase_count_)) + sizeof(frequency_sum_));
   _internal_metadata_.Clear();
 }
 
@@ -1553,6 +1842,28 @@ const char* SearchResponse_Result::_InternalParse(const char* ptr, ::PROTOBUF_NA
           } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
         } else goto handle_unusual;
         continue;
+      // bytes continuation_token = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 26)) {
+          auto str = _internal_mutable_continuation_token();
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 phrase_count = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
+          phrase_count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 frequency_sum = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 40)) {
+          frequency_sum_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -1597,6 +1908,24 @@ failure:
     target = stream->WriteString(2, s, target);
   }
 
+  // bytes continuation_token = 3;
+  if (this->continuation_token().size() > 0) {
+    target = stream->WriteBytesMaybeAliased(
+        3, this->_internal_continuation_token(), target);
+  }
+
+  // uint64 phrase_count = 4;
+  if (this->phrase_count() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(4, this->_internal_phrase_count(), target);
+  }
+
+  // uint64 frequency_sum = 5;
+  if (this->frequency_sum() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(5, this->_internal_frequency_sum(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target, stream);
@@ -1628,6 +1957,27 @@ size_t SearchResponse_Result::ByteSizeLong() const {
       unknown_words_.Get(i));
   }
 
+  // bytes continuation_token = 3;
+  if (this->continuation_token().size() > 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
+        this->_internal_continuation_token());
+  }
+
+  // uint64 phrase_count = 4;
+  if (this->phrase_count() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_phrase_count());
+  }
+
+  // uint64 frequency_sum = 5;
+  if (this->frequency_sum() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_frequency_sum());
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
         _internal_metadata_, total_size, &_cached_size_);
@@ -1661,6 +2011,16 @@ void SearchResponse_Result::MergeFrom(const SearchResponse_Result& from) {
 
   phrases_.MergeFrom(from.phrases_);
   unknown_words_.MergeFrom(from.unknown_words_);
+  if (from.continuation_token().size() > 0) {
+
+    continuation_token_.AssignWithDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), from.continuation_token_);
+  }
+  if (from.phrase_count() != 0) {
+    _internal_set_phrase_count(from._internal_phrase_count());
+  }
+  if (from.frequency_sum() != 0) {
+    _internal_set_frequency_sum(from._internal_frequency_sum());
+  }
 }
 
 void SearchResponse_Result::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
@@ -1686,6 +2046,10 @@ void SearchResponse_Result::InternalSwap(SearchResponse_Result* other) {
   _internal_metadata_.Swap(&other->_internal_metadata_);
   phrases_.InternalSwap(&other->phrases_);
   unknown_words_.InternalSwap(&other->unknown_words_);
+  continuation_token_.Swap(&other->continuation_token_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+    GetArenaNoVirtual());
+  swap(phrase_count_, other->phrase_count_);
+  swap(frequency_sum_, other->frequency_sum_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata SearchResponse_Result::GetMetadata() const {
@@ -1927,11 +2291,14 @@ void SearchResponse::InitAsDefaultInstance() {
       ::netspeak::service::SearchResponse_Result::internal_default_instance());
   ::netspeak::service::_SearchResponse_default_instance_.error_ = const_cast< ::netspeak::service::SearchResponse_Error*>(
       ::netspeak::service::SearchResponse_Error::internal_default_instance());
+  ::netspeak::service::_SearchResponse_default_instance_._instance.get_mutable()->stats_ = const_cast< ::netspeak::service::SearchStats*>(
+      ::netspeak::service::SearchStats::internal_default_instance());
 }
 class SearchResponse::_Internal {
  public:
   static const ::netspeak::service::SearchResponse_Result& result(const SearchResponse* msg);
   static const ::netspeak::service::SearchResponse_Error& error(const SearchResponse* msg);
+  static const ::netspeak::service::SearchStats& stats(const SearchResponse* msg);
 };
 
 const ::netspeak::service::SearchResponse_Result&
@@ -1942,6 +2309,10 @@ const ::netspeak::service::SearchResponse_Error&
 SearchResponse::_Internal::error(const SearchResponse* msg) {
   return *msg->response_.error_;
 }
+const ::netspeak::service::SearchStats&
+SearchResponse::_Internal::stats(const SearchResponse* msg) {
+  return *msg->stats_;
+}
 void SearchResponse::set_allocated_result(::netspeak::service::SearchResponse_Result* result) {
   ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaNoVirtual();
   clear_response();
@@ -1977,8 +2348,14 @@ SearchResponse::SearchResponse()
 }
 SearchResponse::SearchResponse(const SearchResponse& from)
   : ::PROTOBUF_NAMESPACE_ID::Message(),
-      _internal_metadata_(nullptr) {
+      _internal_metadata_(nullptr),
+      corpus_responses_(from.corpus_responses_) {
   _internal_metadata_.MergeFrom(from._internal_metadata_);
+  if (from._internal_has_stats()) {
+    stats_ = new ::netspeak::service::SearchStats(*from.stats_);
+  } else {
+    stats_ = nullptr;
+  }
   clear_has_response();
   switch (from.response_case()) {
     case kResult: {
@@ -1998,6 +2375,7 @@ SearchResponse::SearchResponse(const SearchResponse& from)
 
 void SearchResponse::SharedCtor() {
   ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_SearchResponse_NetspeakService_2eproto.base);
+  stats_ = nullptr;
   clear_has_response();
 }
 
@@ -2007,6 +2385,7 @@ SearchResponse::~SearchResponse() {
 }
 
 void SearchResponse::SharedDtor() {
+  if (this != internal_default_instance()) delete stats_;
   if (has_response()) {
     clear_response();
   }
@@ -2046,6 +2425,11 @@ void SearchResponse::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  corpus_responses_.Clear();
+  if (GetArenaNoVirtual() == nullptr && stats_ != nullptr) {
+    delete stats_;
+  }
+  stats_ = nullptr;
   clear_response();
   _internal_metadata_.Clear();
 }
@@ -2071,6 +2455,25 @@ const char* SearchResponse::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE
           CHK_(ptr);
         } else goto handle_unusual;
         continue;
+      // repeated .netspeak.service.SearchResponse corpus_responses = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_corpus_responses(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else goto handle_unusual;
+        continue;
+      // .netspeak.service.SearchStats stats = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 34)) {
+          ptr = ctx->ParseMessage(_internal_mutable_stats(), ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -2113,6 +2516,22 @@ failure:
         2, _Internal::error(this), target, stream);
   }
 
+  // repeated .netspeak.service.SearchResponse corpus_responses = 3;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->_internal_corpus_responses_size()); i < n; i++) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(3, this->_internal_corpus_responses(i), target, stream);
+  }
+
+  // .netspeak.service.SearchStats stats = 4;
+  if (this->has_stats()) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(
+        4, _Internal::stats(this), target, stream);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target, stream);
@@ -2129,6 +2548,20 @@ size_t SearchResponse::ByteSizeLong() const {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  // repeated .netspeak.service.SearchResponse corpus_responses = 3;
+  total_size += 1UL * this->_internal_corpus_responses_size();
+  for (const auto& msg : this->corpus_responses_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // .netspeak.service.SearchStats stats = 4;
+  if (this->has_stats()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *stats_);
+  }
+
   switch (response_case()) {
     // .netspeak.service.SearchResponse.Result result = 1;
     case kResult: {
@@ -2179,6 +2612,10 @@ void SearchResponse::MergeFrom(const SearchResponse& from) {
   ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
   (void) cached_has_bits;
 
+  corpus_responses_.MergeFrom(from.corpus_responses_);
+  if (from.has_stats()) {
+    _internal_mutable_stats()->::netspeak::service::SearchStats::MergeFrom(from._internal_stats());
+  }
   switch (from.response_case()) {
     case kResult: {
       _internal_mutable_result()->::netspeak::service::SearchResponse_Result::MergeFrom(from._internal_result());
@@ -2215,6 +2652,8 @@ bool SearchResponse::IsInitialized() const {
 void SearchResponse::InternalSwap(SearchResponse* other) {
   using std::swap;
   _internal_metadata_.Swap(&other->_internal_metadata_);
+  corpus_responses_.InternalSwap(&other->corpus_responses_);
+  swap(stats_, other->stats_);
   swap(response_, other->response_);
   swap(_oneof_case_[0], other->_oneof_case_[0]);
 }
@@ -2846,39 +3285,910 @@ void CorporaResponse::InternalSwap(CorporaResponse* other) {
 }
 
 
-// @@protoc_insertion_point(namespace_scope)
-}  // namespace service
-}  // namespace netspeak
-PROTOBUF_NAMESPACE_OPEN
-template<> PROTOBUF_NOINLINE ::netspeak::service::SearchRequest* Arena::CreateMaybeMessage< ::netspeak::service::SearchRequest >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::SearchRequest >(arena);
+// ===================================================================
+
+void SearchBatchRequest::InitAsDefaultInstance() {
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::PhraseConstraints* Arena::CreateMaybeMessage< ::netspeak::service::PhraseConstraints >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::PhraseConstraints >(arena);
+class SearchBatchRequest::_Internal {
+ public:
+};
+
+SearchBatchRequest::SearchBatchRequest()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:netspeak.service.SearchBatchRequest)
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::Phrase_Word* Arena::CreateMaybeMessage< ::netspeak::service::Phrase_Word >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::Phrase_Word >(arena);
+SearchBatchRequest::SearchBatchRequest(const SearchBatchRequest& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr),
+      requests_(from.requests_) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:netspeak.service.SearchBatchRequest)
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::Phrase* Arena::CreateMaybeMessage< ::netspeak::service::Phrase >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::Phrase >(arena);
+
+void SearchBatchRequest::SharedCtor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_SearchBatchRequest_NetspeakService_2eproto.base);
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::SearchResponse_Result* Arena::CreateMaybeMessage< ::netspeak::service::SearchResponse_Result >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::SearchResponse_Result >(arena);
+
+SearchBatchRequest::~SearchBatchRequest() {
+  // @@protoc_insertion_point(destructor:netspeak.service.SearchBatchRequest)
+  SharedDtor();
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::SearchResponse_Error* Arena::CreateMaybeMessage< ::netspeak::service::SearchResponse_Error >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::SearchResponse_Error >(arena);
+
+void SearchBatchRequest::SharedDtor() {
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::SearchResponse* Arena::CreateMaybeMessage< ::netspeak::service::SearchResponse >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::SearchResponse >(arena);
+
+void SearchBatchRequest::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::CorporaRequest* Arena::CreateMaybeMessage< ::netspeak::service::CorporaRequest >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::CorporaRequest >(arena);
+const SearchBatchRequest& SearchBatchRequest::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_SearchBatchRequest_NetspeakService_2eproto.base);
+  return *internal_default_instance();
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::Corpus* Arena::CreateMaybeMessage< ::netspeak::service::Corpus >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::Corpus >(arena);
+
+
+void SearchBatchRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:netspeak.service.SearchBatchRequest)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  requests_.Clear();
+  _internal_metadata_.Clear();
 }
-template<> PROTOBUF_NOINLINE ::netspeak::service::CorporaResponse* Arena::CreateMaybeMessage< ::netspeak::service::CorporaResponse >(Arena* arena) {
-  return Arena::CreateInternal< ::netspeak::service::CorporaResponse >(arena);
+
+const char* SearchBatchRequest::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // repeated .netspeak.service.SearchRequest requests = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_requests(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* SearchBatchRequest::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:netspeak.service.SearchBatchRequest)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .netspeak.service.SearchRequest requests = 1;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->_internal_requests_size()); i < n; i++) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, this->_internal_requests(i), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:netspeak.service.SearchBatchRequest)
+  return target;
+}
+
+size_t SearchBatchRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:netspeak.service.SearchBatchRequest)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .netspeak.service.SearchRequest requests = 1;
+  total_size += 1UL * this->_internal_requests_size();
+  for (const auto& msg : this->requests_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void SearchBatchRequest::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:netspeak.service.SearchBatchRequest)
+  GOOGLE_DCHECK_NE(&from, this);
+  const SearchBatchRequest* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<SearchBatchRequest>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:netspeak.service.SearchBatchRequest)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:netspeak.service.SearchBatchRequest)
+    MergeFrom(*source);
+  }
+}
+
+void SearchBatchRequest::MergeFrom(const SearchBatchRequest& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:netspeak.service.SearchBatchRequest)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  requests_.MergeFrom(from.requests_);
+}
+
+void SearchBatchRequest::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:netspeak.service.SearchBatchRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void SearchBatchRequest::CopyFrom(const SearchBatchRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:netspeak.service.SearchBatchRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool SearchBatchRequest::IsInitialized() const {
+  return true;
+}
+
+void SearchBatchRequest::InternalSwap(SearchBatchRequest* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  requests_.InternalSwap(&other->requests_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata SearchBatchRequest::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+void SearchBatchResponse::InitAsDefaultInstance() {
+}
+class SearchBatchResponse::_Internal {
+ public:
+};
+
+SearchBatchResponse::SearchBatchResponse()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:netspeak.service.SearchBatchResponse)
+}
+SearchBatchResponse::SearchBatchResponse(const SearchBatchResponse& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr),
+      responses_(from.responses_) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:netspeak.service.SearchBatchResponse)
+}
+
+void SearchBatchResponse::SharedCtor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_SearchBatchResponse_NetspeakService_2eproto.base);
+}
+
+SearchBatchResponse::~SearchBatchResponse() {
+  // @@protoc_insertion_point(destructor:netspeak.service.SearchBatchResponse)
+  SharedDtor();
+}
+
+void SearchBatchResponse::SharedDtor() {
+}
+
+void SearchBatchResponse::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const SearchBatchResponse& SearchBatchResponse::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_SearchBatchResponse_NetspeakService_2eproto.base);
+  return *internal_default_instance();
+}
+
+
+void SearchBatchResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:netspeak.service.SearchBatchResponse)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  responses_.Clear();
+  _internal_metadata_.Clear();
+}
+
+const char* SearchBatchResponse::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // repeated .netspeak.service.SearchResponse responses = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_responses(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* SearchBatchResponse::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:netspeak.service.SearchBatchResponse)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .netspeak.service.SearchResponse responses = 1;
+  for (unsigned int i = 0,
+      n = static_cast<unsigned int>(this->_internal_responses_size()); i < n; i++) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(1, this->_internal_responses(i), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:netspeak.service.SearchBatchResponse)
+  return target;
+}
+
+size_t SearchBatchResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:netspeak.service.SearchBatchResponse)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .netspeak.service.SearchResponse responses = 1;
+  total_size += 1UL * this->_internal_responses_size();
+  for (const auto& msg : this->responses_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void SearchBatchResponse::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:netspeak.service.SearchBatchResponse)
+  GOOGLE_DCHECK_NE(&from, this);
+  const SearchBatchResponse* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<SearchBatchResponse>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:netspeak.service.SearchBatchResponse)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:netspeak.service.SearchBatchResponse)
+    MergeFrom(*source);
+  }
+}
+
+void SearchBatchResponse::MergeFrom(const SearchBatchResponse& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:netspeak.service.SearchBatchResponse)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  responses_.MergeFrom(from.responses_);
+}
+
+void SearchBatchResponse::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:netspeak.service.SearchBatchResponse)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void SearchBatchResponse::CopyFrom(const SearchBatchResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:netspeak.service.SearchBatchResponse)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool SearchBatchResponse::IsInitialized() const {
+  return true;
+}
+
+void SearchBatchResponse::InternalSwap(SearchBatchResponse* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  responses_.InternalSwap(&other->responses_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata SearchBatchResponse::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// ===================================================================
+
+void SearchStats::InitAsDefaultInstance() {
+}
+class SearchStats::_Internal {
+ public:
+};
+
+SearchStats::SearchStats()
+  : ::PROTOBUF_NAMESPACE_ID::Message(), _internal_metadata_(nullptr) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:netspeak.service.SearchStats)
+}
+SearchStats::SearchStats(const SearchStats& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message(),
+      _internal_metadata_(nullptr) {
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::memcpy(&parse_time_, &from.parse_time_,
+    static_cast<size_t>(reinterpret_cast<char*>(&query_cache_hits_) -
+    reinterpret_cast<char*>(&parse_time_)) + sizeof(query_cache_hits_));
+  // @@protoc_insertion_point(copy_constructor:netspeak.service.SearchStats)
+}
+
+void SearchStats::SharedCtor() {
+  ::memset(&parse_time_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&query_cache_hits_) -
+      reinterpret_cast<char*>(&parse_time_)) + sizeof(query_cache_hits_));
+}
+
+SearchStats::~SearchStats() {
+  // @@protoc_insertion_point(destructor:netspeak.service.SearchStats)
+  SharedDtor();
+}
+
+void SearchStats::SharedDtor() {
+}
+
+void SearchStats::SetCachedSize(int size) const {
+  _cached_size_.Set(size);
+}
+const SearchStats& SearchStats::default_instance() {
+  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_SearchStats_NetspeakService_2eproto.base);
+  return *internal_default_instance();
+}
+
+
+void SearchStats::Clear() {
+// @@protoc_insertion_point(message_clear_start:netspeak.service.SearchStats)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::memset(&parse_time_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&query_cache_hits_) -
+      reinterpret_cast<char*>(&parse_time_)) + sizeof(query_cache_hits_));
+  _internal_metadata_.Clear();
+}
+
+const char* SearchStats::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
+    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
+    CHK_(ptr);
+    switch (tag >> 3) {
+      // uint64 parse_time = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 8)) {
+          parse_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 normalize_time = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 16)) {
+          normalize_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 postlist_index_time = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 24)) {
+          postlist_index_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 postlist_read_time = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
+          postlist_read_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 intersect_time = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 40)) {
+          intersect_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 merge_time = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 48)) {
+          merge_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 read_phrases_time = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 56)) {
+          read_phrases_time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 norm_queries = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 64)) {
+          norm_queries_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 postlists_read = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 72)) {
+          postlists_read_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 bytes_read = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 80)) {
+          bytes_read_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 entries_scanned = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 88)) {
+          entries_scanned_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 result_cache_hits = 12;
+      case 12:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 96)) {
+          result_cache_hits_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      // uint64 query_cache_hits = 13;
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 104)) {
+          query_cache_hits_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr);
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
+      default: {
+      handle_unusual:
+        if ((tag & 7) == 4 || tag == 0) {
+          ctx->SetLastTag(tag);
+          goto success;
+        }
+        ptr = UnknownFieldParse(tag, &_internal_metadata_, ptr, ctx);
+        CHK_(ptr != nullptr);
+        continue;
+      }
+    }  // switch
+  }  // while
+success:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto success;
+#undef CHK_
+}
+
+::PROTOBUF_NAMESPACE_ID::uint8* SearchStats::_InternalSerialize(
+    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:netspeak.service.SearchStats)
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // uint64 parse_time = 1;
+  if (this->parse_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(1, this->_internal_parse_time(), target);
+  }
+
+  // uint64 normalize_time = 2;
+  if (this->normalize_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(2, this->_internal_normalize_time(), target);
+  }
+
+  // uint64 postlist_index_time = 3;
+  if (this->postlist_index_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(3, this->_internal_postlist_index_time(), target);
+  }
+
+  // uint64 postlist_read_time = 4;
+  if (this->postlist_read_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(4, this->_internal_postlist_read_time(), target);
+  }
+
+  // uint64 intersect_time = 5;
+  if (this->intersect_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(5, this->_internal_intersect_time(), target);
+  }
+
+  // uint64 merge_time = 6;
+  if (this->merge_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(6, this->_internal_merge_time(), target);
+  }
+
+  // uint64 read_phrases_time = 7;
+  if (this->read_phrases_time() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(7, this->_internal_read_phrases_time(), target);
+  }
+
+  // uint64 norm_queries = 8;
+  if (this->norm_queries() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(8, this->_internal_norm_queries(), target);
+  }
+
+  // uint64 postlists_read = 9;
+  if (this->postlists_read() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(9, this->_internal_postlists_read(), target);
+  }
+
+  // uint64 bytes_read = 10;
+  if (this->bytes_read() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(10, this->_internal_bytes_read(), target);
+  }
+
+  // uint64 entries_scanned = 11;
+  if (this->entries_scanned() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(11, this->_internal_entries_scanned(), target);
+  }
+
+  // uint64 result_cache_hits = 12;
+  if (this->result_cache_hits() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(12, this->_internal_result_cache_hits(), target);
+  }
+
+  // uint64 query_cache_hits = 13;
+  if (this->query_cache_hits() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(13, this->_internal_query_cache_hits(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields(), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:netspeak.service.SearchStats)
+  return target;
+}
+
+size_t SearchStats::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:netspeak.service.SearchStats)
+  size_t total_size = 0;
+
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // uint64 parse_time = 1;
+  if (this->parse_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_parse_time());
+  }
+
+  // uint64 normalize_time = 2;
+  if (this->normalize_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_normalize_time());
+  }
+
+  // uint64 postlist_index_time = 3;
+  if (this->postlist_index_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_postlist_index_time());
+  }
+
+  // uint64 postlist_read_time = 4;
+  if (this->postlist_read_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_postlist_read_time());
+  }
+
+  // uint64 intersect_time = 5;
+  if (this->intersect_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_intersect_time());
+  }
+
+  // uint64 merge_time = 6;
+  if (this->merge_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_merge_time());
+  }
+
+  // uint64 read_phrases_time = 7;
+  if (this->read_phrases_time() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_read_phrases_time());
+  }
+
+  // uint64 norm_queries = 8;
+  if (this->norm_queries() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_norm_queries());
+  }
+
+  // uint64 postlists_read = 9;
+  if (this->postlists_read() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_postlists_read());
+  }
+
+  // uint64 bytes_read = 10;
+  if (this->bytes_read() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_bytes_read());
+  }
+
+  // uint64 entries_scanned = 11;
+  if (this->entries_scanned() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_entries_scanned());
+  }
+
+  // uint64 result_cache_hits = 12;
+  if (this->result_cache_hits() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_result_cache_hits());
+  }
+
+  // uint64 query_cache_hits = 13;
+  if (this->query_cache_hits() != 0) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
+        this->_internal_query_cache_hits());
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
+        _internal_metadata_, total_size, &_cached_size_);
+  }
+  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
+  SetCachedSize(cached_size);
+  return total_size;
+}
+
+void SearchStats::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:netspeak.service.SearchStats)
+  GOOGLE_DCHECK_NE(&from, this);
+  const SearchStats* source =
+      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<SearchStats>(
+          &from);
+  if (source == nullptr) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:netspeak.service.SearchStats)
+    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:netspeak.service.SearchStats)
+    MergeFrom(*source);
+  }
+}
+
+void SearchStats::MergeFrom(const SearchStats& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:netspeak.service.SearchStats)
+  GOOGLE_DCHECK_NE(&from, this);
+  _internal_metadata_.MergeFrom(from._internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from.parse_time() != 0) {
+    _internal_set_parse_time(from._internal_parse_time());
+  }
+  if (from.normalize_time() != 0) {
+    _internal_set_normalize_time(from._internal_normalize_time());
+  }
+  if (from.postlist_index_time() != 0) {
+    _internal_set_postlist_index_time(from._internal_postlist_index_time());
+  }
+  if (from.postlist_read_time() != 0) {
+    _internal_set_postlist_read_time(from._internal_postlist_read_time());
+  }
+  if (from.intersect_time() != 0) {
+    _internal_set_intersect_time(from._internal_intersect_time());
+  }
+  if (from.merge_time() != 0) {
+    _internal_set_merge_time(from._internal_merge_time());
+  }
+  if (from.read_phrases_time() != 0) {
+    _internal_set_read_phrases_time(from._internal_read_phrases_time());
+  }
+  if (from.norm_queries() != 0) {
+    _internal_set_norm_queries(from._internal_norm_queries());
+  }
+  if (from.postlists_read() != 0) {
+    _internal_set_postlists_read(from._internal_postlists_read());
+  }
+  if (from.bytes_read() != 0) {
+    _internal_set_bytes_read(from._internal_bytes_read());
+  }
+  if (from.entries_scanned() != 0) {
+    _internal_set_entries_scanned(from._internal_entries_scanned());
+  }
+  if (from.result_cache_hits() != 0) {
+    _internal_set_result_cache_hits(from._internal_result_cache_hits());
+  }
+  if (from.query_cache_hits() != 0) {
+    _internal_set_query_cache_hits(from._internal_query_cache_hits());
+  }
+}
+
+void SearchStats::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:netspeak.service.SearchStats)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void SearchStats::CopyFrom(const SearchStats& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:netspeak.service.SearchStats)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool SearchStats::IsInitialized() const {
+  return true;
+}
+
+void SearchStats::InternalSwap(SearchStats* other) {
+  using std::swap;
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  swap(parse_time_, other->parse_time_);
+  swap(normalize_time_, other->normalize_time_);
+  swap(postlist_index_time_, other->postlist_index_time_);
+  swap(postlist_read_time_, other->postlist_read_time_);
+  swap(intersect_time_, other->intersect_time_);
+  swap(merge_time_, other->merge_time_);
+  swap(read_phrases_time_, other->read_phrases_time_);
+  swap(norm_queries_, other->norm_queries_);
+  swap(postlists_read_, other->postlists_read_);
+  swap(bytes_read_, other->bytes_read_);
+  swap(entries_scanned_, other->entries_scanned_);
+  swap(result_cache_hits_, other->result_cache_hits_);
+  swap(query_cache_hits_, other->query_cache_hits_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata SearchStats::GetMetadata() const {
+  return GetMetadataStatic();
+}
+
+
+// @@protoc_insertion_point(namespace_scope)
+}  // namespace service
+}  // namespace netspeak
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchRequest* Arena::CreateMaybeMessage< ::netspeak::service::SearchRequest >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::PhraseConstraints* Arena::CreateMaybeMessage< ::netspeak::service::PhraseConstraints >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::PhraseConstraints >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::Phrase_Word* Arena::CreateMaybeMessage< ::netspeak::service::Phrase_Word >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::Phrase_Word >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::Phrase* Arena::CreateMaybeMessage< ::netspeak::service::Phrase >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::Phrase >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchResponse_Result* Arena::CreateMaybeMessage< ::netspeak::service::SearchResponse_Result >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchResponse_Result >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchResponse_Error* Arena::CreateMaybeMessage< ::netspeak::service::SearchResponse_Error >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchResponse_Error >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchResponse* Arena::CreateMaybeMessage< ::netspeak::service::SearchResponse >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchResponse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::CorporaRequest* Arena::CreateMaybeMessage< ::netspeak::service::CorporaRequest >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::CorporaRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::Corpus* Arena::CreateMaybeMessage< ::netspeak::service::Corpus >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::Corpus >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::CorporaResponse* Arena::CreateMaybeMessage< ::netspeak::service::CorporaResponse >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::CorporaResponse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchBatchRequest* Arena::CreateMaybeMessage< ::netspeak::service::SearchBatchRequest >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchBatchRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchBatchResponse* Arena::CreateMaybeMessage< ::netspeak::service::SearchBatchResponse >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchBatchResponse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::netspeak::service::SearchStats* Arena::CreateMaybeMessage< ::netspeak::service::SearchStats >(Arena* arena) {
+  return Arena::CreateInternal< ::netspeak::service::SearchStats >(arena);
 }
 PROTOBUF_NAMESPACE_CLOSE
 
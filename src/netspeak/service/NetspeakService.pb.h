@@ -48,7 +48,7 @@ struct TableStruct_NetspeakService_2eproto {
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
   static const ::PROTOBUF_NAMESPACE_ID::internal::AuxillaryParseTableField aux[]
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[10]
+  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[13]
     PROTOBUF_SECTION_VARIABLE(protodesc_cold);
   static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
   static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
@@ -75,6 +75,12 @@ extern PhraseConstraintsDefaultTypeInternal _PhraseConstraints_default_instance_
 class Phrase_Word;
 class Phrase_WordDefaultTypeInternal;
 extern Phrase_WordDefaultTypeInternal _Phrase_Word_default_instance_;
+class SearchBatchRequest;
+class SearchBatchRequestDefaultTypeInternal;
+extern SearchBatchRequestDefaultTypeInternal _SearchBatchRequest_default_instance_;
+class SearchBatchResponse;
+class SearchBatchResponseDefaultTypeInternal;
+extern SearchBatchResponseDefaultTypeInternal _SearchBatchResponse_default_instance_;
 class SearchRequest;
 class SearchRequestDefaultTypeInternal;
 extern SearchRequestDefaultTypeInternal _SearchRequest_default_instance_;
@@ -87,6 +93,9 @@ extern SearchResponse_ErrorDefaultTypeInternal _SearchResponse_Error_default_ins
 class SearchResponse_Result;
 class SearchResponse_ResultDefaultTypeInternal;
 extern SearchResponse_ResultDefaultTypeInternal _SearchResponse_Result_default_instance_;
+class SearchStats;
+class SearchStatsDefaultTypeInternal;
+extern SearchStatsDefaultTypeInternal _SearchStats_default_instance_;
 }  // namespace service
 }  // namespace netspeak
 PROTOBUF_NAMESPACE_OPEN
@@ -96,10 +105,13 @@ template<> ::netspeak::service::Corpus* Arena::CreateMaybeMessage<::netspeak::se
 template<> ::netspeak::service::Phrase* Arena::CreateMaybeMessage<::netspeak::service::Phrase>(Arena*);
 template<> ::netspeak::service::PhraseConstraints* Arena::CreateMaybeMessage<::netspeak::service::PhraseConstraints>(Arena*);
 template<> ::netspeak::service::Phrase_Word* Arena::CreateMaybeMessage<::netspeak::service::Phrase_Word>(Arena*);
+template<> ::netspeak::service::SearchBatchRequest* Arena::CreateMaybeMessage<::netspeak::service::SearchBatchRequest>(Arena*);
+template<> ::netspeak::service::SearchBatchResponse* Arena::CreateMaybeMessage<::netspeak::service::SearchBatchResponse>(Arena*);
 template<> ::netspeak::service::SearchRequest* Arena::CreateMaybeMessage<::netspeak::service::SearchRequest>(Arena*);
 template<> ::netspeak::service::SearchResponse* Arena::CreateMaybeMessage<::netspeak::service::SearchResponse>(Arena*);
 template<> ::netspeak::service::SearchResponse_Error* Arena::CreateMaybeMessage<::netspeak::service::SearchResponse_Error>(Arena*);
 template<> ::netspeak::service::SearchResponse_Result* Arena::CreateMaybeMessage<::netspeak::service::SearchResponse_Result>(Arena*);
+template<> ::netspeak::service::SearchStats* Arena::CreateMaybeMessage<::netspeak::service::SearchStats>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace netspeak {
 namespace service {
@@ -271,11 +283,40 @@ class SearchRequest :
   // accessors -------------------------------------------------------
 
   enum : int {
+    kCorporaFieldNumber = 8,
     kQueryFieldNumber = 1,
     kCorpusFieldNumber = 2,
+    kContinuationTokenFieldNumber = 5,
     kPhraseConstraintsFieldNumber = 4,
     kMaxPhrasesFieldNumber = 3,
+    kCountOnlyFieldNumber = 6,
+    kEstimateCountFieldNumber = 7,
+    kDebugFieldNumber = 9,
   };
+  // repeated string corpora = 8;
+  int corpora_size() const;
+  private:
+  int _internal_corpora_size() const;
+  public:
+  void clear_corpora();
+  const std::string& corpora(int index) const;
+  std::string* mutable_corpora(int index);
+  void set_corpora(int index, const std::string& value);
+  void set_corpora(int index, std::string&& value);
+  void set_corpora(int index, const char* value);
+  void set_corpora(int index, const char* value, size_t size);
+  std::string* add_corpora();
+  void add_corpora(const std::string& value);
+  void add_corpora(std::string&& value);
+  void add_corpora(const char* value);
+  void add_corpora(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& corpora() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_corpora();
+  private:
+  const std::string& _internal_corpora(int index) const;
+  std::string* _internal_add_corpora();
+  public:
+
   // string query = 1;
   void clear_query();
   const std::string& query() const;
@@ -308,6 +349,22 @@ class SearchRequest :
   std::string* _internal_mutable_corpus();
   public:
 
+  // bytes continuation_token = 5;
+  void clear_continuation_token();
+  const std::string& continuation_token() const;
+  void set_continuation_token(const std::string& value);
+  void set_continuation_token(std::string&& value);
+  void set_continuation_token(const char* value);
+  void set_continuation_token(const void* value, size_t size);
+  std::string* mutable_continuation_token();
+  std::string* release_continuation_token();
+  void set_allocated_continuation_token(std::string* continuation_token);
+  private:
+  const std::string& _internal_continuation_token() const;
+  void _internal_set_continuation_token(const std::string& value);
+  std::string* _internal_mutable_continuation_token();
+  public:
+
   // .netspeak.service.PhraseConstraints phrase_constraints = 4;
   bool has_phrase_constraints() const;
   private:
@@ -332,15 +389,47 @@ class SearchRequest :
   void _internal_set_max_phrases(::PROTOBUF_NAMESPACE_ID::uint32 value);
   public:
 
+  // bool count_only = 6;
+  void clear_count_only();
+  bool count_only() const;
+  void set_count_only(bool value);
+  private:
+  bool _internal_count_only() const;
+  void _internal_set_count_only(bool value);
+  public:
+
+  // bool estimate_count = 7;
+  void clear_estimate_count();
+  bool estimate_count() const;
+  void set_estimate_count(bool value);
+  private:
+  bool _internal_estimate_count() const;
+  void _internal_set_estimate_count(bool value);
+  public:
+
+  // bool debug = 9;
+  void clear_debug();
+  bool debug() const;
+  void set_debug(bool value);
+  private:
+  bool _internal_debug() const;
+  void _internal_set_debug(bool value);
+  public:
+
   // @@protoc_insertion_point(class_scope:netspeak.service.SearchRequest)
  private:
   class _Internal;
 
   ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> corpora_;
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr query_;
   ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr corpus_;
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr continuation_token_;
   ::netspeak::service::PhraseConstraints* phrase_constraints_;
   ::PROTOBUF_NAMESPACE_ID::uint32 max_phrases_;
+  bool count_only_;
+  bool estimate_count_;
+  bool debug_;
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_NetspeakService_2eproto;
 };
@@ -953,6 +1042,9 @@ class SearchResponse_Result :
   enum : int {
     kPhrasesFieldNumber = 1,
     kUnknownWordsFieldNumber = 2,
+    kContinuationTokenFieldNumber = 3,
+    kPhraseCountFieldNumber = 4,
+    kFrequencySumFieldNumber = 5,
   };
   // repeated .netspeak.service.Phrase phrases = 1;
   int phrases_size() const;
@@ -996,6 +1088,40 @@ class SearchResponse_Result :
   std::string* _internal_add_unknown_words();
   public:
 
+  // bytes continuation_token = 3;
+  void clear_continuation_token();
+  const std::string& continuation_token() const;
+  void set_continuation_token(const std::string& value);
+  void set_continuation_token(std::string&& value);
+  void set_continuation_token(const char* value);
+  void set_continuation_token(const void* value, size_t size);
+  std::string* mutable_continuation_token();
+  std::string* release_continuation_token();
+  void set_allocated_continuation_token(std::string* continuation_token);
+  private:
+  const std::string& _internal_continuation_token() const;
+  void _internal_set_continuation_token(const std::string& value);
+  std::string* _internal_mutable_continuation_token();
+  public:
+
+  // uint64 phrase_count = 4;
+  void clear_phrase_count();
+  ::PROTOBUF_NAMESPACE_ID::uint64 phrase_count() const;
+  void set_phrase_count(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_phrase_count() const;
+  void _internal_set_phrase_count(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 frequency_sum = 5;
+  void clear_frequency_sum();
+  ::PROTOBUF_NAMESPACE_ID::uint64 frequency_sum() const;
+  void set_frequency_sum(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_frequency_sum() const;
+  void _internal_set_frequency_sum(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
   // @@protoc_insertion_point(class_scope:netspeak.service.SearchResponse.Result)
  private:
   class _Internal;
@@ -1003,6 +1129,9 @@ class SearchResponse_Result :
   ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
   ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::Phrase > phrases_;
   ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> unknown_words_;
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr continuation_token_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 phrase_count_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 frequency_sum_;
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_NetspeakService_2eproto;
 };
@@ -1305,9 +1434,44 @@ class SearchResponse :
   // accessors -------------------------------------------------------
 
   enum : int {
+    kCorpusResponsesFieldNumber = 3,
+    kStatsFieldNumber = 4,
     kResultFieldNumber = 1,
     kErrorFieldNumber = 2,
   };
+  // repeated .netspeak.service.SearchResponse corpus_responses = 3;
+  int corpus_responses_size() const;
+  private:
+  int _internal_corpus_responses_size() const;
+  public:
+  void clear_corpus_responses();
+  ::netspeak::service::SearchResponse* mutable_corpus_responses(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >*
+      mutable_corpus_responses();
+  private:
+  const ::netspeak::service::SearchResponse& _internal_corpus_responses(int index) const;
+  ::netspeak::service::SearchResponse* _internal_add_corpus_responses();
+  public:
+  const ::netspeak::service::SearchResponse& corpus_responses(int index) const;
+  ::netspeak::service::SearchResponse* add_corpus_responses();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >&
+      corpus_responses() const;
+
+  // .netspeak.service.SearchStats stats = 4;
+  bool has_stats() const;
+  private:
+  bool _internal_has_stats() const;
+  public:
+  void clear_stats();
+  const ::netspeak::service::SearchStats& stats() const;
+  ::netspeak::service::SearchStats* release_stats();
+  ::netspeak::service::SearchStats* mutable_stats();
+  void set_allocated_stats(::netspeak::service::SearchStats* stats);
+  private:
+  const ::netspeak::service::SearchStats& _internal_stats() const;
+  ::netspeak::service::SearchStats* _internal_mutable_stats();
+  public:
+
   // .netspeak.service.SearchResponse.Result result = 1;
   bool has_result() const;
   private:
@@ -1350,6 +1514,8 @@ class SearchResponse :
   inline void clear_has_response();
 
   ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse > corpus_responses_;
+  ::netspeak::service::SearchStats* stats_;
   union ResponseUnion {
     ResponseUnion() {}
     ::netspeak::service::SearchResponse_Result* result_;
@@ -1783,204 +1949,738 @@ class CorporaResponse :
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   friend struct ::TableStruct_NetspeakService_2eproto;
 };
-// ===================================================================
-
+// -------------------------------------------------------------------
 
-// ===================================================================
+class SearchBatchRequest :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:netspeak.service.SearchBatchRequest) */ {
+ public:
+  SearchBatchRequest();
+  virtual ~SearchBatchRequest();
 
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// SearchRequest
+  SearchBatchRequest(const SearchBatchRequest& from);
+  SearchBatchRequest(SearchBatchRequest&& from) noexcept
+    : SearchBatchRequest() {
+    *this = ::std::move(from);
+  }
 
-// string query = 1;
-inline void SearchRequest::clear_query() {
-  query_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-inline const std::string& SearchRequest::query() const {
-  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.query)
-  return _internal_query();
-}
-inline void SearchRequest::set_query(const std::string& value) {
-  _internal_set_query(value);
-  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.query)
-}
-inline std::string* SearchRequest::mutable_query() {
-  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.query)
-  return _internal_mutable_query();
-}
-inline const std::string& SearchRequest::_internal_query() const {
-  return query_.GetNoArena();
-}
-inline void SearchRequest::_internal_set_query(const std::string& value) {
-  
-  query_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value);
-}
-inline void SearchRequest::set_query(std::string&& value) {
-  
-  query_.SetNoArena(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
-  // @@protoc_insertion_point(field_set_rvalue:netspeak.service.SearchRequest.query)
-}
-inline void SearchRequest::set_query(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  query_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
-  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchRequest.query)
-}
-inline void SearchRequest::set_query(const char* value, size_t size) {
-  
-  query_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      ::std::string(reinterpret_cast<const char*>(value), size));
-  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchRequest.query)
-}
-inline std::string* SearchRequest::_internal_mutable_query() {
-  
-  return query_.MutableNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-inline std::string* SearchRequest::release_query() {
-  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.query)
-  
-  return query_.ReleaseNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-inline void SearchRequest::set_allocated_query(std::string* query) {
-  if (query != nullptr) {
-    
-  } else {
-    
+  inline SearchBatchRequest& operator=(const SearchBatchRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SearchBatchRequest& operator=(SearchBatchRequest&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
-  query_.SetAllocatedNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), query);
-  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchRequest.query)
-}
 
-// string corpus = 2;
-inline void SearchRequest::clear_corpus() {
-  corpus_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-inline const std::string& SearchRequest::corpus() const {
-  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.corpus)
-  return _internal_corpus();
-}
-inline void SearchRequest::set_corpus(const std::string& value) {
-  _internal_set_corpus(value);
-  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.corpus)
-}
-inline std::string* SearchRequest::mutable_corpus() {
-  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.corpus)
-  return _internal_mutable_corpus();
-}
-inline const std::string& SearchRequest::_internal_corpus() const {
-  return corpus_.GetNoArena();
-}
-inline void SearchRequest::_internal_set_corpus(const std::string& value) {
-  
-  corpus_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value);
-}
-inline void SearchRequest::set_corpus(std::string&& value) {
-  
-  corpus_.SetNoArena(
-    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
-  // @@protoc_insertion_point(field_set_rvalue:netspeak.service.SearchRequest.corpus)
-}
-inline void SearchRequest::set_corpus(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  corpus_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
-  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchRequest.corpus)
-}
-inline void SearchRequest::set_corpus(const char* value, size_t size) {
-  
-  corpus_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
-      ::std::string(reinterpret_cast<const char*>(value), size));
-  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchRequest.corpus)
-}
-inline std::string* SearchRequest::_internal_mutable_corpus() {
-  
-  return corpus_.MutableNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-inline std::string* SearchRequest::release_corpus() {
-  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.corpus)
-  
-  return corpus_.ReleaseNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-}
-inline void SearchRequest::set_allocated_corpus(std::string* corpus) {
-  if (corpus != nullptr) {
-    
-  } else {
-    
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
   }
-  corpus_.SetAllocatedNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), corpus);
-  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchRequest.corpus)
-}
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const SearchBatchRequest& default_instance();
 
-// uint32 max_phrases = 3;
-inline void SearchRequest::clear_max_phrases() {
-  max_phrases_ = 0u;
-}
-inline ::PROTOBUF_NAMESPACE_ID::uint32 SearchRequest::_internal_max_phrases() const {
-  return max_phrases_;
-}
-inline ::PROTOBUF_NAMESPACE_ID::uint32 SearchRequest::max_phrases() const {
-  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.max_phrases)
-  return _internal_max_phrases();
-}
-inline void SearchRequest::_internal_set_max_phrases(::PROTOBUF_NAMESPACE_ID::uint32 value) {
-  
-  max_phrases_ = value;
-}
-inline void SearchRequest::set_max_phrases(::PROTOBUF_NAMESPACE_ID::uint32 value) {
-  _internal_set_max_phrases(value);
-  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.max_phrases)
-}
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const SearchBatchRequest* internal_default_instance() {
+    return reinterpret_cast<const SearchBatchRequest*>(
+               &_SearchBatchRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    10;
 
-// .netspeak.service.PhraseConstraints phrase_constraints = 4;
-inline bool SearchRequest::_internal_has_phrase_constraints() const {
-  return this != internal_default_instance() && phrase_constraints_ != nullptr;
-}
-inline bool SearchRequest::has_phrase_constraints() const {
-  return _internal_has_phrase_constraints();
-}
-inline void SearchRequest::clear_phrase_constraints() {
-  if (GetArenaNoVirtual() == nullptr && phrase_constraints_ != nullptr) {
-    delete phrase_constraints_;
+  friend void swap(SearchBatchRequest& a, SearchBatchRequest& b) {
+    a.Swap(&b);
   }
-  phrase_constraints_ = nullptr;
-}
-inline const ::netspeak::service::PhraseConstraints& SearchRequest::_internal_phrase_constraints() const {
-  const ::netspeak::service::PhraseConstraints* p = phrase_constraints_;
-  return p != nullptr ? *p : *reinterpret_cast<const ::netspeak::service::PhraseConstraints*>(
-      &::netspeak::service::_PhraseConstraints_default_instance_);
-}
-inline const ::netspeak::service::PhraseConstraints& SearchRequest::phrase_constraints() const {
-  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.phrase_constraints)
-  return _internal_phrase_constraints();
-}
-inline ::netspeak::service::PhraseConstraints* SearchRequest::release_phrase_constraints() {
-  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.phrase_constraints)
-  
-  ::netspeak::service::PhraseConstraints* temp = phrase_constraints_;
-  phrase_constraints_ = nullptr;
-  return temp;
-}
-inline ::netspeak::service::PhraseConstraints* SearchRequest::_internal_mutable_phrase_constraints() {
-  
-  if (phrase_constraints_ == nullptr) {
-    auto* p = CreateMaybeMessage<::netspeak::service::PhraseConstraints>(GetArenaNoVirtual());
-    phrase_constraints_ = p;
+  inline void Swap(SearchBatchRequest* other) {
+    if (other == this) return;
+    InternalSwap(other);
   }
-  return phrase_constraints_;
-}
-inline ::netspeak::service::PhraseConstraints* SearchRequest::mutable_phrase_constraints() {
-  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.phrase_constraints)
-  return _internal_mutable_phrase_constraints();
-}
-inline void SearchRequest::set_allocated_phrase_constraints(::netspeak::service::PhraseConstraints* phrase_constraints) {
-  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaNoVirtual();
-  if (message_arena == nullptr) {
-    delete phrase_constraints_;
+
+  // implements Message ----------------------------------------------
+
+  inline SearchBatchRequest* New() const final {
+    return CreateMaybeMessage<SearchBatchRequest>(nullptr);
   }
-  if (phrase_constraints) {
+
+  SearchBatchRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<SearchBatchRequest>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const SearchBatchRequest& from);
+  void MergeFrom(const SearchBatchRequest& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SearchBatchRequest* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "netspeak.service.SearchBatchRequest";
+  }
+  private:
+  inline ::PROTOBUF_NAMESPACE_ID::Arena* GetArenaNoVirtual() const {
+    return nullptr;
+  }
+  inline void* MaybeArenaPtr() const {
+    return nullptr;
+  }
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_NetspeakService_2eproto);
+    return ::descriptor_table_NetspeakService_2eproto.file_level_metadata[kIndexInFileMessages];
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kRequestsFieldNumber = 1,
+  };
+  // repeated .netspeak.service.SearchRequest requests = 1;
+  int requests_size() const;
+  private:
+  int _internal_requests_size() const;
+  public:
+  void clear_requests();
+  ::netspeak::service::SearchRequest* mutable_requests(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchRequest >*
+      mutable_requests();
+  private:
+  const ::netspeak::service::SearchRequest& _internal_requests(int index) const;
+  ::netspeak::service::SearchRequest* _internal_add_requests();
+  public:
+  const ::netspeak::service::SearchRequest& requests(int index) const;
+  ::netspeak::service::SearchRequest* add_requests();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchRequest >&
+      requests() const;
+
+  // @@protoc_insertion_point(class_scope:netspeak.service.SearchBatchRequest)
+ private:
+  class _Internal;
+
+  ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchRequest > requests_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_NetspeakService_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SearchBatchResponse :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:netspeak.service.SearchBatchResponse) */ {
+ public:
+  SearchBatchResponse();
+  virtual ~SearchBatchResponse();
+
+  SearchBatchResponse(const SearchBatchResponse& from);
+  SearchBatchResponse(SearchBatchResponse&& from) noexcept
+    : SearchBatchResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline SearchBatchResponse& operator=(const SearchBatchResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SearchBatchResponse& operator=(SearchBatchResponse&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const SearchBatchResponse& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const SearchBatchResponse* internal_default_instance() {
+    return reinterpret_cast<const SearchBatchResponse*>(
+               &_SearchBatchResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    11;
+
+  friend void swap(SearchBatchResponse& a, SearchBatchResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SearchBatchResponse* other) {
+    if (other == this) return;
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline SearchBatchResponse* New() const final {
+    return CreateMaybeMessage<SearchBatchResponse>(nullptr);
+  }
+
+  SearchBatchResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<SearchBatchResponse>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const SearchBatchResponse& from);
+  void MergeFrom(const SearchBatchResponse& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SearchBatchResponse* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "netspeak.service.SearchBatchResponse";
+  }
+  private:
+  inline ::PROTOBUF_NAMESPACE_ID::Arena* GetArenaNoVirtual() const {
+    return nullptr;
+  }
+  inline void* MaybeArenaPtr() const {
+    return nullptr;
+  }
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_NetspeakService_2eproto);
+    return ::descriptor_table_NetspeakService_2eproto.file_level_metadata[kIndexInFileMessages];
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kResponsesFieldNumber = 1,
+  };
+  // repeated .netspeak.service.SearchResponse responses = 1;
+  int responses_size() const;
+  private:
+  int _internal_responses_size() const;
+  public:
+  void clear_responses();
+  ::netspeak::service::SearchResponse* mutable_responses(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >*
+      mutable_responses();
+  private:
+  const ::netspeak::service::SearchResponse& _internal_responses(int index) const;
+  ::netspeak::service::SearchResponse* _internal_add_responses();
+  public:
+  const ::netspeak::service::SearchResponse& responses(int index) const;
+  ::netspeak::service::SearchResponse* add_responses();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >&
+      responses() const;
+
+  // @@protoc_insertion_point(class_scope:netspeak.service.SearchBatchResponse)
+ private:
+  class _Internal;
+
+  ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse > responses_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_NetspeakService_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SearchStats :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:netspeak.service.SearchStats) */ {
+ public:
+  SearchStats();
+  virtual ~SearchStats();
+
+  SearchStats(const SearchStats& from);
+  SearchStats(SearchStats&& from) noexcept
+    : SearchStats() {
+    *this = ::std::move(from);
+  }
+
+  inline SearchStats& operator=(const SearchStats& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SearchStats& operator=(SearchStats&& from) noexcept {
+    if (GetArenaNoVirtual() == from.GetArenaNoVirtual()) {
+      if (this != &from) InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return GetMetadataStatic().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return GetMetadataStatic().reflection;
+  }
+  static const SearchStats& default_instance();
+
+  static void InitAsDefaultInstance();  // FOR INTERNAL USE ONLY
+  static inline const SearchStats* internal_default_instance() {
+    return reinterpret_cast<const SearchStats*>(
+               &_SearchStats_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    12;
+
+  friend void swap(SearchStats& a, SearchStats& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SearchStats* other) {
+    if (other == this) return;
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  inline SearchStats* New() const final {
+    return CreateMaybeMessage<SearchStats>(nullptr);
+  }
+
+  SearchStats* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+    return CreateMaybeMessage<SearchStats>(arena);
+  }
+  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  void CopyFrom(const SearchStats& from);
+  void MergeFrom(const SearchStats& from);
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
+      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _cached_size_.Get(); }
+
+  private:
+  inline void SharedCtor();
+  inline void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SearchStats* other);
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "netspeak.service.SearchStats";
+  }
+  private:
+  inline ::PROTOBUF_NAMESPACE_ID::Arena* GetArenaNoVirtual() const {
+    return nullptr;
+  }
+  inline void* MaybeArenaPtr() const {
+    return nullptr;
+  }
+  public:
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+  private:
+  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
+    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_NetspeakService_2eproto);
+    return ::descriptor_table_NetspeakService_2eproto.file_level_metadata[kIndexInFileMessages];
+  }
+
+  public:
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kParseTimeFieldNumber = 1,
+    kNormalizeTimeFieldNumber = 2,
+    kPostlistIndexTimeFieldNumber = 3,
+    kPostlistReadTimeFieldNumber = 4,
+    kIntersectTimeFieldNumber = 5,
+    kMergeTimeFieldNumber = 6,
+    kReadPhrasesTimeFieldNumber = 7,
+    kNormQueriesFieldNumber = 8,
+    kPostlistsReadFieldNumber = 9,
+    kBytesReadFieldNumber = 10,
+    kEntriesScannedFieldNumber = 11,
+    kResultCacheHitsFieldNumber = 12,
+    kQueryCacheHitsFieldNumber = 13,
+  };
+  // uint64 parse_time = 1;
+  void clear_parse_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 parse_time() const;
+  void set_parse_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_parse_time() const;
+  void _internal_set_parse_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 normalize_time = 2;
+  void clear_normalize_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 normalize_time() const;
+  void set_normalize_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_normalize_time() const;
+  void _internal_set_normalize_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 postlist_index_time = 3;
+  void clear_postlist_index_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 postlist_index_time() const;
+  void set_postlist_index_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_postlist_index_time() const;
+  void _internal_set_postlist_index_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 postlist_read_time = 4;
+  void clear_postlist_read_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 postlist_read_time() const;
+  void set_postlist_read_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_postlist_read_time() const;
+  void _internal_set_postlist_read_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 intersect_time = 5;
+  void clear_intersect_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 intersect_time() const;
+  void set_intersect_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_intersect_time() const;
+  void _internal_set_intersect_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 merge_time = 6;
+  void clear_merge_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 merge_time() const;
+  void set_merge_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_merge_time() const;
+  void _internal_set_merge_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 read_phrases_time = 7;
+  void clear_read_phrases_time();
+  ::PROTOBUF_NAMESPACE_ID::uint64 read_phrases_time() const;
+  void set_read_phrases_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_read_phrases_time() const;
+  void _internal_set_read_phrases_time(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 norm_queries = 8;
+  void clear_norm_queries();
+  ::PROTOBUF_NAMESPACE_ID::uint64 norm_queries() const;
+  void set_norm_queries(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_norm_queries() const;
+  void _internal_set_norm_queries(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 postlists_read = 9;
+  void clear_postlists_read();
+  ::PROTOBUF_NAMESPACE_ID::uint64 postlists_read() const;
+  void set_postlists_read(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_postlists_read() const;
+  void _internal_set_postlists_read(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 bytes_read = 10;
+  void clear_bytes_read();
+  ::PROTOBUF_NAMESPACE_ID::uint64 bytes_read() const;
+  void set_bytes_read(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_bytes_read() const;
+  void _internal_set_bytes_read(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 entries_scanned = 11;
+  void clear_entries_scanned();
+  ::PROTOBUF_NAMESPACE_ID::uint64 entries_scanned() const;
+  void set_entries_scanned(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_entries_scanned() const;
+  void _internal_set_entries_scanned(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 result_cache_hits = 12;
+  void clear_result_cache_hits();
+  ::PROTOBUF_NAMESPACE_ID::uint64 result_cache_hits() const;
+  void set_result_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_result_cache_hits() const;
+  void _internal_set_result_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // uint64 query_cache_hits = 13;
+  void clear_query_cache_hits();
+  ::PROTOBUF_NAMESPACE_ID::uint64 query_cache_hits() const;
+  void set_query_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  private:
+  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_query_cache_hits() const;
+  void _internal_set_query_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:netspeak.service.SearchStats)
+ private:
+  class _Internal;
+
+  ::PROTOBUF_NAMESPACE_ID::internal::InternalMetadataWithArena _internal_metadata_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 parse_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 normalize_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 postlist_index_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 postlist_read_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 intersect_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 merge_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 read_phrases_time_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 norm_queries_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 postlists_read_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 bytes_read_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 entries_scanned_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 result_cache_hits_;
+  ::PROTOBUF_NAMESPACE_ID::uint64 query_cache_hits_;
+  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  friend struct ::TableStruct_NetspeakService_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// SearchRequest
+
+// string query = 1;
+inline void SearchRequest::clear_query() {
+  query_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline const std::string& SearchRequest::query() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.query)
+  return _internal_query();
+}
+inline void SearchRequest::set_query(const std::string& value) {
+  _internal_set_query(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.query)
+}
+inline std::string* SearchRequest::mutable_query() {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.query)
+  return _internal_mutable_query();
+}
+inline const std::string& SearchRequest::_internal_query() const {
+  return query_.GetNoArena();
+}
+inline void SearchRequest::_internal_set_query(const std::string& value) {
+  
+  query_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value);
+}
+inline void SearchRequest::set_query(std::string&& value) {
+  
+  query_.SetNoArena(
+    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:netspeak.service.SearchRequest.query)
+}
+inline void SearchRequest::set_query(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  
+  query_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchRequest.query)
+}
+inline void SearchRequest::set_query(const char* value, size_t size) {
+  
+  query_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchRequest.query)
+}
+inline std::string* SearchRequest::_internal_mutable_query() {
+  
+  return query_.MutableNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline std::string* SearchRequest::release_query() {
+  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.query)
+  
+  return query_.ReleaseNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline void SearchRequest::set_allocated_query(std::string* query) {
+  if (query != nullptr) {
+    
+  } else {
+    
+  }
+  query_.SetAllocatedNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), query);
+  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchRequest.query)
+}
+
+// string corpus = 2;
+inline void SearchRequest::clear_corpus() {
+  corpus_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline const std::string& SearchRequest::corpus() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.corpus)
+  return _internal_corpus();
+}
+inline void SearchRequest::set_corpus(const std::string& value) {
+  _internal_set_corpus(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.corpus)
+}
+inline std::string* SearchRequest::mutable_corpus() {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.corpus)
+  return _internal_mutable_corpus();
+}
+inline const std::string& SearchRequest::_internal_corpus() const {
+  return corpus_.GetNoArena();
+}
+inline void SearchRequest::_internal_set_corpus(const std::string& value) {
+  
+  corpus_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value);
+}
+inline void SearchRequest::set_corpus(std::string&& value) {
+  
+  corpus_.SetNoArena(
+    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:netspeak.service.SearchRequest.corpus)
+}
+inline void SearchRequest::set_corpus(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  
+  corpus_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchRequest.corpus)
+}
+inline void SearchRequest::set_corpus(const char* value, size_t size) {
+  
+  corpus_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchRequest.corpus)
+}
+inline std::string* SearchRequest::_internal_mutable_corpus() {
+  
+  return corpus_.MutableNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline std::string* SearchRequest::release_corpus() {
+  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.corpus)
+  
+  return corpus_.ReleaseNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline void SearchRequest::set_allocated_corpus(std::string* corpus) {
+  if (corpus != nullptr) {
+    
+  } else {
+    
+  }
+  corpus_.SetAllocatedNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), corpus);
+  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchRequest.corpus)
+}
+
+// uint32 max_phrases = 3;
+inline void SearchRequest::clear_max_phrases() {
+  max_phrases_ = 0u;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint32 SearchRequest::_internal_max_phrases() const {
+  return max_phrases_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint32 SearchRequest::max_phrases() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.max_phrases)
+  return _internal_max_phrases();
+}
+inline void SearchRequest::_internal_set_max_phrases(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+  
+  max_phrases_ = value;
+}
+inline void SearchRequest::set_max_phrases(::PROTOBUF_NAMESPACE_ID::uint32 value) {
+  _internal_set_max_phrases(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.max_phrases)
+}
+
+// .netspeak.service.PhraseConstraints phrase_constraints = 4;
+inline bool SearchRequest::_internal_has_phrase_constraints() const {
+  return this != internal_default_instance() && phrase_constraints_ != nullptr;
+}
+inline bool SearchRequest::has_phrase_constraints() const {
+  return _internal_has_phrase_constraints();
+}
+inline void SearchRequest::clear_phrase_constraints() {
+  if (GetArenaNoVirtual() == nullptr && phrase_constraints_ != nullptr) {
+    delete phrase_constraints_;
+  }
+  phrase_constraints_ = nullptr;
+}
+inline const ::netspeak::service::PhraseConstraints& SearchRequest::_internal_phrase_constraints() const {
+  const ::netspeak::service::PhraseConstraints* p = phrase_constraints_;
+  return p != nullptr ? *p : *reinterpret_cast<const ::netspeak::service::PhraseConstraints*>(
+      &::netspeak::service::_PhraseConstraints_default_instance_);
+}
+inline const ::netspeak::service::PhraseConstraints& SearchRequest::phrase_constraints() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.phrase_constraints)
+  return _internal_phrase_constraints();
+}
+inline ::netspeak::service::PhraseConstraints* SearchRequest::release_phrase_constraints() {
+  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.phrase_constraints)
+  
+  ::netspeak::service::PhraseConstraints* temp = phrase_constraints_;
+  phrase_constraints_ = nullptr;
+  return temp;
+}
+inline ::netspeak::service::PhraseConstraints* SearchRequest::_internal_mutable_phrase_constraints() {
+  
+  if (phrase_constraints_ == nullptr) {
+    auto* p = CreateMaybeMessage<::netspeak::service::PhraseConstraints>(GetArenaNoVirtual());
+    phrase_constraints_ = p;
+  }
+  return phrase_constraints_;
+}
+inline ::netspeak::service::PhraseConstraints* SearchRequest::mutable_phrase_constraints() {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.phrase_constraints)
+  return _internal_mutable_phrase_constraints();
+}
+inline void SearchRequest::set_allocated_phrase_constraints(::netspeak::service::PhraseConstraints* phrase_constraints) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaNoVirtual();
+  if (message_arena == nullptr) {
+    delete phrase_constraints_;
+  }
+  if (phrase_constraints) {
     ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena = nullptr;
     if (message_arena != submessage_arena) {
       phrase_constraints = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
@@ -1994,6 +2694,200 @@ inline void SearchRequest::set_allocated_phrase_constraints(::netspeak::service:
   // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchRequest.phrase_constraints)
 }
 
+// bytes continuation_token = 5;
+inline void SearchRequest::clear_continuation_token() {
+  continuation_token_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline const std::string& SearchRequest::continuation_token() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.continuation_token)
+  return _internal_continuation_token();
+}
+inline void SearchRequest::set_continuation_token(const std::string& value) {
+  _internal_set_continuation_token(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.continuation_token)
+}
+inline std::string* SearchRequest::mutable_continuation_token() {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.continuation_token)
+  return _internal_mutable_continuation_token();
+}
+inline const std::string& SearchRequest::_internal_continuation_token() const {
+  return continuation_token_.GetNoArena();
+}
+inline void SearchRequest::_internal_set_continuation_token(const std::string& value) {
+  
+  continuation_token_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value);
+}
+inline void SearchRequest::set_continuation_token(std::string&& value) {
+  
+  continuation_token_.SetNoArena(
+    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:netspeak.service.SearchRequest.continuation_token)
+}
+inline void SearchRequest::set_continuation_token(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  
+  continuation_token_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchRequest.continuation_token)
+}
+inline void SearchRequest::set_continuation_token(const void* value, size_t size) {
+  
+  continuation_token_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchRequest.continuation_token)
+}
+inline std::string* SearchRequest::_internal_mutable_continuation_token() {
+  
+  return continuation_token_.MutableNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline std::string* SearchRequest::release_continuation_token() {
+  // @@protoc_insertion_point(field_release:netspeak.service.SearchRequest.continuation_token)
+  
+  return continuation_token_.ReleaseNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline void SearchRequest::set_allocated_continuation_token(std::string* continuation_token) {
+  if (continuation_token != nullptr) {
+    
+  } else {
+    
+  }
+  continuation_token_.SetAllocatedNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), continuation_token);
+  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchRequest.continuation_token)
+}
+
+// bool count_only = 6;
+inline void SearchRequest::clear_count_only() {
+  count_only_ = false;
+}
+inline bool SearchRequest::_internal_count_only() const {
+  return count_only_;
+}
+inline bool SearchRequest::count_only() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.count_only)
+  return _internal_count_only();
+}
+inline void SearchRequest::_internal_set_count_only(bool value) {
+  
+  count_only_ = value;
+}
+inline void SearchRequest::set_count_only(bool value) {
+  _internal_set_count_only(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.count_only)
+}
+
+// bool estimate_count = 7;
+inline void SearchRequest::clear_estimate_count() {
+  estimate_count_ = false;
+}
+inline bool SearchRequest::_internal_estimate_count() const {
+  return estimate_count_;
+}
+inline bool SearchRequest::estimate_count() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.estimate_count)
+  return _internal_estimate_count();
+}
+inline void SearchRequest::_internal_set_estimate_count(bool value) {
+  
+  estimate_count_ = value;
+}
+inline void SearchRequest::set_estimate_count(bool value) {
+  _internal_set_estimate_count(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.estimate_count)
+}
+
+// repeated string corpora = 8;
+inline int SearchRequest::_internal_corpora_size() const {
+  return corpora_.size();
+}
+inline int SearchRequest::corpora_size() const {
+  return _internal_corpora_size();
+}
+inline void SearchRequest::clear_corpora() {
+  corpora_.Clear();
+}
+inline std::string* SearchRequest::add_corpora() {
+  // @@protoc_insertion_point(field_add_mutable:netspeak.service.SearchRequest.corpora)
+  return _internal_add_corpora();
+}
+inline const std::string& SearchRequest::_internal_corpora(int index) const {
+  return corpora_.Get(index);
+}
+inline const std::string& SearchRequest::corpora(int index) const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.corpora)
+  return _internal_corpora(index);
+}
+inline std::string* SearchRequest::mutable_corpora(int index) {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchRequest.corpora)
+  return corpora_.Mutable(index);
+}
+inline void SearchRequest::set_corpora(int index, const std::string& value) {
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.corpora)
+  corpora_.Mutable(index)->assign(value);
+}
+inline void SearchRequest::set_corpora(int index, std::string&& value) {
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.corpora)
+  corpora_.Mutable(index)->assign(std::move(value));
+}
+inline void SearchRequest::set_corpora(int index, const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  corpora_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchRequest.corpora)
+}
+inline void SearchRequest::set_corpora(int index, const char* value, size_t size) {
+  corpora_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchRequest.corpora)
+}
+inline std::string* SearchRequest::_internal_add_corpora() {
+  return corpora_.Add();
+}
+inline void SearchRequest::add_corpora(const std::string& value) {
+  corpora_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:netspeak.service.SearchRequest.corpora)
+}
+inline void SearchRequest::add_corpora(std::string&& value) {
+  corpora_.Add(std::move(value));
+  // @@protoc_insertion_point(field_add:netspeak.service.SearchRequest.corpora)
+}
+inline void SearchRequest::add_corpora(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  corpora_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:netspeak.service.SearchRequest.corpora)
+}
+inline void SearchRequest::add_corpora(const char* value, size_t size) {
+  corpora_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:netspeak.service.SearchRequest.corpora)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>&
+SearchRequest::corpora() const {
+  // @@protoc_insertion_point(field_list:netspeak.service.SearchRequest.corpora)
+  return corpora_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>*
+SearchRequest::mutable_corpora() {
+  // @@protoc_insertion_point(field_mutable_list:netspeak.service.SearchRequest.corpora)
+  return &corpora_;
+}
+
+// bool debug = 9;
+inline void SearchRequest::clear_debug() {
+  debug_ = false;
+}
+inline bool SearchRequest::_internal_debug() const {
+  return debug_;
+}
+inline bool SearchRequest::debug() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchRequest.debug)
+  return _internal_debug();
+}
+inline void SearchRequest::_internal_set_debug(bool value) {
+  
+  debug_ = value;
+}
+inline void SearchRequest::set_debug(bool value) {
+  _internal_set_debug(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchRequest.debug)
+}
+
 // -------------------------------------------------------------------
 
 // PhraseConstraints
@@ -2342,6 +3236,106 @@ SearchResponse_Result::mutable_unknown_words() {
   return &unknown_words_;
 }
 
+// bytes continuation_token = 3;
+inline void SearchResponse_Result::clear_continuation_token() {
+  continuation_token_.ClearToEmptyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline const std::string& SearchResponse_Result::continuation_token() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchResponse.Result.continuation_token)
+  return _internal_continuation_token();
+}
+inline void SearchResponse_Result::set_continuation_token(const std::string& value) {
+  _internal_set_continuation_token(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchResponse.Result.continuation_token)
+}
+inline std::string* SearchResponse_Result::mutable_continuation_token() {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchResponse.Result.continuation_token)
+  return _internal_mutable_continuation_token();
+}
+inline const std::string& SearchResponse_Result::_internal_continuation_token() const {
+  return continuation_token_.GetNoArena();
+}
+inline void SearchResponse_Result::_internal_set_continuation_token(const std::string& value) {
+  
+  continuation_token_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), value);
+}
+inline void SearchResponse_Result::set_continuation_token(std::string&& value) {
+  
+  continuation_token_.SetNoArena(
+    &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::move(value));
+  // @@protoc_insertion_point(field_set_rvalue:netspeak.service.SearchResponse.Result.continuation_token)
+}
+inline void SearchResponse_Result::set_continuation_token(const char* value) {
+  GOOGLE_DCHECK(value != nullptr);
+  
+  continuation_token_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:netspeak.service.SearchResponse.Result.continuation_token)
+}
+inline void SearchResponse_Result::set_continuation_token(const void* value, size_t size) {
+  
+  continuation_token_.SetNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:netspeak.service.SearchResponse.Result.continuation_token)
+}
+inline std::string* SearchResponse_Result::_internal_mutable_continuation_token() {
+  
+  return continuation_token_.MutableNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline std::string* SearchResponse_Result::release_continuation_token() {
+  // @@protoc_insertion_point(field_release:netspeak.service.SearchResponse.Result.continuation_token)
+  
+  return continuation_token_.ReleaseNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+}
+inline void SearchResponse_Result::set_allocated_continuation_token(std::string* continuation_token) {
+  if (continuation_token != nullptr) {
+    
+  } else {
+    
+  }
+  continuation_token_.SetAllocatedNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), continuation_token);
+  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchResponse.Result.continuation_token)
+}
+
+// uint64 phrase_count = 4;
+inline void SearchResponse_Result::clear_phrase_count() {
+  phrase_count_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchResponse_Result::_internal_phrase_count() const {
+  return phrase_count_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchResponse_Result::phrase_count() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchResponse.Result.phrase_count)
+  return _internal_phrase_count();
+}
+inline void SearchResponse_Result::_internal_set_phrase_count(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  phrase_count_ = value;
+}
+inline void SearchResponse_Result::set_phrase_count(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_phrase_count(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchResponse.Result.phrase_count)
+}
+
+// uint64 frequency_sum = 5;
+inline void SearchResponse_Result::clear_frequency_sum() {
+  frequency_sum_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchResponse_Result::_internal_frequency_sum() const {
+  return frequency_sum_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchResponse_Result::frequency_sum() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchResponse.Result.frequency_sum)
+  return _internal_frequency_sum();
+}
+inline void SearchResponse_Result::_internal_set_frequency_sum(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  frequency_sum_ = value;
+}
+inline void SearchResponse_Result::set_frequency_sum(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_frequency_sum(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchResponse.Result.frequency_sum)
+}
+
 // -------------------------------------------------------------------
 
 // SearchResponse_Error
@@ -2530,6 +3524,105 @@ inline ::netspeak::service::SearchResponse_Error* SearchResponse::mutable_error(
   return _internal_mutable_error();
 }
 
+// repeated .netspeak.service.SearchResponse corpus_responses = 3;
+inline int SearchResponse::_internal_corpus_responses_size() const {
+  return corpus_responses_.size();
+}
+inline int SearchResponse::corpus_responses_size() const {
+  return _internal_corpus_responses_size();
+}
+inline void SearchResponse::clear_corpus_responses() {
+  corpus_responses_.Clear();
+}
+inline ::netspeak::service::SearchResponse* SearchResponse::mutable_corpus_responses(int index) {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchResponse.corpus_responses)
+  return corpus_responses_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >*
+SearchResponse::mutable_corpus_responses() {
+  // @@protoc_insertion_point(field_mutable_list:netspeak.service.SearchResponse.corpus_responses)
+  return &corpus_responses_;
+}
+inline const ::netspeak::service::SearchResponse& SearchResponse::_internal_corpus_responses(int index) const {
+  return corpus_responses_.Get(index);
+}
+inline const ::netspeak::service::SearchResponse& SearchResponse::corpus_responses(int index) const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchResponse.corpus_responses)
+  return _internal_corpus_responses(index);
+}
+inline ::netspeak::service::SearchResponse* SearchResponse::_internal_add_corpus_responses() {
+  return corpus_responses_.Add();
+}
+inline ::netspeak::service::SearchResponse* SearchResponse::add_corpus_responses() {
+  // @@protoc_insertion_point(field_add:netspeak.service.SearchResponse.corpus_responses)
+  return _internal_add_corpus_responses();
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >&
+SearchResponse::corpus_responses() const {
+  // @@protoc_insertion_point(field_list:netspeak.service.SearchResponse.corpus_responses)
+  return corpus_responses_;
+}
+
+// .netspeak.service.SearchStats stats = 4;
+inline bool SearchResponse::_internal_has_stats() const {
+  return this != internal_default_instance() && stats_ != nullptr;
+}
+inline bool SearchResponse::has_stats() const {
+  return _internal_has_stats();
+}
+inline void SearchResponse::clear_stats() {
+  if (GetArenaNoVirtual() == nullptr && stats_ != nullptr) {
+    delete stats_;
+  }
+  stats_ = nullptr;
+}
+inline const ::netspeak::service::SearchStats& SearchResponse::_internal_stats() const {
+  const ::netspeak::service::SearchStats* p = stats_;
+  return p != nullptr ? *p : *reinterpret_cast<const ::netspeak::service::SearchStats*>(
+      &::netspeak::service::_SearchStats_default_instance_);
+}
+inline const ::netspeak::service::SearchStats& SearchResponse::stats() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchResponse.stats)
+  return _internal_stats();
+}
+inline ::netspeak::service::SearchStats* SearchResponse::release_stats() {
+  // @@protoc_insertion_point(field_release:netspeak.service.SearchResponse.stats)
+  
+  ::netspeak::service::SearchStats* temp = stats_;
+  stats_ = nullptr;
+  return temp;
+}
+inline ::netspeak::service::SearchStats* SearchResponse::_internal_mutable_stats() {
+  
+  if (stats_ == nullptr) {
+    auto* p = CreateMaybeMessage<::netspeak::service::SearchStats>(GetArenaNoVirtual());
+    stats_ = p;
+  }
+  return stats_;
+}
+inline ::netspeak::service::SearchStats* SearchResponse::mutable_stats() {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchResponse.stats)
+  return _internal_mutable_stats();
+}
+inline void SearchResponse::set_allocated_stats(::netspeak::service::SearchStats* stats) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaNoVirtual();
+  if (message_arena == nullptr) {
+    delete stats_;
+  }
+  if (stats) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena = nullptr;
+    if (message_arena != submessage_arena) {
+      stats = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, stats, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  stats_ = stats;
+  // @@protoc_insertion_point(field_set_allocated:netspeak.service.SearchResponse.stats)
+}
+
 inline bool SearchResponse::has_response() const {
   return response_case() != RESPONSE_NOT_SET;
 }
@@ -2770,6 +3863,356 @@ CorporaResponse::corpora() const {
   return corpora_;
 }
 
+// -------------------------------------------------------------------
+
+// SearchBatchRequest
+
+// repeated .netspeak.service.SearchRequest requests = 1;
+inline int SearchBatchRequest::_internal_requests_size() const {
+  return requests_.size();
+}
+inline int SearchBatchRequest::requests_size() const {
+  return _internal_requests_size();
+}
+inline void SearchBatchRequest::clear_requests() {
+  requests_.Clear();
+}
+inline ::netspeak::service::SearchRequest* SearchBatchRequest::mutable_requests(int index) {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchBatchRequest.requests)
+  return requests_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchRequest >*
+SearchBatchRequest::mutable_requests() {
+  // @@protoc_insertion_point(field_mutable_list:netspeak.service.SearchBatchRequest.requests)
+  return &requests_;
+}
+inline const ::netspeak::service::SearchRequest& SearchBatchRequest::_internal_requests(int index) const {
+  return requests_.Get(index);
+}
+inline const ::netspeak::service::SearchRequest& SearchBatchRequest::requests(int index) const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchBatchRequest.requests)
+  return _internal_requests(index);
+}
+inline ::netspeak::service::SearchRequest* SearchBatchRequest::_internal_add_requests() {
+  return requests_.Add();
+}
+inline ::netspeak::service::SearchRequest* SearchBatchRequest::add_requests() {
+  // @@protoc_insertion_point(field_add:netspeak.service.SearchBatchRequest.requests)
+  return _internal_add_requests();
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchRequest >&
+SearchBatchRequest::requests() const {
+  // @@protoc_insertion_point(field_list:netspeak.service.SearchBatchRequest.requests)
+  return requests_;
+}
+
+// -------------------------------------------------------------------
+
+// SearchBatchResponse
+
+// repeated .netspeak.service.SearchResponse responses = 1;
+inline int SearchBatchResponse::_internal_responses_size() const {
+  return responses_.size();
+}
+inline int SearchBatchResponse::responses_size() const {
+  return _internal_responses_size();
+}
+inline void SearchBatchResponse::clear_responses() {
+  responses_.Clear();
+}
+inline ::netspeak::service::SearchResponse* SearchBatchResponse::mutable_responses(int index) {
+  // @@protoc_insertion_point(field_mutable:netspeak.service.SearchBatchResponse.responses)
+  return responses_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >*
+SearchBatchResponse::mutable_responses() {
+  // @@protoc_insertion_point(field_mutable_list:netspeak.service.SearchBatchResponse.responses)
+  return &responses_;
+}
+inline const ::netspeak::service::SearchResponse& SearchBatchResponse::_internal_responses(int index) const {
+  return responses_.Get(index);
+}
+inline const ::netspeak::service::SearchResponse& SearchBatchResponse::responses(int index) const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchBatchResponse.responses)
+  return _internal_responses(index);
+}
+inline ::netspeak::service::SearchResponse* SearchBatchResponse::_internal_add_responses() {
+  return responses_.Add();
+}
+inline ::netspeak::service::SearchResponse* SearchBatchResponse::add_responses() {
+  // @@protoc_insertion_point(field_add:netspeak.service.SearchBatchResponse.responses)
+  return _internal_add_responses();
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::netspeak::service::SearchResponse >&
+SearchBatchResponse::responses() const {
+  // @@protoc_insertion_point(field_list:netspeak.service.SearchBatchResponse.responses)
+  return responses_;
+}
+
+// -------------------------------------------------------------------
+
+// SearchStats
+
+// uint64 parse_time = 1;
+inline void SearchStats::clear_parse_time() {
+  parse_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_parse_time() const {
+  return parse_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::parse_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.parse_time)
+  return _internal_parse_time();
+}
+inline void SearchStats::_internal_set_parse_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  parse_time_ = value;
+}
+inline void SearchStats::set_parse_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_parse_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.parse_time)
+}
+
+// uint64 normalize_time = 2;
+inline void SearchStats::clear_normalize_time() {
+  normalize_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_normalize_time() const {
+  return normalize_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::normalize_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.normalize_time)
+  return _internal_normalize_time();
+}
+inline void SearchStats::_internal_set_normalize_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  normalize_time_ = value;
+}
+inline void SearchStats::set_normalize_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_normalize_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.normalize_time)
+}
+
+// uint64 postlist_index_time = 3;
+inline void SearchStats::clear_postlist_index_time() {
+  postlist_index_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_postlist_index_time() const {
+  return postlist_index_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::postlist_index_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.postlist_index_time)
+  return _internal_postlist_index_time();
+}
+inline void SearchStats::_internal_set_postlist_index_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  postlist_index_time_ = value;
+}
+inline void SearchStats::set_postlist_index_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_postlist_index_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.postlist_index_time)
+}
+
+// uint64 postlist_read_time = 4;
+inline void SearchStats::clear_postlist_read_time() {
+  postlist_read_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_postlist_read_time() const {
+  return postlist_read_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::postlist_read_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.postlist_read_time)
+  return _internal_postlist_read_time();
+}
+inline void SearchStats::_internal_set_postlist_read_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  postlist_read_time_ = value;
+}
+inline void SearchStats::set_postlist_read_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_postlist_read_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.postlist_read_time)
+}
+
+// uint64 intersect_time = 5;
+inline void SearchStats::clear_intersect_time() {
+  intersect_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_intersect_time() const {
+  return intersect_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::intersect_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.intersect_time)
+  return _internal_intersect_time();
+}
+inline void SearchStats::_internal_set_intersect_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  intersect_time_ = value;
+}
+inline void SearchStats::set_intersect_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_intersect_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.intersect_time)
+}
+
+// uint64 merge_time = 6;
+inline void SearchStats::clear_merge_time() {
+  merge_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_merge_time() const {
+  return merge_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::merge_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.merge_time)
+  return _internal_merge_time();
+}
+inline void SearchStats::_internal_set_merge_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  merge_time_ = value;
+}
+inline void SearchStats::set_merge_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_merge_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.merge_time)
+}
+
+// uint64 read_phrases_time = 7;
+inline void SearchStats::clear_read_phrases_time() {
+  read_phrases_time_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_read_phrases_time() const {
+  return read_phrases_time_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::read_phrases_time() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.read_phrases_time)
+  return _internal_read_phrases_time();
+}
+inline void SearchStats::_internal_set_read_phrases_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  read_phrases_time_ = value;
+}
+inline void SearchStats::set_read_phrases_time(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_read_phrases_time(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.read_phrases_time)
+}
+
+// uint64 norm_queries = 8;
+inline void SearchStats::clear_norm_queries() {
+  norm_queries_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_norm_queries() const {
+  return norm_queries_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::norm_queries() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.norm_queries)
+  return _internal_norm_queries();
+}
+inline void SearchStats::_internal_set_norm_queries(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  norm_queries_ = value;
+}
+inline void SearchStats::set_norm_queries(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_norm_queries(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.norm_queries)
+}
+
+// uint64 postlists_read = 9;
+inline void SearchStats::clear_postlists_read() {
+  postlists_read_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_postlists_read() const {
+  return postlists_read_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::postlists_read() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.postlists_read)
+  return _internal_postlists_read();
+}
+inline void SearchStats::_internal_set_postlists_read(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  postlists_read_ = value;
+}
+inline void SearchStats::set_postlists_read(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_postlists_read(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.postlists_read)
+}
+
+// uint64 bytes_read = 10;
+inline void SearchStats::clear_bytes_read() {
+  bytes_read_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_bytes_read() const {
+  return bytes_read_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::bytes_read() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.bytes_read)
+  return _internal_bytes_read();
+}
+inline void SearchStats::_internal_set_bytes_read(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  bytes_read_ = value;
+}
+inline void SearchStats::set_bytes_read(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_bytes_read(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.bytes_read)
+}
+
+// uint64 entries_scanned = 11;
+inline void SearchStats::clear_entries_scanned() {
+  entries_scanned_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_entries_scanned() const {
+  return entries_scanned_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::entries_scanned() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.entries_scanned)
+  return _internal_entries_scanned();
+}
+inline void SearchStats::_internal_set_entries_scanned(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  entries_scanned_ = value;
+}
+inline void SearchStats::set_entries_scanned(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_entries_scanned(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.entries_scanned)
+}
+
+// uint64 result_cache_hits = 12;
+inline void SearchStats::clear_result_cache_hits() {
+  result_cache_hits_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_result_cache_hits() const {
+  return result_cache_hits_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::result_cache_hits() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.result_cache_hits)
+  return _internal_result_cache_hits();
+}
+inline void SearchStats::_internal_set_result_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  result_cache_hits_ = value;
+}
+inline void SearchStats::set_result_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_result_cache_hits(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.result_cache_hits)
+}
+
+// uint64 query_cache_hits = 13;
+inline void SearchStats::clear_query_cache_hits() {
+  query_cache_hits_ = PROTOBUF_ULONGLONG(0);
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::_internal_query_cache_hits() const {
+  return query_cache_hits_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::uint64 SearchStats::query_cache_hits() const {
+  // @@protoc_insertion_point(field_get:netspeak.service.SearchStats.query_cache_hits)
+  return _internal_query_cache_hits();
+}
+inline void SearchStats::_internal_set_query_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  
+  query_cache_hits_ = value;
+}
+inline void SearchStats::set_query_cache_hits(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+  _internal_set_query_cache_hits(value);
+  // @@protoc_insertion_point(field_set:netspeak.service.SearchStats.query_cache_hits)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -2791,6 +4234,12 @@ CorporaResponse::corpora() const {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -1,8 +1,11 @@
 #include "netspeak/service/RequestLogger.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 
+#include <unistd.h>
+
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
@@ -28,14 +31,19 @@ std::string utc_timestamp() {
   return result;
 }
 
-std::string get_log_file_prefix() {
+std::string get_log_file_prefix(bool with_pid) {
   const auto time = utc_timestamp();
   boost::regex re("[^a-zA-Z0-9\\-_]");
-  return boost::regex_replace(time, re, "-");
+  auto prefix = boost::regex_replace(time, re, "-");
+  if (with_pid) {
+    // workers started at the same time must not share their log files
+    prefix += "_" + std::to_string(getpid());
+  }
+  return prefix;
 }
 
 RequestLogger::RequestLogger(std::unique_ptr<NetspeakService::Service> service,
-                             bfs::path log_dir)
+                             bfs::path log_dir, bool with_pid)
     : service_(std::move(service)), req_counter_(0) {
   if (!bfs::is_directory(log_dir)) {
     bfs::create_directories(log_dir);
@@ -43,12 +51,18 @@ RequestLogger::RequestLogger(std::unique_ptr<NetspeakService::Service> service,
 
   util::log("Creating log files in", log_dir);
 
-  const auto prefix = (log_dir / get_log_file_prefix()).string();
+  const auto prefix = (log_dir / get_log_file_prefix(with_pid)).string();
 
   f_search_req_.lock().value().open(prefix + "_search_req.jsonl");
   f_search_error.lock().value().open(prefix + "_search_error.jsonl");
   f_get_corpora_req_.lock().value().open(prefix + "_get_corpora_req.jsonl");
   f_get_corpora_error.lock().value().open(prefix + "_get_corpora_error.jsonl");
+  f_search_batch_req_.lock().value().open(prefix + "_search_batch_req.jsonl");
+  f_search_batch_error.lock().value().open(prefix +
+                                           "_search_batch_error.jsonl");
+  f_search_stream_req_.lock().value().open(prefix + "_search_stream_req.jsonl");
+  f_search_stream_error.lock().value().open(prefix +
+                                            "_search_stream_error.jsonl");
 }
 
 template <class S, class R>
@@ -79,9 +93,62 @@ util::JsonWriter::ObjectContinue<S, R> log_error_status(
       .endObject();
 }
 
+uint64_t RequestLogger::log_search(const grpc::ServerContext& context,
+                                   const SearchRequest& request) {
+  const auto user = get_tracking_id(context);
+  const auto req_id = req_counter_++;
+
+  std::string log_line;
+  log_boilerplate(util::JsonWriter::create(log_line), req_id, user, request)
+      .endObject()
+      .done();
+
+  {
+    auto lock = f_search_req_.lock();
+    lock.value() << log_line << std::endl;
+  }
+  return req_id;
+}
+
+void RequestLogger::log_search_result(uint64_t req_id,
+                                      const grpc::ServerContext& context,
+                                      const SearchRequest& request,
+                                      const SearchResponse& response,
+                                      const grpc::Status& status) {
+  if (!status.ok() || response.has_error()) {
+    const auto user = get_tracking_id(context);
+    std::string log_line;
+    auto writer = log_boilerplate(util::JsonWriter::create(log_line), req_id,
+                                  user, request);
+
+    if (!status.ok()) {
+      writer = log_error_status(std::move(writer), status);
+    }
+    if (response.has_error()) {
+      writer = writer.prop("error_message").protobuf_message(response);
+    }
+
+    writer.endObject().done();
+
+    {
+      auto lock = f_search_error.lock();
+      lock.value() << log_line << std::endl;
+    }
+  }
+}
+
 grpc::Status RequestLogger::Search(grpc::ServerContext* context,
                                    const SearchRequest* request,
                                    SearchResponse* response) {
+  const auto req_id = log_search(*context, *request);
+  const auto status = service_->Search(context, request, response);
+  log_search_result(req_id, *context, *request, *response, status);
+  return status;
+}
+
+grpc::Status RequestLogger::GetCorpora(grpc::ServerContext* context,
+                                       const CorporaRequest* request,
+                                       CorporaResponse* response) {
   const auto user = get_tracking_id(*context);
   const auto req_id = req_counter_++;
 
@@ -92,39 +159,105 @@ grpc::Status RequestLogger::Search(grpc::ServerContext* context,
         .done();
 
     {
-      auto lock = f_search_req_.lock();
+      auto lock = f_get_corpora_req_.lock();
       lock.value() << log_line << std::endl;
     }
   }
 
-  const auto status = service_->Search(context, request, response);
+  const auto status = service_->GetCorpora(context, request, response);
 
-  if (!status.ok() || response->has_error()) {
+  if (!status.ok()) {
     std::string log_line;
-    auto writer = log_boilerplate(util::JsonWriter::create(log_line), req_id,
-                                  user, *request);
+    log_error_status(log_boilerplate(util::JsonWriter::create(log_line), req_id,
+                                     user, *request),
+                     status)
+        .endObject()
+        .done();
 
-    if (!status.ok()) {
-      writer = log_error_status(std::move(writer), status);
-    }
-    if (response->has_error()) {
-      writer = writer.prop("error_message").protobuf_message(*response);
+    {
+      auto lock = f_get_corpora_error.lock();
+      lock.value() << log_line << std::endl;
     }
+  }
 
-    writer.endObject().done();
+  return status;
+}
+
+uint64_t RequestLogger::log_search_batch(const grpc::ServerContext& context,
+                                         const SearchBatchRequest& request) {
+  const auto user = get_tracking_id(context);
+  const auto req_id = req_counter_++;
+
+  std::string log_line;
+  log_boilerplate(util::JsonWriter::create(log_line), req_id, user, request)
+      .endObject()
+      .done();
+
+  {
+    auto lock = f_search_batch_req_.lock();
+    lock.value() << log_line << std::endl;
+  }
+  return req_id;
+}
+
+void RequestLogger::log_search_batch_result(uint64_t req_id,
+                                            const grpc::ServerContext& context,
+                                            const SearchBatchRequest& request,
+                                            const SearchBatchResponse& response,
+                                            const grpc::Status& status) {
+  const auto user = get_tracking_id(context);
+  if (!status.ok()) {
+    std::string log_line;
+    log_error_status(log_boilerplate(util::JsonWriter::create(log_line), req_id,
+                                     user, request),
+                     status)
+        .endObject()
+        .done();
 
     {
-      auto lock = f_search_error.lock();
+      auto lock = f_search_batch_error.lock();
       lock.value() << log_line << std::endl;
     }
+  } else {
+    // every failed search of the batch gets its own line
+    const int count =
+        std::min(request.requests_size(), response.responses_size());
+    for (int i = 0; i < count; i++) {
+      const auto& resp = response.responses(i);
+      if (!resp.has_error()) {
+        continue;
+      }
+
+      std::string log_line;
+      log_boilerplate(util::JsonWriter::create(log_line), req_id, user,
+                      request.requests(i))
+          .prop("index")
+          .number(static_cast<int32_t>(i))
+          .prop("error_message")
+          .protobuf_message(resp)
+          .endObject()
+          .done();
+
+      {
+        auto lock = f_search_batch_error.lock();
+        lock.value() << log_line << std::endl;
+      }
+    }
   }
+}
 
+grpc::Status RequestLogger::SearchBatch(grpc::ServerContext* context,
+                                        const SearchBatchRequest* request,
+                                        SearchBatchResponse* response) {
+  const auto req_id = log_search_batch(*context, *request);
+  const auto status = service_->SearchBatch(context, request, response);
+  log_search_batch_result(req_id, *context, *request, *response, status);
   return status;
 }
 
-grpc::Status RequestLogger::GetCorpora(grpc::ServerContext* context,
-                                       const CorporaRequest* request,
-                                       CorporaResponse* response) {
+grpc::Status RequestLogger::SearchStream(
+    grpc::ServerContext* context, const SearchRequest* request,
+    grpc::ServerWriter<SearchResponse>* writer) {
   const auto user = get_tracking_id(*context);
   const auto req_id = req_counter_++;
 
@@ -135,12 +268,14 @@ grpc::Status RequestLogger::GetCorpora(grpc::ServerContext* context,
         .done();
 
     {
-      auto lock = f_get_corpora_req_.lock();
+      auto lock = f_search_stream_req_.lock();
       lock.value() << log_line << std::endl;
     }
   }
 
-  const auto status = service_->GetCorpora(context, request, response);
+  // The responses are written to the client directly, so only the status of
+  // the stream can be logged.
+  const auto status = service_->SearchStream(context, request, writer);
 
   if (!status.ok()) {
     std::string log_line;
@@ -151,7 +286,7 @@ grpc::Status RequestLogger::GetCorpora(grpc::ServerContext* context,
         .done();
 
     {
-      auto lock = f_get_corpora_error.lock();
+      auto lock = f_search_stream_error.lock();
       lock.value() << log_line << std::endl;
     }
   }
@@ -31,11 +31,25 @@ private:
   util::Mut<std::ofstream> f_get_corpora_req_;
   util::Mut<std::ofstream> f_get_corpora_error;
 
+  util::Mut<std::ofstream> f_search_batch_req_;
+  util::Mut<std::ofstream> f_search_batch_error;
+
+  util::Mut<std::ofstream> f_search_stream_req_;
+  util::Mut<std::ofstream> f_search_stream_error;
+
 public:
   RequestLogger() = delete;
   RequestLogger(const RequestLogger&) = delete;
+  /**
+   * @brief Creates a logger which logs the calls of the given service to new
+   * log files in the given directory.
+   *
+   * The log files are named after the current time. With \c with_pid, the
+   * names also contain the id of the current process, so that processes
+   * started at the same time (e.g. workers) don't share log files.
+   */
   RequestLogger(std::unique_ptr<NetspeakService::Service> service,
-                boost::filesystem::path log_dir);
+                boost::filesystem::path log_dir, bool with_pid = false);
   ~RequestLogger() override {}
 
   grpc::Status Search(grpc::ServerContext* context,
@@ -44,6 +58,30 @@ public:
   grpc::Status GetCorpora(grpc::ServerContext* context,
                           const CorporaRequest* request,
                           CorporaResponse* response) override;
+  grpc::Status SearchBatch(grpc::ServerContext* context,
+                           const SearchBatchRequest* request,
+                           SearchBatchResponse* response) override;
+  grpc::Status SearchStream(
+      grpc::ServerContext* context, const SearchRequest* request,
+      grpc::ServerWriter<SearchResponse>* writer) override;
+
+  // These log the calls of servers that don't forward to the logged service
+  // (e.g. \c AsyncProxyServer). Each call is logged before and after it's
+  // handled using the request id returned by the first function.
+
+  uint64_t log_search(const grpc::ServerContext& context,
+                      const SearchRequest& request);
+  void log_search_result(uint64_t req_id, const grpc::ServerContext& context,
+                         const SearchRequest& request,
+                         const SearchResponse& response,
+                         const grpc::Status& status);
+  uint64_t log_search_batch(const grpc::ServerContext& context,
+                            const SearchBatchRequest& request);
+  void log_search_batch_result(uint64_t req_id,
+                               const grpc::ServerContext& context,
+                               const SearchBatchRequest& request,
+                               const SearchBatchResponse& response,
+                               const grpc::Status& status);
 };
 
 } // namespace service
@@ -0,0 +1,102 @@
+#include "netspeak/service/ResponseCache.hpp"
+
+#include "netspeak/error.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+ResponseCache::ResponseCache(const Options& options) : options_(options) {
+  if (options.max_bytes == 0) {
+    throw tracable_logic_error("A response cache needs a byte budget.");
+  }
+  if (options.ttl.count() <= 0) {
+    throw tracable_logic_error("The TTL of a response cache has to be "
+                               "positive.");
+  }
+}
+
+ResponseCache::Lookup ResponseCache::lookup(const std::string& key,
+                                            Bytes& bytes, Waiter waiter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  acc_count_++;
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    auto& entry = it->second;
+    if (!entry.bytes) {
+      entry.waiters.push_back(std::move(waiter));
+      hit_count_++;
+      return Lookup::PENDING;
+    }
+    if (entry.expires > clock::now()) {
+      lru_.splice(lru_.begin(), lru_, entry.lru_it);
+      bytes = entry.bytes;
+      hit_count_++;
+      return Lookup::HIT;
+    }
+    erase_(it);
+  }
+
+  entries_.emplace(key, Entry());
+  return Lookup::MISS;
+}
+
+void ResponseCache::fill(const std::string& key, const Bytes& bytes) {
+  std::vector<Waiter> waiters;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.bytes) {
+      throw tracable_logic_error("The entry isn't being filled.");
+    }
+    waiters.swap(it->second.waiters);
+
+    const size_t size = bytes ? key.size() + bytes->size() : 0;
+    if (!bytes || size > options_.max_bytes) {
+      entries_.erase(it);
+    } else {
+      auto& entry = it->second;
+      entry.bytes = bytes;
+      entry.expires = clock::now() + options_.ttl;
+      lru_.push_front(&it->first);
+      entry.lru_it = lru_.begin();
+      bytes_ += size;
+
+      // evict the least recently used entries, never the new one
+      while (bytes_ > options_.max_bytes) {
+        erase_(entries_.find(*lru_.back()));
+      }
+    }
+  }
+
+  // the waiters might take a while, so the cache isn't locked
+  for (const auto& waiter : waiters) {
+    waiter(bytes);
+  }
+}
+
+size_t ResponseCache::size_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+size_t ResponseCache::access_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return acc_count_;
+}
+
+double ResponseCache::hit_rate() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return acc_count_ == 0 ? 0 : static_cast<double>(hit_count_) / acc_count_;
+}
+
+void ResponseCache::erase_(
+    std::unordered_map<std::string, Entry>::iterator it) {
+  lru_.erase(it->second.lru_it);
+  bytes_ -= it->first.size() + it->second.bytes->size();
+  entries_.erase(it);
+}
+
+} // namespace service
+} // namespace netspeak
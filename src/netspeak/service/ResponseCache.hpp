@@ -0,0 +1,138 @@
+#ifndef NETSPEAK_SERVICE_RESPONSE_CACHE_HPP
+#define NETSPEAK_SERVICE_RESPONSE_CACHE_HPP
+
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A cache of serialized responses by serialized request.
+ *
+ * Entries expire after a fixed time and the least recently used entries are
+ * evicted once the total size of all keys and responses exceeds the byte
+ * budget.
+ *
+ * Misses are single-flight: the first caller that misses a key has to fill it
+ * (see \c fill), and all other callers that look up the key in the meantime
+ * wait for that fill instead of computing the response themselves.
+ *
+ * All operations of this class are thread safe.
+ */
+class ResponseCache {
+public:
+  typedef std::shared_ptr<const std::string> Bytes;
+  /**
+   * @brief A function that is called with the response of a pending fill or
+   * \c nullptr if the response couldn't be cached.
+   */
+  typedef std::function<void(const Bytes&)> Waiter;
+
+  struct Options {
+    /**
+     * @brief The maximum total size of all keys and responses in bytes.
+     */
+    size_t max_bytes = 0;
+    /**
+     * @brief The time after which a response expires.
+     */
+    std::chrono::milliseconds ttl = std::chrono::seconds(60);
+  };
+
+  enum class Lookup {
+    /**
+     * @brief The response was found.
+     */
+    HIT,
+    /**
+     * @brief The response wasn't found and the caller has to fill it.
+     */
+    MISS,
+    /**
+     * @brief Another caller is filling the response. The waiter will be
+     * called once it's done.
+     */
+    PENDING
+  };
+
+private:
+  typedef std::chrono::steady_clock clock;
+
+  struct Entry {
+    /**
+     * @brief The response or \c nullptr while the entry is filled.
+     */
+    Bytes bytes;
+    clock::time_point expires;
+    std::vector<Waiter> waiters;
+    /**
+     * @brief The position of the entry in the LRU list. Only valid if the
+     * entry is filled.
+     */
+    std::list<const std::string*>::iterator lru_it;
+  };
+
+  Options options_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  /**
+   * @brief The keys of all filled entries, most recently used first.
+   */
+  std::list<const std::string*> lru_;
+  size_t bytes_ = 0;
+  uint64_t acc_count_ = 0;
+  uint64_t hit_count_ = 0;
+
+public:
+  ResponseCache() = delete;
+  ResponseCache(const ResponseCache&) = delete;
+  explicit ResponseCache(const Options& options);
+
+  /**
+   * @brief Looks up the response for the given key.
+   *
+   * @param key
+   * @param bytes Set to the response on a hit.
+   * @param waiter Called on the thread that fills the entry if the result is
+   * \c PENDING.
+   */
+  Lookup lookup(const std::string& key, Bytes& bytes, Waiter waiter);
+
+  /**
+   * @brief Fills the entry of the given key after a miss and wakes all
+   * waiters.
+   *
+   * Every miss has to be followed by exactly one fill of its key.
+   *
+   * @param key
+   * @param bytes The response or \c nullptr if it must not be cached.
+   */
+  void fill(const std::string& key, const Bytes& bytes);
+
+  /**
+   * @brief Returns the total size of all keys and responses in bytes.
+   */
+  size_t size_bytes() const;
+  size_t access_count() const;
+  double hit_rate() const;
+
+private:
+  // Lock mutex before calling these methods
+  void erase_(std::unordered_map<std::string, Entry>::iterator it);
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
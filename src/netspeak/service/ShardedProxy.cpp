@@ -0,0 +1,351 @@
+#include "netspeak/service/ShardedProxy.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include "netspeak/service/LoadBalanceProxy.hpp"
+#include "netspeak/service/continuation.hpp"
+#include "netspeak/util/service.hpp"
+
+namespace netspeak {
+namespace service {
+
+ShardedProxy::ShardedProxy(const BackendVector& backends)
+    : shards_(), corpora_() {
+  std::unordered_map<std::string, Corpus> corpora_map;
+
+  for (const auto& pair : backends) {
+    const auto& corpus = pair.first;
+    const auto& key = corpus.key();
+
+    // add or check the current corpus
+    auto corpora_it = corpora_map.find(key);
+    if (corpora_it == corpora_map.end()) {
+      corpora_.push_back(corpus);
+      corpora_map.emplace(key, corpus);
+    } else if (!LoadBalanceProxy::areCompatible(corpora_it->second, corpus)) {
+      std::stringstream what;
+      what << "The corpora " << corpora_it->second << " and " << corpus
+           << " have the same key but are incompatible.";
+      throw std::logic_error(what.str());
+    }
+
+    shards_[key].push_back(pair.second);
+  }
+}
+
+
+/**
+ * @brief A call to a single shard.
+ */
+template <typename Request, typename Response>
+struct shard_call {
+  NetspeakService::Stub* stub;
+  const Request* request;
+  std::unique_ptr<grpc::ClientContext> context;
+  std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader;
+  Response response;
+  grpc::Status status;
+};
+
+template <typename Request, typename Response>
+using shard_calls = std::vector<std::unique_ptr<shard_call<Request, Response>>>;
+
+template <typename Request, typename Response>
+void add_call(shard_calls<Request, Response>& calls,
+              const grpc::ServerContext& context,
+              const ShardedProxy::BackendPtr& backend, const Request& request) {
+  auto call = std::make_unique<shard_call<Request, Response>>();
+  call->stub = &backend->stub();
+  call->request = &request;
+  call->context = grpc::ClientContext::FromServerContext(context);
+  calls.push_back(std::move(call));
+}
+
+/**
+ * @brief Starts all given calls at once and waits for all of them.
+ *
+ * @param calls
+ * @param start A function that starts the asynchronous call of a stub.
+ */
+template <typename Request, typename Response, typename Start>
+void run_all(shard_calls<Request, Response>& calls, Start start) {
+  grpc::CompletionQueue cq;
+  for (auto& call : calls) {
+    call->reader =
+        start(*call->stub, call->context.get(), *call->request, &cq);
+    call->reader->Finish(&call->response, &call->status, call.get());
+  }
+  void* tag;
+  bool ok;
+  for (size_t i = 0; i < calls.size(); i++) {
+    cq.Next(&tag, &ok);
+  }
+  cq.Shutdown();
+  while (cq.Next(&tag, &ok)) {
+  }
+}
+
+const auto start_search = [](NetspeakService::Stub& stub,
+                             grpc::ClientContext* context,
+                             const SearchRequest& request,
+                             grpc::CompletionQueue* cq) {
+  return stub.AsyncSearch(context, request, cq);
+};
+const auto start_search_batch = [](NetspeakService::Stub& stub,
+                                   grpc::ClientContext* context,
+                                   const SearchBatchRequest& request,
+                                   grpc::CompletionQueue* cq) {
+  return stub.AsyncSearchBatch(context, request, cq);
+};
+
+
+/**
+ * @brief Adds the given stats to the given sum.
+ */
+void add_stats(SearchStats& sum, const SearchStats& stats) {
+  sum.set_parse_time(sum.parse_time() + stats.parse_time());
+  sum.set_normalize_time(sum.normalize_time() + stats.normalize_time());
+  sum.set_postlist_index_time(sum.postlist_index_time() +
+                              stats.postlist_index_time());
+  sum.set_postlist_read_time(sum.postlist_read_time() +
+                             stats.postlist_read_time());
+  sum.set_intersect_time(sum.intersect_time() + stats.intersect_time());
+  sum.set_merge_time(sum.merge_time() + stats.merge_time());
+  sum.set_read_phrases_time(sum.read_phrases_time() +
+                            stats.read_phrases_time());
+  sum.set_norm_queries(sum.norm_queries() + stats.norm_queries());
+  sum.set_postlists_read(sum.postlists_read() + stats.postlists_read());
+  sum.set_bytes_read(sum.bytes_read() + stats.bytes_read());
+  sum.set_entries_scanned(sum.entries_scanned() + stats.entries_scanned());
+  sum.set_result_cache_hits(sum.result_cache_hits() +
+                            stats.result_cache_hits());
+  sum.set_query_cache_hits(sum.query_cache_hits() + stats.query_cache_hits());
+}
+
+void ShardedProxy::merge(const SearchRequest& request,
+                         const std::vector<SearchResponse*>& shard_responses,
+                         SearchResponse& response) {
+  // The stats of a debug request are the sums of the stats of all shards.
+  if (request.debug()) {
+    auto stats = response.mutable_stats();
+    for (const auto shard : shard_responses) {
+      add_stats(*stats, shard->stats());
+    }
+  }
+
+  // all shards get the same query, so the first error is as good as any
+  for (const auto shard : shard_responses) {
+    if (shard->has_error()) {
+      response.mutable_error()->Swap(shard->mutable_error());
+      return;
+    }
+  }
+
+  auto result = response.mutable_result();
+  if (shard_responses.empty()) {
+    return;
+  }
+
+  // a word is only unknown if no shard knows it
+  for (const auto& word : shard_responses[0]->result().unknown_words()) {
+    const bool unknown = std::all_of(
+        shard_responses.begin() + 1, shard_responses.end(),
+        [&](const SearchResponse* shard) {
+          const auto& words = shard->result().unknown_words();
+          return std::find(words.begin(), words.end(), word) != words.end();
+        });
+    if (unknown) {
+      result->add_unknown_words(word);
+    }
+  }
+
+  if (request.count_only()) {
+    // the shards are disjoint, so their counts add up
+    uint64_t phrase_count = 0;
+    uint64_t frequency_sum = 0;
+    for (const auto shard : shard_responses) {
+      phrase_count += shard->result().phrase_count();
+      frequency_sum += shard->result().frequency_sum();
+    }
+    result->set_phrase_count(phrase_count);
+    result->set_frequency_sum(frequency_sum);
+    return;
+  }
+
+  // Every shard returned its own top phrases, so the merged top phrases are
+  // among them.
+  std::vector<Phrase*> phrases;
+  for (const auto shard : shard_responses) {
+    for (auto& phrase : *shard->mutable_result()->mutable_phrases()) {
+      phrases.push_back(&phrase);
+    }
+  }
+  std::sort(phrases.begin(), phrases.end(),
+            [](const Phrase* a, const Phrase* b) {
+              if (a->frequency() != b->frequency()) {
+                return a->frequency() > b->frequency();
+              }
+              return a->id() < b->id();
+            });
+
+  const size_t page_size = request.max_phrases();
+  const size_t count = std::min(phrases.size(), page_size);
+  result->mutable_phrases()->Reserve(count);
+  for (size_t i = 0; i != count; i++) {
+    result->add_phrases()->Swap(phrases[i]);
+  }
+
+  // a full page might be followed by more phrases
+  if (page_size != 0 && count == page_size) {
+    const auto& last = result->phrases(count - 1);
+    const auto token =
+        next_continuation_token(request, last.frequency(), last.id());
+    result->set_continuation_token(token.encode());
+  }
+}
+
+grpc::Status ShardedProxy::Search_(grpc::ServerContext* context,
+                                   const SearchRequest* request,
+                                   SearchResponse* response) const {
+  if (request->corpora_size() != 0) {
+    auto error = response->mutable_error();
+    error->set_kind(SearchResponse::Error::INVALID_PARAMETER);
+    error->set_message("Sharded proxies don't support corpora");
+    return grpc::Status::OK;
+  }
+
+  auto it = shards_.find(request->corpus());
+  // check the corpus
+  if (it == shards_.end()) {
+    auto error = response->mutable_error();
+    error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+    error->set_message("Unknown corpus");
+    return grpc::Status::OK;
+  }
+
+  const auto& shards = it->second;
+  if (shards.size() == 1) {
+    // nothing to merge
+    auto client_context = grpc::ClientContext::FromServerContext(*context);
+    return shards[0]->stub().Search(client_context.get(), *request, response);
+  }
+
+  shard_calls<SearchRequest, SearchResponse> calls;
+  for (const auto& shard : shards) {
+    add_call(calls, *context, shard, *request);
+  }
+  run_all(calls, start_search);
+
+  std::vector<SearchResponse*> shard_responses;
+  for (auto& call : calls) {
+    if (!call->status.ok()) {
+      return call->status;
+    }
+    shard_responses.push_back(&call->response);
+  }
+  merge(*request, shard_responses, *response);
+  return grpc::Status::OK;
+}
+
+grpc::Status ShardedProxy::SearchStream_(
+    grpc::ServerContext* context, const SearchRequest* request,
+    grpc::ServerWriter<SearchResponse>* writer) const {
+  // A phrase of one shard can only be sent once all other shards are known to
+  // have no more frequent phrases, so the merged result is sent at once.
+  SearchResponse response;
+  auto status = Search_(context, request, &response);
+  if (status.ok()) {
+    writer->Write(response);
+  }
+  return status;
+}
+
+grpc::Status ShardedProxy::SearchBatch_(
+    grpc::ServerContext* context, const SearchBatchRequest* request,
+    SearchBatchResponse* response) const {
+  struct sub_batch {
+    SearchBatchRequest request;
+    std::vector<int> indexes;
+  };
+
+  const auto& requests = request->requests();
+  auto& responses = *response->mutable_responses();
+  responses.Reserve(requests.size());
+
+  // split the batch by corpus
+  std::unordered_map<const std::vector<BackendPtr>*,
+                     std::unique_ptr<sub_batch>>
+      batches;
+  for (int i = 0; i < requests.size(); i++) {
+    const auto& req = requests[i];
+    responses.Add();
+
+    auto it = shards_.find(req.corpus());
+    if (it == shards_.end()) {
+      auto error = responses[i].mutable_error();
+      error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+      error->set_message("Unknown corpus");
+      continue;
+    }
+
+    auto& batch = batches[&it->second];
+    if (!batch) {
+      batch = std::make_unique<sub_batch>();
+    }
+    batch->request.add_requests()->CopyFrom(req);
+    batch->indexes.push_back(i);
+  }
+
+  // forward every batch to all shards of its corpus at once
+  shard_calls<SearchBatchRequest, SearchBatchResponse> calls;
+  for (const auto& pair : batches) {
+    for (const auto& shard : *pair.first) {
+      add_call(calls, *context, shard, pair.second->request);
+    }
+  }
+  run_all(calls, start_search_batch);
+
+  // merge the responses of each request
+  auto call = calls.begin();
+  for (const auto& pair : batches) {
+    const auto& batch = *pair.second;
+    std::vector<SearchBatchResponse*> shard_batches;
+    for (size_t k = 0; k != pair.first->size(); k++, call++) {
+      auto& c = **call;
+      if (!c.status.ok()) {
+        return c.status;
+      }
+      if (c.response.responses_size() !=
+          static_cast<int>(batch.indexes.size())) {
+        return grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Invalid number of batch responses");
+      }
+      shard_batches.push_back(&c.response);
+    }
+
+    for (size_t j = 0; j < batch.indexes.size(); j++) {
+      std::vector<SearchResponse*> shard_responses;
+      for (const auto shard_batch : shard_batches) {
+        shard_responses.push_back(shard_batch->mutable_responses(j));
+      }
+      merge(batch.request.requests(j), shard_responses,
+            responses[batch.indexes[j]]);
+    }
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status ShardedProxy::GetCorpora_(grpc::ServerContext*,
+                                       const CorporaRequest*,
+                                       CorporaResponse* response) const {
+  // just add a copy of all corpora
+  for (const auto& corpus : corpora_) {
+    response->add_corpora()->CopyFrom(corpus);
+  }
+  return grpc::Status::OK;
+}
+
+
+} // namespace service
+} // namespace netspeak
@@ -0,0 +1,104 @@
+#ifndef NETSPEAK_SERVICE_SHARDED_PROXY_HPP
+#define NETSPEAK_SERVICE_SHARDED_PROXY_HPP
+
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "netspeak/service/Backend.hpp"
+#include "netspeak/service/NetspeakService.grpc.pb.h"
+#include "netspeak/service/NetspeakService.pb.h"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief A proxy to serve corpora that are partitioned across any number of
+ * Netspeak indexes.
+ *
+ * All indexes with the same corpus key are shards of that corpus. Shards have
+ * to be disjoint and their phrase ids have to be unique across all shards of
+ * a corpus, e.g. each shard contains all phrases of some lengths.
+ *
+ * Each search is forwarded to all shards of its corpus concurrently and their
+ * responses are merged: the top phrases of all shards by frequency, the words
+ * that are unknown to every shard, and the sum of the counts of all shards.
+ * Continuation tokens of merged pages are accepted by all shards. The deadline
+ * of a call is propagated to the calls of all shards.
+ *
+ * All operations of this class are thread safe.
+ */
+class ShardedProxy final : public NetspeakService::Service {
+public:
+  typedef std::shared_ptr<Backend> BackendPtr;
+  typedef std::vector<std::pair<Corpus, BackendPtr>> BackendVector;
+
+private:
+  std::unordered_map<std::string, std::vector<BackendPtr>> shards_;
+  std::vector<Corpus> corpora_;
+
+public:
+  ShardedProxy() = delete;
+  ShardedProxy(const ShardedProxy&) = delete;
+  ShardedProxy(const BackendVector& backends);
+  ~ShardedProxy() override {}
+  grpc::Status Search(grpc::ServerContext* context,
+                      const SearchRequest* request,
+                      SearchResponse* response) override {
+    return Search_(context, request, response);
+  }
+  grpc::Status GetCorpora(grpc::ServerContext* context,
+                          const CorporaRequest* request,
+                          CorporaResponse* response) override {
+    return GetCorpora_(context, request, response);
+  }
+  grpc::Status SearchBatch(grpc::ServerContext* context,
+                           const SearchBatchRequest* request,
+                           SearchBatchResponse* response) override {
+    return SearchBatch_(context, request, response);
+  }
+  grpc::Status SearchStream(
+      grpc::ServerContext* context, const SearchRequest* request,
+      grpc::ServerWriter<SearchResponse>* writer) override {
+    return SearchStream_(context, request, writer);
+  }
+
+private:
+  grpc::Status Search_(grpc::ServerContext* context,
+                       const SearchRequest* request,
+                       SearchResponse* response) const;
+  grpc::Status GetCorpora_(grpc::ServerContext* context,
+                           const CorporaRequest* request,
+                           CorporaResponse* response) const;
+  grpc::Status SearchBatch_(grpc::ServerContext* context,
+                            const SearchBatchRequest* request,
+                            SearchBatchResponse* response) const;
+  grpc::Status SearchStream_(grpc::ServerContext* context,
+                             const SearchRequest* request,
+                             grpc::ServerWriter<SearchResponse>* writer) const;
+
+public:
+  /**
+   * @brief Merges the responses of all shards for the given request into the
+   * given response.
+   *
+   * The phrases of the shard responses are moved into the merged response.
+   * The stats of a \c debug request are the sums of the stats of the shards,
+   * so their times are the time all shards spent together.
+   *
+   * @param request
+   * @param shard_responses
+   * @param response
+   */
+  static void merge(const SearchRequest& request,
+                    const std::vector<SearchResponse*>& shard_responses,
+                    SearchResponse& response);
+};
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
@@ -1,6 +1,15 @@
 #include "netspeak/service/UniqueMap.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "netspeak/error.hpp"
+#include "netspeak/service/corpora.hpp"
+#include "netspeak/service/tracking.hpp"
 
 
 namespace netspeak {
@@ -21,27 +30,256 @@ UniqueMap::UniqueMap(std::unique_ptr<std::vector<entry>> entries_ptr)
       throw tracable_logic_error("Duplicate corpus key " + key);
     }
 
-    instances_.emplace(key, std::move(e.instance));
+    instances_.emplace(
+        key, instance_item{
+                 .instance = std::move(e.instance),
+                 .admission = std::make_unique<AdmissionControl>(e.admission),
+             });
     corpora_.push_back(std::move(e.corpus));
   }
+
+  // The calling thread searches one of the corpora, so a search in all
+  // corpora needs one thread less.
+  const size_t threads =
+      std::min<size_t>(std::thread::hardware_concurrency(),
+                       std::max<size_t>(corpora_.size(), 1) - 1);
+  corpus_pool_ = std::make_unique<util::ThreadPool>(threads);
 }
 
-grpc::Status UniqueMap::Search_(grpc::ServerContext*,
+grpc::Status UniqueMap::Search_(grpc::ServerContext* context,
                                 const SearchRequest* request,
                                 SearchResponse* response) const {
-  auto it = instances_.find(request->corpus());
+  if (request->corpora_size() == 0) {
+    return SearchCorpus_(context, *request, *response);
+  }
+  if (!check_corpora(*request, *response)) {
+    return grpc::Status::OK;
+  }
+
+  // One request per distinct corpus. The i-th corpus is the same as the
+  // original[i]-th one.
+  const size_t count = request->corpora_size();
+  std::vector<size_t> original(count);
+  std::vector<SearchRequest> requests;
+  std::vector<size_t> unique;
+  {
+    std::unordered_map<std::string, size_t> seen;
+    for (size_t i = 0; i != count; i++) {
+      const auto pair = seen.emplace(request->corpora(i), i);
+      original[i] = pair.first->second;
+      if (pair.second) {
+        unique.push_back(i);
+      }
+    }
+  }
+  requests.reserve(unique.size());
+  for (const size_t i : unique) {
+    requests.push_back(*request);
+    requests.back().clear_corpora();
+    requests.back().set_corpus(request->corpora(i));
+  }
+  auto& responses = *response->mutable_corpus_responses();
+  responses.Reserve(count);
+  for (size_t i = 0; i != count; i++) {
+    responses.Add();
+  }
+
+  // The calling thread and some pool threads take the next unsearched corpus
+  // until all are done. Each corpus is admitted by its own admission control,
+  // so a slow or busy corpus doesn't delay the others as long as there are
+  // enough threads. A corpus that can't be searched gets an error response.
+  // Helpers which only start after the calling thread is done return right
+  // away, so a busy pool doesn't delay this search.
+  struct SearchState {
+    grpc::ServerContext* context;
+    std::vector<SearchRequest> requests;
+    std::vector<size_t> unique;
+    google::protobuf::RepeatedPtrField<SearchResponse>* responses;
+    std::atomic<size_t> next{ 0 };
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t running = 0;
+    bool done = false;
+  };
+  const auto state = std::make_shared<SearchState>();
+  state->context = context;
+  state->requests = std::move(requests);
+  state->unique = std::move(unique);
+  state->responses = &responses;
+
+  const auto search_all = [this](SearchState& search) {
+    for (size_t k = search.next++; k < search.unique.size();
+         k = search.next++) {
+      auto& resp = (*search.responses)[search.unique[k]];
+      const auto status =
+          SearchCorpus_(search.context, search.requests[k], resp);
+      if (!status.ok()) {
+        set_corpus_error(status, resp);
+      }
+    }
+  };
+
+  const size_t helpers =
+      std::min(corpus_pool_->size(), state->unique.size() - 1);
+  for (size_t i = 0; i != helpers; i++) {
+    corpus_pool_->execute([state, search_all]() {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done) {
+          return;
+        }
+        state->running++;
+      }
+      search_all(*state);
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->running--;
+      state->cv.notify_one();
+    });
+  }
+  search_all(*state);
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done = true;
+    state->cv.wait(lock, [&]() { return state->running == 0; });
+  }
+
+  for (size_t i = 0; i != count; i++) {
+    if (original[i] != i) {
+      responses[i].CopyFrom(responses[original[i]]);
+    }
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status UniqueMap::SearchCorpus_(grpc::ServerContext* context,
+                                      const SearchRequest& request,
+                                      SearchResponse& response) const {
+  auto it = instances_.find(request.corpus());
   // check the corpus
   if (it == instances_.end()) {
-    auto error = response->mutable_error();
+    auto error = response.mutable_error();
     error->set_kind(SearchResponse::Error::INVALID_CORPUS);
     error->set_message("Unknown corpus");
     return grpc::Status::OK;
   }
 
+  const auto& instance = it->second.instance;
+  auto& admission = *it->second.admission;
+
+  // wait for the admission of the search
+  std::shared_ptr<const model::Query> parsed_query;
+  const size_t cost = admission.uses_cost()
+                          ? instance->estimate_cost(request, &parsed_query)
+                          : 0;
+  AdmissionControl::Ticket ticket;
+  auto status = admission.admit(get_tracking_id(*context), cost,
+                                context->deadline(), ticket);
+  if (!status.ok()) {
+    return status;
+  }
+
   // forward the request to the Netspeak instance
   // (search is guaranteed not to throw, so we don't need to do anything)
-  const auto& instance = it->second;
-  instance->search(*request, *response);
+  instance->search(request, response, std::move(parsed_query));
+  return grpc::Status::OK;
+}
+
+grpc::Status UniqueMap::SearchBatch_(grpc::ServerContext* context,
+                                     const SearchBatchRequest* request,
+                                     SearchBatchResponse* response) const {
+  struct group {
+    std::vector<const SearchRequest*> requests;
+    std::vector<SearchResponse*> responses;
+  };
+
+  // group the requests by corpus
+  const auto& requests = request->requests();
+  auto& responses = *response->mutable_responses();
+  responses.Reserve(requests.size());
+  std::unordered_map<const instance_item*, group> groups;
+  for (const auto& req : requests) {
+    auto resp = responses.Add();
+    auto it = instances_.find(req.corpus());
+    if (it == instances_.end()) {
+      auto error = resp->mutable_error();
+      error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+      error->set_message("Unknown corpus");
+      continue;
+    }
+    auto& g = groups[&it->second];
+    g.requests.push_back(&req);
+    g.responses.push_back(resp);
+  }
+
+  const auto client = get_tracking_id(*context);
+  for (const auto& pair : groups) {
+    const auto& instance = pair.first->instance;
+    auto& admission = *pair.first->admission;
+    const auto& g = pair.second;
+
+    // The whole group is admitted at once and counts as many searches as it
+    // runs in parallel. A group which isn't admitted only fails its own
+    // responses, so the groups searched before aren't wasted.
+    size_t cost = 0;
+    std::vector<std::shared_ptr<const model::Query>> parsed_queries;
+    if (admission.uses_cost()) {
+      parsed_queries.resize(g.requests.size());
+      for (size_t i = 0; i != g.requests.size(); i++) {
+        cost += instance->estimate_cost(*g.requests[i], &parsed_queries[i]);
+      }
+    }
+    AdmissionControl::Ticket ticket;
+    auto status =
+        admission.admit(client, cost, context->deadline(), ticket,
+                        instance->batch_parallelism(g.requests.size()));
+    if (!status.ok()) {
+      for (const auto resp : g.responses) {
+        set_corpus_error(status, *resp);
+      }
+      continue;
+    }
+
+    instance->search_batch(g.requests, g.responses, parsed_queries);
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status UniqueMap::SearchStream_(
+    grpc::ServerContext* context, const SearchRequest* request,
+    grpc::ServerWriter<SearchResponse>* writer) const {
+  auto it = instances_.find(request->corpus());
+  // check the corpus
+  if (it == instances_.end()) {
+    SearchResponse response;
+    auto error = response.mutable_error();
+    error->set_kind(SearchResponse::Error::INVALID_CORPUS);
+    error->set_message("Unknown corpus");
+    writer->Write(response);
+    return grpc::Status::OK;
+  }
+
+  const auto& instance = it->second.instance;
+  auto& admission = *it->second.admission;
+
+  // wait for the admission of the search
+  std::shared_ptr<const model::Query> parsed_query;
+  const size_t cost = admission.uses_cost()
+                          ? instance->estimate_cost(*request, &parsed_query)
+                          : 0;
+  AdmissionControl::Ticket ticket;
+  auto status = admission.admit(get_tracking_id(*context), cost,
+                                context->deadline(), ticket);
+  if (!status.ok()) {
+    return status;
+  }
+
+  // the search stops as soon as the client can't be written to anymore
+  instance->search_stream(
+      *request,
+      [writer](const SearchResponse& response) {
+        return writer->Write(response);
+      },
+      std::move(parsed_query));
   return grpc::Status::OK;
 }
 
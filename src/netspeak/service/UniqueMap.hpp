@@ -4,10 +4,13 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "netspeak/Netspeak.hpp"
+#include "netspeak/service/AdmissionControl.hpp"
 #include "netspeak/service/NetspeakService.grpc.pb.h"
 #include "netspeak/service/NetspeakService.pb.h"
+#include "netspeak/util/ThreadPool.hpp"
 
 
 namespace netspeak {
@@ -17,17 +20,31 @@ namespace service {
  * @brief An implementation of the Netspeak gRPC service that will forward all
  * requests to a unique Netspeak instance for the given corpus.
  *
- * Each corpus (key) can have at most one Netspeak instance.
+ * Each corpus (key) can have at most one Netspeak instance. Searches have to
+ * pass the admission control of their corpus before they are forwarded. The
+ * requests of a batch are grouped by corpus and each group is admitted as a
+ * whole. A streaming search holds its admission until the stream is closed.
+ *
+ * A search in multiple corpora searches each distinct corpus once. The corpora
+ * are searched concurrently by the calling thread and a pool shared by all
+ * searches, and each corpus admits its part of the search on its own.
  */
 class UniqueMap final : public NetspeakService::Service {
 private:
-  std::unordered_map<std::string, std::unique_ptr<Netspeak>> instances_;
+  struct instance_item {
+    std::unique_ptr<Netspeak> instance;
+    std::unique_ptr<AdmissionControl> admission;
+  };
+
+  std::unordered_map<std::string, instance_item> instances_;
   std::vector<Corpus> corpora_;
+  std::unique_ptr<util::ThreadPool> corpus_pool_;
 
 public:
   struct entry {
     std::unique_ptr<Netspeak> instance;
     Corpus corpus;
+    AdmissionControl::Limits admission;
   };
 
 public:
@@ -46,6 +63,16 @@ public:
                           CorporaResponse* response) override {
     return GetCorpora_(context, request, response);
   }
+  grpc::Status SearchBatch(grpc::ServerContext* context,
+                           const SearchBatchRequest* request,
+                           SearchBatchResponse* response) override {
+    return SearchBatch_(context, request, response);
+  }
+  grpc::Status SearchStream(
+      grpc::ServerContext* context, const SearchRequest* request,
+      grpc::ServerWriter<SearchResponse>* writer) override {
+    return SearchStream_(context, request, writer);
+  }
 
 private:
   // These functions exists because we cannot declare the override as `const`.
@@ -55,9 +82,18 @@ private:
   grpc::Status Search_(grpc::ServerContext* context,
                        const SearchRequest* request,
                        SearchResponse* response) const;
+  grpc::Status SearchCorpus_(grpc::ServerContext* context,
+                             const SearchRequest& request,
+                             SearchResponse& response) const;
   grpc::Status GetCorpora_(grpc::ServerContext* context,
                            const CorporaRequest* request,
                            CorporaResponse* response) const;
+  grpc::Status SearchBatch_(grpc::ServerContext* context,
+                            const SearchBatchRequest* request,
+                            SearchBatchResponse* response) const;
+  grpc::Status SearchStream_(grpc::ServerContext* context,
+                             const SearchRequest* request,
+                             grpc::ServerWriter<SearchResponse>* writer) const;
 };
 
 } // namespace service
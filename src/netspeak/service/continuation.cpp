@@ -0,0 +1,30 @@
+#include "netspeak/service/continuation.hpp"
+
+#include <string>
+
+#include "netspeak/util/checksum.hpp"
+
+
+namespace netspeak {
+namespace service {
+
+uint64_t continuation_hash(const SearchRequest& request) {
+  std::string key = request.query();
+  key.push_back('\0');
+  key.append(request.corpus());
+  key.push_back('\0');
+  key.append(request.phrase_constraints().SerializeAsString());
+  return util::hash64(key);
+}
+
+model::ContinuationToken next_continuation_token(const SearchRequest& request,
+                                                 uint64_t freq, uint64_t id) {
+  return model::ContinuationToken{
+    .request_hash = continuation_hash(request),
+    .frequency = freq,
+    .phrase_id = id,
+  };
+}
+
+} // namespace service
+} // namespace netspeak
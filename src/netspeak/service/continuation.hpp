@@ -0,0 +1,34 @@
+#ifndef NETSPEAK_SERVICE_CONTINUATION_HPP
+#define NETSPEAK_SERVICE_CONTINUATION_HPP
+
+
+#include <cstdint>
+
+#include "netspeak/model/ContinuationToken.hpp"
+#include "netspeak/service/NetspeakService.pb.h"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief Returns a hash of all parts of the given request that determine its
+ * phrases.
+ *
+ * The continuation token of the request and its page size are not part of the
+ * hash.
+ */
+uint64_t continuation_hash(const SearchRequest& request);
+
+/**
+ * @brief Returns the continuation token of a page whose last phrase has the
+ * given frequency and id.
+ */
+model::ContinuationToken next_continuation_token(const SearchRequest& request,
+                                                 uint64_t freq, uint64_t id);
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
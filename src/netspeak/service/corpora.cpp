@@ -0,0 +1,36 @@
+#include "netspeak/service/corpora.hpp"
+
+#include <string>
+
+
+namespace netspeak {
+namespace service {
+
+bool check_corpora(const SearchRequest& request, SearchResponse& response) {
+  const char* message = nullptr;
+  if (!request.corpus().empty()) {
+    message = "Either corpus or corpora can be set, not both";
+  } else if (static_cast<size_t>(request.corpora_size()) >
+             MAX_SEARCH_CORPORA) {
+    message = "Too many corpora";
+  }
+  if (message) {
+    auto error = response.mutable_error();
+    error->set_kind(SearchResponse::Error::INVALID_PARAMETER);
+    error->set_message(message);
+    return false;
+  }
+  return true;
+}
+
+void set_corpus_error(const grpc::Status& status, SearchResponse& response) {
+  auto error = response.mutable_error();
+  error->set_kind(status.error_code() == grpc::StatusCode::INTERNAL
+                      ? SearchResponse::Error::INTERNAL_ERROR
+                      : SearchResponse::Error::UNKNOWN);
+  error->set_message("gRPC status " + std::to_string(status.error_code()) +
+                     ": " + status.error_message());
+}
+
+} // namespace service
+} // namespace netspeak
@@ -0,0 +1,39 @@
+#ifndef NETSPEAK_SERVICE_CORPORA_HPP
+#define NETSPEAK_SERVICE_CORPORA_HPP
+
+
+#include <cstddef>
+
+#include "netspeak/service/NetspeakService.grpc.pb.h"
+#include "netspeak/service/NetspeakService.pb.h"
+
+
+namespace netspeak {
+namespace service {
+
+/**
+ * @brief The maximum number of corpora of a search in multiple corpora (see
+ * \c SearchRequest::corpora ).
+ */
+const size_t MAX_SEARCH_CORPORA = 32;
+
+/**
+ * @brief Returns whether the given search in multiple corpora is valid.
+ *
+ * Otherwise, an \c INVALID_PARAMETER error is set in the given response.
+ */
+bool check_corpora(const SearchRequest& request, SearchResponse& response);
+
+/**
+ * @brief Sets an error in the given corpus response of a search in multiple
+ * corpora for the given failed status of its search.
+ *
+ * A failed corpus doesn't fail the whole search.
+ */
+void set_corpus_error(const grpc::Status& status, SearchResponse& response);
+
+} // namespace service
+} // namespace netspeak
+
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef NETSPEAK_UTIL_COST_AWARE_CACHE_HPP
+#define NETSPEAK_UTIL_COST_AWARE_CACHE_HPP
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+
+namespace netspeak {
+namespace util {
+
+/**
+ * @brief A bounded object cache which prefers to keep entries that were
+ * expensive to compute.
+ *
+ * Every entry has a cost (e.g. the time it took to compute its value) which is
+ * given when the entry is inserted. The cache uses the Greedy-Dual-Frequency
+ * policy: The priority of an entry is its cost times the number of times it was
+ * accessed plus an inflation value. If the cache is full, the entry with the
+ * lowest priority is evicted and the inflation value is set to its priority.
+ * This way, cheap entries are evicted before expensive ones and entries which
+ * haven't been accessed in a while will eventually be evicted regardless of
+ * their cost.
+ *
+ * See: Cherkasova, L. (1998). Improving WWW proxies performance with
+ * Greedy-Dual-Size-Frequency caching policy. HP Laboratories Report.
+ */
+template <typename T>
+class CostAwareCache {
+public:
+  typedef std::string key_type;
+  typedef T value_type;
+
+private:
+  typedef std::pair<double, const key_type*> policy_item;
+
+  struct entry {
+    std::shared_ptr<value_type> value;
+    double cost;
+    uint64_t frequency;
+    typename std::set<policy_item>::iterator policy_it;
+  };
+
+  std::unordered_map<key_type, entry> storage_;
+  /**
+   * @brief The priority and key of all entries in ascending order of
+   * priority.
+   */
+  std::set<policy_item> policy_;
+  size_t capacity_;
+  double inflation_ = 0;
+  uint64_t acc_count_ = 0;
+  uint64_t hit_count_ = 0;
+  mutable std::mutex mutex_;
+
+public:
+  CostAwareCache(size_t capacity = 0) : capacity_(capacity) {
+    storage_.reserve(capacity);
+  }
+  CostAwareCache(const CostAwareCache&) = delete;
+
+  size_t access_count() const {
+    std::lock_guard<std::mutex> lg(mutex_);
+    return acc_count_;
+  }
+
+  double hit_rate() const {
+    std::lock_guard<std::mutex> lg(mutex_);
+    return acc_count_ == 0 ? 0 : static_cast<double>(hit_count_) / acc_count_;
+  }
+
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lg(mutex_);
+    return capacity_;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lg(mutex_);
+    return storage_.size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  void reserve(size_t capacity) {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (capacity > capacity_) {
+      storage_.reserve(capacity);
+      capacity_ = capacity;
+    }
+  }
+
+  /**
+   * @brief Inserts the given value with the given cost.
+   *
+   * Returns \c false if the key is already in the cache or if the cache has a
+   * capacity of 0.
+   */
+  bool insert(const key_type& key, const std::shared_ptr<value_type>& value,
+              double cost) {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (capacity_ == 0 || storage_.find(key) != storage_.end()) {
+      return false;
+    }
+    if (storage_.size() >= capacity_) {
+      evict_();
+    }
+
+    const auto it = storage_.emplace(key, entry{ value, cost, 1, {} }).first;
+    it->second.policy_it =
+        policy_.emplace(inflation_ + cost, &it->first).first;
+    return true;
+  }
+
+  std::shared_ptr<value_type> find(const key_type& key) {
+    std::lock_guard<std::mutex> lg(mutex_);
+    ++acc_count_;
+    const auto it = storage_.find(key);
+    if (it == storage_.end()) {
+      return nullptr;
+    }
+    ++hit_count_;
+
+    auto& e = it->second;
+    e.frequency++;
+    policy_.erase(e.policy_it);
+    e.policy_it =
+        policy_.emplace(inflation_ + e.cost * e.frequency, &it->first).first;
+    return e.value;
+  }
+
+  /**
+   * @brief Returns the value of the given key without accessing it.
+   *
+   * Unlike \c find, this neither changes the priority of the entry nor the
+   * access statistics of the cache.
+   */
+  std::shared_ptr<value_type> peek(const key_type& key) const {
+    std::lock_guard<std::mutex> lg(mutex_);
+    const auto it = storage_.find(key);
+    return it == storage_.end() ? nullptr : it->second.value;
+  }
+
+  void erase(const key_type& key) {
+    std::lock_guard<std::mutex> lg(mutex_);
+    const auto it = storage_.find(key);
+    if (it != storage_.end()) {
+      policy_.erase(it->second.policy_it);
+      storage_.erase(it);
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lg(mutex_);
+    policy_.clear();
+    storage_.clear();
+    inflation_ = 0;
+  }
+
+private:
+  // Lock mutex before calling these methods
+  void evict_() {
+    if (policy_.empty()) {
+      return;
+    }
+    const auto lowest = policy_.begin();
+    inflation_ = lowest->first;
+    const key_type* key = lowest->second;
+    policy_.erase(lowest);
+    storage_.erase(*key);
+  }
+};
+
+
+} // namespace util
+} // namespace netspeak
+
+#endif // NETSPEAK_UTIL_COST_AWARE_CACHE_HPP
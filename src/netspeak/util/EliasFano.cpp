@@ -0,0 +1,64 @@
+#include "netspeak/util/EliasFano.hpp"
+
+
+namespace netspeak {
+namespace util {
+
+EliasFano::EliasFano(size_t capacity, uint64_t max_value) {
+  // the number of lower bits is chosen such that the upper bits need about 2
+  // bits per value
+  if (capacity != 0) {
+    for (uint64_t ratio = max_value / capacity; ratio > 1 && low_bits_ < 63;
+         ratio >>= 1) {
+      low_bits_++;
+    }
+  }
+
+  low_.resize((capacity * low_bits_) / 64 + 2, 0);
+  high_.resize((capacity + (max_value >> low_bits_)) / 64 + 2, 0);
+  select_samples_.reserve(capacity / SELECT_SAMPLE_RATE + 1);
+}
+
+void EliasFano::push_back(uint64_t value) {
+  const uint64_t high_bit = (value >> low_bits_) + size_;
+  high_[high_bit / 64] |= uint64_t(1) << (high_bit % 64);
+  if (size_ % SELECT_SAMPLE_RATE == 0) {
+    select_samples_.push_back(high_bit);
+  }
+
+  if (low_bits_ != 0) {
+    const uint64_t low = value & ((uint64_t(1) << low_bits_) - 1);
+    const size_t bit = size_ * low_bits_;
+    const size_t word = bit / 64;
+    const size_t shift = bit % 64;
+    low_[word] |= low << shift;
+    if (shift + low_bits_ > 64) {
+      low_[word + 1] |= low >> (64 - shift);
+    }
+  }
+
+  size_++;
+}
+
+uint64_t EliasFano::select_high(size_t index) const {
+  const uint64_t sample = select_samples_[index / SELECT_SAMPLE_RATE];
+  size_t remaining = index % SELECT_SAMPLE_RATE;
+
+  size_t word = sample / 64;
+  uint64_t bits = high_[word] & (~uint64_t(0) << (sample % 64));
+  size_t count = __builtin_popcountll(bits);
+  while (remaining >= count) {
+    remaining -= count;
+    bits = high_[++word];
+    count = __builtin_popcountll(bits);
+  }
+
+  // clear the lowest set bits which come before the one we want
+  for (; remaining > 0; remaining--) {
+    bits &= bits - 1;
+  }
+  return word * 64 + __builtin_ctzll(bits);
+}
+
+} // namespace util
+} // namespace netspeak
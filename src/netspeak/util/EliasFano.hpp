@@ -0,0 +1,96 @@
+#ifndef NETSPEAK_UTIL_ELIAS_FANO_HPP
+#define NETSPEAK_UTIL_ELIAS_FANO_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+
+namespace netspeak {
+namespace util {
+
+/**
+ * @brief An immutable, compressed, non-decreasing sequence of integers with
+ * constant-time random access.
+ *
+ * Each value is split into its lower and upper bits. The lower bits are
+ * stored as-is in a packed array. The upper bits are stored in unary in a bit
+ * vector where the i-th set bit is at position `(value_i >> low_bits) + i`.
+ * The position of every 256th set bit is sampled, so that the i-th set bit
+ * can be found by scanning at most a few 64-bit words.
+ *
+ * A sequence of n values less than u needs about `n * (2 + log2(u / n))` bits.
+ *
+ * See: Elias, P. (1974). Efficient storage and retrieval by content and
+ * address of static files. Journal of the ACM.
+ */
+class EliasFano {
+private:
+  static const size_t SELECT_SAMPLE_RATE = 256;
+
+  size_t size_ = 0;
+  uint32_t low_bits_ = 0;
+  std::vector<uint64_t> low_;
+  std::vector<uint64_t> high_;
+  std::vector<uint64_t> select_samples_;
+
+  uint64_t select_high(size_t index) const;
+  uint64_t get_low(size_t index) const {
+    if (low_bits_ == 0) {
+      return 0;
+    }
+    const size_t bit = index * low_bits_;
+    const size_t word = bit / 64;
+    const size_t shift = bit % 64;
+    uint64_t low = low_[word] >> shift;
+    if (shift + low_bits_ > 64) {
+      low |= low_[word + 1] << (64 - shift);
+    }
+    return low & ((uint64_t(1) << low_bits_) - 1);
+  }
+
+public:
+  EliasFano() {}
+  /**
+   * @brief Creates a new empty sequence for the given number of values which
+   * are all at most \c max_value .
+   */
+  EliasFano(size_t capacity, uint64_t max_value);
+  EliasFano(const EliasFano&) = delete;
+  EliasFano(EliasFano&&) = default;
+  EliasFano& operator=(EliasFano&&) = default;
+
+  /**
+   * @brief Appends the given value.
+   *
+   * The value must not be less than the last value and the number of values
+   * must not exceed the capacity.
+   */
+  void push_back(uint64_t value);
+
+  /**
+   * @brief Returns the value at the given index.
+   */
+  uint64_t operator[](size_t index) const {
+    return ((select_high(index) - index) << low_bits_) | get_low(index);
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * @brief Returns the number of bytes used by the sequence.
+   */
+  size_t memory_usage() const {
+    return (low_.capacity() + high_.capacity() + select_samples_.capacity()) *
+           sizeof(uint64_t);
+  }
+};
+
+} // namespace util
+} // namespace netspeak
+
+
+#endif
@@ -0,0 +1,144 @@
+#include "netspeak/util/ProcessSupervisor.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "netspeak/util/logging.hpp"
+
+
+namespace netspeak {
+namespace util {
+
+typedef std::chrono::steady_clock clock;
+
+const std::chrono::seconds ProcessSupervisor::MIN_UPTIME(1);
+
+ProcessSupervisor::ProcessSupervisor(size_t workers, Worker worker)
+    : workers_(workers), worker_(std::move(worker)) {
+  if (workers == 0) {
+    throw std::logic_error("A process supervisor needs at least one worker.");
+  }
+  if (!worker_) {
+    throw std::logic_error("The worker of a process supervisor is null.");
+  }
+}
+
+std::string describe_exit(int status) {
+  if (WIFEXITED(status)) {
+    return "exited with status " + std::to_string(WEXITSTATUS(status));
+  }
+  if (WIFSIGNALED(status)) {
+    return "was killed by signal " + std::to_string(WTERMSIG(status));
+  }
+  return "stopped";
+}
+
+void ProcessSupervisor::run() {
+  // The supervisor waits for signals with sigwait, so they have to be blocked.
+  // Workers restore the original mask.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGCHLD);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigset_t mask;
+  sigprocmask(SIG_BLOCK, &signals, &mask);
+
+  std::unordered_map<pid_t, clock::time_point> started;
+  for (size_t i = 0; i < workers_; i++) {
+    started[start_worker_(mask)] = clock::now();
+  }
+
+  bool stopping = false;
+  while (!started.empty()) {
+    int signal = 0;
+    sigwait(&signals, &signal);
+    if (signal != SIGCHLD) {
+      if (!stopping) {
+        stopping = true;
+        log("Stopping all workers after signal", signal);
+        for (const auto& pair : started) {
+          kill(pair.first, SIGTERM);
+        }
+      }
+      continue;
+    }
+
+    // SIGCHLD isn't queued, so one signal may stand for several workers
+    pid_t pid;
+    int status;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+      auto it = started.find(pid);
+      if (it == started.end()) {
+        continue;
+      }
+      const auto uptime = clock::now() - it->second;
+      started.erase(it);
+      log("Worker " + std::to_string(pid) + " " + describe_exit(status));
+
+      if (!stopping) {
+        if (uptime < MIN_UPTIME) {
+          std::this_thread::sleep_for(MIN_UPTIME - uptime);
+        }
+        started[start_worker_(mask)] = clock::now();
+      }
+    }
+  }
+
+  sigprocmask(SIG_SETMASK, &mask, nullptr);
+}
+
+pid_t ProcessSupervisor::start_worker_(const sigset_t& mask) const {
+  // buffered output would be written by both processes
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  const pid_t supervisor = getpid();
+  const pid_t pid = fork();
+  if (pid < 0) {
+    throw std::runtime_error(std::string("Unable to fork a worker: ") +
+                             std::strerror(errno));
+  }
+  if (pid != 0) {
+    log("Started worker", pid);
+    return pid;
+  }
+
+#ifdef __linux__
+  prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+  if (getppid() != supervisor) {
+    // the supervisor died before the worker could notice
+    _exit(EXIT_FAILURE);
+  }
+  sigprocmask(SIG_SETMASK, &mask, nullptr);
+
+  int status = EXIT_FAILURE;
+  try {
+    status = worker_();
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+  }
+  std::cout.flush();
+  std::cerr.flush();
+  // The objects of the supervisor belong to the supervisor, so the worker
+  // exits without running any destructors or exit handlers.
+  _exit(status);
+}
+
+} // namespace util
+} // namespace netspeak
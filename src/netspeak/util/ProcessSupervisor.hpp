@@ -0,0 +1,66 @@
+#ifndef NETSPEAK_UTIL_PROCESS_SUPERVISOR_HPP
+#define NETSPEAK_UTIL_PROCESS_SUPERVISOR_HPP
+
+#include <signal.h>
+#include <sys/types.h>
+
+#include <chrono>
+#include <functional>
+
+
+namespace netspeak {
+namespace util {
+
+/**
+ * @brief Runs a function in a number of forked worker processes and restarts
+ * every worker that exits.
+ *
+ * Workers are forked from the supervising process, so they share all memory
+ * the supervisor allocated before (copy-on-write) and inherit its open files.
+ * The supervisor itself must not start any threads before \c run is called
+ * because only the forking thread exists in the forked process.
+ *
+ * A worker that exits shortly after it started is restarted after a delay, so
+ * a worker that can't start doesn't keep the supervisor busy. Workers are
+ * terminated if the supervisor dies.
+ */
+class ProcessSupervisor {
+public:
+  /**
+   * @brief The function run by each worker. Its result is the exit status of
+   * the worker.
+   */
+  typedef std::function<int()> Worker;
+
+private:
+  size_t workers_;
+  Worker worker_;
+
+public:
+  /**
+   * @brief The time a worker has to run before it's restarted without delay.
+   */
+  static const std::chrono::seconds MIN_UPTIME;
+
+  ProcessSupervisor() = delete;
+  ProcessSupervisor(const ProcessSupervisor&) = delete;
+  ProcessSupervisor(size_t workers, Worker worker);
+
+  /**
+   * @brief Starts all workers and supervises them until the process receives
+   * \c SIGINT or \c SIGTERM.
+   *
+   * All workers are then terminated with \c SIGTERM and this function returns
+   * once all of them exited.
+   */
+  void run();
+
+private:
+  pid_t start_worker_(const sigset_t& mask) const;
+};
+
+} // namespace util
+} // namespace netspeak
+
+
+#endif
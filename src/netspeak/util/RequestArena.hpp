@@ -0,0 +1,78 @@
+#ifndef NETSPEAK_UTIL_REQUEST_ARENA_HPP
+#define NETSPEAK_UTIL_REQUEST_ARENA_HPP
+
+#include <stddef.h>
+
+#include <memory_resource>
+#include <optional>
+
+
+namespace netspeak {
+namespace util {
+
+/**
+ * @brief A monotonic memory resource for the temporary objects of a single
+ * request.
+ *
+ * Memory is handed out by bumping a pointer and is only released (all at once)
+ * when the arena is destroyed. Each thread has a buffer which is reused by all
+ * arenas of that thread, so small requests don't touch the global heap at
+ * all and large requests only allocate a few big blocks. This avoids most of
+ * the allocator contention between the threads serving requests.
+ *
+ * Objects allocated in the arena must not outlive the arena. This means that
+ * nothing that is cached or returned to the caller may use the arena.
+ *
+ * Arenas can be nested. Only the outermost arena of a thread will use the
+ * thread's buffer.
+ */
+class RequestArena {
+public:
+  static const size_t THREAD_BUFFER_SIZE = 64 * 1024;
+
+private:
+  struct thread_buffer {
+    alignas(std::max_align_t) char data[THREAD_BUFFER_SIZE];
+    bool in_use = false;
+  };
+  static thread_buffer& local_buffer() {
+    thread_local thread_buffer buffer;
+    return buffer;
+  }
+
+  thread_buffer* buffer_;
+  std::optional<std::pmr::monotonic_buffer_resource> resource_;
+
+public:
+  /**
+   * @brief Creates a new arena which will allocate additional memory from the
+   * given upstream resource.
+   */
+  explicit RequestArena(
+      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : buffer_(&local_buffer()) {
+    if (buffer_->in_use) {
+      buffer_ = nullptr;
+      resource_.emplace(upstream);
+    } else {
+      buffer_->in_use = true;
+      resource_.emplace(buffer_->data, THREAD_BUFFER_SIZE, upstream);
+    }
+  }
+  RequestArena(const RequestArena&) = delete;
+  ~RequestArena() {
+    resource_.reset();
+    if (buffer_) {
+      buffer_->in_use = false;
+    }
+  }
+
+  std::pmr::memory_resource* resource() {
+    return &*resource_;
+  }
+};
+
+} // namespace util
+} // namespace netspeak
+
+#endif // NETSPEAK_UTIL_REQUEST_ARENA_HPP
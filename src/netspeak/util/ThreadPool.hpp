@@ -0,0 +1,127 @@
+#ifndef NETSPEAK_UTIL_THREAD_POOL_HPP
+#define NETSPEAK_UTIL_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace netspeak {
+namespace util {
+
+/**
+ * @brief A simple fixed-size pool of worker threads.
+ *
+ * Tasks are executed in the order in which they were submitted. The pool does
+ * not return futures. Tasks that need to report results or wait on each other
+ * have to do their own synchronization.
+ *
+ * The worker threads are started by the first task, so a process can fork
+ * while it holds pools that didn't execute any tasks yet.
+ *
+ * When the pool is destroyed, all tasks that are still queued will be executed
+ * before the worker threads are joined.
+ */
+class ThreadPool {
+private:
+  size_t size_;
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+
+  void run_worker() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stopped_ || !queue_.empty(); });
+        if (queue_.empty()) {
+          // the pool was stopped and there is nothing left to do
+          return;
+        }
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+  // Lock mutex before calling this method
+  void start_workers() {
+    if (workers_.size() != size_) {
+      workers_.reserve(size_);
+      for (size_t i = 0; i < size_; i++) {
+        workers_.emplace_back([this]() { run_worker(); });
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Creates a new pool with the given number of worker threads.
+   *
+   * A pool with 0 threads is valid but will never execute any tasks.
+   */
+  explicit ThreadPool(size_t threads) : size_(threads) {}
+  ThreadPool(const ThreadPool&) = delete;
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /**
+   * @brief Returns the number of worker threads of this pool.
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  /**
+   * @brief Adds the given task to the queue of this pool.
+   *
+   * Tasks must not throw.
+   */
+  void execute(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      start_workers();
+      queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+  /**
+   * @brief Adds the given task to the queue of this pool unless there are
+   * already at least \c max_queued tasks waiting for a worker.
+   *
+   * Returns whether the task was added. Tasks must not throw.
+   */
+  bool try_execute(std::function<void()> task, size_t max_queued) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.size() >= max_queued) {
+        return false;
+      }
+      start_workers();
+      queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+    return true;
+  }
+};
+
+} // namespace util
+} // namespace netspeak
+
+
+#endif
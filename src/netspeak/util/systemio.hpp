@@ -3,6 +3,9 @@
 #ifndef NETSPEAK_UTIL_SYSTEMIO_HPP
 #define NETSPEAK_UTIL_SYSTEMIO_HPP
 
+#include <unistd.h>
+
+#include <cerrno>
 #include <climits>
 #include <cstring>
 
@@ -90,6 +93,30 @@ inline void fread(void* data, size_t size, size_t count, FILE* fs) {
   }
 }
 
+/**
+ * Reads exactly \c size bytes at the given offset of the file without
+ * changing the offset of the file. Concurrent reads of the same file therefore
+ * don't need to be synchronized, even if the file is shared with forked
+ * processes.
+ */
+inline void pread(int fd, void* data, size_t size, uint64_t offset) {
+  assert(data != NULL || size == 0);
+
+  char* pos = static_cast<char*>(data);
+  while (size != 0) {
+    const ssize_t n = ::pread(fd, pos, size, offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      signal_error("pread failed");
+    }
+    pos += n;
+    size -= n;
+    offset += n;
+  }
+}
+
 inline void fseek(FILE* fs, long offset, int origin) {
   assert(fs != NULL);
   if (std::fseek(fs, offset, origin) != 0) {
@@ -0,0 +1,213 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/service/AdmissionControl.hpp"
+
+namespace netspeak {
+
+using namespace service;
+
+typedef AdmissionControl::Limits Limits;
+typedef AdmissionControl::Ticket Ticket;
+
+const auto NO_DEADLINE = std::chrono::system_clock::time_point::max();
+
+bool admit(AdmissionControl& control, Ticket& ticket, size_t cost = 0,
+           const std::string& client = "") {
+  return control.admit(client, cost, NO_DEADLINE, ticket).ok();
+}
+
+BOOST_AUTO_TEST_SUITE(admission_control)
+
+BOOST_AUTO_TEST_CASE(test_unlimited) {
+  AdmissionControl control(Limits{});
+  Ticket tickets[100];
+  for (auto& ticket : tickets) {
+    BOOST_REQUIRE(admit(control, ticket, 1000, "a"));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_max_concurrent) {
+  Limits limits;
+  limits.max_concurrent = 2;
+  AdmissionControl control(limits);
+
+  Ticket a;
+  BOOST_REQUIRE(admit(control, a));
+  {
+    Ticket b;
+    BOOST_REQUIRE(admit(control, b));
+
+    Ticket c;
+    auto status = control.admit("", 0, NO_DEADLINE, c);
+    BOOST_REQUIRE_EQUAL(status.error_code(),
+                        grpc::StatusCode::RESOURCE_EXHAUSTED);
+  }
+  // b released its admission
+  Ticket d;
+  BOOST_REQUIRE(admit(control, d));
+}
+
+BOOST_AUTO_TEST_CASE(test_max_concurrent_parallelism) {
+  Limits limits;
+  limits.max_concurrent = 4;
+  AdmissionControl control(limits);
+
+  {
+    // a batch which alone exceeds the limit is admitted if nothing else runs
+    Ticket batch;
+    BOOST_REQUIRE(control.admit("", 0, NO_DEADLINE, batch, 8).ok());
+    Ticket single;
+    BOOST_REQUIRE(!admit(control, single));
+  }
+
+  Ticket batch;
+  BOOST_REQUIRE(control.admit("", 0, NO_DEADLINE, batch, 3).ok());
+  Ticket other_batch;
+  BOOST_REQUIRE(!control.admit("", 0, NO_DEADLINE, other_batch, 2).ok());
+  Ticket single;
+  BOOST_REQUIRE(admit(control, single));
+  Ticket full;
+  BOOST_REQUIRE(!admit(control, full));
+}
+
+BOOST_AUTO_TEST_CASE(test_max_concurrent_cost) {
+  Limits limits;
+  limits.max_concurrent_cost = 10;
+  AdmissionControl control(limits);
+
+  {
+    // expensive searches are admitted if nothing else is running
+    Ticket expensive;
+    BOOST_REQUIRE(admit(control, expensive, 100));
+    Ticket cheap;
+    BOOST_REQUIRE(!admit(control, cheap, 1));
+  }
+
+  Ticket a;
+  BOOST_REQUIRE(admit(control, a, 8));
+  Ticket b;
+  BOOST_REQUIRE(!admit(control, b, 5));
+  Ticket c;
+  BOOST_REQUIRE(admit(control, c, 2));
+}
+
+BOOST_AUTO_TEST_CASE(test_max_concurrent_per_client) {
+  Limits limits;
+  limits.max_concurrent_per_client = 1;
+  AdmissionControl control(limits);
+
+  Ticket a1;
+  BOOST_REQUIRE(admit(control, a1, 0, "a"));
+  {
+    Ticket a2;
+    BOOST_REQUIRE(!admit(control, a2, 0, "a"));
+    Ticket b1;
+    BOOST_REQUIRE(admit(control, b1, 0, "b"));
+  }
+
+  // requests without tracking id are not limited
+  Ticket anonymous1;
+  BOOST_REQUIRE(admit(control, anonymous1));
+  Ticket anonymous2;
+  BOOST_REQUIRE(admit(control, anonymous2));
+}
+
+BOOST_AUTO_TEST_CASE(test_max_concurrent_per_client_waiting) {
+  Limits limits;
+  limits.max_concurrent = 1;
+  limits.max_concurrent_per_client = 2;
+  limits.max_queue_time = std::chrono::seconds(10);
+  AdmissionControl control(limits);
+
+  // block the only slot, so all searches of client a have to wait
+  auto blocker = std::make_unique<Ticket>();
+  BOOST_REQUIRE(admit(control, *blocker, 0, "b"));
+
+  std::atomic<size_t> admitted(0);
+  std::atomic<size_t> rejected(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 5; i++) {
+    threads.emplace_back([&]() {
+      Ticket ticket;
+      if (admit(control, ticket, 0, "a")) {
+        admitted++;
+      } else {
+        rejected++;
+      }
+    });
+  }
+
+  // waiting searches count towards the limit of their client
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_REQUIRE_EQUAL(rejected.load(), 3);
+  BOOST_REQUIRE_EQUAL(admitted.load(), 0);
+
+  blocker.reset();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_REQUIRE_EQUAL(admitted.load(), 2);
+
+  // the client can search again once its searches are done
+  Ticket again;
+  BOOST_REQUIRE(admit(control, again, 0, "a"));
+}
+
+BOOST_AUTO_TEST_CASE(test_max_queue_time) {
+  Limits limits;
+  limits.max_concurrent = 1;
+  limits.max_queue_time = std::chrono::seconds(10);
+  AdmissionControl control(limits);
+
+  auto first = std::make_unique<Ticket>();
+  BOOST_REQUIRE(admit(control, *first));
+
+  std::thread release([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    first.reset();
+  });
+
+  // waits for the first search to finish
+  Ticket second;
+  BOOST_REQUIRE(admit(control, second));
+  release.join();
+
+  // the deadline of the request is shorter than the queue time
+  Ticket third;
+  const auto deadline =
+      std::chrono::system_clock::now() + std::chrono::milliseconds(20);
+  auto status = control.admit("", 0, deadline, third);
+  BOOST_REQUIRE_EQUAL(status.error_code(),
+                      grpc::StatusCode::RESOURCE_EXHAUSTED);
+}
+
+BOOST_AUTO_TEST_CASE(test_no_queue_time) {
+  Limits limits;
+  limits.max_concurrent = 1;
+  AdmissionControl control(limits);
+  BOOST_REQUIRE_EQUAL(limits.max_queue_time.count(), 0);
+
+  Ticket first;
+  BOOST_REQUIRE(admit(control, first));
+
+  // a queue time of 0 rejects right away, even if the deadline is far away
+  const auto start = std::chrono::steady_clock::now();
+  Ticket second;
+  const auto deadline =
+      std::chrono::system_clock::now() + std::chrono::seconds(10);
+  auto status = control.admit("", 0, deadline, second);
+  BOOST_REQUIRE_EQUAL(status.error_code(),
+                      grpc::StatusCode::RESOURCE_EXHAUSTED);
+  BOOST_REQUIRE(std::chrono::steady_clock::now() - start <
+                std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -0,0 +1,44 @@
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/model/ContinuationToken.hpp"
+
+namespace netspeak {
+
+using namespace model;
+
+BOOST_AUTO_TEST_SUITE(continuation_token)
+
+BOOST_AUTO_TEST_CASE(test_round_trip) {
+  const ContinuationToken token = {
+    .request_hash = 0x0123456789ABCDEFULL,
+    .frequency = 42,
+    .phrase_id = (3ULL << 32) | 17,
+  };
+
+  ContinuationToken decoded = {};
+  BOOST_REQUIRE(ContinuationToken::decode(token.encode(), decoded));
+  BOOST_REQUIRE_EQUAL(decoded.request_hash, token.request_hash);
+  BOOST_REQUIRE_EQUAL(decoded.frequency, token.frequency);
+  BOOST_REQUIRE_EQUAL(decoded.phrase_id, token.phrase_id);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid) {
+  const ContinuationToken token = { 1, 2, 3 };
+  const std::string data = token.encode();
+
+  ContinuationToken decoded = {};
+  BOOST_REQUIRE(!ContinuationToken::decode("", decoded));
+  BOOST_REQUIRE(!ContinuationToken::decode("not a token", decoded));
+  BOOST_REQUIRE(!ContinuationToken::decode(data.substr(1), decoded));
+  BOOST_REQUIRE(!ContinuationToken::decode(data + "x", decoded));
+
+  std::string other_version = data;
+  other_version[0] = 0;
+  BOOST_REQUIRE(!ContinuationToken::decode(other_version, decoded));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
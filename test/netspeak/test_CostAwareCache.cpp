@@ -0,0 +1,113 @@
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/util/CostAwareCache.hpp"
+
+namespace netspeak {
+
+using namespace util;
+
+typedef std::shared_ptr<std::string> shared_value;
+
+BOOST_AUTO_TEST_SUITE(cost_aware_cache)
+
+shared_value make_value(const std::string& value) {
+  return std::make_shared<std::string>(value);
+}
+
+BOOST_AUTO_TEST_CASE(test_insert) {
+  CostAwareCache<std::string> cache(0);
+  BOOST_REQUIRE_EQUAL(cache.capacity(), 0);
+
+  // a cache without capacity can't hold anything
+  BOOST_REQUIRE(!cache.insert("key", make_value("value"), 1));
+  BOOST_REQUIRE(cache.empty());
+
+  cache.reserve(2);
+  BOOST_REQUIRE_EQUAL(cache.capacity(), 2);
+  BOOST_REQUIRE(cache.insert("key1", make_value("value1"), 1));
+  BOOST_REQUIRE(!cache.insert("key1", make_value("other"), 1));
+  BOOST_REQUIRE(cache.insert("key2", make_value("value2"), 1));
+  BOOST_REQUIRE_EQUAL(cache.size(), 2);
+
+  // the cache is full, so this has to evict an entry
+  BOOST_REQUIRE(cache.insert("key3", make_value("value3"), 1));
+  BOOST_REQUIRE_EQUAL(cache.size(), 2);
+  BOOST_REQUIRE(cache.find("key3"));
+}
+
+BOOST_AUTO_TEST_CASE(test_find) {
+  CostAwareCache<std::string> cache(10);
+  BOOST_REQUIRE(!cache.find("key"));
+
+  cache.insert("key", make_value("value"), 1);
+  const auto value = cache.find("key");
+  BOOST_REQUIRE(value);
+  BOOST_REQUIRE_EQUAL(*value, "value");
+
+  BOOST_REQUIRE_EQUAL(cache.access_count(), 2);
+  BOOST_REQUIRE_CLOSE(cache.hit_rate(), 0.5, 1e-6);
+
+  cache.erase("key");
+  BOOST_REQUIRE(!cache.find("key"));
+  BOOST_REQUIRE(cache.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_peek) {
+  CostAwareCache<std::string> cache(2);
+  BOOST_REQUIRE(!cache.peek("key"));
+
+  cache.insert("old", make_value("1"), 1);
+  cache.insert("new", make_value("2"), 1);
+  const auto value = cache.peek("old");
+  BOOST_REQUIRE(value);
+  BOOST_REQUIRE_EQUAL(*value, "1");
+  BOOST_REQUIRE_EQUAL(cache.access_count(), 0);
+
+  // peeking doesn't raise the priority of an entry
+  cache.find("new");
+  cache.insert("newer", make_value("3"), 1);
+  BOOST_REQUIRE(!cache.peek("old"));
+  BOOST_REQUIRE(cache.peek("new"));
+}
+
+BOOST_AUTO_TEST_CASE(test_evict_cheap_entries) {
+  CostAwareCache<std::string> cache(3);
+  cache.insert("expensive", make_value("1"), 100);
+  cache.insert("cheap", make_value("2"), 1);
+  cache.insert("medium", make_value("3"), 10);
+
+  // the cheapest entry is evicted first
+  cache.insert("new1", make_value("4"), 5);
+  BOOST_REQUIRE(!cache.find("cheap"));
+  BOOST_REQUIRE(cache.find("expensive"));
+  BOOST_REQUIRE(cache.find("medium"));
+  BOOST_REQUIRE(cache.find("new1"));
+
+  // frequently accessed entries are kept even if they are cheap
+  cache.insert("frequent", make_value("5"), 3);
+  BOOST_REQUIRE(!cache.find("new1"));
+  for (int i = 0; i < 100; i++) {
+    BOOST_REQUIRE(cache.find("frequent"));
+  }
+  cache.insert("new2", make_value("6"), 1);
+  BOOST_REQUIRE(cache.find("frequent"));
+}
+
+BOOST_AUTO_TEST_CASE(test_aging) {
+  CostAwareCache<std::string> cache(2);
+  cache.insert("old", make_value("1"), 50);
+
+  // Every eviction raises the priority of new entries, so an expensive entry
+  // which isn't used anymore will eventually be evicted.
+  for (int i = 0; i < 100; i++) {
+    cache.insert("key" + std::to_string(i), make_value("2"), 1);
+  }
+  BOOST_REQUIRE(!cache.find("old"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -0,0 +1,51 @@
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/util/EliasFano.hpp"
+
+namespace netspeak {
+
+using namespace util;
+
+BOOST_AUTO_TEST_SUITE(elias_fano)
+
+void test_sequence(const std::vector<uint64_t>& values) {
+  const uint64_t max = values.empty() ? 0 : values.back();
+  EliasFano sequence(values.size(), max);
+  for (const auto value : values) {
+    sequence.push_back(value);
+  }
+
+  BOOST_REQUIRE_EQUAL(sequence.size(), values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    BOOST_REQUIRE_EQUAL(sequence[i], values[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_small_sequences) {
+  test_sequence({});
+  test_sequence({ 0 });
+  test_sequence({ 5 });
+  test_sequence({ 0, 0, 0 });
+  test_sequence({ 1, 2, 3, 4, 5 });
+  test_sequence({ 0, 1000000, 1000000, 1u << 31 });
+}
+
+BOOST_AUTO_TEST_CASE(test_random_sequences) {
+  std::mt19937_64 rng(42);
+  for (const uint64_t max_gap : { 1, 2, 10, 1000, 1 << 20 }) {
+    std::vector<uint64_t> values;
+    uint64_t value = 0;
+    for (size_t i = 0; i < 10000; i++) {
+      value += rng() % (max_gap + 1);
+      values.push_back(value);
+    }
+    test_sequence(values);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -0,0 +1,60 @@
+#include <chrono>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/service/LatencyTracker.hpp"
+
+namespace netspeak {
+
+using namespace service;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+BOOST_AUTO_TEST_SUITE(latency_tracker)
+
+BOOST_AUTO_TEST_CASE(test_empty) {
+  LatencyTracker tracker(100);
+  BOOST_CHECK_EQUAL(tracker.samples(), 0u);
+  BOOST_CHECK(tracker.percentile(50) == nanoseconds(0));
+}
+
+BOOST_AUTO_TEST_CASE(test_percentile) {
+  LatencyTracker tracker(1000);
+  for (int i = 0; i < 90; i++) {
+    tracker.record(microseconds(100));
+  }
+  for (int i = 0; i < 10; i++) {
+    tracker.record(microseconds(10000));
+  }
+  BOOST_CHECK_EQUAL(tracker.samples(), 100u);
+
+  // percentiles are upper bounds that are at most 19% too large
+  const auto p50 = tracker.percentile(50);
+  BOOST_CHECK(p50 >= microseconds(100));
+  BOOST_CHECK(p50 <= microseconds(119));
+  const auto p90 = tracker.percentile(90);
+  BOOST_CHECK(p90 >= microseconds(100));
+  BOOST_CHECK(p90 <= microseconds(119));
+  const auto p95 = tracker.percentile(95);
+  BOOST_CHECK(p95 >= microseconds(10000));
+  BOOST_CHECK(p95 <= microseconds(11900));
+}
+
+BOOST_AUTO_TEST_CASE(test_decay) {
+  LatencyTracker tracker(100);
+  for (int i = 0; i < 100; i++) {
+    tracker.record(microseconds(10000));
+  }
+  BOOST_CHECK(tracker.percentile(50) >= microseconds(10000));
+
+  // old latencies fade out
+  for (int i = 0; i < 1000; i++) {
+    tracker.record(microseconds(100));
+  }
+  BOOST_CHECK(tracker.samples() <= 100u);
+  BOOST_CHECK(tracker.percentile(95) <= microseconds(119));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -0,0 +1,292 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/service/LoadBalanceProxy.hpp"
+#include "netspeak/service/corpora.hpp"
+
+namespace netspeak {
+
+using namespace service;
+
+typedef LoadBalanceProxy::BackendPtr BackendPtr;
+
+Corpus make_corpus(const std::string& key) {
+  Corpus corpus;
+  corpus.set_key(key);
+  corpus.set_name(key);
+  corpus.set_language("en");
+  return corpus;
+}
+
+std::vector<BackendPtr> make_backends(size_t count) {
+  // channels connect lazily, so there don't have to be servers
+  std::vector<BackendPtr> backends;
+  for (size_t i = 0; i < count; i++) {
+    backends.push_back(
+        std::make_shared<Backend>("localhost:" + std::to_string(1 + i), 1));
+  }
+  return backends;
+}
+
+LoadBalanceProxy::BackendVector replicas(
+    const std::vector<BackendPtr>& backends) {
+  LoadBalanceProxy::BackendVector vector;
+  for (const auto& backend : backends) {
+    vector.emplace_back(make_corpus("web"), backend);
+  }
+  return vector;
+}
+
+SearchRequest make_request(const std::string& query) {
+  SearchRequest request;
+  request.set_corpus("web");
+  request.set_query(query);
+  return request;
+}
+
+BOOST_AUTO_TEST_SUITE(load_balance_proxy)
+
+BOOST_AUTO_TEST_CASE(test_route_unknown_corpus) {
+  const auto backends = make_backends(2);
+  LoadBalanceProxy proxy(replicas(backends));
+
+  auto request = make_request("foo");
+  request.set_corpus("books");
+  BOOST_CHECK(proxy.route(request) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_affinity) {
+  const auto backends = make_backends(4);
+  LoadBalanceProxy proxy(replicas(backends));
+
+  // without load, every query always goes to the same backend and the
+  // queries are spread over all backends
+  std::vector<size_t> counts(backends.size());
+  for (int i = 0; i < 400; i++) {
+    const auto request = make_request("query " + std::to_string(i));
+    const auto backend = proxy.route(request);
+    BOOST_REQUIRE(backend != nullptr);
+    BOOST_CHECK(proxy.route(request) == backend);
+    for (size_t j = 0; j < backends.size(); j++) {
+      if (backends[j].get() == backend) {
+        counts[j]++;
+      }
+    }
+  }
+  for (auto count : counts) {
+    BOOST_CHECK(count > 50u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_route_weights) {
+  std::vector<BackendPtr> backends{
+    std::make_shared<Backend>("localhost:1", 1, 1),
+    std::make_shared<Backend>("localhost:2", 1, 3),
+  };
+  LoadBalanceProxy proxy(replicas(backends));
+
+  size_t heavy = 0;
+  for (int i = 0; i < 1000; i++) {
+    const auto request = make_request("query " + std::to_string(i));
+    if (proxy.route(request) == backends[1].get()) {
+      heavy++;
+    }
+  }
+  // about 3 of 4 queries prefer the backend with weight 3
+  BOOST_CHECK(heavy > 650u);
+  BOOST_CHECK(heavy < 850u);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_consistent) {
+  // a proxy with one backend less, e.g. because it was removed
+  const auto backends = make_backends(4);
+  LoadBalanceProxy proxy(replicas(backends));
+  const auto fewer_backends = make_backends(3);
+  LoadBalanceProxy fewer(replicas(fewer_backends));
+
+  // only the queries of the removed backend move
+  size_t moved = 0;
+  for (int i = 0; i < 1000; i++) {
+    const auto request = make_request("query " + std::to_string(i));
+    const auto& address = proxy.route(request)->address();
+    const auto& fewer_address = fewer.route(request)->address();
+    if (address != backends[3]->address()) {
+      BOOST_CHECK_EQUAL(address, fewer_address);
+    } else {
+      moved++;
+    }
+  }
+  BOOST_CHECK(moved > 150u);
+  BOOST_CHECK(moved < 350u);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_bounded_load) {
+  const auto backends = make_backends(3);
+  LoadBalanceProxy::Options options;
+  options.load_factor = 1.5;
+  LoadBalanceProxy proxy(replicas(backends), options);
+
+  const auto request = make_request("foo");
+  const auto preferred = proxy.route(request);
+
+  // the preferred backend is slow and its calls pile up
+  preferred->begin_call();
+  preferred->begin_call();
+  const auto other = proxy.route(request);
+  BOOST_CHECK(other != preferred);
+
+  // once it caught up, the query goes back to it
+  preferred->end_call();
+  preferred->end_call();
+  BOOST_CHECK(proxy.route(request) == preferred);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_least_outstanding) {
+  const auto backends = make_backends(2);
+  LoadBalanceProxy proxy(replicas(backends));
+
+  // the only backend that isn't excluded is over the bound, so the least
+  // loaded one is chosen anyway
+  backends[0]->begin_call();
+  backends[0]->begin_call();
+  backends[0]->begin_call();
+  BOOST_CHECK(proxy.route(make_request("foo"), backends[1].get()) ==
+              backends[0].get());
+  for (int i = 0; i < 3; i++) {
+    backends[0]->end_call();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_route_exclude) {
+  const auto backends = make_backends(3);
+  LoadBalanceProxy proxy(replicas(backends));
+
+  const auto request = make_request("foo");
+  const auto preferred = proxy.route(request);
+  const auto hedge = proxy.route(request, preferred);
+  BOOST_CHECK(hedge != nullptr);
+  BOOST_CHECK(hedge != preferred);
+}
+
+BOOST_AUTO_TEST_CASE(test_hedge_delay) {
+  const auto backends = make_backends(2);
+  const auto request = make_request("foo");
+
+  // hedging is disabled by default
+  LoadBalanceProxy disabled(replicas(backends));
+  for (int i = 0; i < 1000; i++) {
+    disabled.record_latency(request, std::chrono::milliseconds(1));
+  }
+  BOOST_CHECK(disabled.hedge_delay(request).count() == 0);
+
+  LoadBalanceProxy::Options options;
+  options.hedge_percentile = 95;
+  LoadBalanceProxy proxy(replicas(backends), options);
+  // too few latencies
+  BOOST_CHECK(proxy.hedge_delay(request).count() == 0);
+  for (int i = 0; i < 1000; i++) {
+    proxy.record_latency(request, std::chrono::milliseconds(1));
+  }
+  BOOST_CHECK(proxy.hedge_delay(request) >= std::chrono::milliseconds(1));
+  BOOST_CHECK(proxy.hedge_delay(request) < std::chrono::milliseconds(2));
+
+  // a single backend can't be hedged
+  LoadBalanceProxy single(replicas(make_backends(1)), options);
+  for (int i = 0; i < 1000; i++) {
+    single.record_latency(request, std::chrono::milliseconds(1));
+  }
+  BOOST_CHECK(single.hedge_delay(request).count() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_split_corpora) {
+  const auto backends = make_backends(2);
+  auto vector = replicas({ backends[0] });
+  vector.emplace_back(make_corpus("books"), backends[1]);
+  LoadBalanceProxy proxy(vector);
+
+  auto request = make_request("foo");
+  request.clear_corpus();
+  request.add_corpora("books");
+  request.add_corpora("news");
+  request.add_corpora("web");
+  SearchResponse response;
+  const auto searches = proxy.split_corpora(request, response);
+
+  BOOST_REQUIRE(response.corpus_responses_size() == 3);
+  BOOST_CHECK(!response.has_error());
+  BOOST_CHECK(response.corpus_responses(1).error().kind() ==
+              SearchResponse::Error::INVALID_CORPUS);
+  BOOST_REQUIRE(searches.size() == 2);
+  BOOST_CHECK(searches[0]->index == 0);
+  BOOST_CHECK(searches[0]->backend == backends[1].get());
+  BOOST_CHECK(searches[0]->request.corpus() == "books");
+  BOOST_CHECK(searches[0]->request.corpora_size() == 0);
+  BOOST_CHECK(searches[0]->request.query() == "foo");
+  BOOST_CHECK(searches[1]->index == 2);
+  BOOST_CHECK(searches[1]->backend == backends[0].get());
+
+  // errors of single corpora aren't cached
+  BOOST_CHECK(!LoadBalanceProxy::is_cacheable(response));
+  response.mutable_corpus_responses(1)->mutable_result();
+  BOOST_CHECK(LoadBalanceProxy::is_cacheable(response));
+}
+
+BOOST_AUTO_TEST_CASE(test_split_corpora_invalid) {
+  const auto backends = make_backends(1);
+  LoadBalanceProxy proxy(replicas(backends));
+
+  // either corpus or corpora
+  auto request = make_request("foo");
+  request.add_corpora("web");
+  SearchResponse response;
+  BOOST_CHECK(proxy.split_corpora(request, response).empty());
+  BOOST_CHECK(response.error().kind() ==
+              SearchResponse::Error::INVALID_PARAMETER);
+  BOOST_CHECK(response.corpus_responses_size() == 0);
+
+  // too many corpora
+  request.clear_corpus();
+  request.clear_corpora();
+  for (size_t i = 0; i != MAX_SEARCH_CORPORA + 1; i++) {
+    request.add_corpora("web");
+  }
+  response.Clear();
+  BOOST_CHECK(proxy.split_corpora(request, response).empty());
+  BOOST_CHECK(response.error().kind() ==
+              SearchResponse::Error::INVALID_PARAMETER);
+  BOOST_CHECK(response.corpus_responses_size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_set_corpus_error) {
+  SearchResponse response;
+  response.mutable_result();
+  set_corpus_error(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "busy"),
+                   response);
+  BOOST_CHECK(response.error().kind() == SearchResponse::Error::UNKNOWN);
+  BOOST_CHECK(response.error().message().find("busy") != std::string::npos);
+  BOOST_CHECK(!response.has_result());
+  BOOST_CHECK(!LoadBalanceProxy::is_cacheable(response));
+
+  set_corpus_error(grpc::Status(grpc::StatusCode::INTERNAL, "oops"), response);
+  BOOST_CHECK(response.error().kind() ==
+              SearchResponse::Error::INTERNAL_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_options) {
+  const auto backends = make_backends(2);
+  LoadBalanceProxy::Options options;
+  options.load_factor = 0.5;
+  BOOST_CHECK_THROW(LoadBalanceProxy(replicas(backends), options),
+                    std::logic_error);
+  options.load_factor = 1;
+  options.hedge_percentile = 100;
+  BOOST_CHECK_THROW(LoadBalanceProxy(replicas(backends), options),
+                    std::logic_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
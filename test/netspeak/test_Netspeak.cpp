@@ -1,10 +1,16 @@
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <set>
 
+#include <boost/filesystem/fstream.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "ManagedDirectory.hpp"
 #include "paths.hpp"
 
 #include "netspeak/Netspeak.hpp"
+#include "netspeak/indexing.hpp"
 #include "netspeak/service/NetspeakService.pb.h"
 
 namespace netspeak {
@@ -293,6 +299,346 @@ BOOST_AUTO_TEST_CASE(test_search_with_maxfreq) {
   CHECK_PHRASES(request, expected);
 }
 
+BOOST_AUTO_TEST_CASE(test_search_stream) {
+  const std::vector<std::string> test_cases = {
+    "the *", "* ? {the world}", "i love", "foo | bar", "the [ same first ] ?",
+    "this is invalid [",
+  };
+
+  service::SearchRequest request;
+  request.set_max_phrases(20);
+
+  for (const auto& query : test_cases) {
+    BOOST_TEST_CHECKPOINT(query);
+    request.set_query(query);
+
+    service::SearchResponse expected;
+    netspeak.search(request, expected);
+
+    // the stream has to return the same phrases in the same order
+    std::vector<service::SearchResponse> stream;
+    netspeak.search_stream(request,
+                           [&](const service::SearchResponse& response) {
+                             stream.push_back(response);
+                             return true;
+                           });
+    BOOST_REQUIRE(!stream.empty());
+    const auto& last = stream.back();
+    if (expected.has_error()) {
+      BOOST_REQUIRE(last.has_error());
+      BOOST_CHECK_EQUAL(last.error().kind(), expected.error().kind());
+      continue;
+    }
+
+    service::SearchResponse::Result actual;
+    for (const auto& response : stream) {
+      BOOST_REQUIRE(response.has_result());
+      for (const auto& phrase : response.result().phrases()) {
+        actual.add_phrases()->CopyFrom(phrase);
+      }
+    }
+    actual.mutable_unknown_words()->CopyFrom(last.result().unknown_words());
+    BOOST_CHECK_EQUAL(actual.SerializeAsString(),
+                      expected.result().SerializeAsString());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_continuation_token) {
+  const std::vector<std::string> test_cases = {
+    "the *", "* ? {the world}", "i love", "foo | bar", "the [ same first ] ?",
+  };
+
+  for (const auto& query : test_cases) {
+    BOOST_TEST_CHECKPOINT(query);
+    service::SearchRequest request;
+    request.set_query(query);
+    request.set_max_phrases(30);
+    const auto expected = search(request);
+
+    // page through the same result
+    request.set_max_phrases(7);
+    service::SearchResponse::Result actual;
+    while (actual.phrases_size() < expected.phrases_size()) {
+      const auto page = search(request);
+      for (const auto& phrase : page.phrases()) {
+        actual.add_phrases()->CopyFrom(phrase);
+      }
+      if (page.continuation_token().empty()) {
+        break;
+      }
+      request.set_continuation_token(page.continuation_token());
+    }
+
+    BOOST_REQUIRE_GE(actual.phrases_size(), expected.phrases_size());
+    for (int i = 0; i < expected.phrases_size(); i++) {
+      BOOST_CHECK_EQUAL(actual.phrases(i).id(), expected.phrases(i).id());
+    }
+  }
+
+  // tokens of other requests are rejected
+  service::SearchRequest request;
+  request.set_query("the *");
+  request.set_max_phrases(7);
+  const auto page = search(request);
+  BOOST_REQUIRE(!page.continuation_token().empty());
+
+  request.set_query("i love");
+  request.set_continuation_token(page.continuation_token());
+  service::SearchResponse response;
+  netspeak.search(request, response);
+  BOOST_REQUIRE(response.has_error());
+  BOOST_CHECK_EQUAL(response.error().kind(),
+                    service::SearchResponse::Error::INVALID_PARAMETER);
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_continuation_token_plateau) {
+  const int page_size = 2;
+
+  // find a frequency shared by more phrases than fit on one page
+  service::SearchRequest request;
+  request.set_query("the ? ?");
+  request.mutable_phrase_constraints()->set_frequency_max(1000);
+  request.set_max_phrases(200);
+  const auto all = search(request);
+  BOOST_REQUIRE_GT(all.phrases_size(), 0);
+  std::map<uint64_t, int> frequency_counts;
+  for (const auto& phrase : all.phrases()) {
+    frequency_counts[phrase.frequency()]++;
+  }
+  // the phrases of the last frequency might be cut off
+  frequency_counts.erase(all.phrases(all.phrases_size() - 1).frequency());
+  const auto plateau = std::max_element(
+      frequency_counts.begin(), frequency_counts.end(),
+      [](const auto& a, const auto& b) { return a.second < b.second; });
+  BOOST_REQUIRE(plateau != frequency_counts.end());
+  BOOST_REQUIRE_GT(plateau->second, page_size);
+
+  // the result starts with the plateau
+  request.mutable_phrase_constraints()->set_frequency_max(plateau->first);
+  request.set_max_phrases(plateau->second + 10);
+  const auto expected = search(request);
+
+  request.set_max_phrases(page_size);
+  service::SearchResponse::Result actual;
+  while (actual.phrases_size() < expected.phrases_size()) {
+    const auto page = search(request);
+    // every page is full, no matter how many phrases share a frequency
+    BOOST_REQUIRE_EQUAL(page.phrases_size(), page_size);
+    for (const auto& phrase : page.phrases()) {
+      actual.add_phrases()->CopyFrom(phrase);
+    }
+    if (page.continuation_token().empty()) {
+      break;
+    }
+    request.set_continuation_token(page.continuation_token());
+  }
+
+  BOOST_REQUIRE_GE(actual.phrases_size(), expected.phrases_size());
+  for (int i = 0; i < expected.phrases_size(); i++) {
+    BOOST_CHECK_EQUAL(actual.phrases(i).id(), expected.phrases(i).id());
+    BOOST_CHECK_EQUAL(actual.phrases(i).frequency(),
+                      expected.phrases(i).frequency());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_continuation_token_index_point) {
+  // All phrases of "same ?" have the same frequency, so the points of the
+  // postlist index are in the middle of this run of equal frequencies.
+  const int phrase_count = 3000;
+  test::ManagedDirectory phrases("plateau_phrases");
+  test::ManagedDirectory index("plateau_index");
+  {
+    boost::filesystem::ofstream ofs(phrases.dir() / "phrases.txt");
+    ofs << "same\t" << 2 * phrase_count << "\n";
+    for (int i = 0; i < phrase_count; i++) {
+      ofs << "w" << i << "\t2\n";
+    }
+    for (int i = 0; i < phrase_count; i++) {
+      ofs << "same w" << i << "\t2\n";
+    }
+  }
+  BuildNetspeak(phrases.dir(), index.dir());
+
+  Netspeak plateau;
+  plateau.initialize({
+      { Configuration::PATH_TO_HOME, index.dir().string() },
+      { Configuration::CACHE_CAPACITY, "0" },
+  });
+
+  service::SearchRequest request;
+  request.set_query("same ?");
+  request.set_max_phrases(500);
+  std::set<uint64_t> ids;
+  for (;;) {
+    service::SearchResponse response;
+    plateau.search(request, response);
+    BOOST_REQUIRE(response.has_result());
+    for (const auto& phrase : response.result().phrases()) {
+      BOOST_CHECK(ids.insert(phrase.id()).second);
+    }
+    if (response.result().continuation_token().empty()) {
+      break;
+    }
+    request.set_continuation_token(response.result().continuation_token());
+  }
+
+  BOOST_CHECK_EQUAL(ids.size(), size_t(phrase_count));
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_count_only) {
+  const std::vector<std::string> test_cases = {
+    "i love ?", "foo | bar", "the [ same first ] ?", "? ? {the world}",
+  };
+
+  for (const auto& query : test_cases) {
+    BOOST_TEST_CHECKPOINT(query);
+    service::SearchRequest request;
+    request.set_query(query);
+    request.set_max_phrases(100000);
+    const auto all = search(request);
+    BOOST_REQUIRE_LT(all.phrases_size(), 100000);
+    uint64_t frequency_sum = 0;
+    for (const auto& phrase : all.phrases()) {
+      frequency_sum += phrase.frequency();
+    }
+
+    request.set_max_phrases(10);
+    request.set_count_only(true);
+    const auto exact = search(request);
+    BOOST_CHECK_EQUAL(exact.phrases_size(), 0);
+    BOOST_CHECK_EQUAL(exact.phrase_count(), uint64_t(all.phrases_size()));
+    BOOST_CHECK_EQUAL(exact.frequency_sum(), frequency_sum);
+
+    request.set_estimate_count(true);
+    const auto estimate = search(request);
+    BOOST_CHECK_EQUAL(estimate.phrases_size(), 0);
+    BOOST_CHECK_EQUAL(estimate.phrase_count() > 0, exact.phrase_count() > 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_single_word_estimate_count) {
+  // the postlist of a single word contains exactly the phrases of the query
+  for (const std::string query : { "i ?", "? love", "? ? world" }) {
+    BOOST_TEST_CHECKPOINT(query);
+    service::SearchRequest request;
+    request.set_query(query);
+    request.set_count_only(true);
+    const auto exact = search(request);
+
+    request.set_estimate_count(true);
+    const auto estimate = search(request);
+    BOOST_CHECK_EQUAL(estimate.phrase_count(), exact.phrase_count());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_bounded_count_only) {
+  Netspeak bounded;
+  bounded.initialize({
+      { Configuration::PATH_TO_HOME, test::INDEX_DIR },
+      { Configuration::SEARCH_COUNT_MAX_ENTRIES, "0" },
+  });
+
+  for (const std::string query : { "i love ?", "? ? {the world}" }) {
+    BOOST_TEST_CHECKPOINT(query);
+    service::SearchRequest request;
+    request.set_query(query);
+    request.set_count_only(true);
+    request.set_estimate_count(true);
+    const auto estimate = search(request);
+
+    // exact counts beyond the bounds are estimated
+    request.set_estimate_count(false);
+    service::SearchResponse response;
+    bounded.search(request, response);
+    BOOST_REQUIRE(response.has_result());
+    BOOST_CHECK_EQUAL(response.result().phrase_count(),
+                      estimate.phrase_count());
+    BOOST_CHECK_EQUAL(response.result().frequency_sum(),
+                      estimate.frequency_sum());
+
+    // but are more expensive to admit
+    request.set_count_only(false);
+    const size_t search_cost = netspeak.estimate_cost(request);
+    request.set_count_only(true);
+    BOOST_CHECK_EQUAL(netspeak.estimate_cost(request),
+                      Netspeak::EXACT_COUNT_COST * search_cost);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_estimate_cost_with_parsed_query) {
+  const auto query_cache_accesses = [&]() {
+    return netspeak.properties().get(Properties::cache_query_access_count);
+  };
+
+  service::SearchRequest request;
+  request.set_query("? love [ you me ]");
+  request.set_max_phrases(20);
+
+  // estimating the cost of an uncached query doesn't access the cache but
+  // parses the query
+  const auto accesses = query_cache_accesses();
+  std::shared_ptr<const model::Query> parsed_query;
+  BOOST_CHECK_GT(netspeak.estimate_cost(request, &parsed_query), 0);
+  BOOST_REQUIRE(parsed_query);
+  BOOST_CHECK_EQUAL(query_cache_accesses(), accesses);
+
+  // the search takes the parsed query
+  service::SearchResponse response;
+  netspeak.search(request, response, parsed_query);
+  BOOST_REQUIRE(response.has_result());
+  service::SearchResponse expected;
+  netspeak.search(request, expected);
+  BOOST_REQUIRE(expected.has_result());
+  BOOST_CHECK_EQUAL(response.result().phrases_size(),
+                    expected.result().phrases_size());
+
+  // cached norm queries don't have to be parsed
+  parsed_query = nullptr;
+  const auto cached_accesses = query_cache_accesses();
+  BOOST_CHECK_GT(netspeak.estimate_cost(request, &parsed_query), 0);
+  BOOST_CHECK(!parsed_query);
+  BOOST_CHECK_EQUAL(query_cache_accesses(), cached_accesses);
+}
+
+BOOST_AUTO_TEST_CASE(test_search_with_debug) {
+  service::SearchRequest request;
+  request.set_query("the ? ?");
+  request.set_max_phrases(20);
+
+  const auto searches = netspeak.stats().searches;
+  service::SearchResponse response;
+  netspeak.search(request, response);
+  BOOST_REQUIRE(response.has_result());
+  BOOST_CHECK(!response.has_stats());
+
+  // the norm queries of the query are cached now
+  request.set_debug(true);
+  response.Clear();
+  netspeak.search(request, response);
+  BOOST_REQUIRE(response.has_result());
+  BOOST_REQUIRE(response.has_stats());
+  const auto& stats = response.stats();
+  BOOST_CHECK_EQUAL(stats.norm_queries(), 1);
+  BOOST_CHECK_EQUAL(stats.query_cache_hits(), 1);
+  BOOST_CHECK(stats.postlists_read() > 0 || stats.result_cache_hits() > 0);
+  BOOST_CHECK_GE(stats.merge_time(), stats.read_phrases_time());
+  BOOST_CHECK_EQUAL(netspeak.stats().searches, searches + 2);
+
+  // only the last response of a stream has stats
+  std::vector<service::SearchResponse> stream;
+  netspeak.search_stream(request,
+                         [&](const service::SearchResponse& response) {
+                           stream.push_back(response);
+                           return true;
+                         });
+  BOOST_REQUIRE(!stream.empty());
+  for (size_t i = 0; i + 1 < stream.size(); i++) {
+    BOOST_CHECK(!stream[i].has_stats());
+  }
+  BOOST_CHECK(stream.back().has_stats());
+  BOOST_CHECK_EQUAL(netspeak.stats().searches, searches + 3);
+}
+
 /*BOOST_AUTO_TEST_CASE(test_search_with_phrase_tag_bug) {
   generated::Request request;
   request.set_query("waiting * #response");
@@ -0,0 +1,127 @@
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/util/ProcessSupervisor.hpp"
+
+namespace netspeak {
+
+using namespace util;
+
+const int TIMEOUT_MS = 10000;
+
+/**
+ * @brief Reads a pid from the given pipe. Returns 0 if the pipe was closed or
+ * nothing was written in time.
+ */
+pid_t read_pid(int fd) {
+  pollfd p = { fd, POLLIN, 0 };
+  pid_t pid = 0;
+  if (poll(&p, 1, TIMEOUT_MS) != 1 || read(fd, &pid, sizeof(pid)) <= 0) {
+    return 0;
+  }
+  return pid;
+}
+
+/**
+ * @brief Waits for the given child to exit and returns its status. Returns -1
+ * if it didn't exit in time.
+ */
+int wait_for(pid_t pid) {
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(TIMEOUT_MS);
+  while (std::chrono::steady_clock::now() < deadline) {
+    int status;
+    if (waitpid(pid, &status, WNOHANG) == pid) {
+      return status;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  kill(pid, SIGKILL);
+  waitpid(pid, nullptr, 0);
+  return -1;
+}
+
+BOOST_AUTO_TEST_SUITE(process_supervisor)
+
+BOOST_AUTO_TEST_CASE(test_invalid) {
+  BOOST_CHECK_THROW(ProcessSupervisor(0, []() { return 0; }),
+                    std::logic_error);
+  BOOST_CHECK_THROW(ProcessSupervisor(1, nullptr), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_restart_and_stop) {
+  // the number of started workers is shared by all processes
+  void* shared = mmap(nullptr, sizeof(std::atomic<int>), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  BOOST_REQUIRE(shared != MAP_FAILED);
+  auto starts = new (shared) std::atomic<int>(0);
+
+  int fds[2];
+  BOOST_REQUIRE_EQUAL(pipe(fds), 0);
+
+  // The supervisor waits for signals of the whole process, so it runs in a
+  // process of its own.
+  std::cout.flush();
+  std::fflush(nullptr);
+  const pid_t supervisor = fork();
+  BOOST_REQUIRE(supervisor >= 0);
+  if (supervisor == 0) {
+    close(fds[0]);
+    signal(SIGCHLD, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    ProcessSupervisor(1, [&]() {
+      if ((*starts)++ == 0) {
+        // the first worker exits right away
+        return EXIT_FAILURE;
+      }
+      const pid_t pid = getpid();
+      if (write(fds[1], &pid, sizeof(pid)) != sizeof(pid)) {
+        return EXIT_FAILURE;
+      }
+      while (true) {
+        pause();
+      }
+    }).run();
+    _exit(EXIT_SUCCESS);
+  }
+  close(fds[1]);
+
+  // the worker that exited was restarted
+  const pid_t worker = read_pid(fds[0]);
+  BOOST_CHECK(worker != 0);
+  BOOST_CHECK_EQUAL(starts->load(), 2);
+
+  // SIGTERM stops the supervisor and its worker
+  kill(supervisor, SIGTERM);
+  const int status = wait_for(supervisor);
+  BOOST_CHECK(status != -1 && WIFEXITED(status) &&
+              WEXITSTATUS(status) == EXIT_SUCCESS);
+  if (worker != 0) {
+    BOOST_CHECK(kill(worker, 0) == -1 && errno == ESRCH);
+  }
+  // no worker is left to write
+  BOOST_CHECK_EQUAL(read_pid(fds[0]), 0);
+  BOOST_CHECK_EQUAL(starts->load(), 2);
+
+  close(fds[0]);
+  munmap(shared, sizeof(std::atomic<int>));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -0,0 +1,83 @@
+#include <memory_resource>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/util/RequestArena.hpp"
+
+namespace netspeak {
+
+using namespace util;
+
+/**
+ * @brief A memory resource which counts the allocations and deallocations of
+ * the new-delete resource.
+ */
+class counting_resource : public std::pmr::memory_resource {
+public:
+  size_t allocations = 0;
+  size_t deallocations = 0;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    deallocations++;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(request_arena)
+
+BOOST_AUTO_TEST_CASE(test_small_requests) {
+  counting_resource upstream;
+  for (int request = 0; request < 10; request++) {
+    RequestArena arena(&upstream);
+    std::pmr::vector<int> values(arena.resource());
+    for (int i = 0; i < 1000; i++) {
+      values.push_back(i);
+    }
+  }
+
+  // everything fits into the buffer of the thread
+  BOOST_REQUIRE_EQUAL(upstream.allocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_large_requests) {
+  counting_resource upstream;
+  {
+    RequestArena arena(&upstream);
+    std::pmr::vector<int> values(arena.resource());
+    for (int i = 0; i < 1000000; i++) {
+      values.push_back(i);
+    }
+    BOOST_REQUIRE_GT(upstream.allocations, 0);
+    BOOST_REQUIRE_EQUAL(upstream.deallocations, 0);
+  }
+
+  // all memory is released when the arena is destroyed
+  BOOST_REQUIRE_EQUAL(upstream.allocations, upstream.deallocations);
+}
+
+BOOST_AUTO_TEST_CASE(test_nested) {
+  counting_resource upstream;
+  RequestArena outer(&upstream);
+  std::pmr::vector<int> outer_values({ 1, 2, 3 }, outer.resource());
+  {
+    // the buffer of the thread is already used by the outer arena
+    RequestArena inner(&upstream);
+    std::pmr::vector<int> inner_values({ 4, 5, 6 }, inner.resource());
+    BOOST_REQUIRE_GT(upstream.allocations, 0);
+  }
+  BOOST_REQUIRE_EQUAL(upstream.allocations, upstream.deallocations);
+  BOOST_REQUIRE_EQUAL(outer_values[2], 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
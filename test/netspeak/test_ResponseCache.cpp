@@ -0,0 +1,134 @@
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/service/ResponseCache.hpp"
+
+namespace netspeak {
+
+using namespace service;
+
+typedef ResponseCache::Bytes Bytes;
+typedef ResponseCache::Lookup Lookup;
+
+Bytes make_bytes(const std::string& value) {
+  return std::make_shared<const std::string>(value);
+}
+
+ResponseCache::Options make_options(size_t max_bytes) {
+  ResponseCache::Options options;
+  options.max_bytes = max_bytes;
+  return options;
+}
+
+void unexpected_waiter(const Bytes&) {
+  BOOST_FAIL("unexpected waiter call");
+}
+
+BOOST_AUTO_TEST_SUITE(response_cache)
+
+BOOST_AUTO_TEST_CASE(test_hit_and_miss) {
+  ResponseCache cache(make_options(1000));
+
+  Bytes bytes;
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("a", make_bytes("response"));
+  BOOST_CHECK_EQUAL(cache.size_bytes(), 9u);
+
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::HIT);
+  BOOST_CHECK_EQUAL(*bytes, "response");
+  BOOST_CHECK(cache.lookup("b", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("b", nullptr);
+  BOOST_CHECK_EQUAL(cache.access_count(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(test_single_flight) {
+  ResponseCache cache(make_options(1000));
+
+  Bytes bytes;
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::MISS);
+
+  // other lookups wait for the fill
+  size_t woken = 0;
+  const auto waiter = [&](const Bytes& filled) {
+    BOOST_REQUIRE(filled);
+    BOOST_CHECK_EQUAL(*filled, "response");
+    woken++;
+  };
+  BOOST_REQUIRE(cache.lookup("a", bytes, waiter) == Lookup::PENDING);
+  BOOST_REQUIRE(cache.lookup("a", bytes, waiter) == Lookup::PENDING);
+  BOOST_CHECK_EQUAL(woken, 0u);
+
+  cache.fill("a", make_bytes("response"));
+  BOOST_CHECK_EQUAL(woken, 2u);
+  BOOST_CHECK(cache.lookup("a", bytes, unexpected_waiter) == Lookup::HIT);
+}
+
+BOOST_AUTO_TEST_CASE(test_failed_fill) {
+  ResponseCache cache(make_options(1000));
+
+  Bytes bytes;
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::MISS);
+  bool woken = false;
+  BOOST_REQUIRE(cache.lookup("a", bytes, [&](const Bytes& filled) {
+    BOOST_CHECK(!filled);
+    woken = true;
+  }) == Lookup::PENDING);
+
+  // waiters learn that there is no response and the next lookup misses
+  cache.fill("a", nullptr);
+  BOOST_CHECK(woken);
+  BOOST_CHECK(cache.lookup("a", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("a", nullptr);
+  BOOST_CHECK_EQUAL(cache.size_bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_ttl) {
+  auto options = make_options(1000);
+  options.ttl = std::chrono::milliseconds(10);
+  ResponseCache cache(options);
+
+  Bytes bytes;
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("a", make_bytes("response"));
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::HIT);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  BOOST_CHECK(cache.lookup("a", bytes, unexpected_waiter) == Lookup::MISS);
+  BOOST_CHECK_EQUAL(cache.size_bytes(), 0u);
+  cache.fill("a", nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_byte_budget) {
+  ResponseCache cache(make_options(20));
+
+  Bytes bytes;
+  for (auto key : { "a", "b" }) {
+    BOOST_REQUIRE(cache.lookup(key, bytes, unexpected_waiter) == Lookup::MISS);
+    cache.fill(key, make_bytes("123456789"));
+  }
+  BOOST_CHECK_EQUAL(cache.size_bytes(), 20u);
+
+  // "a" was used more recently than "b", so "b" is evicted
+  BOOST_REQUIRE(cache.lookup("a", bytes, unexpected_waiter) == Lookup::HIT);
+  BOOST_REQUIRE(cache.lookup("c", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("c", make_bytes("123456789"));
+  BOOST_CHECK_EQUAL(cache.size_bytes(), 20u);
+  BOOST_CHECK(cache.lookup("a", bytes, unexpected_waiter) == Lookup::HIT);
+  BOOST_CHECK(cache.lookup("b", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("b", nullptr);
+
+  // responses larger than the budget aren't cached
+  BOOST_REQUIRE(cache.lookup("d", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("d", make_bytes(std::string(100, 'x')));
+  BOOST_CHECK(cache.lookup("d", bytes, unexpected_waiter) == Lookup::MISS);
+  cache.fill("d", nullptr);
+  BOOST_CHECK_EQUAL(cache.size_bytes(), 20u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -0,0 +1,131 @@
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "netspeak/model/ContinuationToken.hpp"
+#include "netspeak/service/ShardedProxy.hpp"
+
+namespace netspeak {
+
+using namespace service;
+
+void add_phrase(SearchResponse& response, uint64_t id, uint64_t freq) {
+  auto phrase = response.mutable_result()->add_phrases();
+  phrase->set_id(id);
+  phrase->set_frequency(freq);
+}
+
+SearchResponse merge_shards(const SearchRequest& request,
+                            std::vector<SearchResponse>& shards) {
+  std::vector<SearchResponse*> ptrs;
+  for (auto& shard : shards) {
+    ptrs.push_back(&shard);
+  }
+  SearchResponse response;
+  ShardedProxy::merge(request, ptrs, response);
+  return response;
+}
+
+BOOST_AUTO_TEST_SUITE(sharded_proxy)
+
+BOOST_AUTO_TEST_CASE(test_merge_phrases) {
+  SearchRequest request;
+  request.set_query("foo ?");
+  request.set_max_phrases(4);
+
+  std::vector<SearchResponse> shards(3);
+  add_phrase(shards[0], 1, 100);
+  add_phrase(shards[0], 2, 10);
+  add_phrase(shards[1], 3, 50);
+  add_phrase(shards[1], 4, 10);
+  add_phrase(shards[1], 5, 5);
+  shards[2].mutable_result();
+
+  const auto response = merge_shards(request, shards);
+  BOOST_REQUIRE(response.has_result());
+  const auto& phrases = response.result().phrases();
+  BOOST_REQUIRE_EQUAL(phrases.size(), 4);
+  const uint64_t expected_ids[] = { 1, 3, 2, 4 };
+  for (int i = 0; i < 4; i++) {
+    BOOST_CHECK_EQUAL(phrases[i].id(), expected_ids[i]);
+  }
+
+  // the page is full, so the last phrase is the next start
+  model::ContinuationToken token = {};
+  BOOST_REQUIRE(model::ContinuationToken::decode(
+      response.result().continuation_token(), token));
+  BOOST_CHECK_EQUAL(token.frequency, 10u);
+  BOOST_CHECK_EQUAL(token.phrase_id, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_unknown_words) {
+  SearchRequest request;
+  request.set_max_phrases(10);
+
+  std::vector<SearchResponse> shards(2);
+  shards[0].mutable_result()->add_unknown_words("foo");
+  shards[0].mutable_result()->add_unknown_words("bar");
+  shards[1].mutable_result()->add_unknown_words("bar");
+
+  const auto response = merge_shards(request, shards);
+  const auto& words = response.result().unknown_words();
+  BOOST_REQUIRE_EQUAL(words.size(), 1);
+  BOOST_CHECK_EQUAL(words[0], "bar");
+  BOOST_CHECK(response.result().continuation_token().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_counts) {
+  SearchRequest request;
+  request.set_count_only(true);
+
+  std::vector<SearchResponse> shards(2);
+  shards[0].mutable_result()->set_phrase_count(3);
+  shards[0].mutable_result()->set_frequency_sum(30);
+  shards[1].mutable_result()->set_phrase_count(4);
+  shards[1].mutable_result()->set_frequency_sum(12);
+
+  const auto response = merge_shards(request, shards);
+  BOOST_CHECK_EQUAL(response.result().phrase_count(), 7u);
+  BOOST_CHECK_EQUAL(response.result().frequency_sum(), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_error) {
+  SearchRequest request;
+  request.set_max_phrases(10);
+
+  std::vector<SearchResponse> shards(2);
+  add_phrase(shards[0], 1, 100);
+  shards[1].mutable_error()->set_kind(SearchResponse::Error::INVALID_QUERY);
+
+  const auto response = merge_shards(request, shards);
+  BOOST_REQUIRE(response.has_error());
+  BOOST_CHECK_EQUAL(response.error().kind(),
+                    SearchResponse::Error::INVALID_QUERY);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_stats) {
+  SearchRequest request;
+  request.set_max_phrases(10);
+
+  std::vector<SearchResponse> shards(2);
+  add_phrase(shards[0], 1, 100);
+  shards[0].mutable_stats()->set_parse_time(10);
+  shards[0].mutable_stats()->set_postlists_read(2);
+  add_phrase(shards[1], 2, 50);
+  shards[1].mutable_stats()->set_parse_time(5);
+  shards[1].mutable_stats()->set_postlists_read(3);
+
+  // only debug requests get stats
+  BOOST_CHECK(!merge_shards(request, shards).has_stats());
+
+  request.set_debug(true);
+  const auto response = merge_shards(request, shards);
+  BOOST_REQUIRE(response.has_stats());
+  BOOST_CHECK_EQUAL(response.stats().parse_time(), 15u);
+  BOOST_CHECK_EQUAL(response.stats().postlists_read(), 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace netspeak
@@ -523,5 +523,129 @@ BOOST_AUTO_TEST_CASE(test_lower_case) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_regex_cache) {
+  const QueryNormalizer::InitConfig init = {
+    .regex_index = DEFAULT_INIT.regex_index,
+    .dictionary = DEFAULT_INIT.dictionary,
+    .regex_cache_capacity = 10,
+  };
+  QueryNormalizer normalizer(init);
+  BOOST_REQUIRE(normalizer.regex_cache());
+
+  auto normalize = [&](const std::string& query, size_t max_regex_matches) {
+    auto options = DEFAULT_OPTIONS;
+    options.max_regex_matches = max_regex_matches;
+    std::vector<NormQuery> norm_queries;
+    normalizer.normalize(antlr4::parse_query(query), options, norm_queries);
+    return stringify_norm_queries(norm_queries);
+  };
+
+  {
+    const auto actual = normalize("te*", 10);
+    std::vector<std::string> expected{
+      "test",
+      "tester",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                  expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(normalizer.regex_cache()->size(), 1);
+  }
+  {
+    // served from the cache by truncation
+    const auto actual = normalize("te*", 1);
+    std::vector<std::string> expected{
+      "test",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                  expected.begin(), expected.end());
+  }
+  {
+    // the cached entry contains all matches, so it can serve more as well
+    const auto actual = normalize("te*", 100);
+    std::vector<std::string> expected{
+      "test",
+      "tester",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                  expected.begin(), expected.end());
+  }
+  BOOST_CHECK_EQUAL(normalizer.regex_cache()->size(), 1);
+  BOOST_CHECK_EQUAL(normalizer.regex_cache()->access_count(), 3);
+  BOOST_CHECK_CLOSE(normalizer.regex_cache()->hit_rate(), 2.0 / 3.0, 1e-6);
+
+  {
+    // a truncated entry cannot serve a larger request
+    const auto truncated = normalize("**", 1);
+    BOOST_CHECK_EQUAL(truncated.size(), 1);
+    const auto actual = normalize("**", 10);
+    std::vector<std::string> expected{
+      "test",
+      "tester",
+      "total",
+      "toronto",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                  expected.begin(), expected.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_estimate) {
+  const QueryNormalizer::InitConfig init = {
+    .regex_index = DEFAULT_INIT.regex_index,
+    .dictionary = DEFAULT_INIT.dictionary,
+    .regex_cache_capacity = 10,
+  };
+  QueryNormalizer normalizer(init);
+
+  const std::vector<std::string> queries{
+    "foo ? [ bar baz ]", "te* ?", "** ... #waste", "{ a b c }",
+    "? ? ? ? ? ? ?",
+  };
+  std::vector<size_t> estimates;
+  for (const auto& query : queries) {
+    estimates.push_back(
+        normalizer.estimate(antlr4::parse_query(query), DEFAULT_OPTIONS));
+  }
+  // estimates don't search for regex matches
+  BOOST_CHECK_EQUAL(normalizer.regex_cache()->access_count(), 0);
+
+  for (size_t i = 0; i < queries.size(); i++) {
+    std::vector<NormQuery> norm_queries;
+    normalizer.normalize(antlr4::parse_query(queries[i]), DEFAULT_OPTIONS,
+                         norm_queries);
+    BOOST_TEST_INFO("query: " << queries[i]);
+    BOOST_CHECK_GE(estimates[i], norm_queries.size());
+    BOOST_CHECK_LE(estimates[i], DEFAULT_OPTIONS.max_norm_queries);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_word_ids) {
+  QueryNormalizer::Vocabulary::Builder builder;
+  builder.append("foo", 3);
+  builder.append("bar", 7);
+  const QueryNormalizer::InitConfig init = {
+    .vocabulary =
+        std::make_shared<const QueryNormalizer::Vocabulary>(std::move(builder)),
+  };
+  QueryNormalizer normalizer(init);
+
+  std::vector<NormQuery> norm_queries;
+  normalizer.normalize(antlr4::parse_query("foo ? [ bar baz ]"),
+                       DEFAULT_OPTIONS, norm_queries);
+  BOOST_REQUIRE_EQUAL(norm_queries.size(), 2);
+
+  const auto& foo_bar = norm_queries[0].units();
+  BOOST_REQUIRE_EQUAL(norm_queries[0].size(), 3);
+  BOOST_CHECK_EQUAL(foo_bar[0].id(), 3);
+  BOOST_CHECK_EQUAL(foo_bar[1].id(), NormQuery::Unit::UNKNOWN_ID);
+  BOOST_CHECK_EQUAL(foo_bar[2].id(), 7);
+
+  // words which are not in the vocabulary keep their text
+  const auto& foo_baz = norm_queries[1].units();
+  BOOST_REQUIRE_EQUAL(norm_queries[1].size(), 3);
+  BOOST_CHECK_EQUAL(*foo_baz[2].text(), "baz");
+  BOOST_CHECK_EQUAL(foo_baz[2].id(), NormQuery::Unit::UNKNOWN_ID);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,12 +1,20 @@
+#include <dirent.h>
+
+#include <fstream>
 #include <iostream>
+#include <random>
 #include <sstream>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include "paths.hpp"
+
 #include "antlr4/parse.hpp"
 
 #include "netspeak/error.hpp"
 #include "netspeak/model/Query.hpp"
+#include "netspeak/parse.hpp"
 
 
 namespace netspeak {
@@ -24,14 +32,54 @@ std::string remove_spaces(const std::string& str) {
   return new_str;
 }
 
-std::string parse(const std::string& query_str) {
-  const auto query = antlr4::parse_query(query_str);
+typedef std::shared_ptr<model::Query> (*query_parser)(const std::string&);
+
+std::string parse(const std::string& query_str, query_parser parser) {
+  const auto query = parser(query_str);
 
   std::stringstream out;
   out << *query;
   return out.str();
 }
 
+/**
+ * @brief Parses the given query with both the ANTLR parser and the
+ * recursive-descent parser and returns the result of the ANTLR parser.
+ *
+ * If only one of the parsers throws, the test will fail.
+ */
+std::string parse(const std::string& query_str) {
+  std::string expected;
+  try {
+    expected = parse(query_str, antlr4::parse_query);
+  } catch (const netspeak::invalid_query_error&) {
+    BOOST_CHECK_THROW(parse(query_str, netspeak::parse_query),
+                      netspeak::invalid_query_error);
+    throw;
+  }
+  BOOST_CHECK_EQUAL(parse(query_str, netspeak::parse_query), expected);
+  return expected;
+}
+
+/**
+ * @brief Returns the query tree of the given parser or "FAIL" if the query is
+ * invalid.
+ */
+std::string parse_or_fail(const std::string& query_str, query_parser parser) {
+  try {
+    return parse(query_str, parser);
+  } catch (const netspeak::invalid_query_error&) {
+    return "FAIL";
+  }
+}
+
+void check_same_parse(const std::string& query_str) {
+  BOOST_TEST_CONTEXT("Query: " << query_str) {
+    BOOST_CHECK_EQUAL(parse_or_fail(query_str, netspeak::parse_query),
+                      parse_or_fail(query_str, antlr4::parse_query));
+  }
+}
+
 // The syntax for this test suite is brought to you by the C preprocessor.
 // https://gcc.gnu.org/onlinedocs/gcc-4.8.5/cpp/Stringification.html
 #define ASSERT_QUERY(query, expected)                                         \
@@ -142,6 +190,64 @@ BOOST_AUTO_TEST_CASE(test_too_long_query) {
   ASSERT_INCORRECT_QUERY(std::string(4000, 'a'));
 }
 
+BOOST_AUTO_TEST_CASE(test_same_as_antlr4_on_test_queries) {
+  std::string path(test::QUERIES_DIR);
+
+  DIR* dir = opendir(path.c_str());
+  if (dir == NULL) {
+    std::cerr << "no such directory" << std::endl;
+    return;
+  }
+  std::vector<std::string> files;
+  struct dirent* pdir;
+  while ((pdir = readdir(dir)) != NULL) {
+    files.push_back(path + "/" + pdir->d_name);
+  }
+  closedir(dir);
+
+  for (const auto& file : files) {
+    std::ifstream in(file, std::ios::in);
+    std::string line;
+    while (std::getline(in, line)) {
+      check_same_parse(line.substr(0, line.find('\t')));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_same_as_antlr4_on_random_queries) {
+  // Random queries made of all characters of the grammar. Most of them are
+  // invalid but all of them have to be tokenized and parsed the same way.
+  const std::vector<std::string> chars = {
+    "a", "b", "c", ".", ".", "?", "*", "+", "|", "#", "{", "}", "[", "]",
+    "\"", "\\", " ", " ", "\t", "\xC3\xA9" /* é */,
+    "\xE3\x80\x80" /* ideographic space */,
+  };
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> length_dist(1, 12);
+  std::uniform_int_distribution<size_t> char_dist(0, chars.size() - 1);
+
+  for (size_t i = 0; i < 5000; i++) {
+    std::string query;
+    for (size_t length = length_dist(rng); length > 0; length--) {
+      query.append(chars[char_dist(rng)]);
+    }
+    check_same_parse(query);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_escaping) {
+  ASSERT_QUERY("\\?", Query(Alternation{ Concat{ Word("?") } }));
+  ASSERT_QUERY("a\\..", Query(Alternation{ Concat{ Word("a..") } }));
+  ASSERT_QUERY("[abc]x", Query(Alternation{ Concat{ Regex("[abc]x") } }));
+  ASSERT_INCORRECT_QUERY("x\\ y");
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_utf8) {
+  BOOST_CHECK_THROW(netspeak::parse_query("abc \xFF"),
+                    netspeak::invalid_query_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace regex
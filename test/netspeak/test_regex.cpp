@@ -1,10 +1,18 @@
 #include <iostream>
+#include <memory>
+#include <random>
 
+#include <boost/regex.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "paths.hpp"
 
+#include "antlr4/parse.hpp"
+
+#include "netspeak/QueryNormalizer.hpp"
+#include "netspeak/model/NormQuery.hpp"
 #include "netspeak/regex/DefaultRegexIndex.hpp"
+#include "netspeak/regex/RegexMatcher.hpp"
 #include "netspeak/regex/RegexQuery.hpp"
 #include "netspeak/regex/parsers.hpp"
 
@@ -223,6 +231,285 @@ BOOST_AUTO_TEST_CASE(test_default_regex_index_unicode) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_default_regex_index_threads) {
+  // a vocabulary large enough to be split into many chunks
+  std::string vocabulary;
+  for (size_t i = 0; i < 100000; i++) {
+    if (i != 0) {
+      vocabulary.push_back('\n');
+    }
+    vocabulary.append("w" + std::to_string(i * 7919 % 100003));
+  }
+  const DefaultRegexIndex sequential(vocabulary, { .threads = 1 });
+  const DefaultRegexIndex parallel(vocabulary, { .threads = 4 });
+
+  auto test = [&](std::string query, uint32_t max_matches) {
+    std::vector<std::string> expected = matches(sequential, query, max_matches);
+    std::vector<std::string> actual = matches(parallel, query, max_matches);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                    expected.begin(), expected.end());
+  };
+
+  test("w*7", 10);
+  test("w*7", 100000);
+  test("w[12]*[34]", 1000);
+  test("w9999?", 5);
+  test("w*x", 10); // no matches at all
+}
+
+BOOST_AUTO_TEST_CASE(test_default_regex_index_complete_when_full) {
+  // a vocabulary spanning many chunks with way more than max_matches matches
+  std::string vocabulary;
+  for (size_t i = 0; i < 100000; i++) {
+    if (i != 0) {
+      vocabulary.push_back('\n');
+    }
+    vocabulary.append("w" + std::to_string(i));
+  }
+
+  for (const size_t threads : { 1, 4 }) {
+    const auto index = std::make_shared<DefaultRegexIndex>(
+        vocabulary, DefaultRegexIndex::InitConfig{ .threads = threads });
+
+    // filling max_matches is a complete result, even if later chunks were
+    // never scanned
+    std::vector<uint32_t> indexes;
+    const auto query = parse_netspeak_regex_query("w*7");
+    BOOST_CHECK(index->match_query_indexes(query, indexes, 10,
+                                           std::chrono::seconds(5)));
+    BOOST_CHECK_EQUAL(indexes.size(), 10);
+
+    // and complete results get cached
+    const QueryNormalizer::InitConfig init = {
+      .regex_index = index,
+      .regex_cache_capacity = 10,
+    };
+    QueryNormalizer normalizer(init);
+    const QueryNormalizer::Options options = {
+      .max_norm_queries = 1000,
+      .min_length = 1,
+      .max_length = 5,
+      .max_regex_matches = 10,
+      .max_regex_time = std::chrono::seconds(5),
+    };
+    std::vector<model::NormQuery> norm_queries;
+    BOOST_CHECK(normalizer.normalize(antlr4::parse_query("w*7"), options,
+                                     norm_queries));
+    BOOST_CHECK_EQUAL(norm_queries.size(), 10);
+    BOOST_CHECK_EQUAL(normalizer.regex_cache()->size(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_default_regex_index_trigram_index) {
+  std::string vocabulary;
+  for (size_t i = 0; i < 100000; i++) {
+    if (i != 0) {
+      vocabulary.push_back('\n');
+    }
+    vocabulary.append("w" + std::to_string(i * 7919 % 100003) + "ä");
+  }
+  const DefaultRegexIndex scan(vocabulary);
+  const DefaultRegexIndex trigrams(vocabulary, { .trigram_index = true });
+  BOOST_REQUIRE(trigrams.trigram_index() != nullptr);
+
+  auto test = [&](std::string query, uint32_t max_matches) {
+    std::vector<std::string> expected = matches(scan, query, max_matches);
+    std::vector<std::string> actual = matches(trigrams, query, max_matches);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                    expected.begin(), expected.end());
+  };
+
+  test("*123*", 10);
+  test("*123*", 100000);
+  test("w12*45?", 1000);
+  test("*9?9*0ä", 1000);
+  test("*2ä", 100000);
+  test("*xyz*", 10); // unknown trigram
+  test("w*1*", 10);  // no trigrams, so this is a scan
+}
+
+BOOST_AUTO_TEST_CASE(test_default_regex_index_affix_index) {
+  std::string vocabulary;
+  for (size_t i = 0; i < 100000; i++) {
+    if (i != 0) {
+      vocabulary.push_back('\n');
+    }
+    vocabulary.append(std::to_string(i * 7919 % 100003) + "ä");
+  }
+  const DefaultRegexIndex scan(vocabulary);
+  const DefaultRegexIndex affixes(vocabulary, { .affix_index = true });
+  BOOST_REQUIRE(affixes.memory_usage().affix_index > 0);
+
+  auto test = [&](std::string query, uint32_t max_matches) {
+    std::vector<std::string> expected = matches(scan, query, max_matches);
+    std::vector<std::string> actual = matches(affixes, query, max_matches);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                    expected.begin(), expected.end());
+  };
+
+  test("12*", 10);
+  test("12*", 100000);
+  test("1*", 100);
+  test("*3ä", 10);
+  test("*93ä", 100000);
+  test("4?2*", 100);
+  test("12*0ä", 100);
+  test("*7?ä", 100);
+  test("99999*", 10);
+  test("*ü", 10); // no matches at all
+}
+
+/**
+ * @brief Returns an equivalent boost regex pattern for the given query.
+ *
+ * This is how regex queries used to be matched before \c RegexMatcher .
+ */
+std::string boost_regex_pattern(const RegexQuery& query) {
+  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
+  std::string pattern;
+  auto append_escaped = [&](const std::u32string& chars) {
+    for (const auto c : chars) {
+      if (c < 128 && !std::isalnum((int)c)) {
+        pattern.push_back('\\');
+      }
+      pattern.append(conv.to_bytes(c));
+    }
+  };
+
+  for (const auto& unit : query.get_units()) {
+    switch (unit.type) {
+      case RegexUnit::Type::QMARK:
+        pattern.append("(?:[\\x00-\\x7F]|[\\xC0-\\xDF][\\x80-\\xBF]|"
+                       "[\\xE0-\\xEF][\\x80-\\xBF]{2}|"
+                       "[\\xF0-\\xF7][\\x80-\\xBF]{3})");
+        break;
+      case RegexUnit::Type::STAR:
+        pattern.append("(?:.|\\n)*");
+        break;
+      case RegexUnit::Type::CHAR_SET:
+        pattern.append("(?:");
+        for (size_t i = 0; i < unit.value.size(); i++) {
+          if (i != 0) {
+            pattern.push_back('|');
+          }
+          append_escaped(unit.value.substr(i, 1));
+        }
+        pattern.append(unit.value.empty() ? "(?!))" : ")");
+        break;
+      case RegexUnit::Type::OPTIONAL_WORD:
+        pattern.append("(?:");
+        append_escaped(unit.value);
+        pattern.append(")?");
+        break;
+      default:
+        append_escaped(unit.value);
+        break;
+    }
+  }
+
+  return pattern;
+}
+
+BOOST_AUTO_TEST_CASE(test_regex_matcher) {
+  auto test = [](std::string query, std::string word, bool expected) {
+    const RegexMatcher matcher(parse_netspeak_regex_query(query));
+    BOOST_TEST_CONTEXT("query: " << query << ", word: " << word) {
+      BOOST_REQUIRE_EQUAL(matcher.match(word), expected);
+    }
+  };
+
+  test("*", "", true);
+  test("*", "foo", true);
+  test("f?r", "für", true);
+  test("f?r", "fr", false);
+  test("f??r", "für", false);
+  test("*add*", "address", true);
+  test("*add*", "adder", true);
+  test("*add*", "adieu", false);
+  test("a*b*c", "abc", true);
+  test("a*b*c", "aXbYc", true);
+  test("a*b*c", "acb", false);
+  test("*ab*ab", "abab", true);
+  test("*ab*ab", "aab", false);
+  test("*ab*ab", "abXXab", true);
+  test("[äb]et", "ät", false);
+  test("[äb]et", "äet", true);
+  test("[äb]et", "bet", true);
+  test("f{or}m", "from", true);
+  test("f{or}m", "form", true);
+  test("f{or}m", "fom", false);
+  test("col[o]r", "color", true);
+  test("col[o]r", "colr", true);
+  test("col[o]r", "coloor", false);
+  test("*b[a]c", "bac", true);
+  test("*b[a]c", "bacc", false);
+  test("*?ß", "aß", true);
+  test("*?ß", "ß", false);
+
+  // optional words with more than one character
+  const RegexMatcher optional(RegexQuery({ RegexUnit::word(U"a"),
+                                           RegexUnit::optional_word(U"bc"),
+                                           RegexUnit::word(U"c") }));
+  BOOST_REQUIRE(optional.match("abcc"));
+  BOOST_REQUIRE(optional.match("ac"));
+  BOOST_REQUIRE(!optional.match("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(test_regex_matcher_against_boost_regex) {
+  // Compare the matcher to boost::regex on random words and queries made from
+  // a small alphabet, so that there are plenty of matches.
+  const std::u32string alphabet = U"abcä€";
+  const std::vector<std::string> queries{
+    "*",      "?",       "a*",     "*a",       "*a*",         "*ab*",
+    "a?*b",   "*a*b*c*", "?ä*",    "*€",       "[abä]*",      "*[c€]?",
+    "a[b]c*", "*b[a]a*", "{ab}*",  "*{aä}?",   "a*?*?a",      "*ä*ä*",
+    "[a]b*a", "?*€?",    "*[ab]b", "*[ä€]*b*", "a[ä][b]*?c*", "**b?",
+  };
+
+  std::mt19937 rng(42);
+  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 2000; i++) {
+    std::u32string word;
+    const size_t length = rng() % 8;
+    for (size_t j = 0; j < length; j++) {
+      word.push_back(alphabet[rng() % alphabet.size()]);
+    }
+    words.push_back(conv.to_bytes(word));
+  }
+
+  for (const auto& query_string : queries) {
+    const auto query = parse_netspeak_regex_query(query_string);
+    const RegexMatcher matcher(query);
+    const boost::regex expression(boost_regex_pattern(query));
+
+    for (const auto& word : words) {
+      BOOST_TEST_CONTEXT("query: " << query_string << ", word: " << word) {
+        BOOST_REQUIRE_EQUAL(matcher.match(word),
+                            boost::regex_match(word, expression));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_default_regex_index_empty_lines) {
+  // empty lines are ignored and the last word doesn't need a \n
+  const DefaultRegexIndex index("\n\nfor\n\n\nfür\nfar\n\nform");
+
+  auto test = [&](std::string query, const std::vector<std::string>& expected) {
+    std::vector<std::string> actual = matches(index, query, 10);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(actual.begin(), actual.end(),
+                                    expected.begin(), expected.end());
+  };
+
+  test("f?r", { "for", "für", "far" });
+  test("f*", { "for", "für", "far", "form" });
+  test("*m", { "form" });
+  test("[fb]or[m]", { "for", "form" });
+  test("für", { "für" });
+  test("fur", {});
+}
+
 uint32_t get_combinations(std::string netspeak_regex_query) {
   return parse_netspeak_regex_query(netspeak_regex_query)
       .combinations_upper_bound();